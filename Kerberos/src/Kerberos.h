@@ -24,11 +24,13 @@
 #include "Kerberos/Renderer/Renderer.h"
 #include "Kerberos/Renderer/Renderer2D.h"
 #include "Kerberos/Renderer/RenderCommand.h"
+#include "Kerberos/Renderer/RenderThread.h"
 #include "Kerberos/Renderer/OrthographicCamera.h"
 #include "Kerberos/Renderer/Buffer.h"
 #include "Kerberos/Renderer/Shader.h"
 #include "Kerberos/Renderer/Texture.h"
 #include "Kerberos/Renderer/SubTexture2D.h"
+#include "Kerberos/Renderer/TextureAtlas.h"
 #include "Kerberos/Renderer/TextureCube.h"
 #include "Kerberos/Renderer/VertexArray.h"
 #include "Kerberos/Renderer/Framebuffer.h"
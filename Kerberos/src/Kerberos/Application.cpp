@@ -3,6 +3,7 @@
 
 #include "Events/KeyEvent.h"
 #include "Kerberos/Core.h"
+#include "Kerberos/Internal/JobSystem.h"
 #include "Kerberos/Renderer/Renderer.h"
 #include "Kerberos/Scripting/ScriptEngine.h"
 
@@ -32,6 +33,9 @@ namespace Kerberos
 			KBR_CORE_WARN("No working directory specified, using current path: {0}", std::filesystem::current_path().string());
 		}
 
+		/// Created before the systems using it, like the asset importer, fonts and physics
+		JobSystem::Init();
+
 		const WindowProps props{ spec.Name, true, 1280, 720 };
 		m_Window = Window::Create(props);
 		m_Window->SetEventCallback(KBR_BIND_EVENT_FN(Application::OnEvent));
@@ -42,12 +46,18 @@ namespace Kerberos
 		m_ImGuiLayer = new ImGuiLayer();
 		PushOverlay(m_ImGuiLayer);
 
-		Renderer::Init();
+		Renderer::Init(spec.Renderer2DSettings);
 		ScriptEngine::Init();
+
+		/// Everything created before this was created on the main thread, from now on the context belongs to the render thread
+		RenderThread::Init(spec.RenderThreading, m_Window->GetGraphicsContext());
 	}
 
 	Application::~Application() 
 	{
+		/// Executes the last frame and hands the context back, so the resources can be destroyed on the main thread
+		RenderThread::Shutdown();
+
 		if (m_AudioManager)
 		{
 			m_AudioManager->Shutdown();
@@ -57,6 +67,8 @@ namespace Kerberos
 
 		//Renderer::Shutdown();
 		ScriptEngine::Shutdown();
+
+		JobSystem::Shutdown();
 	};
 
 	void Application::Run()
@@ -70,7 +82,7 @@ namespace Kerberos
 
 			ExecuteMainThreadQueue();
 
-			// TODO: Execute this on the render thread
+			/// The render commands are recorded here, and executed on the render thread during the next frame
 			if (!m_Minimized)
 			{
 				for (Layer* layer : m_LayerStack)
@@ -82,6 +94,8 @@ namespace Kerberos
 			m_ImGuiLayer->End();
 
 			m_Window->OnUpdate();
+
+			RenderThread::Kick();
 		}
 	}
 
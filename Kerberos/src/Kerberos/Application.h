@@ -4,6 +4,8 @@
 #include "ImGui/ImGuiLayer.h"
 #include "Kerberos/LayerStack.h"
 #include "Kerberos/Events/ApplicationEvent.h"
+#include "Kerberos/Renderer/Renderer2D.h"
+#include "Kerberos/Renderer/RenderThread.h"
 #include "Kerberos/Renderer/VertexArray.h"
 
 #include <mutex>
@@ -31,6 +33,10 @@ namespace Kerberos
 		std::string Name = "Kerberos Application";
 		std::string WorkingDirectory;
 		ApplicationCommandLineArgs CommandLineArgs;
+		/// Whether the render commands of a frame are executed on a dedicated thread, overlapping the next frame
+		RenderThreadPolicy RenderThreading = RenderThreadPolicy::MultiThreaded;
+		/// Whether Renderer2D expands the quads on the CPU or draws them instanced
+		Renderer2DSpecification Renderer2DSettings;
 	};
 
 	class Application
@@ -36,6 +36,20 @@ namespace Kerberos
 		AssetHandle m_Handle{};
 	};
 
+	/**
+	* Creates an asset from the data loaded by an importer on a worker thread.
+	* It creates the GPU resources of the asset, so it has to be called on the main thread.
+	*/
+	using AssetFinalizer = std::function<Ref<Asset>()>;
+
+	enum class AssetLoadState : uint8_t
+	{
+		NotLoaded = 0,
+		Loading,
+		Loaded,
+		Failed
+	};
+
 	static constexpr std::string_view AssetTypeToString(const AssetType type)
 	{
 		switch (type)
@@ -18,6 +18,19 @@ namespace Kerberos
 			return std::static_pointer_cast<T>(asset);
 		}
 
+		/**
+		 * Starts loading the asset in the background, see AssetManagerBase::GetAssetAsync.
+		 */
+		static std::shared_future<Ref<Asset>> GetAssetAsync(const AssetHandle handle)
+		{
+			return Project::GetActive()->GetAssetManager()->GetAssetAsync(handle);
+		}
+
+		static AssetLoadState GetAssetLoadState(const AssetHandle handle)
+		{
+			return Project::GetActive()->GetAssetManager()->GetAssetLoadState(handle);
+		}
+
 		static AssetType GetAssetType(const AssetHandle handle)
 		{
 			return Project::GetActive()->GetAssetManager()->GetAssetType(handle);
@@ -3,6 +3,7 @@
 #include "Kerberos/Renderer/Texture.h"
 #include "Kerberos/Assets/Asset.h"
 
+#include <future>
 #include <map>
 
 
@@ -17,6 +18,14 @@ namespace Kerberos
 
 		virtual Ref<Asset> GetAsset(AssetHandle handle) = 0;
 
+		/**
+		 * Starts loading the asset in the background, if it isn't loaded or being loaded already.
+		 * The future becomes ready on the main thread, after the GPU resources of the asset were created,
+		 * so it must not be waited on from the main thread. Use GetAsset there, which finishes the load right away.
+		 */
+		virtual std::shared_future<Ref<Asset>> GetAssetAsync(AssetHandle handle) = 0;
+		virtual AssetLoadState GetAssetLoadState(AssetHandle handle) const = 0;
+
 		virtual bool IsAssetHandleValid(AssetHandle handle) const = 0;
 		virtual bool IsAssetLoaded(AssetHandle handle) const = 0;
 
@@ -51,6 +51,11 @@ namespace Kerberos
 		{
 			asset = m_LoadedAssets.at(handle);
 		}
+		else if (m_PendingLoads.contains(handle))
+		{
+			/// The asset is needed now, so don't wait for the main thread queue to finish the load
+			asset = FinishLoad(handle);
+		}
 		else
 		{
 			const AssetMetadata& metadata = GetMetadata(handle);
@@ -58,6 +63,7 @@ namespace Kerberos
 			if (!asset)
 			{
 				KBR_CORE_ERROR("Asset import failed!");
+				m_FailedAssets.insert(handle);
 				return nullptr;
 			}
 
@@ -66,8 +72,83 @@ namespace Kerberos
 
 			/// Save the loaded asset
 			m_LoadedAssets[handle] = asset;
+			m_FailedAssets.erase(handle);
+		}
+
+		return asset;
+	}
+
+	std::shared_future<Ref<Asset>> EditorAssetManager::GetAssetAsync(const AssetHandle handle)
+	{
+		if (const auto it = m_PendingLoads.find(handle); it != m_PendingLoads.end())
+			return it->second.Result;
+
+		if (!IsAssetHandleValid(handle) || IsAssetLoaded(handle))
+		{
+			std::promise<Ref<Asset>> promise;
+			promise.set_value(IsAssetLoaded(handle) ? m_LoadedAssets.at(handle) : nullptr);
+			return promise.get_future().share();
+		}
+
+		m_FailedAssets.erase(handle);
+
+		PendingLoad& load = m_PendingLoads[handle];
+		load.Result = load.Promise.get_future().share();
+
+		/// The load is finished on the main thread, unless GetAsset needed the asset earlier and finished it already
+		load.Data = AssetImporter::LoadAssetDataAsync(handle, GetMetadata(handle), [this, handle, lifetime = std::weak_ptr(m_LifetimeToken)]()
+			{
+				if (lifetime.expired())
+					return;
+
+				if (m_PendingLoads.contains(handle))
+					FinishLoad(handle);
+			});
+
+		return load.Result;
+	}
+
+	AssetLoadState EditorAssetManager::GetAssetLoadState(const AssetHandle handle) const
+	{
+		if (IsAssetLoaded(handle))
+			return AssetLoadState::Loaded;
+
+		if (m_PendingLoads.contains(handle))
+			return AssetLoadState::Loading;
+
+		if (m_FailedAssets.contains(handle))
+			return AssetLoadState::Failed;
+
+		return AssetLoadState::NotLoaded;
+	}
+
+	Ref<Asset> EditorAssetManager::FinishLoad(const AssetHandle handle)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		const auto it = m_PendingLoads.find(handle);
+		KBR_CORE_ASSERT(it != m_PendingLoads.end(), "Asset is not being loaded!");
+
+		PendingLoad load = std::move(it->second);
+		m_PendingLoads.erase(it);
+
+		Ref<Asset> asset = nullptr;
+		if (const AssetFinalizer& finalizer = load.Data.get())
+			asset = finalizer();
+
+		if (asset)
+		{
+			/// Assign the handle to the asset, since a random one was generated when creating the asset
+			asset->GetHandle() = handle;
+			m_LoadedAssets[handle] = asset;
+		}
+		else
+		{
+			KBR_CORE_ERROR("Asset import failed: {0}", GetMetadata(handle).Filepath.string());
+			m_FailedAssets.insert(handle);
 		}
 
+		load.Promise.set_value(asset);
 		return asset;
 	}
 
@@ -12,6 +12,8 @@ namespace Kerberos
 		EditorAssetManager();
 
 		Ref<Asset> GetAsset(AssetHandle handle) override;
+		std::shared_future<Ref<Asset>> GetAssetAsync(AssetHandle handle) override;
+		AssetLoadState GetAssetLoadState(AssetHandle handle) const override;
 
 		bool IsAssetHandleValid(AssetHandle handle) const override;
 		bool IsAssetLoaded(AssetHandle handle) const override;
@@ -36,8 +38,29 @@ namespace Kerberos
 
 		const AssetRegistry& GetAssetRegistry() const { return m_AssetRegistry; }
 
+	private:
+		/**
+		 * Creates the asset from its loaded data, and stores it in the loaded assets.
+		 * Waits for the data if it is still being loaded.
+		 */
+		Ref<Asset> FinishLoad(AssetHandle handle);
+
+		struct PendingLoad
+		{
+			std::shared_future<AssetFinalizer> Data;
+			std::promise<Ref<Asset>> Promise;
+			std::shared_future<Ref<Asset>> Result;
+		};
+
 	private:
 		AssetMap m_LoadedAssets;
 		AssetRegistry m_AssetRegistry;
+
+		/// Only accessed from the main thread, the loading threads only fulfill the data futures
+		std::map<AssetHandle, PendingLoad> m_PendingLoads;
+		std::set<AssetHandle> m_FailedAssets;
+
+		/// Expires when the manager is destroyed, so loads finishing after that are ignored
+		Ref<bool> m_LifetimeToken = CreateRef<bool>(true);
 	};
 }
\ No newline at end of file
@@ -5,40 +5,115 @@
 #include "TextureImporter.h"
 #include "MeshImporter.h"
 #include "SoundImporter.h"
+#include "Kerberos/Application.h"
+#include "Kerberos/Internal/JobSystem.h"
 #include "Kerberos/Renderer/Texture.h"
 
 namespace Kerberos
 {
 	void AssetImporter::Init()
 	{
-		m_ThreadPool.Enqueue([]()
-		{
-			KBR_CORE_INFO("AssetImporter thread pool initialized with 4 threads.");
-			});
+		KBR_CORE_INFO("AssetImporter loads assets on the {} workers of the job system.", JobSystem::GetWorkerCount());
 	}
 
 	Ref<Asset> AssetImporter::ImportAsset(const AssetHandle handle, const AssetMetadata& metadata) 
 	{
+		const AssetFinalizer finalizer = LoadAssetData(handle, metadata);
+		if (!finalizer)
+			return nullptr;
+
+		return finalizer();
+	}
+
+	AssetFinalizer AssetImporter::LoadAssetData(const AssetHandle handle, const AssetMetadata& metadata)
+	{
+		KBR_PROFILE_FUNCTION();
+
 		switch (metadata.Type)
 		{
 		case AssetType::Texture2D:
-			return TextureImporter::ImportTexture(handle, metadata);
+		{
+			auto [spec, data] = TextureImporter::LoadTextureData(metadata.Filepath, true);
+			if (data.Data == nullptr)
+				return {};
+
+			return [spec, data, name = metadata.Filepath.filename().string()]() -> Ref<Asset>
+				{
+					return TextureImporter::CreateTexture(spec, data, name);
+				};
+		}
 		case AssetType::TextureCube:
-			return CubemapImporter::ImportCubemap(handle, metadata);
+		{
+			CubemapData cubemapData;
+			if (!CubemapImporter::LoadCubemapData(metadata.Filepath, cubemapData))
+				return {};
+
+			return [cubemapData = std::move(cubemapData), filepath = metadata.Filepath]() -> Ref<Asset>
+				{
+					return CubemapImporter::CreateCubemap(cubemapData, filepath);
+				};
+		}
 		case AssetType::Material:
 			break;
 		case AssetType::Mesh:
 		{
-			MeshImporter meshImporter;
-			return meshImporter.ImportMesh(metadata.Filepath);
+			const auto meshImporter = CreateRef<MeshImporter>();
+			if (!meshImporter->LoadModelData(metadata.Filepath))
+				return {};
+
+			return [meshImporter, filepath = metadata.Filepath]() -> Ref<Asset>
+				{
+					Ref<Mesh> mesh = meshImporter->CreateMesh();
+					if (!mesh)
+						KBR_CORE_ERROR("No meshes found in the model at {}", filepath.string());
+
+					return mesh;
+				};
 		}
 		case AssetType::Scene:
 			break;
 		case AssetType::Sound:
-			return SoundImporter::ImportSound(handle, metadata);
+		{
+			auto registerSound = SoundImporter::LoadSoundData(metadata.Filepath);
+			if (!registerSound)
+				return {};
+
+			return [registerSound = std::move(registerSound)]() -> Ref<Asset>
+				{
+					return registerSound();
+				};
+		}
 		}
 
 		KBR_CORE_ASSERT(false, "Unsupported asset type by AssetImporter!");
-		return nullptr;
+		return {};
+	}
+
+	std::shared_future<AssetFinalizer> AssetImporter::LoadAssetDataAsync(const AssetHandle handle, const AssetMetadata& metadata, std::function<void()> onDataLoaded)
+	{
+		/// The job system only takes copyable jobs, so the promise is shared with the job
+		const auto promise = CreateRef<std::promise<AssetFinalizer>>();
+		std::shared_future<AssetFinalizer> future = promise->get_future().share();
+
+		/// Loading blocks on the disk, so it runs with a low priority, after the jobs the frame waits on
+		JobSystem::Submit([handle, metadata, promise, onDataLoaded = std::move(onDataLoaded)]()
+			{
+				AssetFinalizer finalizer;
+				try
+				{
+					finalizer = LoadAssetData(handle, metadata);
+				}
+				catch (const std::exception& e)
+				{
+					KBR_CORE_ERROR("Failed to load asset {0}: {1}", metadata.Filepath.string(), e.what());
+				}
+
+				promise->set_value(std::move(finalizer));
+
+				if (onDataLoaded)
+					Application::Get().SubmitToMainThread(onDataLoaded);
+			}, JobPriority::Low);
+
+		return future;
 	}
 }
@@ -5,8 +5,6 @@
 
 #include <future>
 
-import ThreadPool;
-
 namespace Kerberos
 {
 	class AssetImporter
@@ -16,12 +14,17 @@ namespace Kerberos
 
 		static Ref<Asset> ImportAsset(AssetHandle handle, const AssetMetadata& metadata);
 
-		static std::future<Ref<Asset>> ImportAssetAsync(AssetHandle handle, const AssetMetadata& metadata)
-		{
-			return std::async(std::launch::async, ImportAsset, handle, metadata);
-		}
+		/**
+		 * Loads and decodes the data of the asset on the calling thread, without creating any GPU resources.
+		 * @return The finalizer creating the asset on the main thread, or an empty function if the loading failed.
+		 */
+		static AssetFinalizer LoadAssetData(AssetHandle handle, const AssetMetadata& metadata);
 
-	private:
-		inline static ThreadPool m_ThreadPool = ThreadPool(4);
+		/**
+		 * Loads the data of the asset on the engine job system, with a low priority.
+		 * When the data is ready, the callback is submitted to the main thread, where the finalizer can be called.
+		 * The returned future can be waited on to get the finalizer earlier, when the asset is needed right away.
+		 */
+		static std::shared_future<AssetFinalizer> LoadAssetDataAsync(AssetHandle handle, const AssetMetadata& metadata, std::function<void()> onDataLoaded);
 	};
-}
\ No newline at end of file
+}
@@ -16,6 +16,15 @@ namespace Kerberos
 	}
 
 	Ref<TextureCube> CubemapImporter::ImportCubemap(const std::filesystem::path& filepath)
+	{
+		CubemapData cubemapData;
+		if (!LoadCubemapData(filepath, cubemapData))
+			return nullptr;
+
+		return CreateCubemap(cubemapData, filepath);
+	}
+
+	bool CubemapImporter::LoadCubemapData(const std::filesystem::path& filepath, CubemapData& outData)
 	{
 		///Imports a cubemap descriptor file, which contains paths to the six faces of the cubemap.
 
@@ -31,7 +40,7 @@ namespace Kerberos
 		catch (const YAML::Exception& e)
 		{
 			KBR_CORE_ERROR("CubemapImporter::ImportCubemap - Failed to load yaml file: {}", e.what());
-			return nullptr;
+			return false;
 		}
 
 		if (auto cubemapNode = node["Cubemap"])
@@ -48,12 +57,11 @@ namespace Kerberos
 		else
 		{
 			KBR_CORE_ERROR("CubemapImporter::ImportCubemap - Failed to load cubemap descriptor from file: {}", filepath.string());
-			return nullptr;
+			return false;
 		}
 
-		CubemapData cubemapData;
-		cubemapData.Name = descriptor.Name;
-		cubemapData.IsSRGB = descriptor.IsSRGB;
+		outData.Name = descriptor.Name;
+		outData.IsSRGB = descriptor.IsSRGB;
 
 		const auto loadFace = [](const std::filesystem::path& facePath) -> FaceData
 			{
@@ -75,18 +83,23 @@ namespace Kerberos
 				return faceData;
 			};
 
-		cubemapData.Faces[0] = loadFace(descriptor.RightPath);
-		cubemapData.Faces[1] = loadFace(descriptor.LeftPath);
-		cubemapData.Faces[2] = loadFace(descriptor.TopPath);
-		cubemapData.Faces[3] = loadFace(descriptor.BottomPath);
-		cubemapData.Faces[4] = loadFace(descriptor.FrontPath);
-		cubemapData.Faces[5] = loadFace(descriptor.BackPath);
+		outData.Faces[0] = loadFace(descriptor.RightPath);
+		outData.Faces[1] = loadFace(descriptor.LeftPath);
+		outData.Faces[2] = loadFace(descriptor.TopPath);
+		outData.Faces[3] = loadFace(descriptor.BottomPath);
+		outData.Faces[4] = loadFace(descriptor.FrontPath);
+		outData.Faces[5] = loadFace(descriptor.BackPath);
 
-		Ref<TextureCube> cubemapTexture = TextureCube::Create(cubemapData);
+		return true;
+	}
+
+	Ref<TextureCube> CubemapImporter::CreateCubemap(const CubemapData& data, const std::filesystem::path& filepath)
+	{
+		Ref<TextureCube> cubemapTexture = TextureCube::Create(data);
 
-		for (size_t i = 1; i < cubemapData.Faces.size(); ++i)
+		for (size_t i = 1; i < data.Faces.size(); ++i)
 		{
-			stbi_image_free(cubemapData.Faces[i].Buffer.Data);
+			stbi_image_free(data.Faces[i].Buffer.Data);
 		}
 
 		if (!cubemapTexture)
@@ -95,7 +108,7 @@ namespace Kerberos
 			return nullptr;
 		}
 
-		cubemapTexture->SetDebugName(descriptor.Name);
+		cubemapTexture->SetDebugName(data.Name);
 
 		return cubemapTexture;
 	}
@@ -23,5 +23,17 @@ namespace Kerberos
 	public:
 		static Ref<TextureCube> ImportCubemap(AssetHandle handle, const AssetMetadata& metadata);
 		static Ref<TextureCube> ImportCubemap(const std::filesystem::path& filepath);
+
+		/**
+		 * Loads the descriptor and decodes the faces of the cubemap. Doesn't touch the GPU, so it can run on any thread.
+		 * @return False if the descriptor could not be loaded.
+		 */
+		static bool LoadCubemapData(const std::filesystem::path& filepath, CubemapData& outData);
+
+		/**
+		 * Creates the cubemap from data loaded by LoadCubemapData, and frees the face data.
+		 * Has to be called on the main thread.
+		 */
+		static Ref<TextureCube> CreateCubemap(const CubemapData& data, const std::filesystem::path& filepath);
 	};
 }
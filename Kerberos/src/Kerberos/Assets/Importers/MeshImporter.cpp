@@ -1,6 +1,9 @@
 #include "kbrpch.h"
 
+#include "Kerberos/Core/BinaryStream.h"
+#include "Kerberos/Core/Hash.h"
 #include "Kerberos/Core/Timer.h"
+#include "Kerberos/Project/Project.h"
 #include "MeshImporter.h"
 #include "TextureImporter.h"
 
@@ -10,42 +13,146 @@
 
 #include "assimp/material.h"
 
+#include <stb_image.h>
+#include <array>
+#include <format>
+#include <fstream>
+#include <ranges>
+
 namespace Kerberos
 {
+	/// Increment when the layout of the cooked mesh file changes
+	static constexpr uint32_t CookedMeshVersion = 1;
+	static constexpr std::array<char, 4> CookedMeshMagic = { 'K', 'M', 'S', 'H' };
+
+	/// The geometry blobs are aligned, so they can be read in place from the mapped file
+	static constexpr uint64_t CookedMeshBlobAlignment = 16;
+
+	/**
+	* The layout of a cooked mesh file:
+	* header | submesh table | materials | geometry blobs.
+	* A material is its record followed by its name and the path of its diffuse texture, relative to the model.
+	*/
+	struct CookedMeshHeader
+	{
+		std::array<char, 4> Magic;
+		uint32_t Version;
+		uint64_t Key;
+		uint32_t SubmeshCount;
+		uint32_t MaterialCount;
+	};
+
+	struct CookedSubmesh
+	{
+		uint64_t VertexOffset;
+		uint64_t IndexOffset;
+		uint32_t VertexCount;
+		uint32_t IndexCount;
+		uint32_t MaterialIndex;
+		glm::vec3 BoundsMin;
+		glm::vec3 BoundsMax;
+	};
+
+	struct CookedMaterial
+	{
+		glm::vec3 Ambient;
+		glm::vec3 Diffuse;
+		glm::vec3 Specular;
+		float Shininess;
+		uint32_t NameLength;
+		uint32_t TexturePathLength;
+	};
+
+	/**
+	* The key of a cooked mesh, a hash of the size and modification time of the model file, and of the format.
+	* Hashing the contents of large models would take a good part of the time saved by cooking them.
+	*/
+	static uint64_t CreateCookedMeshKey(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		const uintmax_t fileSize = std::filesystem::file_size(path, error);
+		if (error)
+			return 0;
+
+		const auto writeTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+		if (error)
+			return 0;
+
+		uint64_t key = HashBytes(&fileSize, sizeof(fileSize));
+		key = HashValue(writeTime, key);
+		key = HashValue(CookedMeshVersion, key);
+		key = HashValue(sizeof(Vertex), key);
+
+		return key;
+	}
+
+	static std::filesystem::path GetCookedMeshDirectory()
+	{
+		if (Project::GetActive())
+			return Project::GetAssetDirectory() / "cache" / "mesh";
+
+		return "assets/cache/mesh";
+	}
+
+	static void WritePadding(std::ofstream& out, const uint64_t alignment)
+	{
+		static constexpr std::array<char, CookedMeshBlobAlignment> zeros{};
+
+		const uint64_t position = static_cast<uint64_t>(out.tellp());
+		const uint64_t padding = (alignment - position % alignment) % alignment;
+		out.write(zeros.data(), static_cast<std::streamsize>(padding));
+	}
+
 	Ref<Mesh> MeshImporter::ImportMesh(AssetHandle handle, const AssetMetadata& metadata)
 	{
 		return ImportMesh(metadata.Filepath);
 	}
 
+	MeshImporter::~MeshImporter()
+	{
+		/// Free the textures which were decoded, but never uploaded
+		for (const auto& textureData : m_TextureData | std::views::values)
+		{
+			stbi_image_free(textureData.Data.Data);
+		}
+	}
+
 	Ref<Mesh> MeshImporter::ImportMesh(const std::filesystem::path& filepath)
 	{
-		LoadModel(filepath);
+		if (!LoadModelData(filepath))
+			return nullptr;
 
-		if (m_Submeshes.empty())
+		const Ref<Mesh> mesh = CreateMesh();
+		if (!mesh)
 		{
 			KBR_CORE_ERROR("No meshes found in the model at {}", filepath.string());
 			return nullptr;
 		}
-		return m_Submeshes[0].Mesh;
+		return mesh;
 	}
 
-	void MeshImporter::LoadModel(const std::filesystem::path& path)
+	bool MeshImporter::LoadModelData(const std::filesystem::path& path)
 	{
 		Timer timer("Model Loading", [&](const TimerData& data)
 			{
 				KBR_CORE_INFO("Loading model from {} took {:.2f} ms", path.string(), data.DurationMs);
 			});
 
+		if (!std::filesystem::exists(path))
 		{
-			std::ifstream file(path);
-			if (!file.is_open())
-			{
-				KBR_CORE_ERROR("Failed to open model file: {}", path.string());
-				return;
-			}
-			const std::string data = std::string((std::istreambuf_iterator<char>(file)),
-				std::istreambuf_iterator<char>());
+			KBR_CORE_ERROR("Failed to open model file: {}", path.string());
+			return false;
+		}
 
+		m_Directory = path.parent_path();
+
+		const std::filesystem::path cookedPath = GetCookedMeshPath(path);
+		const uint64_t key = CreateCookedMeshKey(path);
+		if (LoadCookedMesh(cookedPath, key))
+		{
+			KBR_CORE_TRACE("Loaded cooked mesh of {0} from {1}", path.string(), cookedPath.string());
+			LoadMaterialTextures();
+			return true;
 		}
 
 		Assimp::Importer importer;
@@ -58,20 +165,265 @@ namespace Kerberos
 		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
 		{
 			KBR_CORE_ERROR("Assimp error: {}", importer.GetErrorString());
-			return;
+			return false;
 		}
 
-		m_Directory = path.parent_path();
-
 		ProcessMaterials(scene);
 
 		ProcessMeshes(scene);
+
+		if (!WriteCookedMesh(cookedPath, key))
+			KBR_CORE_WARN("Failed to write cooked mesh file: {0}", cookedPath.string());
+
+		LoadMaterialTextures();
+
+		return true;
+	}
+
+	std::filesystem::path MeshImporter::GetCookedMeshPath(const std::filesystem::path& path)
+	{
+		/// Models with the same name in different directories are told apart by the hash of their path
+		const std::string pathString = std::filesystem::absolute(path).generic_string();
+		const uint64_t pathHash = HashBytes(pathString.data(), pathString.size());
+
+		return GetCookedMeshDirectory() / std::format("{}-{:016x}.kbrmesh", path.stem().string(), pathHash);
+	}
+
+	void MeshImporter::LoadMaterialTextures()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		for (const auto& texturePath : m_MaterialTexturePaths)
+		{
+			if (texturePath.empty() || m_TextureData.contains(texturePath))
+				continue;
+
+			/// The texture is created and assigned to the material in CreateMesh
+			const auto [spec, data] = TextureImporter::LoadTextureData(texturePath, true);
+			m_TextureData[texturePath] = { .Specification = spec, .Data = data };
+		}
+	}
+
+	bool MeshImporter::LoadCookedMesh(const std::filesystem::path& cookedPath, const uint64_t key)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (key == 0 || !std::filesystem::exists(cookedPath))
+			return false;
+
+		MappedFile file(cookedPath);
+		if (!file.IsValid())
+			return false;
+
+		uint64_t offset = 0;
+
+		CookedMeshHeader header{};
+		if (!ReadPod(file, offset, header) || header.Magic != CookedMeshMagic || header.Version != CookedMeshVersion || header.Key != key)
+			return false;
+
+		/// The counts come from the file, so they are checked against its size before allocating anything
+		if (!IsInFile(file, offset, static_cast<uint64_t>(header.SubmeshCount) * sizeof(CookedSubmesh) + static_cast<uint64_t>(header.MaterialCount) * sizeof(CookedMaterial)))
+			return false;
+
+		std::vector<CookedSubmesh> cookedSubmeshes(header.SubmeshCount);
+		for (auto& cookedSubmesh : cookedSubmeshes)
+		{
+			if (!ReadPod(file, offset, cookedSubmesh))
+				return false;
+		}
+
+		std::vector<Ref<Material>> materials;
+		std::vector<std::filesystem::path> materialTexturePaths;
+		materials.reserve(header.MaterialCount);
+		materialTexturePaths.reserve(header.MaterialCount);
+		for (uint32_t i = 0; i < header.MaterialCount; ++i)
+		{
+			CookedMaterial cookedMaterial{};
+			std::string name;
+			std::string texturePath;
+			if (!ReadPod(file, offset, cookedMaterial)
+				|| !ReadString(file, offset, cookedMaterial.NameLength, name)
+				|| !ReadString(file, offset, cookedMaterial.TexturePathLength, texturePath))
+				return false;
+
+			auto material = CreateRef<Material>(cookedMaterial.Ambient, cookedMaterial.Diffuse, cookedMaterial.Specular, cookedMaterial.Shininess);
+			material->Name = std::move(name);
+
+			materials.push_back(material);
+			materialTexturePaths.push_back(texturePath.empty() ? std::filesystem::path() : m_Directory / texturePath);
+		}
+
+		if (materials.empty())
+			return false;
+
+		std::vector<SubmeshData> submeshes(cookedSubmeshes.size());
+		for (size_t i = 0; i < cookedSubmeshes.size(); ++i)
+		{
+			const CookedSubmesh& cookedSubmesh = cookedSubmeshes[i];
+
+			const uint64_t vertexBytes = static_cast<uint64_t>(cookedSubmesh.VertexCount) * sizeof(Vertex);
+			const uint64_t indexBytes = static_cast<uint64_t>(cookedSubmesh.IndexCount) * sizeof(uint32_t);
+			if (!IsInFile(file, cookedSubmesh.VertexOffset, vertexBytes) || !IsInFile(file, cookedSubmesh.IndexOffset, indexBytes)
+				|| cookedSubmesh.VertexOffset % CookedMeshBlobAlignment != 0 || cookedSubmesh.IndexOffset % CookedMeshBlobAlignment != 0
+				|| cookedSubmesh.MaterialIndex >= materials.size())
+				return false;
+
+			/// The blobs are aligned, and the mapping starts at a page boundary, so they can be used in place
+			SubmeshData& submesh = submeshes[i];
+			submesh.Vertices = { reinterpret_cast<const Vertex*>(file.GetData() + cookedSubmesh.VertexOffset), cookedSubmesh.VertexCount };
+			submesh.Indices = { reinterpret_cast<const uint32_t*>(file.GetData() + cookedSubmesh.IndexOffset), cookedSubmesh.IndexCount };
+
+			/// An index past the vertices of a corrupt file would read out of the vertex buffer on the GPU
+			if (std::ranges::any_of(submesh.Indices, [&cookedSubmesh](const uint32_t index) { return index >= cookedSubmesh.VertexCount; }))
+				return false;
+			submesh.Bounds = AABB(cookedSubmesh.BoundsMin, cookedSubmesh.BoundsMax);
+			submesh.MaterialIndex = cookedSubmesh.MaterialIndex;
+		}
+
+		m_CookedFile = std::move(file);
+		m_SubmeshData = std::move(submeshes);
+		m_Materials = std::move(materials);
+		m_MaterialTexturePaths = std::move(materialTexturePaths);
+
+		return true;
+	}
+
+	bool MeshImporter::WriteCookedMesh(const std::filesystem::path& cookedPath, const uint64_t key) const
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (key == 0)
+			return false;
+
+		std::error_code error;
+		std::filesystem::create_directories(cookedPath.parent_path(), error);
+
+		/// Written to a temporary file first, so an interrupted write can't leave a cooked mesh that passes the key check
+		const std::filesystem::path tempPath = cookedPath.string() + ".tmp";
+
+		std::ofstream out(tempPath, std::ios::binary);
+		if (!out)
+			return false;
+
+		CookedMeshHeader header{};
+		header.Magic = CookedMeshMagic;
+		header.Version = CookedMeshVersion;
+		header.Key = key;
+		header.SubmeshCount = static_cast<uint32_t>(m_SubmeshData.size());
+		header.MaterialCount = static_cast<uint32_t>(m_Materials.size());
+		WritePod(out, header);
+
+		/// The offsets of the blobs are only known after the materials are written, so the table is filled in at the end
+		const std::streampos submeshTablePosition = out.tellp();
+		std::vector<CookedSubmesh> cookedSubmeshes(m_SubmeshData.size());
+		for (const auto& cookedSubmesh : cookedSubmeshes)
+		{
+			WritePod(out, cookedSubmesh);
+		}
+
+		for (size_t i = 0; i < m_Materials.size(); ++i)
+		{
+			const Material& material = *m_Materials[i];
+			const std::string texturePath = i < m_MaterialTexturePaths.size() && !m_MaterialTexturePaths[i].empty()
+				? m_MaterialTexturePaths[i].lexically_relative(m_Directory).generic_string()
+				: std::string();
+
+			CookedMaterial cookedMaterial{};
+			cookedMaterial.Ambient = material.Ambient;
+			cookedMaterial.Diffuse = material.Diffuse;
+			cookedMaterial.Specular = material.Specular;
+			cookedMaterial.Shininess = material.Shininess;
+			cookedMaterial.NameLength = static_cast<uint32_t>(material.Name.size());
+			cookedMaterial.TexturePathLength = static_cast<uint32_t>(texturePath.size());
+
+			WritePod(out, cookedMaterial);
+			out.write(material.Name.data(), static_cast<std::streamsize>(material.Name.size()));
+			out.write(texturePath.data(), static_cast<std::streamsize>(texturePath.size()));
+		}
+
+		for (size_t i = 0; i < m_SubmeshData.size(); ++i)
+		{
+			const SubmeshData& submesh = m_SubmeshData[i];
+			CookedSubmesh& cookedSubmesh = cookedSubmeshes[i];
+
+			WritePadding(out, CookedMeshBlobAlignment);
+			cookedSubmesh.VertexOffset = static_cast<uint64_t>(out.tellp());
+			out.write(reinterpret_cast<const char*>(submesh.Vertices.data()), static_cast<std::streamsize>(submesh.Vertices.size_bytes()));
+
+			WritePadding(out, CookedMeshBlobAlignment);
+			cookedSubmesh.IndexOffset = static_cast<uint64_t>(out.tellp());
+			out.write(reinterpret_cast<const char*>(submesh.Indices.data()), static_cast<std::streamsize>(submesh.Indices.size_bytes()));
+
+			cookedSubmesh.VertexCount = static_cast<uint32_t>(submesh.Vertices.size());
+			cookedSubmesh.IndexCount = static_cast<uint32_t>(submesh.Indices.size());
+			cookedSubmesh.MaterialIndex = submesh.MaterialIndex;
+			cookedSubmesh.BoundsMin = submesh.Bounds.Min;
+			cookedSubmesh.BoundsMax = submesh.Bounds.Max;
+		}
+
+		out.seekp(submeshTablePosition);
+		for (const auto& cookedSubmesh : cookedSubmeshes)
+		{
+			WritePod(out, cookedSubmesh);
+		}
+
+		out.close();
+		if (out)
+			std::filesystem::rename(tempPath, cookedPath, error);
+
+		if (!out || error)
+		{
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+
+		return true;
+	}
+
+	Ref<Mesh> MeshImporter::CreateMesh()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		for (auto& [texturePath, textureData] : m_TextureData)
+		{
+			if (textureData.Data.Data == nullptr)
+				continue;
+
+			m_LoadedTextures[texturePath] = TextureImporter::CreateTexture(textureData.Specification, textureData.Data, texturePath.filename().string());
+		}
+		m_TextureData.clear();
+
+		for (size_t i = 0; i < m_MaterialTexturePaths.size(); ++i)
+		{
+			if (const auto it = m_LoadedTextures.find(m_MaterialTexturePaths[i]); it != m_LoadedTextures.end())
+				m_Materials[i]->DiffuseTexture = it->second;
+		}
+
+		for (const SubmeshData& submeshData : m_SubmeshData)
+		{
+			// Create a single mesh for this material group
+			const auto mergedMesh = CreateRef<Mesh>(submeshData.Vertices, submeshData.Indices, submeshData.Bounds);
+
+			// Find the corresponding material
+			const Ref<Material> material = (m_Materials.size() > submeshData.MaterialIndex) ? m_Materials[submeshData.MaterialIndex] : m_Materials.front();
+
+			// Store the submesh
+			m_Submeshes.push_back({ .Mesh = mergedMesh, .Material = material });
+		}
+		m_SubmeshData.clear();
+		m_CookedFile = MappedFile();
+
+		if (m_Submeshes.empty())
+			return nullptr;
+
+		return m_Submeshes[0].Mesh;
 	}
 
 	void MeshImporter::ProcessMaterials(const aiScene* scene)
 	{
 		KBR_CORE_TRACE("Loading {} materials...", scene->mNumMaterials);
 		m_Materials.reserve(scene->mNumMaterials);
+		m_MaterialTexturePaths.resize(scene->mNumMaterials);
 
 		for (unsigned int i = 0; i < scene->mNumMaterials; ++i)
 		{
@@ -103,14 +455,7 @@ namespace Kerberos
 			{
 				aiString str;
 				aiMat->GetTexture(aiTextureType_DIFFUSE, 0, &str);
-				const std::filesystem::path texturePath = m_Directory / str.C_Str();
-
-				if (!m_LoadedTextures.contains(texturePath))
-				{
-					/// Texture not loaded yet, load it
-					m_LoadedTextures[texturePath] = TextureImporter::ImportTexture(texturePath);
-				}
-				material->DiffuseTexture = m_LoadedTextures[texturePath]; // Assign to material
+				m_MaterialTexturePaths[i] = m_Directory / str.C_Str();
 			}
 
 			m_Materials.push_back(material);
@@ -149,12 +494,27 @@ namespace Kerberos
 		KBR_CORE_TRACE("Model has been sorted into {} material groups.", meshesByMaterial.size());
 
 		// Now, for each material group, merge the meshes into one.
+		/// Reserved up front, so the views of the submeshes are not invalidated by moving them
+		m_SubmeshData.reserve(meshesByMaterial.size());
 		for (auto const& [materialIndex, meshGroup] : meshesByMaterial)
 		{
-			std::vector<Vertex> combinedVertices;
-			std::vector<uint32_t> combinedIndices;
+			SubmeshData& submeshData = m_SubmeshData.emplace_back();
+			submeshData.MaterialIndex = materialIndex;
+
+			std::vector<Vertex>& combinedVertices = submeshData.VertexStorage;
+			std::vector<uint32_t>& combinedIndices = submeshData.IndexStorage;
 			uint32_t vertexOffset = 0;
 
+			size_t vertexCount = 0;
+			size_t indexCount = 0;
+			for (const aiMesh* mesh : meshGroup)
+			{
+				vertexCount += mesh->mNumVertices;
+				indexCount += static_cast<size_t>(mesh->mNumFaces) * 3; /// Triangulated
+			}
+			combinedVertices.reserve(vertexCount);
+			combinedIndices.reserve(indexCount);
+
 			for (const aiMesh* mesh : meshGroup)
 			{
 				// Copy vertices
@@ -171,6 +531,7 @@ namespace Kerberos
 						vertex.TexCoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
 					}
 					combinedVertices.push_back(vertex);
+					submeshData.Bounds.Merge(vertex.Position);
 				}
 
 				// Copy indices, making sure to add the offset!
@@ -187,14 +548,8 @@ namespace Kerberos
 				vertexOffset += mesh->mNumVertices;
 			}
 
-			// Create a single mesh for this material group
-			const auto mergedMesh = CreateRef<Mesh>(combinedVertices, combinedIndices);
-
-			// Find the corresponding material
-			const Ref<Material> material = (m_Materials.size() > materialIndex) ? m_Materials[materialIndex] : m_Materials.front();
-
-			// Store the submesh
-			m_Submeshes.push_back({ .Mesh = mergedMesh, .Material = material });
+			submeshData.Vertices = combinedVertices;
+			submeshData.Indices = combinedIndices;
 		}
 	}
 }
@@ -1,10 +1,12 @@
 #pragma once
 #include "Kerberos/Assets/AssetMetadata.h"
+#include "Kerberos/Core/MappedFile.h"
 #include "Kerberos/Renderer/Material.h"
 #include "Kerberos/Renderer/Mesh.h"
 #include "Kerberos/Renderer/Texture.h"
 
 #include <filesystem>
+#include <span>
 
 struct aiScene;
 
@@ -19,19 +21,82 @@ namespace Kerberos
 	class MeshImporter
 	{
 	public:
+		MeshImporter() = default;
+		~MeshImporter();
+
+		MeshImporter(const MeshImporter& other) = delete;
+		MeshImporter(MeshImporter&& other) noexcept = default;
+		MeshImporter& operator=(const MeshImporter& other) = delete;
+		MeshImporter& operator=(MeshImporter&& other) noexcept = default;
+
 		Ref<Mesh> ImportMesh(AssetHandle handle, const AssetMetadata& metadata);
 		Ref<Mesh> ImportMesh(const std::filesystem::path& filepath);
 
-	private:
-        void LoadModel(const std::filesystem::path& path);
+		/**
+		 * Parses the model and decodes its textures, without creating any GPU resources,
+		 * so it can be called from any thread.
+		 * @return False if the model could not be loaded.
+		 */
+		bool LoadModelData(const std::filesystem::path& path);
+
+		/**
+		 * Creates the meshes and textures of the model loaded by LoadModelData.
+		 * Has to be called on the main thread.
+		 * @return The mesh of the first submesh, or nullptr if the model didn't contain any.
+		 */
+		Ref<Mesh> CreateMesh();
 
+		/**
+		 * The path of the cooked version of the model, in the cache directory next to the asset registry.
+		 * The cooked file is written the first time the model is imported with Assimp,
+		 * and loaded instead of the model until the model file changes.
+		 */
+		static std::filesystem::path GetCookedMeshPath(const std::filesystem::path& path);
+
+	private:
         void ProcessMaterials(const aiScene* scene);
         void ProcessMeshes(const aiScene* scene);
 
+        /// Decodes the diffuse textures of the materials
+        void LoadMaterialTextures();
+
+        bool LoadCookedMesh(const std::filesystem::path& cookedPath, uint64_t key);
+        bool WriteCookedMesh(const std::filesystem::path& cookedPath, uint64_t key) const;
+
     private:
+        /// The geometry of the meshes using the same material, merged together
+        struct SubmeshData
+        {
+            /// Points either into the storage, or into the mapped cooked file
+            std::span<const Vertex> Vertices;
+            std::span<const uint32_t> Indices;
+            AABB Bounds;
+            uint32_t MaterialIndex = 0;
+
+            /// Only used when the model was processed by Assimp
+            std::vector<Vertex> VertexStorage;
+            std::vector<uint32_t> IndexStorage;
+        };
+
+        /// Texture decoded by LoadModelData, waiting to be uploaded by CreateMesh
+        struct TextureData
+        {
+            TextureSpecification Specification;
+            Buffer Data;
+        };
+
         // This is our new primary data structure
         std::vector<Submesh> m_Submeshes;
 
+        std::vector<SubmeshData> m_SubmeshData;
+        std::map<std::filesystem::path, TextureData> m_TextureData;
+
+        /// Kept mapped until CreateMesh uploaded the geometry
+        MappedFile m_CookedFile;
+
+        /// The diffuse texture of each material, empty if the material doesn't have one
+        std::vector<std::filesystem::path> m_MaterialTexturePaths;
+
         std::filesystem::path m_Directory;
 
         // We can store loaded textures in a map to prevent reloading
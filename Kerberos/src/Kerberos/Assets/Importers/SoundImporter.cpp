@@ -15,4 +15,9 @@ namespace Kerberos
 	{
 		return Application::Get().GetAudioManager()->Load(filepath);
 	}
+
+	std::function<Ref<Sound>()> SoundImporter::LoadSoundData(const std::filesystem::path& filepath)
+	{
+		return Application::Get().GetAudioManager()->Decode(filepath);
+	}
 }
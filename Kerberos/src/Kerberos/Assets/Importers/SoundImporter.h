@@ -11,5 +11,11 @@ namespace Kerberos
 	public:
 		static Ref<Sound> ImportSound(AssetHandle handle, const AssetMetadata& metadata);
 		static Ref<Sound> ImportSound(const std::filesystem::path& filepath);
+
+		/**
+		 * Decodes the sound file on the calling thread.
+		 * @return A function registering the sound in the audio manager, which has to be called on the main thread.
+		 */
+		static std::function<Ref<Sound>()> LoadSoundData(const std::filesystem::path& filepath);
 	};
 }
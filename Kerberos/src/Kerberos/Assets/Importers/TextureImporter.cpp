@@ -16,10 +16,15 @@ namespace Kerberos
 
 		const auto [spec, data] = LoadTextureData(filepath, true);
 
-		auto texture = Texture2D::Create(spec, data);
+		return CreateTexture(spec, data, filepath.filename().string());
+	}
+
+	Ref<Texture2D> TextureImporter::CreateTexture(const TextureSpecification& spec, const Buffer data, const std::string& debugName)
+	{
+		KBR_PROFILE_FUNCTION();
 
-		const std::string name = filepath.filename().string();
-		texture->SetDebugName(name);
+		auto texture = Texture2D::Create(spec, data);
+		texture->SetDebugName(debugName);
 
 		stbi_image_free(data.Data);
 
@@ -30,7 +35,8 @@ namespace Kerberos
 	{
 		int width, height, channels;
 
-		stbi_set_flip_vertically_on_load(flip);
+		/// Textures are decoded on the asset loading threads too, so only set the flag for this thread
+		stbi_set_flip_vertically_on_load_thread(flip);
 		Buffer data;
 
 		{
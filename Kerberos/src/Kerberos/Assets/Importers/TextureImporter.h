@@ -18,5 +18,11 @@ namespace Kerberos
 		 * @return A pair containing the TextureSpecification and the loaded Buffer.
 		 */
 		static std::pair<TextureSpecification, Buffer> LoadTextureData(const std::filesystem::path& filepath, bool flip, int desiredChannels = 0);
+
+		/**
+		 * Creates the texture from data loaded by LoadTextureData, and frees the data.
+		 * Has to be called on the main thread, since it creates the GPU resource.
+		 */
+		static Ref<Texture2D> CreateTexture(const TextureSpecification& spec, Buffer data, const std::string& debugName);
 	};
 }
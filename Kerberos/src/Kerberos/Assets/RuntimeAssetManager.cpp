@@ -8,6 +8,16 @@ namespace Kerberos
 		throw std::runtime_error("RuntimeAssetManager::GetAsset is not implemented yet!");
 	}
 
+	std::shared_future<Ref<Asset>> RuntimeAssetManager::GetAssetAsync(AssetHandle handle)
+	{
+		throw std::runtime_error("RuntimeAssetManager::GetAssetAsync is not implemented yet!");
+	}
+
+	AssetLoadState RuntimeAssetManager::GetAssetLoadState(AssetHandle handle) const
+	{
+		throw std::runtime_error("RuntimeAssetManager::GetAssetLoadState is not implemented yet!");
+	}
+
 	bool RuntimeAssetManager::IsAssetHandleValid(AssetHandle handle) const
 	{
 		throw std::runtime_error("RuntimeAssetManager::IsAssetHandleValid is not implemented yet!");
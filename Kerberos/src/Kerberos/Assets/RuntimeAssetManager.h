@@ -8,6 +8,8 @@ namespace Kerberos
 	{
 	public:
 		Ref<Asset> GetAsset(AssetHandle handle) override;
+		std::shared_future<Ref<Asset>> GetAssetAsync(AssetHandle handle) override;
+		AssetLoadState GetAssetLoadState(AssetHandle handle) const override;
 
 		bool IsAssetHandleValid(AssetHandle handle) const override;
 		bool IsAssetLoaded(AssetHandle handle) const override;
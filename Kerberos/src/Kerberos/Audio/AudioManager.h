@@ -4,6 +4,7 @@
 #include "Sound.h"
 
 #include <filesystem>
+#include <functional>
 
 
 namespace Kerberos
@@ -24,6 +25,13 @@ namespace Kerberos
 		virtual void Shutdown() = 0;
 
 		virtual Ref<Sound> Load(const std::filesystem::path& filepath) = 0;
+
+		/**
+		 * Decodes the sound file without registering it in the manager, so it can be called from any thread.
+		 * @return A function registering the decoded sound, which has to be called on the main thread,
+		 * or an empty function if the file could not be decoded.
+		 */
+		virtual std::function<Ref<Sound>()> Decode(const std::filesystem::path& filepath) = 0;
 		virtual void Play(const std::filesystem::path& filepath) = 0;
 		virtual void Play(const UUID& soundID) = 0;
 		virtual void Stop(const UUID& soundID) = 0;
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace Kerberos
+{
+	/**
+	* Helpers for the binary cache files, the values are written and read as their raw bytes.
+	* The files are only read on the platform that wrote them, so the byte order is not converted.
+	*/
+	template<typename T>
+	void WritePod(std::ostream& out, const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	/// Check the stream after reading, a failed read leaves the value unchanged
+	template<typename T>
+	void ReadPod(std::istream& in, T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		in.read(reinterpret_cast<char*>(&value), sizeof(T));
+	}
+
+	/// Whether the range is inside the file, without overflowing on the offsets and sizes read from it
+	inline bool IsInFile(const MappedFile& file, const uint64_t offset, const uint64_t size)
+	{
+		return offset <= file.GetSize() && size <= file.GetSize() - offset;
+	}
+
+	/// Reads a value from the mapped file, and advances the offset. Returns false when reading past the end of the file.
+	template<typename T>
+	bool ReadPod(const MappedFile& file, uint64_t& offset, T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		if (!IsInFile(file, offset, sizeof(T)))
+			return false;
+
+		std::memcpy(&value, file.GetData() + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	}
+
+	inline bool ReadString(const MappedFile& file, uint64_t& offset, const uint32_t length, std::string& value)
+	{
+		if (!IsInFile(file, offset, length))
+			return false;
+
+		value.assign(reinterpret_cast<const char*>(file.GetData() + offset), length);
+		offset += length;
+		return true;
+	}
+}
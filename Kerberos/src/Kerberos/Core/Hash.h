@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Kerberos
+{
+	/**
+	* FNV-1a, used for the keys of the cache files and the command hash of the Null renderer.
+	* It is the same on every platform and run, unlike std::hash, but it is not meant to resist collisions made on purpose.
+	*/
+	constexpr uint64_t FNVOffsetBasis = 14695981039346656037ull;
+	constexpr uint64_t FNVPrime = 1099511628211ull;
+
+	inline uint64_t HashBytes(const void* data, const size_t size, uint64_t hash = FNVOffsetBasis)
+	{
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= FNVPrime;
+		}
+
+		return hash;
+	}
+
+	/// Hashes the bytes of the value, so it must not have padding or pointers
+	template<typename T>
+	uint64_t HashValue(const T& value, const uint64_t hash = FNVOffsetBasis)
+	{
+		return HashBytes(&value, sizeof(T), hash);
+	}
+}
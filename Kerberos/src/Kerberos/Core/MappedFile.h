@@ -0,0 +1,38 @@
+#pragma once
+
+#include <filesystem>
+
+namespace Kerberos
+{
+	/**
+	* Read-only memory mapping of a whole file.
+	* The mapping is released when the object is destroyed.
+	*/
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path& filepath);
+		~MappedFile();
+
+		MappedFile(const MappedFile& other) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(const MappedFile& other) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		bool IsValid() const { return m_Data != nullptr; }
+
+		const uint8_t* GetData() const { return m_Data; }
+		uint64_t GetSize() const { return m_Size; }
+
+	private:
+		void Release();
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		uint64_t m_Size = 0;
+
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+	};
+}
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <algorithm>
 #include <fstream>
+#include <mutex>
 #include <thread>
 
 namespace Kerberos
@@ -43,8 +44,11 @@ namespace Kerberos
 			m_ProfileCount = 0;
 		}
 
+		/// The scopes are profiled on the worker threads too
 		void WriteProfile(const ProfileResult& result)
 		{
+			std::scoped_lock lock(m_Mutex);
+
 			if (m_ProfileCount++ > 0)
 				m_OutputStream << ",";
 
@@ -85,6 +89,7 @@ namespace Kerberos
 	private:
 		InstrumentationSession* m_CurrentSession;
 		std::ofstream m_OutputStream;
+		std::mutex m_Mutex;
 		int m_ProfileCount;
 	};
 
@@ -15,10 +15,82 @@
 
 #include "Kerberos/Renderer/Renderer.h"
 #include "Kerberos/Renderer/RendererAPI.h"
+#include "Kerberos/Renderer/RenderThread.h"
 #include "Platform/Vulkan/VulkanContext.h"
 
+#include <array>
+
 namespace Kerberos
 {
+	/**
+	* A copy of the draw data of a frame, which is rendered on the render thread while ImGui builds the next frame.
+	* The draw lists are reused, so copying them doesn't allocate once they are large enough.
+	*/
+	struct ImGuiDrawDataSnapshot
+	{
+		ImDrawData DrawData;
+		ImVector<ImDrawList*> DrawLists;
+	};
+
+	/// The render thread can be at most one frame behind, so two snapshots are enough
+	static std::array<ImGuiDrawDataSnapshot, 2> s_DrawDataSnapshots;
+	static uint32_t s_DrawDataSnapshotIndex = 0;
+
+	static ImDrawData* SnapshotDrawData(const ImDrawData* drawData)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		ImGuiDrawDataSnapshot& snapshot = s_DrawDataSnapshots[s_DrawDataSnapshotIndex];
+		s_DrawDataSnapshotIndex = (s_DrawDataSnapshotIndex + 1) % static_cast<uint32_t>(s_DrawDataSnapshots.size());
+
+		while (snapshot.DrawLists.Size < drawData->CmdListsCount)
+		{
+			snapshot.DrawLists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+		}
+
+		ImDrawData& copy = snapshot.DrawData;
+		copy.Valid = drawData->Valid;
+		copy.CmdListsCount = drawData->CmdListsCount;
+		copy.TotalIdxCount = drawData->TotalIdxCount;
+		copy.TotalVtxCount = drawData->TotalVtxCount;
+		copy.DisplayPos = drawData->DisplayPos;
+		copy.DisplaySize = drawData->DisplaySize;
+		copy.FramebufferScale = drawData->FramebufferScale;
+		copy.OwnerViewport = drawData->OwnerViewport;
+		copy.CmdLists.resize(drawData->CmdListsCount);
+
+		for (int i = 0; i < drawData->CmdListsCount; ++i)
+		{
+			const ImDrawList* source = drawData->CmdLists[i];
+			ImDrawList* destination = snapshot.DrawLists[i];
+
+			/// ImVector keeps its capacity when it is resized, unlike when it is assigned
+			destination->CmdBuffer.resize(source->CmdBuffer.Size);
+			destination->IdxBuffer.resize(source->IdxBuffer.Size);
+			destination->VtxBuffer.resize(source->VtxBuffer.Size);
+			std::memcpy(destination->CmdBuffer.Data, source->CmdBuffer.Data, source->CmdBuffer.size_in_bytes());
+			std::memcpy(destination->IdxBuffer.Data, source->IdxBuffer.Data, source->IdxBuffer.size_in_bytes());
+			std::memcpy(destination->VtxBuffer.Data, source->VtxBuffer.Data, source->VtxBuffer.size_in_bytes());
+			destination->Flags = source->Flags;
+
+			copy.CmdLists[i] = destination;
+		}
+
+		return &copy;
+	}
+
+	static void DestroyDrawDataSnapshots()
+	{
+		for (ImGuiDrawDataSnapshot& snapshot : s_DrawDataSnapshots)
+		{
+			for (ImDrawList* drawList : snapshot.DrawLists)
+				IM_DELETE(drawList);
+
+			snapshot.DrawLists.clear();
+			snapshot.DrawData.Clear();
+		}
+	}
+
 	ImGuiLayer::ImGuiLayer()
 		: Layer("ImGuiLayer")
 	{}
@@ -33,7 +105,14 @@ namespace Kerberos
 
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-		io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+
+		/// The platform windows make their own contexts current, which only works on the thread owning the context.
+		/// The Null renderer has nothing to present them with.
+		if (Application::Get().GetSpecification().RenderThreading == RenderThreadPolicy::SingleThreaded
+			&& Renderer::GetAPI() != RendererAPI::API::Null)
+		{
+			io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+		}
 
 		/*io.BackendFlags |= ImGuiBackendFlags_HasMouseCursors;
 		io.BackendFlags |= ImGuiBackendFlags_HasSetMousePos; */
@@ -64,6 +143,9 @@ namespace Kerberos
 		{
 			ImGui_ImplGlfw_InitForOpenGL(window, true);
 			ImGui_ImplOpenGL3_Init("#version 410");
+
+			/// Created here, on the main thread, instead of lazily in the first NewFrame on the render thread
+			ImGui_ImplOpenGL3_CreateDeviceObjects();
 		}
 		else if (Renderer::GetAPI() == RendererAPI::API::D3D11)
 		{
@@ -95,6 +177,16 @@ namespace Kerberos
 
 			ImGui_ImplVulkan_Init(&initInfo);
 		}
+		else if (Renderer::GetAPI() == RendererAPI::API::Null)
+		{
+			ImGui_ImplGlfw_InitForOther(window, true);
+
+			/// Without a renderer backend nothing uploads the font atlas, it only has to be built
+			unsigned char* pixels = nullptr;
+			int width = 0;
+			int height = 0;
+			io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+		}
 	}
 
 	void ImGuiLayer::OnDetach()
@@ -114,6 +206,8 @@ namespace Kerberos
 			ImGui_ImplVulkan_Shutdown();
 		}
 
+		DestroyDrawDataSnapshots();
+
 		ImGui_ImplGlfw_Shutdown();
 		ImGui::DestroyContext();
 	}
@@ -138,7 +232,10 @@ namespace Kerberos
 	{
 		if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
 		{
-			ImGui_ImplOpenGL3_NewFrame();
+			RenderThread::Submit([]
+				{
+					ImGui_ImplOpenGL3_NewFrame();
+				});
 		}
 		else if (Renderer::GetAPI() == RendererAPI::API::D3D11)
 		{
@@ -168,7 +265,10 @@ namespace Kerberos
 
 		if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
 		{
-			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			RenderThread::Submit([drawData = SnapshotDrawData(ImGui::GetDrawData())]
+				{
+					ImGui_ImplOpenGL3_RenderDrawData(drawData);
+				});
 		}
 		else if (Renderer::GetAPI() == RendererAPI::API::D3D11)
 		{
@@ -180,7 +280,10 @@ namespace Kerberos
 		{
 			/// For Vulkan, the rendering is done inside VulkanContext::RecordCommandBuffer
 			/// Later the structure of the command might have to be rethought to better support D3D12 and Vulkan
-			const uint32_t currentFrame = VulkanContext::Get().GetCurrentFrameIndex();
+			RenderThread::Submit([drawData = SnapshotDrawData(ImGui::GetDrawData())]
+				{
+					VulkanContext::Get().SetImGuiDrawData(drawData);
+				});
 			/*ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), VulkanContext::Get().GetCommandBuffers()[currentFrame]);*/
 		}
 
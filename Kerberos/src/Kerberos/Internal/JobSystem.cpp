@@ -0,0 +1,117 @@
+#include "kbrpch.h"
+#include "JobSystem.h"
+
+#include <thread>
+
+import ThreadPool;
+
+namespace Kerberos
+{
+	static ThreadPool* s_Pool = nullptr;
+
+	static TaskPriority ToTaskPriority(const JobPriority priority)
+	{
+		switch (priority)
+		{
+			case JobPriority::High:		return TaskPriority::High;
+			case JobPriority::Normal:	return TaskPriority::Normal;
+			case JobPriority::Low:		return TaskPriority::Low;
+		}
+
+		KBR_CORE_ASSERT(false, "Unknown job priority!");
+		return TaskPriority::Normal;
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		KBR_CORE_ASSERT(!s_Pool, "JobSystem is already initialized!");
+
+		if (workerCount == 0)
+		{
+			/// hardware_concurrency can return 0 if it's unknown, so clamp it before leaving a core for the main thread
+			workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+		}
+
+		s_Pool = new ThreadPool(static_cast<int>(workerCount));
+
+		KBR_CORE_INFO("JobSystem initialized with {} workers", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		delete s_Pool;
+		s_Pool = nullptr;
+	}
+
+	void JobSystem::Submit(Job job, const JobPriority priority, JobCounter* counter)
+	{
+		KBR_CORE_ASSERT(s_Pool, "JobSystem is not initialized!");
+
+		if (counter)
+			counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+		s_Pool->Enqueue([job = std::move(job), counter]
+			{
+				/// Decrements the counter even if the job throws, the pool logs the exception
+				struct CounterRelease
+				{
+					JobCounter* Counter;
+					~CounterRelease()
+					{
+						if (Counter)
+							Counter->m_Count.fetch_sub(1, std::memory_order_release);
+					}
+				} release{ counter };
+
+				job();
+			}, ToTaskPriority(priority));
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		while (!counter.IsDone())
+		{
+			if (!TryRunJob(JobPriority::Normal))
+				std::this_thread::yield();
+		}
+	}
+
+	bool JobSystem::TryRunJob(const JobPriority lowestPriority)
+	{
+		return s_Pool && s_Pool->TryRunTask(ToTaskPriority(lowestPriority));
+	}
+
+	void JobSystem::ParallelFor(const uint32_t count, const uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& fn, const JobPriority priority)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (!s_Pool)
+		{
+			if (count > 0)
+				fn(0, count);
+			return;
+		}
+
+		/// A few chunks per thread balances the uneven chunks, without too many tasks
+		const uint32_t threadCount = GetWorkerCount() + 1;
+		const uint32_t chunkSize = std::max(grainSize, (count + threadCount * 4 - 1) / (threadCount * 4));
+
+		s_Pool->ParallelFor(count, chunkSize, fn, ToTaskPriority(priority));
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return s_Pool ? s_Pool->GetThreadCount() : 0;
+	}
+
+	int32_t JobSystem::GetWorkerIndex()
+	{
+		return s_Pool ? s_Pool->GetWorkerIndex() : -1;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+namespace Kerberos
+{
+	enum class JobPriority : uint8_t
+	{
+		/// Jobs the frame is waiting on, like the steps of the physics
+		High,
+		Normal,
+		/// Long running background work, like loading assets
+		Low,
+	};
+
+	/**
+	* Counts the unfinished jobs submitted with it.
+	* It must outlive the jobs, waiting on it with JobSystem::Wait ensures that.
+	*/
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+
+		JobCounter(const JobCounter& other) = delete;
+		JobCounter& operator=(const JobCounter& other) = delete;
+
+		bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+
+	private:
+		std::atomic<uint32_t> m_Count = 0;
+
+		friend class JobSystem;
+	};
+
+	/**
+	* The job system shared by the whole engine, so the systems running work in parallel
+	* don't create their own threads and oversubscribe the machine.
+	*
+	* There is a worker thread per core, except the one of the main thread.
+	* The jobs run on the work-stealing ThreadPool, see its description for how they are scheduled.
+	*/
+	class JobSystem
+	{
+	public:
+		using Job = std::function<void()>;
+
+		/// @param workerCount The number of worker threads, 0 creates one per core except the one of the main thread
+		static void Init(uint32_t workerCount = 0);
+		/// Runs all the queued jobs before stopping the workers, so the counters waiting on them are released
+		static void Shutdown();
+
+		/// @param counter Optional counter incremented until the job is finished
+		static void Submit(Job job, JobPriority priority = JobPriority::Normal, JobCounter* counter = nullptr);
+
+		/**
+		 * @brief Runs queued jobs on the calling thread, until all the jobs of the counter are finished
+		 *
+		 * Low priority jobs are not run while waiting, so a long background job can't stall the waiting thread.
+		 */
+		static void Wait(const JobCounter& counter);
+
+		/// Runs a queued job with at least the given priority on the calling thread, returns false if there was none
+		static bool TryRunJob(JobPriority lowestPriority = JobPriority::Normal);
+
+		/**
+		 * @brief Calls the function with the ranges of [0, count), split into chunks of at least grainSize elements,
+		 * and waits until all of them are done. The calling thread works on the chunks too.
+		 */
+		static void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& fn, JobPriority priority = JobPriority::High);
+
+		static uint32_t GetWorkerCount();
+
+		/// Returns the index of the worker of the calling thread, or -1 if it is not a worker
+		static int32_t GetWorkerIndex();
+	};
+}
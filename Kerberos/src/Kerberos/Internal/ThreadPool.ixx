@@ -1,94 +1,592 @@
 ﻿#include "kbrpch.h"
 
-#include <queue>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <new>
+#include <thread>
 
 export module ThreadPool;
 
+namespace Kerberos
+{
+	/**
+	* Chase-Lev work-stealing deque with a fixed capacity (Le, Pop, Cohen, Zappa Nardelli: "Correct and Efficient
+	* Work-Stealing for Weak Memory Models").
+	* The owner thread pushes and pops at the bottom without locking, the other threads steal from the top.
+	*/
+	template<typename T>
+	class WorkStealingDeque
+	{
+	public:
+		/// The capacity is rounded up to a power of two
+		explicit WorkStealingDeque(const uint32_t capacity)
+			: m_Mask(std::bit_ceil(std::max(capacity, 2u)) - 1), m_Buffer(std::make_unique<std::atomic<T*>[]>(m_Mask + 1))
+		{}
+
+		/// Must only be called by the owner, returns false if the deque is full
+		bool Push(T* item)
+		{
+			const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+			const int64_t top = m_Top.load(std::memory_order_acquire);
+			if (bottom - top > static_cast<int64_t>(m_Mask))
+				return false;
+
+			m_Buffer[bottom & m_Mask].store(item, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		/// Must only be called by the owner, returns the newest item
+		T* Pop()
+		{
+			const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+			m_Bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_Top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* item = m_Buffer[bottom & m_Mask].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				/// The last item, a thief may be taking it at the same time
+				if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					item = nullptr;
+
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return item;
+		}
+
+		/// Thread safe, returns the oldest item, or nullptr if the deque is empty or another thread took it first
+		T* Steal()
+		{
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			T* item = m_Buffer[top & m_Mask].load(std::memory_order_relaxed);
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return item;
+		}
+
+	private:
+		uint32_t m_Mask;
+		std::unique_ptr<std::atomic<T*>[]> m_Buffer;
+
+		/// The owner and the thieves write to different cache lines
+		alignas(64) std::atomic<int64_t> m_Top = 0;
+		alignas(64) std::atomic<int64_t> m_Bottom = 0;
+	};
+}
+
 export namespace Kerberos
 {
+	enum class TaskPriority : uint8_t
+	{
+		High,
+		Normal,
+		Low,
+	};
+
+	/**
+	* A move-only callable without arguments.
+	* Callables up to InlineSize bytes are stored in the task itself, so submitting them doesn't allocate,
+	* the bigger ones are allocated on the heap.
+	*/
+	class Task
+	{
+	public:
+		/// Big enough for a std::function and a pointer next to it
+		static constexpr size_t InlineSize = 80;
+
+		Task() = default;
+
+		template<typename F>
+			requires (!std::is_same_v<std::decay_t<F>, Task>)
+		Task(F&& function)
+		{
+			using Fn = std::decay_t<F>;
+
+			if constexpr (sizeof(Fn) <= InlineSize && alignof(Fn) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Fn>)
+			{
+				new (m_Storage) Fn(std::forward<F>(function));
+
+				m_Invoke = [](void* storage) { (*static_cast<Fn*>(storage))(); };
+				m_Move = [](void* destination, void* source)
+					{
+						Fn* from = static_cast<Fn*>(source);
+						if (destination)
+							new (destination) Fn(std::move(*from));
+
+						from->~Fn();
+					};
+			}
+			else
+			{
+				*reinterpret_cast<Fn**>(m_Storage) = new Fn(std::forward<F>(function));
+
+				m_Invoke = [](void* storage) { (**static_cast<Fn**>(storage))(); };
+				m_Move = [](void* destination, void* source)
+					{
+						Fn** from = static_cast<Fn**>(source);
+						if (destination)
+							*static_cast<Fn**>(destination) = *from;
+						else
+							delete *from;
+					};
+			}
+		}
+
+		Task(Task&& other) noexcept
+		{
+			MoveFrom(other);
+		}
+
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Reset();
+				MoveFrom(other);
+			}
+			return *this;
+		}
+
+		Task(const Task& other) = delete;
+		Task& operator=(const Task& other) = delete;
+
+		~Task()
+		{
+			Reset();
+		}
+
+		void operator()() { m_Invoke(m_Storage); }
+
+		explicit operator bool() const { return m_Invoke != nullptr; }
+
+		void Reset()
+		{
+			if (m_Move)
+				m_Move(nullptr, m_Storage);
+
+			m_Invoke = nullptr;
+			m_Move = nullptr;
+		}
+
+	private:
+		void MoveFrom(Task& other)
+		{
+			m_Invoke = std::exchange(other.m_Invoke, nullptr);
+			m_Move = std::exchange(other.m_Move, nullptr);
+
+			if (m_Move)
+				m_Move(m_Storage, other.m_Storage);
+		}
+
+	private:
+		alignas(std::max_align_t) std::byte m_Storage[InlineSize];
+
+		void (*m_Invoke)(void* storage) = nullptr;
+		/// Moves the callable into the destination and destroys the source, or only destroys it if the destination is null
+		void (*m_Move)(void* destination, void* source) = nullptr;
+	};
+
+	/**
+	* Counts the unfinished tasks enqueued with it.
+	* It must outlive the tasks, waiting on it with ThreadPool::Wait ensures that.
+	*/
+	class TaskGroup
+	{
+	public:
+		TaskGroup() = default;
+
+		TaskGroup(const TaskGroup& other) = delete;
+		TaskGroup& operator=(const TaskGroup& other) = delete;
+
+		bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		std::atomic<uint32_t> m_Pending = 0;
+
+		friend class ThreadPool;
+	};
+
+	/**
+	* Work-stealing thread pool.
+	*
+	* Every worker has a Chase-Lev deque per priority. The tasks enqueued by a worker are pushed to its own deques
+	* without locking, the worker pops its newest task first, as its data is the most likely to be in the cache.
+	* Idle workers steal the oldest tasks of the others, which are usually the biggest pieces of work.
+	* The tasks of the other threads go to a shared queue guarded by a mutex.
+	* Tasks of a higher priority are always taken before the lower ones.
+	*/
 	class ThreadPool
 	{
 	public:
-		explicit ThreadPool(const int threadCount) 
-			: m_Stop(false)
+		static constexpr uint32_t PriorityCount = 3;
+		/// The number of tasks a worker can have queued at once, when it runs out of them it runs the new tasks right away
+		static constexpr uint32_t WorkerTaskCapacity = 4096;
+
+		explicit ThreadPool(const int threadCount)
 		{
-			for (size_t i = 0; std::cmp_less(i, threadCount); ++i)
+			m_Workers.reserve(threadCount);
+			for (int i = 0; i < threadCount; ++i)
 			{
-				m_Workers.emplace_back([this]
+				m_Workers.emplace_back(std::make_unique<Worker>());
+			}
+
+			/// The workers are only started after all of them exist, as they steal from each other
+			for (int i = 0; i < threadCount; ++i)
+			{
+				m_Workers[i]->Thread = std::thread(&ThreadPool::WorkerMain, this, static_cast<uint32_t>(i));
+			}
+		}
+
+		/// Runs all the queued tasks before stopping, so the groups waiting on them are released
+		~ThreadPool()
+		{
+			{
+				std::scoped_lock lock(m_WakeMutex);
+				m_Stop.store(true, std::memory_order_release);
+			}
+			m_WakeCondition.notify_all();
+
+			for (const auto& worker : m_Workers)
+			{
+				worker->Thread.join();
+			}
+
+			/// Without workers the shared tasks are still queued
+			while (TryRunTask(TaskPriority::Low))
+			{}
+		}
+
+		ThreadPool(const ThreadPool& other) = delete;
+		ThreadPool& operator=(const ThreadPool& other) = delete;
+
+		/// @param group Optional group counting the task until it is finished
+		template<typename F>
+		void Enqueue(F&& function, const TaskPriority priority = TaskPriority::Normal, TaskGroup* group = nullptr)
+		{
+			if (group)
+				group->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+			if (Worker* worker = GetCurrentWorker())
+			{
+				TaskNode* node = worker->AllocateNode();
+				if (!node)
+				{
+					/// All the tasks of the worker are still queued or running
+					Task task(std::forward<F>(function));
+					RunTask(task, group);
+					return;
+				}
+
+				node->Work = Task(std::forward<F>(function));
+				node->Group = group;
+
+				/// A deque holds as many tasks as the nodes of the worker, so it can't be full here
+				const bool pushed = worker->Deques[static_cast<size_t>(priority)].Push(node);
+				KBR_CORE_ASSERT(pushed, "The task deque of the worker is full!");
+			}
+			else
+			{
+				std::scoped_lock lock(m_SharedMutex);
+				m_SharedTasks[static_cast<size_t>(priority)].push_back({ Task(std::forward<F>(function)), group });
+				m_SharedTaskCount.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			NotifyTaskQueued();
+		}
+
+		/**
+		 * @brief Runs queued tasks on the calling thread, until all the tasks of the group are finished
+		 *
+		 * @param lowestPriority The lowest priority of the tasks run while waiting, so a long background task
+		 * can't stall the waiting thread.
+		 */
+		void Wait(const TaskGroup& group, const TaskPriority lowestPriority = TaskPriority::Normal)
+		{
+			while (!group.IsDone())
+			{
+				if (!TryRunTask(lowestPriority))
+					std::this_thread::yield();
+			}
+		}
+
+		/// Runs a queued task with at least the given priority, returns false if there was none
+		bool TryRunTask(const TaskPriority lowestPriority = TaskPriority::Low)
+		{
+			if (m_QueuedTaskCount.load(std::memory_order_acquire) == 0)
+				return false;
+
+			Worker* self = GetCurrentWorker();
+			const size_t workerCount = m_Workers.size();
+
+			for (size_t priority = 0; priority <= static_cast<size_t>(lowestPriority); ++priority)
+			{
+				if (self)
+				{
+					if (TaskNode* node = self->Deques[priority].Pop())
 					{
-						while (true)
+						RunNode(*node);
+						return true;
+					}
+				}
+
+				if (m_SharedTaskCount.load(std::memory_order_relaxed) > 0)
+				{
+					Task task;
+					TaskGroup* group = nullptr;
+					{
+						std::scoped_lock lock(m_SharedMutex);
+						auto& tasks = m_SharedTasks[priority];
+						if (!tasks.empty())
 						{
-							std::function<void()> task;
-							/// The reason for putting the below code
-							/// here is to unlock the queue before
-							/// executing the task so that other
-							/// threads can perform enqueue tasks
-							{
-								/// Locking the queue so that data
-								/// can be shared safely
-								std::unique_lock<std::mutex> lock(m_QueueMutex);
-
-								/// Waiting until there is a task to
-								/// execute or the pool is stopped
-								m_Condition.wait(lock, [this]
-									{
-										return !m_TaskQueue.empty() || m_Stop;
-									});
-
-								/// Exit the thread in case the pool
-								/// is stopped and there are no tasks
-								if (m_Stop && m_TaskQueue.empty())
-								{
-									return;
-								}
-
-								/// Get the next task from the queue
-								task = std::move(m_TaskQueue.front());
-								m_TaskQueue.pop();
-							}
-
-							try
-							{
-								task();
-							}
-							catch (const std::exception& e)
-							{
-								KBR_CORE_ERROR("Exception in thread pool task: {}", e.what());
-							}
+							task = std::move(tasks.front().Work);
+							group = tasks.front().Group;
+							tasks.pop_front();
+							m_SharedTaskCount.fetch_sub(1, std::memory_order_relaxed);
 						}
-					});
+					}
+
+					if (task)
+					{
+						m_QueuedTaskCount.fetch_sub(1, std::memory_order_relaxed);
+						RunTask(task, group);
+						return true;
+					}
+				}
+
+				/// Steal starting from the next worker, so the thieves spread out
+				const size_t start = self ? static_cast<size_t>(t_WorkerIndex) + 1 : 0;
+				for (size_t i = 0; i < workerCount; ++i)
+				{
+					Worker& victim = *m_Workers[(start + i) % workerCount];
+					if (&victim == self)
+						continue;
+
+					if (TaskNode* node = victim.Deques[priority].Steal())
+					{
+						RunNode(*node);
+						return true;
+					}
+				}
 			}
+
+			return false;
 		}
 
-		~ThreadPool()
+		/**
+		 * @brief Calls the function with the ranges of [0, count), split into chunks of at least grainSize elements,
+		 * and waits until all of them are done. The calling thread works on the chunks too.
+		 *
+		 * The range is split in half recursively, so the idle workers steal the biggest remaining pieces.
+		 */
+		template<typename Fn>
+		void ParallelFor(const uint32_t count, const uint32_t grainSize, Fn&& fn, const TaskPriority priority = TaskPriority::High)
 		{
+			if (count == 0)
+				return;
+
+			if (m_Workers.empty() || count <= grainSize)
 			{
-				std::unique_lock<std::mutex> lock(m_QueueMutex);
-				m_Stop = true;
+				fn(0u, count);
+				return;
 			}
 
-			m_Condition.notify_all();
+			TaskGroup group;
+			ParallelForRange(0, count, std::max(grainSize, 1u), fn, group, priority);
+			Wait(group, priority);
+		}
+
+		uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Workers.size()); }
 
-			for (std::thread& worker : m_Workers)
+		/// Returns the index of the worker of the calling thread, or -1 if it is not a worker of this pool
+		int32_t GetWorkerIndex() const { return t_CurrentPool == this ? static_cast<int32_t>(t_WorkerIndex) : -1; }
+
+	private:
+		struct TaskNode
+		{
+			Task Work;
+			TaskGroup* Group = nullptr;
+			/// Set while the node is queued, cleared when a thread takes the task
+			std::atomic<bool> InUse = false;
+		};
+
+		struct SharedTask
+		{
+			Task Work;
+			TaskGroup* Group = nullptr;
+		};
+
+		struct alignas(64) Worker
+		{
+			Worker()
+				: Deques{ WorkStealingDeque<TaskNode>(WorkerTaskCapacity), WorkStealingDeque<TaskNode>(WorkerTaskCapacity), WorkStealingDeque<TaskNode>(WorkerTaskCapacity) },
+				Nodes(std::make_unique<TaskNode[]>(WorkerTaskCapacity))
+			{}
+
+			/// Only called by the owner, returns null if the next node is still in use
+			TaskNode* AllocateNode()
+			{
+				TaskNode& node = Nodes[NextNode & (WorkerTaskCapacity - 1)];
+				if (node.InUse.load(std::memory_order_acquire))
+					return nullptr;
+
+				node.InUse.store(true, std::memory_order_relaxed);
+				++NextNode;
+				return &node;
+			}
+
+			std::array<WorkStealingDeque<TaskNode>, PriorityCount> Deques;
+			/// The tasks are stored in a ring of nodes, so queueing them doesn't allocate
+			std::unique_ptr<TaskNode[]> Nodes;
+			uint32_t NextNode = 0;
+
+			std::thread Thread;
+		};
+
+		static_assert(std::has_single_bit(WorkerTaskCapacity), "The task capacity of the workers must be a power of two");
+
+		Worker* GetCurrentWorker() const
+		{
+			return t_CurrentPool == this ? m_Workers[t_WorkerIndex].get() : nullptr;
+		}
+
+		void NotifyTaskQueued()
+		{
+			/// Pairs with the sleeping worker count incremented before checking the queued tasks,
+			/// one of the two threads always sees the change of the other
+			m_QueuedTaskCount.fetch_add(1, std::memory_order_seq_cst);
+			if (m_SleepingWorkerCount.load(std::memory_order_seq_cst) == 0)
+				return;
+
+			/// Taking the lock makes sure a worker checking the task count can't miss the notification
+			{
+				std::scoped_lock lock(m_WakeMutex);
+			}
+			m_WakeCondition.notify_one();
+		}
+
+		void RunNode(TaskNode& node)
+		{
+			m_QueuedTaskCount.fetch_sub(1, std::memory_order_relaxed);
+
+			Task task = std::move(node.Work);
+			TaskGroup* group = node.Group;
+			node.InUse.store(false, std::memory_order_release);
+
+			RunTask(task, group);
+		}
+
+		static void RunTask(Task& task, TaskGroup* group)
+		{
+			try
+			{
+				task();
+			}
+			catch (const std::exception& e)
 			{
-				worker.join();
+				KBR_CORE_ERROR("Exception in thread pool task: {}", e.what());
 			}
+
+			if (group)
+				group->m_Pending.fetch_sub(1, std::memory_order_release);
 		}
 
-		void Enqueue(std::function<void()> task)
+		template<typename Fn>
+		void ParallelForRange(const uint32_t begin, uint32_t end, const uint32_t grainSize, Fn& fn, TaskGroup& group, const TaskPriority priority)
 		{
+			/// Give away the upper halves and keep splitting the lower one
+			while (end - begin > grainSize)
 			{
-				std::unique_lock<std::mutex> lock(m_QueueMutex);
-				m_TaskQueue.emplace(std::move(task));
+				const uint32_t middle = begin + (end - begin) / 2;
+				Enqueue([this, &fn, &group, middle, end, grainSize, priority]
+					{
+						ParallelForRange(middle, end, grainSize, fn, group, priority);
+					}, priority, &group);
+
+				end = middle;
 			}
-			m_Condition.notify_one();
+
+			fn(begin, end);
+		}
+
+		void WorkerMain(const uint32_t workerIndex)
+		{
+			t_CurrentPool = this;
+			t_WorkerIndex = workerIndex;
+
+			/// Spin for a while before sleeping, as new tasks usually arrive in bursts
+			constexpr uint32_t SpinCount = 64;
+			uint32_t spins = 0;
+
+			while (true)
+			{
+				if (TryRunTask(TaskPriority::Low))
+				{
+					spins = 0;
+					continue;
+				}
+
+				/// The workers keep running the queued tasks after the pool is stopped, until all the queues are empty
+				if (m_Stop.load(std::memory_order_acquire) && m_QueuedTaskCount.load(std::memory_order_acquire) == 0)
+					break;
+
+				if (++spins < SpinCount)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				spins = 0;
+
+				m_SleepingWorkerCount.fetch_add(1, std::memory_order_seq_cst);
+				{
+					std::unique_lock lock(m_WakeMutex);
+					m_WakeCondition.wait(lock, [this]
+						{
+							return m_QueuedTaskCount.load(std::memory_order_seq_cst) > 0 || m_Stop.load(std::memory_order_acquire);
+						});
+				}
+				m_SleepingWorkerCount.fetch_sub(1, std::memory_order_seq_cst);
+			}
+
+			t_CurrentPool = nullptr;
 		}
 
 	private:
-		std::vector<std::thread> m_Workers;
-		std::queue<std::function<void()>> m_TaskQueue;
-		std::mutex m_QueueMutex;
-		std::condition_variable m_Condition;
-		bool m_Stop;
+		std::vector<std::unique_ptr<Worker>> m_Workers;
+
+		/// The tasks enqueued by threads which are not workers of the pool
+		std::mutex m_SharedMutex;
+		std::array<std::deque<SharedTask>, PriorityCount> m_SharedTasks;
+		std::atomic<uint32_t> m_SharedTaskCount = 0;
+
+		std::mutex m_WakeMutex;
+		std::condition_variable m_WakeCondition;
+		/// The number of tasks in all the queues, the idle workers sleep while it is zero
+		alignas(64) std::atomic<uint32_t> m_QueuedTaskCount = 0;
+		std::atomic<uint32_t> m_SleepingWorkerCount = 0;
+		std::atomic<bool> m_Stop = false;
+
+		inline static thread_local ThreadPool* t_CurrentPool = nullptr;
+		inline static thread_local uint32_t t_WorkerIndex = 0;
 	};
-}
\ No newline at end of file
+}
@@ -4,20 +4,42 @@
 #include <Jolt/Physics/Body/BodyActivationListener.h>
 #include <Jolt/Physics/Body/Body.h>
 
+#include <mutex>
+
 namespace Kerberos::Physics
 {
+	/**
+	* Collects the bodies that went to sleep, so their transforms can be synced one last time,
+	* as only the active bodies are synced after the step.
+	*/
 	class BodyActivationListener final : public JPH::BodyActivationListener
 	{
 	public:
 		void OnBodyActivated(const JPH::BodyID& inBodyID, uint64_t inBodyUserData) override
 		{
-			KBR_CORE_TRACE("A body got activated: {}", inBodyID.GetIndex());
 		}
 
+		/// Called from the physics jobs, but bodies go to sleep rarely, so a lock is fine here
 		void OnBodyDeactivated(const JPH::BodyID& inBodyID, uint64_t inBodyUserData) override
 		{
-			KBR_CORE_TRACE("A body went to sleep: {}", inBodyID.GetIndex());
+			std::scoped_lock lock(m_Mutex);
+			m_DeactivatedBodies.push_back(inBodyID);
+		}
 
+		/// Returns the bodies that went to sleep since the last call, the vector stays valid until the next call
+		const std::vector<JPH::BodyID>& TakeDeactivatedBodies()
+		{
+			m_TakenBodies.clear();
+
+			std::scoped_lock lock(m_Mutex);
+			m_DeactivatedBodies.swap(m_TakenBodies);
+			return m_TakenBodies;
 		}
+
+	private:
+		std::mutex m_Mutex;
+		std::vector<JPH::BodyID> m_DeactivatedBodies;
+		/// Swapped with the deactivated bodies, so neither of them has to allocate again
+		std::vector<JPH::BodyID> m_TakenBodies;
 	};
 }
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+
+namespace Kerberos::Physics
+{
+	/// A contact change reported by Jolt, the bodies are resolved to entities when the queue is drained
+	struct RawContactEvent
+	{
+		enum class Kind : uint8_t
+		{
+			Added,
+			Persisted,
+			Removed,
+		};
+
+		Kind Type = Kind::Added;
+		uint32_t Body1 = 0;
+		uint32_t Body2 = 0;
+	};
+
+	/**
+	* Bounded multi-producer single-consumer ring buffer of contact events.
+	*
+	* The contact callbacks of Jolt run on its job threads, they push the events without locking or allocating.
+	* The main thread pops them after the step. Every slot has a sequence number telling whether it is free
+	* for the producer of that position, or holds an event for the consumer (Vyukov's bounded queue).
+	* When the queue is full, the events are dropped and counted instead of blocking the physics jobs.
+	*/
+	class ContactEventQueue
+	{
+	public:
+		/// The capacity is rounded up to a power of two
+		explicit ContactEventQueue(const uint32_t capacity)
+			: m_Capacity(std::bit_ceil(std::max(capacity, 2u))), m_Slots(std::make_unique<Slot[]>(m_Capacity))
+		{
+			for (uint32_t i = 0; i < m_Capacity; ++i)
+			{
+				m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		/// Thread safe, can be called from any number of threads at the same time
+		bool Push(const RawContactEvent& event)
+		{
+			uint64_t position = m_Head.load(std::memory_order_relaxed);
+			while (true)
+			{
+				Slot& slot = m_Slots[position & (m_Capacity - 1)];
+				const uint64_t sequence = slot.Sequence.load(std::memory_order_acquire);
+				const int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+
+				if (difference == 0)
+				{
+					/// The slot is free, claim the position
+					if (m_Head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						slot.Event = event;
+						slot.Sequence.store(position + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					/// The slot still holds an event from the previous lap, the queue is full
+					m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				else
+				{
+					/// Another producer claimed the position
+					position = m_Head.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/// Must only be called from a single thread
+		bool Pop(RawContactEvent& outEvent)
+		{
+			Slot& slot = m_Slots[m_Tail & (m_Capacity - 1)];
+			if (slot.Sequence.load(std::memory_order_acquire) != m_Tail + 1)
+				return false;
+
+			outEvent = slot.Event;
+
+			/// Free the slot for the producers of the next lap
+			slot.Sequence.store(m_Tail + m_Capacity, std::memory_order_release);
+			++m_Tail;
+
+			return true;
+		}
+
+		uint32_t GetCapacity() const { return m_Capacity; }
+
+		/// Returns the number of events dropped since the last call
+		uint32_t ResetDroppedCount() { return m_DroppedCount.exchange(0, std::memory_order_relaxed); }
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint64_t> Sequence = 0;
+			RawContactEvent Event;
+		};
+
+		uint32_t m_Capacity;
+		std::unique_ptr<Slot[]> m_Slots;
+
+		/// The producers and the consumer write to different cache lines
+		alignas(64) std::atomic<uint64_t> m_Head = 0;
+		alignas(64) uint64_t m_Tail = 0;
+		alignas(64) std::atomic<uint32_t> m_DroppedCount = 0;
+	};
+}
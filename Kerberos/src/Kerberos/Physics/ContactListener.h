@@ -5,32 +5,45 @@
 #include "Jolt/Physics/Collision/ContactListener.h"
 #include "Jolt/Physics/Body/Body.h"
 
+#include "ContactEventQueue.h"
+
 namespace Kerberos::Physics
 {
+	/**
+	* Pushes the contact changes into the event queue, which is drained on the main thread after the step.
+	* The callbacks are called from the physics jobs, so they must not touch the scene.
+	* Jolt reports the contacts of every sub shape pair, PhysicsSystem merges them into the events of the body pair.
+	*/
 	class ContactListener final : public JPH::ContactListener
 	{
 	public:
+		explicit ContactListener(ContactEventQueue& queue)
+			: m_Queue(queue)
+		{}
+
 		JPH::ValidateResult	OnContactValidate(const JPH::Body& inBody1, const JPH::Body& inBody2, JPH::RVec3Arg inBaseOffset, const JPH::CollideShapeResult& inCollisionResult) override
 		{
-			KBR_CORE_TRACE("Contact validate callback: {} - {}", inBody1.GetID().GetIndex(), inBody2.GetID().GetIndex());
-
 			/// Allows you to ignore a contact before it is created (using layers to not make objects collide is cheaper!)
 			return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
 		}
 
 		void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override
 		{
-			KBR_CORE_TRACE("A contact was added: {} - {}", inBody1.GetID().GetIndex(), inBody2.GetID().GetIndex());
+			m_Queue.Push({ RawContactEvent::Kind::Added, inBody1.GetID().GetIndexAndSequenceNumber(), inBody2.GetID().GetIndexAndSequenceNumber() });
 		}
 
 		void OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override
 		{
-			KBR_CORE_TRACE("A contact was persisted: {} - {}", inBody1.GetID().GetIndex(), inBody2.GetID().GetIndex());
+			m_Queue.Push({ RawContactEvent::Kind::Persisted, inBody1.GetID().GetIndexAndSequenceNumber(), inBody2.GetID().GetIndexAndSequenceNumber() });
 		}
 
+		/// The bodies can't be accessed here, they may already be removed
 		void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override
 		{
-			KBR_CORE_TRACE("A contact was removed: {} - {}", inSubShapePair.GetBody1ID().GetIndex(), inSubShapePair.GetBody2ID().GetIndex());
+			m_Queue.Push({ RawContactEvent::Kind::Removed, inSubShapePair.GetBody1ID().GetIndexAndSequenceNumber(), inSubShapePair.GetBody2ID().GetIndexAndSequenceNumber() });
 		}
+
+	private:
+		ContactEventQueue& m_Queue;
 	};
 }
@@ -1,13 +1,88 @@
 #pragma once
 
 #include "Kerberos/Core.h"
+#include "Kerberos/Core/UUID.h"
 
 #include <glm/glm.hpp>
 
+#include <span>
+
 namespace Kerberos 
 {
 	class Scene;
 
+	struct PhysicsSettings
+	{
+		/// The maximum number of bodies in the world, creating more bodies fails
+		uint32_t MaxBodies = 65536;
+
+		/// The number of mutexes protecting the bodies from concurrent access, 0 uses the default of Jolt
+		uint32_t NumBodyMutexes = 0;
+
+		/**
+		* The maximum number of body pairs queued by the broad phase for the narrow phase.
+		* When the queue fills up, the broad phase jobs start to do narrow phase work, which is less efficient.
+		*/
+		uint32_t MaxBodyPairs = 65536;
+
+		/// The maximum number of contacts, the contacts above it are ignored and the bodies start interpenetrating
+		uint32_t MaxContactConstraints = 10240;
+
+		/// The maximum number of contact events queued during a fixed step, the events above it are dropped
+		uint32_t MaxContactEvents = 16384;
+
+		/// The number of fixed steps the simulation takes per second
+		float FixedUpdateRate = 60.0f;
+
+		/**
+		* The maximum number of fixed steps taken in a single frame.
+		* Frames longer than this many steps are clamped, and the time above it is dropped,
+		* so a hitch can't make the simulation fall further and further behind.
+		*/
+		uint32_t MaxStepsPerFrame = 4;
+
+		/// The number of collision steps Jolt takes during a fixed step
+		int CollisionSteps = 1;
+
+		/// If true, the rendered transforms are interpolated between the last two fixed steps
+		bool Interpolate = true;
+	};
+
+	struct PhysicsStatistics
+	{
+		/// Number of fixed steps taken during the last update
+		uint32_t StepsTaken = 0;
+		/// Number of fixed steps dropped during the last update, because of the per frame limit
+		uint32_t StepsDropped = 0;
+		/// The simulation time not yet stepped, in seconds
+		float AccumulatorLag = 0.0f;
+		/// The factor the rendered transforms were interpolated with, between the previous and the current step
+		float InterpolationAlpha = 1.0f;
+		/// Number of awake bodies, whose transforms were synced during the last update
+		uint32_t ActiveBodies = 0;
+		/// Number of contact events reported during the last update
+		uint32_t ContactEvents = 0;
+		/// Number of contact events dropped during the last update, because the queue was full
+		uint32_t ContactEventsDropped = 0;
+	};
+
+	enum class ContactEventType : uint8_t
+	{
+		CollisionEnter,
+		CollisionStay,
+		CollisionExit,
+		TriggerEnter,
+		TriggerExit,
+	};
+
+	/// A contact between the bodies of two entities starting, persisting or ending during a fixed step
+	struct ContactEvent
+	{
+		ContactEventType Type = ContactEventType::CollisionEnter;
+		UUID Entity1{ 0 };
+		UUID Entity2{ 0 };
+	};
+
 	class IPhysicsSystem 
 	{
 	public:
@@ -23,8 +98,20 @@ namespace Kerberos
 		virtual void Initialize(const Ref<Scene>& scene) = 0;
 		virtual void Cleanup() = 0;
 
+		/**
+		 * @brief Advances the simulation by the time elapsed since the last update
+		 *
+		 * The simulation is stepped with a fixed timestep, the time left over is carried to the next update.
+		 */
 		virtual void Update(float deltaTime) = 0;
 
+		virtual void SetSettings(const PhysicsSettings& settings) = 0;
+		virtual const PhysicsSettings& GetSettings() const = 0;
+		virtual const PhysicsStatistics& GetStatistics() const = 0;
+
+		/// The contact events of the fixed steps taken during the last update, in the order they happened
+		virtual std::span<const ContactEvent> GetContactEvents() const = 0;
+
 		virtual void AddImpulse(uint32_t bodyId, const glm::vec3& impulse) const = 0;
 		virtual void AddImpulse(uint32_t bodyId, const glm::vec3& impulse, const glm::vec3& point) const = 0;
 	};
@@ -0,0 +1,70 @@
+#include "kbrpch.h"
+#include "JobSystemAdapter.h"
+
+#include "Kerberos/Internal/JobSystem.h"
+
+#include <thread>
+
+namespace Kerberos::Physics
+{
+	JobSystemAdapter::JobSystemAdapter(const JPH::uint maxJobs, const JPH::uint maxBarriers)
+		: JobSystemWithBarrier(maxBarriers)
+	{
+		m_Jobs.Init(maxJobs, maxJobs);
+	}
+
+	int JobSystemAdapter::GetMaxConcurrency() const
+	{
+		/// The thread waiting on the barrier runs jobs too
+		return static_cast<int>(JobSystem::GetWorkerCount()) + 1;
+	}
+
+	JobSystemAdapter::JobHandle JobSystemAdapter::CreateJob(const char* inName, const JPH::ColorArg inColor, const JobFunction& inJobFunction, const JPH::uint32 inNumDependencies)
+	{
+		/// When all the jobs are in use, wait for one to be freed
+		JPH::uint32 index;
+		while (true)
+		{
+			index = m_Jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+			if (index != AvailableJobs::cInvalidObjectIndex)
+				break;
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+
+		Job* job = &m_Jobs.Get(index);
+
+		/// The handle keeps a reference, so the job can't be freed before it is returned
+		JobHandle handle(job);
+
+		/// The jobs with dependencies are queued when their dependencies are done
+		if (inNumDependencies == 0)
+			QueueJob(job);
+
+		return handle;
+	}
+
+	void JobSystemAdapter::QueueJob(Job* inJob)
+	{
+		/// The reference keeps the job alive until it is executed
+		inJob->AddRef();
+
+		JobSystem::Submit([inJob]
+			{
+				inJob->Execute();
+				inJob->Release();
+			}, JobPriority::High);
+	}
+
+	void JobSystemAdapter::QueueJobs(Job** inJobs, const JPH::uint inNumJobs)
+	{
+		for (JPH::uint i = 0; i < inNumJobs; ++i)
+		{
+			QueueJob(inJobs[i]);
+		}
+	}
+
+	void JobSystemAdapter::FreeJob(Job* inJob)
+	{
+		m_Jobs.DestructObject(inJob);
+	}
+}
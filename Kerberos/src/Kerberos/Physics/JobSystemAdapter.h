@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+namespace Kerberos::Physics
+{
+	/**
+	* Runs the jobs of Jolt on the engine job system, instead of the threads of a JobSystemThreadPool.
+	* The jobs are submitted with a high priority, since the frame waits on the physics step.
+	*/
+	class JobSystemAdapter final : public JPH::JobSystemWithBarrier
+	{
+	public:
+		JobSystemAdapter(JPH::uint maxJobs, JPH::uint maxBarriers);
+		~JobSystemAdapter() override = default;
+
+		int GetMaxConcurrency() const override;
+		JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies = 0) override;
+
+	protected:
+		void QueueJob(Job* inJob) override;
+		void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override;
+		void FreeJob(Job* inJob) override;
+
+	private:
+		using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+		AvailableJobs m_Jobs;
+	};
+}
@@ -2,9 +2,12 @@
 
 #include "PhysicsSystem.h"
 #include "BodyActivationListener.h"
+#include "ContactEventQueue.h"
 #include "ContactListener.h"
+#include "JobSystemAdapter.h"
 #include "JoltImpl.h"
 #include "Layers.h"
+#include "ShapeCache.h"
 #include "Utils.h"
 #include "Kerberos/Scene/Entity.h"
 #include "Kerberos/Scene/Scene.h"
@@ -16,15 +19,13 @@
 #include <Jolt/Physics/Collision/Shape/Shape.h>
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/PhysicsSettings.h>
-#include "Jolt/Physics/Collision/Shape/BoxShape.h"
-#include "Jolt/Physics/Collision/Shape/SphereShape.h"
-#include "Jolt/Physics/Collision/Shape/StaticCompoundShape.h"
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
-#include "Jolt/Physics/Collision/Shape/CapsuleShape.h"
+#include <Jolt/Physics/Body/BodyLockInterface.h>
 #include "Jolt/Physics/Collision/Shape/OffsetCenterOfMassShape.h"
 
+#include <optional>
+
 
 namespace Kerberos
 {
@@ -38,6 +39,11 @@ namespace Kerberos
 		KBR_PROFILE_FUNCTION();
 
 		m_Scene = scene;
+		m_Accumulator = 0.0f;
+		m_Statistics = {};
+		m_ContactEvents.clear();
+		m_ActiveContacts.clear();
+		m_StepIndex = 0;
 
 		/// Register allocation hook. In this example we'll just let Jolt use malloc / free but you can override these if you want (see Memory.h).
 		/// This needs to be done before any other Jolt function is called.
@@ -65,28 +71,10 @@ namespace Kerberos
 		constexpr size_t cTempAllocatorSize = 10 * 1024 * 1024; /// 10 MB
 		m_PhysicsTempAllocator = new JPH::TempAllocatorImpl(cTempAllocatorSize);
 
-		/// We need a job system that will execute physics jobs on multiple threads. Typically
-		/// you would implement the JobSystem interface yourself and let Jolt PhysicsTemp run on top
-		/// of your own job scheduler. JobSystemThreadPool is an example implementation.
-		m_PhysicsJobSystem = new JPH::JobSystemThreadPool(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, static_cast<int>(std::thread::hardware_concurrency()) - 1);
-
-		/// This is the max amount of rigid bodies that you can add to the physics system. If you try to add more you'll get an error.
-		/// Note: This value is low because this is a simple test. For a real project use something in the order of 65536.
-		constexpr uint32_t cMaxBodies = 1024;
-
-		/// This determines how many mutexes to allocate to protect rigid bodies from concurrent access. Set it to 0 for the default settings.
-		constexpr uint32_t cNumBodyMutexes = 0;
+		/// The physics jobs run on the engine job system, so they don't compete with the threads of a separate pool
+		m_PhysicsJobSystem = new Physics::JobSystemAdapter(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
 
-		/// This is the max amount of body pairs that can be queued at any time (the broad phase will detect overlapping
-		/// body pairs based on their bounding boxes and will insert them into a queue for the narrowphase). If you make this buffer
-		/// too small the queue will fill up and the broad phase jobs will start to do narrow phase work. This is slightly less efficient.
-		/// Note: This value is low because this is a simple test. For a real project use something in the order of 65536.
-		constexpr uint32_t cMaxBodyPairs = 1024;
-
-		/// This is the maximum size of the contact constraint buffer. If more contacts (collisions between bodies) are detected than this
-		/// number then these contacts will be ignored and bodies will start interpenetrating / fall through the world.
-		/// Note: This value is low because this is a simple test. For a real project use something in the order of 10240.
-		constexpr uint32_t cMaxContactConstraints = 1024;
+		/// The capacities of the world come from the settings, see PhysicsSettings for what they limit
 
 		/// Create mapping table from object layer to broadphase layer
 		/// Note: As this is an interface, PhysicsSystem will take a reference to this so this instance needs to stay alive!
@@ -104,7 +92,7 @@ namespace Kerberos
 		m_ObjectVsObjectLayerFilter = new Physics::ObjectLayerPairFilterImpl();
 
 		m_JoltSystem = new JPH::PhysicsSystem();
-		m_JoltSystem->Init(cMaxBodies, cNumBodyMutexes, cMaxBodyPairs, cMaxContactConstraints, *m_BroadPhaseLayerInterface, *m_ObjectVsBroadPhaseLayerFilter, *m_ObjectVsObjectLayerFilter);
+		m_JoltSystem->Init(m_Settings.MaxBodies, m_Settings.NumBodyMutexes, m_Settings.MaxBodyPairs, m_Settings.MaxContactConstraints, *m_BroadPhaseLayerInterface, *m_ObjectVsBroadPhaseLayerFilter, *m_ObjectVsObjectLayerFilter);
 
 		/// A body activation listener gets notified when bodies activate and go to sleep
 		/// Note that this is called from a job so whatever you do here needs to be thread safe.
@@ -114,9 +102,19 @@ namespace Kerberos
 
 		/// A contact listener gets notified when bodies (are about to) collide, and when they separate again.
 		/// Note that this is called from a job so whatever you do here needs to be thread safe.
-		/// Registering one is entirely optional.
-		m_ContactListener = new Physics::ContactListener();
+		/// The listener only pushes the events into a lock-free queue, they are handled on the main thread after the step.
+		m_ContactEventQueue = new Physics::ContactEventQueue(m_Settings.MaxContactEvents);
+		m_ContactListener = new Physics::ContactListener(*m_ContactEventQueue);
 		m_JoltSystem->SetContactListener(m_ContactListener);
+
+		m_ShapeCache = new Physics::ShapeCache();
+
+		/// Create the bodies of the scene in a single batch, and optimize the broad phase once they are all added.
+		/// Adding the bodies one by one leaves the broad phase in a state that is slow to query.
+		if (UpdateAndCreatePhysicsBodies() > 0)
+		{
+			m_JoltSystem->OptimizeBroadPhase();
+		}
 	}
 
 
@@ -126,10 +124,46 @@ namespace Kerberos
 
 		UpdateAndCreatePhysicsBodies();
 
-		constexpr int collisionSteps = 3;
-		m_JoltSystem->Update(deltaTime, collisionSteps, m_PhysicsTempAllocator, m_PhysicsJobSystem);
+		m_ContactEvents.clear();
+		m_Statistics.ContactEventsDropped = 0;
+
+		const float fixedTimestep = 1.0f / m_Settings.FixedUpdateRate;
+
+		/// Clamp long frames (hitches, breakpoints), so they can't trigger a burst of steps
+		m_Accumulator += std::min(deltaTime, fixedTimestep * static_cast<float>(m_Settings.MaxStepsPerFrame));
+
+		const uint32_t stepCount = std::min(static_cast<uint32_t>(m_Accumulator / fixedTimestep), m_Settings.MaxStepsPerFrame);
+		for (uint32_t i = 0; i < stepCount; ++i)
+		{
+			/// Only the pose before the last step is needed to interpolate between the last two steps
+			if (i + 1 == stepCount)
+				StorePreviousPoses();
+
+			m_JoltSystem->Update(fixedTimestep, m_Settings.CollisionSteps, m_PhysicsTempAllocator, m_PhysicsJobSystem);
+
+			/// Drained after every step, so the queue only has to hold the events of a single step
+			DrainContactEvents();
+		}
+		m_Accumulator -= static_cast<float>(stepCount) * fixedTimestep;
+
+		/// Drop the steps above the limit instead of carrying them to the next frame
+		m_Statistics.StepsDropped = static_cast<uint32_t>(m_Accumulator / fixedTimestep);
+		m_Accumulator -= static_cast<float>(m_Statistics.StepsDropped) * fixedTimestep;
 
-		SyncTransforms();
+		m_Statistics.StepsTaken = stepCount;
+		m_Statistics.AccumulatorLag = m_Accumulator;
+		m_Statistics.InterpolationAlpha = m_Settings.Interpolate ? m_Accumulator / fixedTimestep : 1.0f;
+		m_Statistics.ContactEvents = static_cast<uint32_t>(m_ContactEvents.size());
+
+		SyncTransforms(m_Statistics.InterpolationAlpha);
+	}
+
+	void PhysicsSystem::SetSettings(const PhysicsSettings& settings)
+	{
+		KBR_CORE_ASSERT(settings.FixedUpdateRate > 0.0f, "The physics update rate must be positive!");
+		KBR_CORE_ASSERT(settings.MaxStepsPerFrame > 0, "The physics must be able to take at least one step per frame!");
+
+		m_Settings = settings;
 	}
 
 	void PhysicsSystem::AddImpulse(const uint32_t bodyId, const glm::vec3& impulse) const
@@ -154,131 +188,238 @@ namespace Kerberos
 		return m_JoltSystem->GetBodyInterface();
 	}
 
-	void PhysicsSystem::UpdateAndCreatePhysicsBodies() 
+	uint32_t PhysicsSystem::UpdateAndCreatePhysicsBodies() 
 	{
 		KBR_PROFILE_FUNCTION();
 
 		KBR_CORE_ASSERT(!m_Scene.expired(), "Scene is not initialized!");
 		KBR_CORE_ASSERT(m_JoltSystem, "Jolt Physics System is not initialized!");
 
-		// Handle entities with rigidbodies but no physics body created yet
-		const auto newBodies = m_Scene.lock()->m_Registry.view<RigidBody3DComponent, TransformComponent>(/*entt::exclude<>*/ );
-		for (const entt::entity id : newBodies)
+		const Ref<Scene> scene = m_Scene.lock();
+		JPH::BodyInterface& bodyInterface = m_JoltSystem->GetBodyInterface();
+
+		/// Update the dirty bodies in place, and collect the entities without a physics body yet,
+		/// and the ones whose body can't be updated in place and has to be recreated
+		std::vector<entt::entity> entities;
+		std::vector<JPH::BodyID> staleBodies;
+
+		const auto view = scene->m_Registry.view<RigidBody3DComponent, TransformComponent>();
+		for (const entt::entity id : view)
 		{
-			const Entity entity(id, m_Scene);
-			auto& rb = entity.GetComponent<RigidBody3DComponent>();
-			/*if (rb.bodyID == JPH::BodyID::cInvalidBodyID)
-			{
-				CreatePhysicsBody(id);
-			}*/
-			if (!rb.RuntimeBody)
+			auto& rb = view.get<RigidBody3DComponent>(id);
+			if (rb.RuntimeBody && !rb.IsDirty)
+				continue;
+
+			if (rb.RuntimeBody)
 			{
-				CreatePhysicsBody(entity);
-				rb.IsDirty = false;
+				if (UpdatePhysicsBody(Entity(id, scene.get())))
+					continue;
+
+				staleBodies.push_back(static_cast<JPH::Body*>(rb.RuntimeBody)->GetID());
+				rb.RuntimeBody = nullptr;
 			}
-			/*else
-			{
-				rb.IsDirty = true;
-			}*/
+
+			entities.push_back(id);
 		}
 
-		/// Update existing bodies that are marked dirty
-		const auto existingBodies = m_Scene.lock()->m_Registry.view<RigidBody3DComponent, TransformComponent>();
-		for (const entt::entity id : existingBodies)
+		if (!staleBodies.empty())
 		{
-			const Entity entity(id, m_Scene);
-			auto& rb = entity.GetComponent<RigidBody3DComponent>();
-			if (rb.IsDirty)
-			{
-				/// Remove the old body if it exists
-				if (rb.RuntimeBody)
-				{
-					/// TODO: Do not remove and destroy the old body, but modify it
-					JPH::BodyInterface& bodyInterface = m_JoltSystem->GetBodyInterface();
-					bodyInterface.RemoveBody(static_cast<JPH::Body*>(rb.RuntimeBody)->GetID());
-					bodyInterface.DestroyBody(static_cast<JPH::Body*>(rb.RuntimeBody)->GetID());
-					rb.RuntimeBody = nullptr;
-				}
+			bodyInterface.RemoveBodies(staleBodies.data(), static_cast<int>(staleBodies.size()));
+			bodyInterface.DestroyBodies(staleBodies.data(), static_cast<int>(staleBodies.size()));
+		}
 
-				CreatePhysicsBody(entity);
-				rb.IsDirty = false;
+		if (entities.empty())
+			return 0;
+
+		std::vector<JPH::BodyID> newBodies;
+		newBodies.reserve(entities.size());
+
+		for (const entt::entity id : entities)
+		{
+			if (const JPH::Body* body = CreatePhysicsBody(Entity(id, scene.get())))
+			{
+				newBodies.push_back(body->GetID());
 			}
 		}
+
+		if (newBodies.empty())
+			return 0;
+
+		/// Insert the bodies into the broad phase as a single batch
+		const int bodyCount = static_cast<int>(newBodies.size());
+		const JPH::BodyInterface::AddState addState = bodyInterface.AddBodiesPrepare(newBodies.data(), bodyCount);
+		bodyInterface.AddBodiesFinalize(newBodies.data(), bodyCount, addState, JPH::EActivation::Activate);
+
+		return static_cast<uint32_t>(bodyCount);
+	}
+
+	static std::span<const JPH::BodyID> GetActiveBodies(const JPH::PhysicsSystem& system)
+	{
+		return { system.GetActiveBodiesUnsafe(JPH::EBodyType::RigidBody), system.GetNumActiveBodies(JPH::EBodyType::RigidBody) };
+	}
+
+	/**
+	 * Calls the function with the bodies that still exist, and the components of their entities.
+	 * The bodies are read without locking, so the physics jobs must not be running.
+	 */
+	template<typename Fn>
+	static void ForEachBody(const JPH::PhysicsSystem& system, entt::registry& registry, const std::span<const JPH::BodyID> bodies, Fn&& fn)
+	{
+		const JPH::BodyLockInterfaceNoLock& lockInterface = system.GetBodyLockInterfaceNoLock();
+		for (const JPH::BodyID& id : bodies)
+		{
+			const JPH::Body* body = lockInterface.TryGetBody(id);
+			if (!body)
+				continue;
+
+			/// The user data of the body is the entity it belongs to
+			const auto entity = static_cast<entt::entity>(body->GetUserData());
+			if (!registry.valid(entity) || !registry.all_of<RigidBody3DComponent, TransformComponent>(entity))
+				continue;
+
+			auto [rigidBody, transform] = registry.get<RigidBody3DComponent, TransformComponent>(entity);
+			fn(*body, rigidBody, transform);
+		}
 	}
 
-	void PhysicsSystem::SyncTransforms() const 
+	void PhysicsSystem::StorePreviousPoses() const
 	{
+		KBR_PROFILE_FUNCTION();
+
+		/// Sleeping bodies don't move, their previous pose is already the pose they fell asleep in
+		ForEachBody(*m_JoltSystem, m_Scene.lock()->m_Registry, GetActiveBodies(*m_JoltSystem),
+			[](const JPH::Body& body, RigidBody3DComponent& rigidBody, TransformComponent&)
+			{
+				std::tie(rigidBody.PreviousPosition, rigidBody.PreviousRotation) = Physics::Utils::GetEntityPose(body, rigidBody.ColliderOffset);
+			});
+	}
+
+	void PhysicsSystem::SyncTransforms(const float alpha)
+	{
+		KBR_PROFILE_FUNCTION();
+
 		KBR_CORE_ASSERT(!m_Scene.expired(), "Scene is not initialized!");
 		KBR_CORE_ASSERT(m_JoltSystem, "Jolt Physics System is not initialized!");
 
-		const auto view = m_Scene.lock()->m_Registry.view<RigidBody3DComponent, TransformComponent>();
-		for (const auto e : view)
+		entt::registry& registry = m_Scene.lock()->m_Registry;
+
+		/// The bodies that went to sleep are not active anymore, so they are moved to their final pose here once
+		ForEachBody(*m_JoltSystem, registry, m_BodyActivationListener->TakeDeactivatedBodies(),
+			[](const JPH::Body& body, RigidBody3DComponent& rigidBody, TransformComponent& transform)
+			{
+				std::tie(rigidBody.PreviousPosition, rigidBody.PreviousRotation) = Physics::Utils::GetEntityPose(body, rigidBody.ColliderOffset);
+				Physics::Utils::ApplyJoltTransformToEntity(transform, body, rigidBody, 1.0f);
+			});
+
+		/// Static and sleeping bodies don't move, so only the active bodies are synced
+		const std::span<const JPH::BodyID> activeBodies = GetActiveBodies(*m_JoltSystem);
+		ForEachBody(*m_JoltSystem, registry, activeBodies,
+			[alpha](const JPH::Body& body, const RigidBody3DComponent& rigidBody, TransformComponent& transform)
+			{
+				Physics::Utils::ApplyJoltTransformToEntity(transform, body, rigidBody, alpha);
+			});
+
+		m_Statistics.ActiveBodies = static_cast<uint32_t>(activeBodies.size());
+	}
+
+	void PhysicsSystem::DrainContactEvents()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		/// The physics jobs are finished, so the bodies can be read without locking
+		const JPH::BodyLockInterfaceNoLock& lockInterface = m_JoltSystem->GetBodyLockInterfaceNoLock();
+		const entt::registry& registry = m_Scene.lock()->m_Registry;
+
+		/// Only called for a new contact, Jolt adds contacts between existing bodies only
+		const auto getBodyEntity = [&lockInterface, &registry](const uint32_t bodyId, bool& outIsSensor) -> std::optional<UUID>
+			{
+				const JPH::Body* body = lockInterface.TryGetBody(JPH::BodyID(bodyId));
+				if (!body)
+					return std::nullopt;
+
+				/// The user data of the body is the entity it belongs to
+				const auto entity = static_cast<entt::entity>(body->GetUserData());
+				if (!registry.valid(entity))
+					return std::nullopt;
+
+				outIsSensor = body->IsSensor();
+				return registry.get<IDComponent>(entity).ID;
+			};
+
+		++m_StepIndex;
+
+		Physics::RawContactEvent rawEvent;
+		while (m_ContactEventQueue->Pop(rawEvent))
 		{
-			auto& transform = view.get<TransformComponent>(e);
-			const auto& rigidBody = view.get<RigidBody3DComponent>(e);
+			/// The order of the bodies is not the same in every callback of a pair
+			const uint64_t pairKey = static_cast<uint64_t>(std::min(rawEvent.Body1, rawEvent.Body2)) << 32 | std::max(rawEvent.Body1, rawEvent.Body2);
 
-			if (rigidBody.RuntimeBody)
+			switch (rawEvent.Type)
 			{
-				const JPH::Body* body = static_cast<JPH::Body*>(rigidBody.RuntimeBody);
+			case Physics::RawContactEvent::Kind::Added:
+			{
+				const auto it = m_ActiveContacts.find(pairKey);
+				if (it != m_ActiveContacts.end())
+				{
+					++it->second.SubShapeContactCount;
+					break;
+				}
+
+				bool isSensor1 = false;
+				bool isSensor2 = false;
+				const std::optional<UUID> entity1 = getBodyEntity(rawEvent.Body1, isSensor1);
+				const std::optional<UUID> entity2 = getBodyEntity(rawEvent.Body2, isSensor2);
+				if (!entity1 || !entity2)
+					break;
 
-				const Entity entity(e, m_Scene);
-				const JPH::Vec3 offset = m_ColliderOffsets.at(entity.GetUUID());
+				const ActiveContact contact{ *entity1, *entity2, isSensor1 || isSensor2, 1, 0 };
+				m_ActiveContacts.emplace(pairKey, contact);
 
-				Physics::Utils::ApplyJoltTransformToEntity(transform.WorldTransform, *body, offset, entity.GetComponent<TransformComponent>());
+				m_ContactEvents.push_back({ contact.IsTrigger ? ContactEventType::TriggerEnter : ContactEventType::CollisionEnter, contact.Entity1, contact.Entity2 });
+				break;
 			}
-		}
+			case Physics::RawContactEvent::Kind::Persisted:
+			{
+				const auto it = m_ActiveContacts.find(pairKey);
 
-		/// There probably is a better solution, but lets just stick to something that mostly works for now.
+				/// Triggers only report entering and exiting
+				if (it == m_ActiveContacts.end() || it->second.IsTrigger || it->second.LastStayStep == m_StepIndex)
+					break;
 
-		//const JPH::BodyInterface& bodyInterface = m_JoltSystem->GetBodyInterface();
+				it->second.LastStayStep = m_StepIndex;
+				m_ContactEvents.push_back({ ContactEventType::CollisionStay, it->second.Entity1, it->second.Entity2 });
+				break;
+			}
+			case Physics::RawContactEvent::Kind::Removed:
+			{
+				/// The bodies may already be destroyed, the entities resolved when the contact started are used
+				const auto it = m_ActiveContacts.find(pairKey);
+				if (it == m_ActiveContacts.end() || --it->second.SubShapeContactCount > 0)
+					break;
+
+				const ActiveContact& contact = it->second;
+				m_ContactEvents.push_back({ contact.IsTrigger ? ContactEventType::TriggerExit : ContactEventType::CollisionExit, contact.Entity1, contact.Entity2 });
+				m_ActiveContacts.erase(it);
+				break;
+			}
+			}
+		}
 
-		//const auto view = m_Scene->m_Registry.view<RigidBody3DComponent, TransformComponent>();
-		//for (const entt::entity id : view)
-		//{
-		//	const Entity entity(id, m_Scene);
-		//	auto& rb = entity.GetComponent<RigidBody3DComponent>();
-		//	auto& transform = entity.GetComponent<TransformComponent>();
-
-		//	if (rb.bodyID == JPH::BodyID::cInvalidBodyID) continue;
-		//	if (rb.motionType == JPH::EMotionType::Static) continue;
-
-		//	// Get position and rotation from physics body
-		//	JPH::RVec3 position = bodyInterface.GetPosition(rb.bodyID);
-		//	JPH::Quat rotation = bodyInterface.GetRotation(rb.bodyID);
-
-		//	// Update transform
-		//	transform.Translation = glm::vec3(position.GetX(), position.GetY(), position.GetZ());
-		//	transform.Rotation = glm::quat(rotation.GetW(), rotation.GetX(), rotation.GetY(), rotation.GetZ());
-
-		//	// Update velocity for access by other systems
-		//	JPH::Vec3 vel = bodyInterface.GetLinearVelocity(rb.bodyID);
-		//	JPH::Vec3 angVel = bodyInterface.GetAngularVelocity(rb.bodyID);
-		//	rb.Velocity = glm::vec3(vel.GetX(), vel.GetY(), vel.GetZ());
-		//	rb.AngularVelocity = glm::vec3(angVel.GetX(), angVel.GetY(), angVel.GetZ());
-		//}
+		m_Statistics.ContactEventsDropped += m_ContactEventQueue->ResetDroppedCount();
 	}
 
-	void PhysicsSystem::CreatePhysicsBody(const Entity& entity) 
+	JPH::Body* PhysicsSystem::CreatePhysicsBody(const Entity& entity) 
 	{
 		auto& rigidBody = entity.GetComponent<RigidBody3DComponent>();
-		auto& transform = entity.GetComponent<TransformComponent>();
 
 		const JPH::RefConst<JPH::Shape> shape = CreateShapeForEntity(entity);
 		const auto shapeRef = shape.GetPtr();
-		if (!shape) return; // No colliders found
-
-		const glm::vec4 worldPos = transform.WorldTransform[3];
-		const float posX = worldPos.x; //+ collider.Offset.x;
-		const float posY = worldPos.y; //+ collider.Offset.y;
-		const float posZ = worldPos.z; //+ collider.Offset.z;
+		if (!shape) return nullptr; // No colliders found
 
-		const JPH::Vec3 offset = m_ColliderOffsets[entity.GetUUID()];
-		const JPH::Vec3 position = JPH::Vec3(posX + offset.GetX(), posY + offset.GetY(), posZ + offset.GetZ());
-
-		/// Extract rotation quaternion from the transform matrix
-		glm::quat glmRotation = glm::quat_cast(glm::mat3(transform.WorldTransform));
-		glmRotation = glm::normalize(glmRotation); /// Ensure the quaternion is normalized
-		const JPH::Quat rotation = JPH::Quat(glmRotation.x, glmRotation.y, glmRotation.z, glmRotation.w);
+		JPH::Vec3 position;
+		JPH::Quat rotation;
+		GetBodyTransform(entity, position, rotation);
+		rigidBody.WorldScale = Physics::Utils::GetScale(entity.GetComponent<TransformComponent>().WorldTransform);
 
 		JPH::BodyCreationSettings bodySettings(
 			shapeRef,
@@ -290,6 +431,8 @@ namespace Kerberos
 		const bool isTrigger = IsColliderTrigger(entity);
 
 		bodySettings.mIsSensor = isTrigger;
+		/// The contact events and the synced transforms are resolved to entities through the user data
+		bodySettings.mUserData = static_cast<uint64_t>(static_cast<entt::entity>(entity));
 		bodySettings.mMassPropertiesOverride.mMass = rigidBody.Mass;
 		bodySettings.mFriction = rigidBody.Friction;
 		bodySettings.mRestitution = rigidBody.Restitution;
@@ -304,63 +447,133 @@ namespace Kerberos
 
 		JPH::BodyInterface& bodyInterface = m_JoltSystem->GetBodyInterface();
 		JPH::Body* body = bodyInterface.CreateBody(bodySettings);
+		if (!body)
+		{
+			KBR_CORE_ERROR("Failed to create the physics body of entity {}, the maximum of {} bodies is reached!", entity.GetName(), m_Settings.MaxBodies);
+			return nullptr;
+		}
+
 		rigidBody.RuntimeBody = body;
+		std::tie(rigidBody.PreviousPosition, rigidBody.PreviousRotation) = Physics::Utils::GetEntityPose(*body, rigidBody.ColliderOffset);
 		//rigidBody.bodyID = body->GetID();
-		//bodyInterface.AddBody(body->GetID(), rigidBody.isActive ? JPH::EActivation::Activate : JPH::EActivation::DontActivate);
-		bodyInterface.AddBody(body->GetID(), JPH::EActivation::Activate);
 
 		rigidBody.IsDirty = false;
+		return body;
+	}
+
+	bool PhysicsSystem::UpdatePhysicsBody(const Entity& entity)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		auto& rigidBody = entity.GetComponent<RigidBody3DComponent>();
+		JPH::Body* body = static_cast<JPH::Body*>(rigidBody.RuntimeBody);
+
+		/// Static bodies have no motion properties, so a body can't change between static and moving in place
+		const JPH::EMotionType motionType = Physics::Utils::GetJPHMotionTypeFromComponent(rigidBody);
+		if ((motionType == JPH::EMotionType::Static) != body->IsStatic())
+			return false;
+
+		const JPH::RefConst<JPH::Shape> shape = CreateShapeForEntity(entity);
+		if (!shape)
+			return false;
+
+		JPH::Vec3 position;
+		JPH::Quat rotation;
+		GetBodyTransform(entity, position, rotation);
+
+		JPH::BodyInterface& bodyInterface = m_JoltSystem->GetBodyInterface();
+		const JPH::BodyID id = body->GetID();
+
+		/// The mass properties are calculated below, with the mass of the component
+		bodyInterface.SetShape(id, shape, false, JPH::EActivation::Activate);
+		bodyInterface.SetPositionAndRotation(id, position, rotation, JPH::EActivation::Activate);
+		bodyInterface.SetObjectLayer(id, Physics::Utils::GetObjectLayerFromComponent(rigidBody));
+		if (body->GetMotionType() != motionType)
+		{
+			bodyInterface.SetMotionType(id, motionType, JPH::EActivation::Activate);
+		}
+
+		bodyInterface.SetFriction(id, rigidBody.Friction);
+		bodyInterface.SetRestitution(id, rigidBody.Restitution);
+		bodyInterface.SetGravityFactor(id, rigidBody.UseGravity ? 1.0f : 0.0f);
+		body->SetIsSensor(IsColliderTrigger(entity));
+
+		if (JPH::MotionProperties* motionProperties = body->GetMotionPropertiesUnchecked(); !body->IsStatic())
+		{
+			JPH::MassProperties massProperties = shape->GetMassProperties();
+			massProperties.ScaleToMass(rigidBody.Mass);
+			motionProperties->SetMassProperties(motionProperties->GetAllowedDOFs(), massProperties);
+		}
+
+		rigidBody.WorldScale = Physics::Utils::GetScale(entity.GetComponent<TransformComponent>().WorldTransform);
+		std::tie(rigidBody.PreviousPosition, rigidBody.PreviousRotation) = Physics::Utils::GetEntityPose(*body, rigidBody.ColliderOffset);
+		rigidBody.IsDirty = false;
+
+		return true;
+	}
+
+	void PhysicsSystem::GetBodyTransform(const Entity& entity, JPH::Vec3& outPosition, JPH::Quat& outRotation) const
+	{
+		const auto& transform = entity.GetComponent<TransformComponent>();
+
+		const glm::vec4 worldPos = transform.WorldTransform[3];
+		const glm::vec3& offset = entity.GetComponent<RigidBody3DComponent>().ColliderOffset;
+		outPosition = JPH::Vec3(worldPos.x + offset.x, worldPos.y + offset.y, worldPos.z + offset.z);
+
+		/// Extract rotation quaternion from the transform matrix
+		glm::quat glmRotation = glm::quat_cast(glm::mat3(transform.WorldTransform));
+		glmRotation = glm::normalize(glmRotation); /// Ensure the quaternion is normalized
+		outRotation = JPH::Quat(glmRotation.x, glmRotation.y, glmRotation.z, glmRotation.w);
 	}
 
 	JPH::RefConst<JPH::Shape> PhysicsSystem::CreateShapeForEntity(const Entity& entity) 
 	{
+		auto& rigidBody = entity.GetComponent<RigidBody3DComponent>();
 		std::vector<JPH::RefConst<JPH::Shape>> shapes;
 
 		if (entity.HasComponent<BoxCollider3DComponent>())
 		{
 			const auto& coll = entity.GetComponent<BoxCollider3DComponent>();
-			const JPH::Shape* shape = new JPH::BoxShape(JPH::Vec3(coll.Size.x, coll.Size.y, coll.Size.z));
 
-			const JPH::Vec3 offset(coll.Offset.x, coll.Offset.y, coll.Offset.z);
-			m_ColliderOffsets[entity.GetUUID()] = offset;
+			rigidBody.ColliderOffset = coll.Offset;
 
-			shapes.emplace_back(shape);
+			shapes.push_back(m_ShapeCache->GetBoxShape(coll.Size));
 		}
 
 		if (entity.HasComponent<SphereCollider3DComponent>())
 		{
 			const auto& coll = entity.GetComponent<SphereCollider3DComponent>();
-			const JPH::Shape* shape = new JPH::SphereShape(coll.Radius);
 			
-			const JPH::Vec3 offset(coll.Offset.x, coll.Offset.y, coll.Offset.z);
-			m_ColliderOffsets[entity.GetUUID()] = offset;
+			rigidBody.ColliderOffset = coll.Offset;
 
-			shapes.emplace_back(shape);
+			shapes.push_back(m_ShapeCache->GetSphereShape(coll.Radius));
 		}
 
 		if (entity.HasComponent<CapsuleCollider3DComponent>())
 		{
 			const auto& coll = entity.GetComponent<CapsuleCollider3DComponent>();
-			const JPH::Shape* shape = new JPH::CapsuleShape(coll.Height / 2, coll.Radius);
 			
-			const JPH::Vec3 offset(coll.Offset.x, coll.Offset.y, coll.Offset.z);
-			m_ColliderOffsets[entity.GetUUID()] = offset;
+			rigidBody.ColliderOffset = coll.Offset;
 
-			shapes.emplace_back(shape);
+			shapes.push_back(m_ShapeCache->GetCapsuleShape(coll.Height / 2, coll.Radius));
 		}
 
 		if (entity.HasComponent<MeshCollider3DComponent>())
 		{
-			const StaticMeshComponent& mesh = entity.GetComponent<StaticMeshComponent>();
 			const auto& coll = entity.GetComponent<MeshCollider3DComponent>();
-			if (mesh.StaticMesh)
+
+			/// The collider uses the mesh of the static mesh when it has no mesh of its own
+			Ref<Mesh> mesh = coll.Mesh;
+			if (!mesh && entity.HasComponent<StaticMeshComponent>())
+				mesh = entity.GetComponent<StaticMeshComponent>().StaticMesh;
+
+			if (mesh)
 			{
-				if (const JPH::RefConst<JPH::Shape> shape = Physics::Utils::CreateJoltMeshShape(mesh.StaticMesh, entity.GetName()))
+				if (JPH::RefConst<JPH::Shape> shape = m_ShapeCache->GetMeshShape(mesh, entity.GetName()))
 				{
-					const JPH::Vec3 offset(coll.Offset.x, coll.Offset.y, coll.Offset.z);
-					m_ColliderOffsets[entity.GetUUID()] = offset;
+					rigidBody.ColliderOffset = coll.Offset;
 
-					shapes.push_back(shape);
+					shapes.push_back(std::move(shape));
 				}
 			}
 		}
@@ -372,12 +585,7 @@ namespace Kerberos
 			return shapes[0];
 		}
 
-		JPH::StaticCompoundShapeSettings compoundSettings;
-		for (const auto& shape : shapes)
-		{
-			compoundSettings.AddShape(JPH::Vec3::sZero(), JPH::Quat::sIdentity(), shape);
-		}
-		return compoundSettings.Create().Get();
+		return m_ShapeCache->GetCompoundShape(shapes);
 	}
 
 	bool PhysicsSystem::IsColliderTrigger(const Entity& entity) 
@@ -412,9 +620,16 @@ namespace Kerberos
 		//	rigidbody.RuntimeBody = nullptr;
 		//}
 
+		delete m_ShapeCache;
+		m_ShapeCache = nullptr;
+
 		delete m_ContactListener;
 		m_ContactListener = nullptr;
 
+		delete m_ContactEventQueue;
+		m_ContactEventQueue = nullptr;
+		m_ActiveContacts.clear();
+
 		delete m_BodyActivationListener;
 		m_BodyActivationListener = nullptr;
 
@@ -23,6 +23,14 @@ namespace JPH
 	class ObjectLayerPairFilter;
 
 	class Vec3;
+	class Quat;
+}
+
+namespace Kerberos::Physics
+{
+	class ShapeCache;
+	class ContactEventQueue;
+	class BodyActivationListener;
 }
 
 namespace Kerberos
@@ -44,6 +52,12 @@ namespace Kerberos
 		void Initialize(const Ref<Scene>& scene) override;
 		void Update(float deltaTime) override;
 
+		/// The capacities in the settings are only applied when the system is initialized
+		void SetSettings(const PhysicsSettings& settings) override;
+		const PhysicsSettings& GetSettings() const override { return m_Settings; }
+		const PhysicsStatistics& GetStatistics() const override { return m_Statistics; }
+		std::span<const ContactEvent> GetContactEvents() const override { return m_ContactEvents; }
+
 		void AddImpulse(uint32_t bodyId, const glm::vec3& impulse) const override;
 		void AddImpulse(uint32_t bodyId, const glm::vec3& impulse, const glm::vec3& point) const override;
 
@@ -52,18 +66,83 @@ namespace Kerberos
 
 		void Cleanup() override;
 	private:
-		void UpdateAndCreatePhysicsBodies();
-		void CreatePhysicsBody(const Entity& entity);
+		/**
+		 * @brief Creates the bodies of the entities that don't have one yet, and recreates the dirty ones
+		 *
+		 * The new bodies are added to the world in a single batch.
+		 *
+		 * @return The number of bodies added
+		 */
+		uint32_t UpdateAndCreatePhysicsBodies();
+
+		/**
+		 * @brief Creates the body of the entity, without adding it to the world
+		 *
+		 * @return The created body, or nullptr if the entity has no colliders or there is no room for more bodies
+		 */
+		JPH::Body* CreatePhysicsBody(const Entity& entity);
+
+		/**
+		 * @brief Updates the shape, transform and properties of the existing body of a dirty entity in place
+		 *
+		 * @return False if the body can't be updated in place and has to be recreated,
+		 * because it has to change between static and moving, or the entity has no colliders anymore
+		 */
+		bool UpdatePhysicsBody(const Entity& entity);
+
 		JPH::RefConst<JPH::Shape> CreateShapeForEntity(const Entity& entity);
 
-		void SyncTransforms() const;
+		/// Returns the position and rotation of the body of the entity, from its world transform and collider offset
+		void GetBodyTransform(const Entity& entity, JPH::Vec3& outPosition, JPH::Quat& outRotation) const;
+
+		/// Stores the current pose of the bodies, before the last fixed step of the frame is taken
+		void StorePreviousPoses() const;
+		/**
+		 * @brief Writes the pose of the active bodies into their transforms
+		 *
+		 * Static and sleeping bodies don't move, so they are skipped. The bodies that went to sleep
+		 * since the last sync are moved to their final pose once.
+		 *
+		 * @param alpha The factor to interpolate the rendered transform with, between the previous and current pose
+		 */
+		void SyncTransforms(float alpha);
+
+		/**
+		 * @brief Pops the contact events queued by the physics jobs during the last step,
+		 * and appends them to the contact events of the update, with the bodies resolved to entities
+		 */
+		void DrainContactEvents();
 
 		static bool IsColliderTrigger(const Entity& entity);
 
 	private:
 		std::weak_ptr<Scene> m_Scene;
 
-		std::unordered_map<UUID, JPH::Vec3> m_ColliderOffsets;
+		PhysicsSettings m_Settings;
+		PhysicsStatistics m_Statistics;
+		/// The simulation time not yet stepped, in seconds
+		float m_Accumulator = 0.0f;
+
+		/// The contact events of the current update, the capacity is kept between the updates
+		std::vector<ContactEvent> m_ContactEvents;
+
+		/// Two bodies touching. Jolt reports every pair of their sub shapes separately, the events are sent for the bodies
+		struct ActiveContact
+		{
+			/// Resolved when the contact starts, so the exit is still reported after a body is destroyed
+			UUID Entity1{ 0 };
+			UUID Entity2{ 0 };
+			bool IsTrigger = false;
+			/// The pair enters with its first sub shape contact and exits after its last one
+			uint32_t SubShapeContactCount = 0;
+			/// CollisionStay is reported once per step, not for every sub shape contact
+			uint64_t LastStayStep = 0;
+		};
+
+		/// The touching body pairs, keyed by their body ids
+		std::unordered_map<uint64_t, ActiveContact> m_ActiveContacts;
+		/// The fixed steps taken since the system was initialized
+		uint64_t m_StepIndex = 0;
 
 		JPH::PhysicsSystem* m_JoltSystem = nullptr;
 		JPH::TempAllocator* m_PhysicsTempAllocator = nullptr;
@@ -72,12 +151,13 @@ namespace Kerberos
 		JPH::BroadPhaseLayerInterface* m_BroadPhaseLayerInterface = nullptr;
 		JPH::ObjectLayerPairFilter* m_ObjectVsObjectLayerFilter = nullptr;
 		JPH::ContactListener* m_ContactListener = nullptr;
-		JPH::BodyActivationListener* m_BodyActivationListener = nullptr;
+		Physics::BodyActivationListener* m_BodyActivationListener = nullptr;
+		Physics::ContactEventQueue* m_ContactEventQueue = nullptr;
 
 		/**
 		 * Shape cache to avoid creating the same shape multiple times.
 		 */
-		std::unordered_map<size_t, JPH::RefConst<JPH::Shape>> shapeCache;
+		Physics::ShapeCache* m_ShapeCache = nullptr;
 	};
 
 }
\ No newline at end of file
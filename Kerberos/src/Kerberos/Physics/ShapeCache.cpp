@@ -0,0 +1,239 @@
+#include "kbrpch.h"
+#include "ShapeCache.h"
+
+#include "Utils.h"
+#include "Kerberos/Assets/AssetManager.h"
+#include "Kerberos/Core/Hash.h"
+#include "Kerberos/Project/Project.h"
+#include "Kerberos/Renderer/Mesh.h"
+
+#include <Jolt/Core/StreamWrapper.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+
+#include <fstream>
+
+namespace Kerberos::Physics
+{
+	/// Increment when the cooked shapes have to be rebuilt, for example after changing how mesh shapes are created
+	static constexpr uint32_t CookedShapeVersion = 1;
+	static constexpr std::array<char, 4> CookedShapeMagic = { 'K', 'S', 'H', 'P' };
+
+	struct CookedShapeHeader
+	{
+		std::array<char, 4> Magic;
+		uint32_t Version;
+		/// The hash of the mesh the shape was cooked from, the shape is rebuilt when the mesh changes
+		uint64_t MeshHash;
+	};
+
+	enum class ShapeKind : uint8_t
+	{
+		Box,
+		Sphere,
+		Capsule,
+		Mesh,
+		Compound,
+	};
+
+	/**
+	* Hashes the vertex positions and indices of the mesh, which are the only data the mesh shape is built from.
+	*/
+	static uint64_t HashMeshGeometry(const Mesh& mesh, uint64_t hash)
+	{
+		for (const Vertex& vertex : mesh.GetVertices())
+		{
+			hash = HashValue(vertex.Position, hash);
+		}
+
+		const std::vector<uint32_t>& indices = mesh.GetIndices();
+		return HashBytes(indices.data(), indices.size() * sizeof(uint32_t), hash);
+	}
+
+	static std::filesystem::path GetCookedShapeDirectory()
+	{
+		if (Project::GetActive())
+			return Project::GetAssetDirectory() / "cache" / "physics";
+
+		return "assets/cache/physics";
+	}
+
+	template<typename Fn>
+	JPH::RefConst<JPH::Shape> ShapeCache::GetOrCreate(const uint64_t key, Fn&& create)
+	{
+		if (const auto it = m_Shapes.find(key); it != m_Shapes.end())
+			return it->second;
+
+		JPH::RefConst<JPH::Shape> shape = create();
+		if (shape)
+			m_Shapes.emplace(key, shape);
+
+		return shape;
+	}
+
+	JPH::RefConst<JPH::Shape> ShapeCache::GetBoxShape(const glm::vec3& halfExtents)
+	{
+		const uint64_t key = HashValue(halfExtents, HashValue(ShapeKind::Box));
+		return GetOrCreate(key, [&halfExtents]
+			{
+				return JPH::RefConst<JPH::Shape>(new JPH::BoxShape(JPH::Vec3(halfExtents.x, halfExtents.y, halfExtents.z)));
+			});
+	}
+
+	JPH::RefConst<JPH::Shape> ShapeCache::GetSphereShape(const float radius)
+	{
+		const uint64_t key = HashValue(radius, HashValue(ShapeKind::Sphere));
+		return GetOrCreate(key, [radius]
+			{
+				return JPH::RefConst<JPH::Shape>(new JPH::SphereShape(radius));
+			});
+	}
+
+	JPH::RefConst<JPH::Shape> ShapeCache::GetCapsuleShape(const float halfHeight, const float radius)
+	{
+		const uint64_t key = HashValue(radius, HashValue(halfHeight, HashValue(ShapeKind::Capsule)));
+		return GetOrCreate(key, [halfHeight, radius]
+			{
+				return JPH::RefConst<JPH::Shape>(new JPH::CapsuleShape(halfHeight, radius));
+			});
+	}
+
+	/**
+	* Only meshes imported as assets keep their handle between runs.
+	* The others, like the default cube, get a new handle every time they are created, so cooking them would only fill the cache with files never loaded again.
+	*/
+	static bool IsMeshCookable(const Mesh& mesh)
+	{
+		return Project::GetActive() && AssetManager::IsAssetHandleValid(mesh.GetHandle());
+	}
+
+	JPH::RefConst<JPH::Shape> ShapeCache::GetMeshShape(const Ref<Mesh>& mesh, const std::string_view debugName)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (!IsMeshCookable(*mesh))
+		{
+			/// Shared by the geometry instead, so the copies of a runtime mesh still use one shape
+			const uint64_t key = HashMeshGeometry(*mesh, HashValue(ShapeKind::Mesh));
+			return GetOrCreate(key, [&mesh, debugName]
+				{
+					return Utils::CreateJoltMeshShape(mesh, debugName);
+				});
+		}
+
+		const uint64_t key = HashValue(static_cast<uint64_t>(mesh->GetHandle()), HashValue(ShapeKind::Mesh));
+		return GetOrCreate(key, [&mesh, debugName]() -> JPH::RefConst<JPH::Shape>
+			{
+				const std::filesystem::path cookedPath = GetCookedShapePath(mesh);
+				const uint64_t meshHash = HashMeshGeometry(*mesh, HashValue(CookedShapeVersion));
+
+				if (JPH::RefConst<JPH::Shape> shape = LoadCookedShape(cookedPath, meshHash))
+				{
+					KBR_CORE_TRACE("Loaded cooked mesh shape of {0} from {1}", debugName, cookedPath.string());
+					return shape;
+				}
+
+				JPH::RefConst<JPH::Shape> shape = Utils::CreateJoltMeshShape(mesh, debugName);
+				if (shape)
+					WriteCookedShape(cookedPath, meshHash, *shape);
+
+				return shape;
+			});
+	}
+
+	JPH::RefConst<JPH::Shape> ShapeCache::GetCompoundShape(const std::vector<JPH::RefConst<JPH::Shape>>& shapes)
+	{
+		/// The children are shared too, so their addresses identify the compound shape
+		uint64_t key = HashValue(ShapeKind::Compound);
+		for (const auto& shape : shapes)
+		{
+			key = HashValue(shape.GetPtr(), key);
+		}
+
+		return GetOrCreate(key, [&shapes]() -> JPH::RefConst<JPH::Shape>
+			{
+				JPH::StaticCompoundShapeSettings compoundSettings;
+				for (const auto& shape : shapes)
+				{
+					compoundSettings.AddShape(JPH::Vec3::sZero(), JPH::Quat::sIdentity(), shape);
+				}
+
+				const JPH::ShapeSettings::ShapeResult result = compoundSettings.Create();
+				if (result.HasError())
+				{
+					KBR_CORE_ERROR("Jolt: compound shape error: {}", result.GetError().c_str());
+					return nullptr;
+				}
+
+				return result.Get();
+			});
+	}
+
+	std::filesystem::path ShapeCache::GetCookedShapePath(const Ref<Mesh>& mesh)
+	{
+		return GetCookedShapeDirectory() / std::format("{:016x}.kbrshape", static_cast<uint64_t>(mesh->GetHandle()));
+	}
+
+	JPH::RefConst<JPH::Shape> ShapeCache::LoadCookedShape(const std::filesystem::path& cookedPath, const uint64_t meshHash)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		std::ifstream in(cookedPath, std::ios::binary);
+		if (!in)
+			return nullptr;
+
+		CookedShapeHeader header{};
+		in.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!in || header.Magic != CookedShapeMagic || header.Version != CookedShapeVersion || header.MeshHash != meshHash)
+			return nullptr;
+
+		JPH::StreamInWrapper stream(in);
+		JPH::Shape::IDToShapeMap shapeMap;
+		JPH::Shape::IDToMaterialMap materialMap;
+		const JPH::Shape::ShapeResult result = JPH::Shape::sRestoreWithChildren(stream, shapeMap, materialMap);
+		if (result.HasError())
+		{
+			KBR_CORE_WARN("Failed to restore the cooked shape {0}: {1}", cookedPath.string(), result.GetError().c_str());
+			return nullptr;
+		}
+
+		return result.Get();
+	}
+
+	void ShapeCache::WriteCookedShape(const std::filesystem::path& cookedPath, const uint64_t meshHash, const JPH::Shape& shape)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		std::error_code error;
+		std::filesystem::create_directories(cookedPath.parent_path(), error);
+		if (error)
+		{
+			KBR_CORE_WARN("Failed to create the shape cache directory {0}: {1}", cookedPath.parent_path().string(), error.message());
+			return;
+		}
+
+		std::ofstream out(cookedPath, std::ios::binary);
+		if (!out)
+		{
+			KBR_CORE_WARN("Failed to open {0} for writing the cooked shape", cookedPath.string());
+			return;
+		}
+
+		const CookedShapeHeader header{ .Magic = CookedShapeMagic, .Version = CookedShapeVersion, .MeshHash = meshHash };
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		JPH::StreamOutWrapper stream(out);
+		JPH::Shape::ShapeToIDMap shapeMap;
+		JPH::Shape::MaterialToIDMap materialMap;
+		shape.SaveWithChildren(stream, shapeMap, materialMap);
+
+		if (stream.IsFailed())
+		{
+			KBR_CORE_WARN("Failed to write the cooked shape {0}", cookedPath.string());
+			out.close();
+			std::filesystem::remove(cookedPath, error);
+		}
+	}
+}
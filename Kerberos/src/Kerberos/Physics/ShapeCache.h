@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Kerberos/Core.h"
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/Reference.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+
+namespace Kerberos { class Mesh; }
+
+namespace Kerberos::Physics
+{
+	/**
+	* Shares the collision shapes between the bodies.
+	* Primitive shapes are shared by their parameters, mesh shapes by their mesh asset,
+	* or by their geometry if the mesh is not an asset, and compound shapes by their children.
+	*
+	* The shapes of mesh assets are cooked once, and saved to the asset cache with the binary serialization of Jolt,
+	* so later runs load them instead of building them again.
+	*/
+	class ShapeCache
+	{
+	public:
+		JPH::RefConst<JPH::Shape> GetBoxShape(const glm::vec3& halfExtents);
+		JPH::RefConst<JPH::Shape> GetSphereShape(float radius);
+		JPH::RefConst<JPH::Shape> GetCapsuleShape(float halfHeight, float radius);
+		JPH::RefConst<JPH::Shape> GetMeshShape(const Ref<Mesh>& mesh, std::string_view debugName);
+		JPH::RefConst<JPH::Shape> GetCompoundShape(const std::vector<JPH::RefConst<JPH::Shape>>& shapes);
+
+		/// Releases the shapes, the bodies using them keep their own references
+		void Clear() { m_Shapes.clear(); }
+
+		size_t GetShapeCount() const { return m_Shapes.size(); }
+
+		static std::filesystem::path GetCookedShapePath(const Ref<Mesh>& mesh);
+
+	private:
+		template<typename Fn>
+		JPH::RefConst<JPH::Shape> GetOrCreate(uint64_t key, Fn&& create);
+
+		static JPH::RefConst<JPH::Shape> LoadCookedShape(const std::filesystem::path& cookedPath, uint64_t meshHash);
+		static void WriteCookedShape(const std::filesystem::path& cookedPath, uint64_t meshHash, const JPH::Shape& shape);
+
+	private:
+		std::unordered_map<uint64_t, JPH::RefConst<JPH::Shape>> m_Shapes;
+	};
+}
@@ -74,43 +74,47 @@ namespace Kerberos::Physics
         /**
 		 * Applies the Jolt physics transform to the entity's world transform, and takes the offset of
 		 * the collider into account.
-		 * @param worldTransform The world transform of the entity to update.
-		 * @param body The Jolt body to get the position and rotation from.
-		 * @param offset The offset of the collider in the entity's local space.
+		 * The translation and rotation of the entity are set to the simulated pose, while the world transform,
+		 * which is used for rendering, is interpolated between the previous and the simulated pose.
+		 * The world transform is built from the cached world scale of the rigid body, without decomposing it.
 		 * @param tc The TransformComponent of the entity to update.
+		 * @param body The Jolt body to get the position and rotation from.
+		 * @param rb The RigidBody3DComponent of the entity, with the collider offset, the scale and the previous pose.
+		 * @param alpha The interpolation factor, 0 is the previous pose and 1 is the simulated pose.
          */
-        static void ApplyJoltTransformToEntity(glm::mat4& worldTransform, const JPH::Body& body, const JPH::Vec3& offset, TransformComponent& tc)
+        static void ApplyJoltTransformToEntity(TransformComponent& tc, const JPH::Body& body, const RigidBody3DComponent& rb, const float alpha)
         {
-            KBR_PROFILE_FUNCTION();
-
-            /// TODO: Update the transform, rotation and scale of the entity, not its world transform
-
-            const JPH::RVec3 joltPosition = body.GetPosition();
-            const JPH::Quat joltRotation = body.GetRotation();
+            const auto [position, rotation] = GetEntityPose(body, rb.ColliderOffset);
 
-            glm::vec3 position = ToGlmVec3(joltPosition);
-            glm::quat rotation = ToGlmQuat(joltRotation);
+            const glm::vec3 renderPosition = glm::mix(rb.PreviousPosition, position, alpha);
+            const glm::quat renderRotation = alpha < 1.0f ? glm::slerp(rb.PreviousRotation, rotation, alpha) : rotation;
 
-			/// Subtract the offset from the position to get the correct world position
-			position -= ToGlmVec3(offset);
+            /// Translation * rotation * scale, written column by column
+            const glm::mat3 rotationMatrix = glm::mat3_cast(renderRotation);
+            tc.WorldTransform[0] = glm::vec4(rotationMatrix[0] * rb.WorldScale.x, 0.0f);
+            tc.WorldTransform[1] = glm::vec4(rotationMatrix[1] * rb.WorldScale.y, 0.0f);
+            tc.WorldTransform[2] = glm::vec4(rotationMatrix[2] * rb.WorldScale.z, 0.0f);
+            tc.WorldTransform[3] = glm::vec4(renderPosition, 1.0f);
 
-            /// Decompose the current transform to get the scale
-            glm::vec3 scale, skew;
-            glm::vec4 perspective;
-            glm::quat oldRotation;
-            glm::vec3 oldPosition;
-
-            glm::decompose(worldTransform, scale, oldRotation, oldPosition, skew, perspective);
-
-            /// Rebuild world transform using physics position & rotation but keep original scale
-            glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), position);
-            glm::mat4 rotationMatrix = glm::toMat4(rotation);
-            glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), scale);
-
-            worldTransform = translationMatrix * rotationMatrix * scaleMatrix;
 			tc.Translation = position;
 			tc.Rotation = glm::eulerAngles(rotation);
-			tc.Scale = scale;
+			tc.Scale = rb.WorldScale;
+			++tc.WorldTransformVersion;
+        }
+
+        /**
+		 * Returns the position and rotation of the entity the body belongs to,
+		 * which is the pose of the body without the offset of the collider.
+         */
+        static std::pair<glm::vec3, glm::quat> GetEntityPose(const JPH::Body& body, const glm::vec3& offset)
+        {
+            return { ToGlmVec3(body.GetPosition()) - offset, ToGlmQuat(body.GetRotation()) };
+        }
+
+        /// Returns the scale of the transform, from the length of its basis vectors
+        static glm::vec3 GetScale(const glm::mat4& transform)
+        {
+            return { glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2])) };
         }
 
         static JPH::Ref<JPH::Shape> CreateJoltMeshShape(const Ref<Mesh>& mesh, const std::string_view debugName)
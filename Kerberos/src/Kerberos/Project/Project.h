@@ -4,6 +4,7 @@
 #include "Kerberos/Assets/AssetManagerBase.h"
 #include "Kerberos/Assets/EditorAssetManager.h"
 #include "Kerberos/Assets/RuntimeAssetManager.h"
+#include "Kerberos/Physics/IPhysicsSystem.h"
 
 #include <filesystem>
 
@@ -15,6 +16,9 @@ namespace Kerberos
 		std::filesystem::path AssetDirectory = "Assets";
 
 		std::filesystem::path StartScenePath;
+
+		/// The settings the physics of every scene in the project is initialized with
+		PhysicsSettings Physics;
 	};
 
 	class Project
@@ -23,6 +23,20 @@ namespace Kerberos
 			out << YAML::Key << "Name" << YAML::Value << info.Name;
 			out << YAML::Key << "AssetDirectory" << YAML::Value << info.AssetDirectory.string();
 			out << YAML::Key << "StartScenePath" << YAML::Value << info.StartScenePath.string();
+
+			out << YAML::Key << "Physics" << YAML::Value;
+			out << YAML::BeginMap;
+			out << YAML::Key << "MaxBodies" << YAML::Value << info.Physics.MaxBodies;
+			out << YAML::Key << "NumBodyMutexes" << YAML::Value << info.Physics.NumBodyMutexes;
+			out << YAML::Key << "MaxBodyPairs" << YAML::Value << info.Physics.MaxBodyPairs;
+			out << YAML::Key << "MaxContactConstraints" << YAML::Value << info.Physics.MaxContactConstraints;
+			out << YAML::Key << "MaxContactEvents" << YAML::Value << info.Physics.MaxContactEvents;
+			out << YAML::Key << "FixedUpdateRate" << YAML::Value << info.Physics.FixedUpdateRate;
+			out << YAML::Key << "MaxStepsPerFrame" << YAML::Value << info.Physics.MaxStepsPerFrame;
+			out << YAML::Key << "CollisionSteps" << YAML::Value << info.Physics.CollisionSteps;
+			out << YAML::Key << "Interpolate" << YAML::Value << info.Physics.Interpolate;
+			out << YAML::EndMap;
+
 			out << YAML::EndMap;
 		}
 		out << YAML::EndMap;
@@ -65,6 +79,21 @@ namespace Kerberos
 		info.AssetDirectory = projectNode["AssetDirectory"].as<std::string>();
 		info.StartScenePath = projectNode["StartScenePath"].as<std::string>();
 
+		/// Older projects don't have physics settings, they keep the defaults
+		if (const auto physicsNode = projectNode["Physics"])
+		{
+			PhysicsSettings& physics = info.Physics;
+			physics.MaxBodies = physicsNode["MaxBodies"].as<uint32_t>(physics.MaxBodies);
+			physics.NumBodyMutexes = physicsNode["NumBodyMutexes"].as<uint32_t>(physics.NumBodyMutexes);
+			physics.MaxBodyPairs = physicsNode["MaxBodyPairs"].as<uint32_t>(physics.MaxBodyPairs);
+			physics.MaxContactConstraints = physicsNode["MaxContactConstraints"].as<uint32_t>(physics.MaxContactConstraints);
+			physics.MaxContactEvents = physicsNode["MaxContactEvents"].as<uint32_t>(physics.MaxContactEvents);
+			physics.FixedUpdateRate = physicsNode["FixedUpdateRate"].as<float>(physics.FixedUpdateRate);
+			physics.MaxStepsPerFrame = physicsNode["MaxStepsPerFrame"].as<uint32_t>(physics.MaxStepsPerFrame);
+			physics.CollisionSteps = physicsNode["CollisionSteps"].as<int>(physics.CollisionSteps);
+			physics.Interpolate = physicsNode["Interpolate"].as<bool>(physics.Interpolate);
+		}
+
 		return true;
 	}
 }
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <limits>
+
+namespace Kerberos
+{
+	/**
+	* Axis-aligned bounding box. A default constructed box is empty (invalid),
+	* and can be grown by merging points or other boxes into it.
+	*/
+	struct AABB
+	{
+		glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+		AABB() = default;
+		AABB(const glm::vec3& min, const glm::vec3& max)
+			: Min(min), Max(max)
+		{}
+
+		bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+
+		glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+		glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		float GetSurfaceArea() const
+		{
+			const glm::vec3 size = Max - Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		void Merge(const glm::vec3& point)
+		{
+			Min = glm::min(Min, point);
+			Max = glm::max(Max, point);
+		}
+
+		static AABB Merge(const AABB& a, const AABB& b)
+		{
+			return { glm::min(a.Min, b.Min), glm::max(a.Max, b.Max) };
+		}
+
+		bool Contains(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Min)) && glm::all(glm::greaterThanEqual(Max, other.Max));
+		}
+
+		AABB Expanded(const float margin) const
+		{
+			return { Min - glm::vec3(margin), Max + glm::vec3(margin) };
+		}
+
+		/**
+		* Returns the bounds of this box after transforming it by the matrix.
+		* Uses the absolute value of the rotation part, so only the center and extents are transformed,
+		* instead of all eight corners.
+		*/
+		AABB Transform(const glm::mat4& transform) const
+		{
+			const glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+			const glm::mat3 absolute = glm::mat3(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])), glm::abs(glm::vec3(transform[2])));
+			const glm::vec3 extents = absolute * GetExtents();
+
+			return { center - extents, center + extents };
+		}
+	};
+
+	/**
+	* The six planes of a view frustum, with the normals pointing inwards.
+	*/
+	struct Frustum
+	{
+		enum class Containment : uint8_t
+		{
+			Outside,
+			Intersects,
+			Inside,
+		};
+
+		/// Left, right, bottom, top, near, far
+		std::array<glm::vec4, 6> Planes;
+
+		/**
+		* Extracts the planes from a view-projection matrix (Gribb-Hartmann).
+		* The near plane is extracted for a [-1, 1] depth range, which is also conservative for [0, 1].
+		*/
+		static Frustum FromViewProjection(const glm::mat4& viewProjection)
+		{
+			const glm::mat4 m = glm::transpose(viewProjection);
+
+			Frustum frustum;
+			frustum.Planes[0] = m[3] + m[0];
+			frustum.Planes[1] = m[3] - m[0];
+			frustum.Planes[2] = m[3] + m[1];
+			frustum.Planes[3] = m[3] - m[1];
+			frustum.Planes[4] = m[3] + m[2];
+			frustum.Planes[5] = m[3] - m[2];
+
+			for (auto& plane : frustum.Planes)
+			{
+				plane /= glm::length(glm::vec3(plane));
+			}
+
+			return frustum;
+		}
+
+		Containment Classify(const AABB& bounds) const
+		{
+			const glm::vec3 center = bounds.GetCenter();
+			const glm::vec3 extents = bounds.GetExtents();
+
+			Containment result = Containment::Inside;
+			for (const auto& plane : Planes)
+			{
+				const glm::vec3 normal = glm::vec3(plane);
+				const float distance = glm::dot(normal, center) + plane.w;
+				const float radius = glm::dot(extents, glm::abs(normal));
+
+				if (distance + radius < 0.0f)
+					return Containment::Outside;
+
+				if (distance - radius < 0.0f)
+					result = Containment::Intersects;
+			}
+
+			return result;
+		}
+
+		bool Intersects(const AABB& bounds) const
+		{
+			return Classify(bounds) != Containment::Outside;
+		}
+	};
+}
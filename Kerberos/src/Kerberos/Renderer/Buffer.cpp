@@ -3,6 +3,7 @@
 #include "RendererAPI.h"
 #include "Kerberos/Core.h"
 #include "Platform/D3D11/D3D11Buffer.h"
+#include "Platform/Null/NullBuffer.h"
 #include "Platform/OpenGL/OpenGLBuffer.h"
 #include "Platform/Vulkan/VulkanBuffer.h"
 
@@ -24,6 +25,9 @@ namespace Kerberos
 
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanVertexBuffer>(vertices, size);
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullVertexBuffer>(vertices, size);
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -46,6 +50,34 @@ namespace Kerberos
 
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanVertexBuffer>(size);
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullVertexBuffer>(size);
+		}
+
+		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<VertexBuffer> VertexBuffer::CreateMapped(uint32_t size)
+	{
+		switch (RendererAPI::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLVertexBuffer>(size, true);
+
+		case RendererAPI::API::D3D11:
+			return CreateRef<D3D11VertexBuffer>(size);
+
+		case RendererAPI::API::D3D12:
+			KBR_CORE_ASSERT(false, "D3D12 is currently not supported!");
+			return nullptr;
+
+		case RendererAPI::API::Vulkan:
+			return CreateRef<VulkanVertexBuffer>(size);
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullVertexBuffer>(size, true);
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -68,6 +100,9 @@ namespace Kerberos
 
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanIndexBuffer>(indices, count);
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullIndexBuffer>(indices, count);
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
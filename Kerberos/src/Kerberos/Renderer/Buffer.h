@@ -31,6 +31,14 @@ namespace Kerberos
 		return 0;
 	}
 
+	/// How often the attributes of a vertex buffer advance
+	enum class VertexInputRate : uint8_t
+	{
+		Vertex = 0,
+		/// The attributes advance once per instance, for instanced drawing
+		Instance = 1,
+	};
+
 	struct BufferElement
 	{
 		std::string Name;
@@ -73,14 +81,15 @@ namespace Kerberos
 	public:
 		BufferLayout() = default;
 
-		BufferLayout(const std::initializer_list<BufferElement>& elements)
-			: m_Elements(elements), m_Stride(0)
+		BufferLayout(const std::initializer_list<BufferElement>& elements, const VertexInputRate inputRate = VertexInputRate::Vertex)
+			: m_Elements(elements), m_Stride(0), m_InputRate(inputRate)
 		{
 			CalculateOffsetsAndStride();
 		}
 
 		const std::vector<BufferElement>& GetElements() const { return m_Elements; }
 		uint32_t GetStride() const { return m_Stride; }
+		VertexInputRate GetInputRate() const { return m_InputRate; }
 
 		std::vector<BufferElement>::iterator begin() { return m_Elements.begin(); }
 		std::vector<BufferElement>::iterator end() { return m_Elements.end(); }
@@ -102,6 +111,7 @@ namespace Kerberos
 	private:
 		std::vector<BufferElement> m_Elements;
 		uint32_t m_Stride;
+		VertexInputRate m_InputRate = VertexInputRate::Vertex;
 	};
 
 	class VertexBuffer
@@ -114,6 +124,11 @@ namespace Kerberos
 
 		virtual void SetData(const void* data, uint32_t size) = 0;
 
+		/// The memory of a buffer created with CreateMapped, or nullptr if the backend can't keep buffers mapped
+		virtual void* GetMappedData() const { return nullptr; }
+		/// Makes the range written through GetMappedData visible to the draws submitted after this
+		virtual void FlushMappedData(uint32_t offset, uint32_t size) {}
+
 		virtual void SetLayout(const BufferLayout& layout) = 0;
 		virtual const BufferLayout& GetLayout() const = 0;
 		virtual uint32_t GetCount() const = 0;
@@ -128,6 +143,12 @@ namespace Kerberos
 
 		static Ref<VertexBuffer> Create(const float* vertices, uint32_t size);
 		static Ref<VertexBuffer> Create(uint32_t size);
+		/**
+		* @brief Creates a buffer which stays mapped for its whole lifetime, so the vertices can be written straight into it.
+		* The caller has to make sure the GPU is not reading the range anymore before writing it, see Fence.
+		* If the backend doesn't support it, a regular dynamic buffer is created and GetMappedData returns nullptr.
+		*/
+		static Ref<VertexBuffer> CreateMapped(uint32_t size);
 	};
 
 	class IndexBuffer
@@ -0,0 +1,36 @@
+#include "kbrpch.h"
+#include "Fence.h"
+
+#include "Renderer.h"
+#include "Platform/Null/NullFence.h"
+#include "Platform/OpenGL/OpenGLFence.h"
+
+namespace Kerberos
+{
+	Ref<Fence> Fence::Create()
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLFence>();
+
+		case RendererAPI::API::D3D11:
+			KBR_CORE_ASSERT(false, "Fence is not yet implemented for D3D11!");
+			return nullptr;
+
+		case RendererAPI::API::D3D12:
+			KBR_CORE_ASSERT(false, "D3D12 is currently not supported!");
+			return nullptr;
+
+		case RendererAPI::API::Vulkan:
+			KBR_CORE_ASSERT(false, "Fence is not yet implemented for Vulkan!");
+			return nullptr;
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullFence>();
+		}
+
+		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Kerberos/Core.h"
+
+namespace Kerberos
+{
+	/**
+	* Marks a point in the submitted render commands, and tells when the GPU has passed it.
+	* Used to find out when the GPU has finished reading a resource, so the CPU can write it again without the driver synchronizing implicitly.
+	*/
+	class Fence
+	{
+	public:
+		virtual ~Fence() = default;
+
+		/// Inserts the fence after the commands submitted so far
+		virtual void Signal() = 0;
+
+		/**
+		* @brief Checks whether the GPU has finished the commands submitted before the last Signal, without blocking.
+		* A fence that was never signaled counts as signaled.
+		*/
+		virtual bool IsSignaled() = 0;
+
+		/// Blocks until the GPU has finished the commands submitted before the last Signal
+		virtual void Wait() = 0;
+
+		static Ref<Fence> Create();
+	};
+}
@@ -2,7 +2,11 @@
 #include "Font.h"
 
 #include "Kerberos/Renderer/Texture.h"
+#include "Kerberos/Core/BinaryStream.h"
+#include "Kerberos/Core/Filesystem.h"
+#include "Kerberos/Core/Hash.h"
 #include "Kerberos/Core/Timer.h"
+#include "Kerberos/Internal/JobSystem.h"
 
 #undef INFINITE
 #include <msdfgen.h>
@@ -12,62 +16,262 @@
 #include <msdf-atlas-gen/msdf-atlas-gen/GlyphGeometry.h>
 
 #include <algorithm>
+#include <format>
+#include <fstream>
 
 namespace Kerberos
 {
+	struct GlyphData
+	{
+		/// Left, bottom, right, top
+		std::array<double, 4> AtlasBounds;
+		std::array<double, 4> PlaneBounds;
+		double Advance = 0.0;
+	};
+
+	/**
+	* The glyph data baked out of the msdf-atlas-gen geometry, so it can be written to
+	* and loaded from the atlas cache without loading the font with FreeType.
+	*/
 	struct MSDFData
 	{
-		std::vector<msdf_atlas::GlyphGeometry> Glyphs;
-		msdf_atlas::FontGeometry FontGeometry;
+		std::unordered_map<uint32_t, GlyphData> Glyphs;
+		/// The kerning between two codepoints, keyed by (first << 32 | second)
+		std::unordered_map<uint64_t, double> Kerning;
+		FontMetrics Metrics;
 	};
 
-	template<typename T, typename S, int N, msdf_atlas::GeneratorFunction<S, N> GenFunc>
-	static Ref<Texture2D> GenerateAtlas(const std::vector<msdf_atlas::GlyphGeometry>& glyphs, int width, int height)
+	/// Settings of the atlas generation. The cache key contains all of them, so changing one regenerates the atlases.
+	namespace AtlasSettings
 	{
-		msdf_atlas::ImmediateAtlasGenerator<S, N, GenFunc, msdf_atlas::BitmapAtlasStorage<T, N>> generator(width, height);
+		struct CharsetRange
+		{
+			uint32_t Start;
+			uint32_t End;
+		};
 
-		msdf_atlas::GeneratorAttributes genAttributes;
-		genAttributes.config.overlapSupport = true;
-		genAttributes.scanlinePass = true;
-		generator.setAttributes(genAttributes);
-		generator.setThreadCount(std::max(1u, std::thread::hardware_concurrency() - 1));
+		static constexpr CharsetRange CharsetRanges[] = {
+			{.Start = 0x0020, .End = 0x007E }, // Basic Latin
+			{.Start = 0x00A0, .End = 0x00FF }, // Latin-1 Supplement
+		};
 
-		generator.generate(glyphs.data(), static_cast<int>(glyphs.size()));
+		static constexpr double FontScale = 1.0;
+		static constexpr double PixelRange = 2.0;
+		static constexpr double MiterLimit = 1.0;
+		static constexpr int Spacing = 1;
+		static constexpr double EmSize = 40.0;
+		static constexpr double MaxCornerAngle = 3.0;
+		static constexpr bool ExpensiveEdgeColoring = true;
+		static constexpr uint64_t ColoringSeed = 0x12345678abcdef00ull;
+	}
 
-		msdfgen::BitmapConstRef<T, N> bitmap = generator.atlasStorage();
+	/// Increment when the layout of the cache file changes
+	static constexpr uint32_t FontAtlasCacheVersion = 1;
+	static constexpr std::array<char, 4> FontAtlasCacheMagic = { 'K', 'F', 'N', 'T' };
 
-		TextureSpecification spec;
-		spec.Width = bitmap.width;
-		spec.Height = bitmap.height;
-		spec.Format = ImageFormat::RGB8;
-		spec.GenerateMips = false;
+	/// The key of a font's atlas cache, a hash of the font file, the charset and the generator settings
+	static uint64_t CreateAtlasCacheKey(const std::filesystem::path& filepath)
+	{
+		uint32_t fileSize = 0;
+		const char* fileData = Filesystem::ReadBytes(filepath, &fileSize);
+		if (!fileData)
+			return 0;
+
+		uint64_t key = HashBytes(fileData, fileSize);
+		delete[] fileData;
+
+		key = HashBytes(AtlasSettings::CharsetRanges, sizeof(AtlasSettings::CharsetRanges), key);
+		key = HashValue(AtlasSettings::FontScale, key);
+		key = HashValue(AtlasSettings::PixelRange, key);
+		key = HashValue(AtlasSettings::MiterLimit, key);
+		key = HashValue(AtlasSettings::Spacing, key);
+		key = HashValue(AtlasSettings::EmSize, key);
+		key = HashValue(AtlasSettings::MaxCornerAngle, key);
+		key = HashValue(AtlasSettings::ExpensiveEdgeColoring, key);
+		key = HashValue(AtlasSettings::ColoringSeed, key);
+		key = HashValue(FontAtlasCacheVersion, key);
+
+		return key;
+	}
 
-		const Ref<Texture2D> atlasTexture = Texture2D::Create(spec);
-		atlasTexture->SetData(static_cast<void*>(const_cast<T*>(bitmap.pixels)), bitmap.width * bitmap.height * sizeof(T) * N);
+	static const char* GetAtlasCacheDirectory()
+	{
+		return "assets/cache/font";
+	}
 
-		return atlasTexture;
+	struct AtlasBitmap
+	{
+		int Width = 0;
+		int Height = 0;
+		/// RGB8 pixels
+		std::vector<uint8_t> Pixels;
+	};
+
+	static bool WriteAtlasCache(const std::filesystem::path& cachePath, const uint64_t key, const MSDFData& data, const AtlasBitmap& bitmap)
+	{
+		std::filesystem::create_directories(cachePath.parent_path());
+
+		std::ofstream out(cachePath, std::ios::binary);
+		if (!out)
+			return false;
+
+		WritePod(out, FontAtlasCacheMagic);
+		WritePod(out, FontAtlasCacheVersion);
+		WritePod(out, key);
+		WritePod(out, data.Metrics);
+
+		WritePod(out, static_cast<uint32_t>(data.Glyphs.size()));
+		for (const auto& [codepoint, glyph] : data.Glyphs)
+		{
+			WritePod(out, codepoint);
+			WritePod(out, glyph);
+		}
+
+		WritePod(out, static_cast<uint32_t>(data.Kerning.size()));
+		for (const auto& [pair, kerning] : data.Kerning)
+		{
+			WritePod(out, pair);
+			WritePod(out, kerning);
+		}
+
+		WritePod(out, bitmap.Width);
+		WritePod(out, bitmap.Height);
+		out.write(reinterpret_cast<const char*>(bitmap.Pixels.data()), static_cast<std::streamsize>(bitmap.Pixels.size()));
+
+		return static_cast<bool>(out);
 	}
 
-	Font::Font(std::string name, const std::filesystem::path& filepath)
-		: m_Name(std::move(name)), m_Filepath(filepath), m_MSDFData(new MSDFData)
+	/// Upper limits for the values read from a cache file, a file exceeding them is treated as a cache miss
+	static constexpr uint32_t MaxCachedGlyphs = 0x110000;
+	static constexpr int MaxCachedAtlasSize = 16384;
+
+	/// The bytes left to read, so the counts in a truncated or corrupt file can't make us allocate more than the file holds
+	static uint64_t GetRemainingSize(std::ifstream& in, const uint64_t fileSize)
 	{
-		KBR_PROFILE_FUNCTION();
+		const std::streamoff position = in.tellg();
+		if (position < 0 || static_cast<uint64_t>(position) > fileSize)
+			return 0;
 
-		Timer timer("Font::Font", [&](const TimerData& data) {
-			KBR_CORE_INFO("Timer: Loading font {0} from {1} took {2}ms", m_Name, filepath.string(), data.DurationMs);
-			});
+		return fileSize - static_cast<uint64_t>(position);
+	}
 
-		if (!std::filesystem::exists(filepath))
+	static bool ReadAtlasCache(const std::filesystem::path& cachePath, const uint64_t key, MSDFData& data, AtlasBitmap& bitmap)
+	{
+		std::ifstream in(cachePath, std::ios::binary | std::ios::ate);
+		if (!in)
+			return false;
+
+		const uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+		in.seekg(0, std::ios::beg);
+
+		std::array<char, 4> magic{};
+		uint32_t version = 0;
+		uint64_t cachedKey = 0;
+		ReadPod(in, magic);
+		ReadPod(in, version);
+		ReadPod(in, cachedKey);
+		if (!in || magic != FontAtlasCacheMagic || version != FontAtlasCacheVersion || cachedKey != key)
+			return false;
+
+		ReadPod(in, data.Metrics);
+
+		uint32_t glyphCount = 0;
+		ReadPod(in, glyphCount);
+		if (!in || glyphCount > MaxCachedGlyphs || glyphCount * static_cast<uint64_t>(sizeof(uint32_t) + sizeof(GlyphData)) > GetRemainingSize(in, fileSize))
+			return false;
+
+		data.Glyphs.reserve(glyphCount);
+		for (uint32_t i = 0; i < glyphCount && in; ++i)
 		{
-			KBR_CORE_ASSERT(false, "Font file does not exist: {0}", filepath.string());
-			return;
+			uint32_t codepoint = 0;
+			GlyphData glyph;
+			ReadPod(in, codepoint);
+			ReadPod(in, glyph);
+			data.Glyphs.emplace(codepoint, glyph);
 		}
 
+		uint32_t kerningCount = 0;
+		ReadPod(in, kerningCount);
+		if (!in || kerningCount * static_cast<uint64_t>(sizeof(uint64_t) + sizeof(double)) > GetRemainingSize(in, fileSize))
+			return false;
+
+		data.Kerning.reserve(kerningCount);
+		for (uint32_t i = 0; i < kerningCount && in; ++i)
+		{
+			uint64_t pair = 0;
+			double kerning = 0.0;
+			ReadPod(in, pair);
+			ReadPod(in, kerning);
+			data.Kerning.emplace(pair, kerning);
+		}
+
+		ReadPod(in, bitmap.Width);
+		ReadPod(in, bitmap.Height);
+		if (!in || bitmap.Width <= 0 || bitmap.Height <= 0 || bitmap.Width > MaxCachedAtlasSize || bitmap.Height > MaxCachedAtlasSize)
+			return false;
+
+		const uint64_t pixelsSize = static_cast<uint64_t>(bitmap.Width) * bitmap.Height * 3;
+		if (pixelsSize > GetRemainingSize(in, fileSize))
+			return false;
+
+		bitmap.Pixels.resize(pixelsSize);
+		in.read(reinterpret_cast<char*>(bitmap.Pixels.data()), static_cast<std::streamsize>(bitmap.Pixels.size()));
+
+		return static_cast<bool>(in);
+	}
+
+	/// The glyphs are generated on the job system in chunks of this many glyphs
+	static constexpr uint32_t GlyphGrainSize = 8;
+
+	/**
+	* Generates the glyphs on the engine job system, instead of the worker threads of msdf-atlas-gen.
+	* Every glyph is generated into a scratch bitmap of its chunk, then copied into its own box of the atlas,
+	* so the chunks never write to the same pixels.
+	*/
+	template<typename T, typename S, int N, msdf_atlas::GeneratorFunction<S, N> GenFunc>
+	static std::vector<T> GenerateAtlas(const std::vector<msdf_atlas::GlyphGeometry>& glyphs, int width, int height)
+	{
+		msdf_atlas::BitmapAtlasStorage<T, N> storage(width, height);
+
+		msdf_atlas::GeneratorAttributes genAttributes;
+		genAttributes.config.overlapSupport = true;
+		genAttributes.scanlinePass = true;
+
+		JobSystem::ParallelFor(static_cast<uint32_t>(glyphs.size()), GlyphGrainSize, [&](const uint32_t begin, const uint32_t end)
+			{
+				std::vector<S> glyphBuffer;
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					const msdf_atlas::GlyphGeometry& glyph = glyphs[i];
+					if (glyph.isWhitespace())
+						continue;
+
+					int x, y, w, h;
+					glyph.getBoxRect(x, y, w, h);
+
+					glyphBuffer.resize(static_cast<size_t>(N) * w * h);
+					const msdfgen::BitmapRef<S, N> glyphBitmap(glyphBuffer.data(), w, h);
+					GenFunc(glyphBitmap, glyph, genAttributes);
+
+					storage.put(x, y, msdfgen::BitmapConstRef<S, N>(glyphBitmap));
+				}
+			});
+
+		const msdfgen::BitmapConstRef<T, N> bitmap = storage;
+
+		return std::vector<T>(bitmap.pixels, bitmap.pixels + static_cast<size_t>(bitmap.width) * bitmap.height * N);
+	}
+
+	/// Loads the font with FreeType and generates the MSDF atlas
+	static bool GenerateFontAtlas(const std::filesystem::path& filepath, MSDFData& data, AtlasBitmap& bitmap)
+	{
+		KBR_PROFILE_FUNCTION();
+
 		msdfgen::FreetypeHandle* ft = msdfgen::initializeFreetype();
 		if (!ft)
 		{
 			KBR_CORE_ASSERT(false, "Could not initialize FreeType library!");
-			return;
+			return false;
 		}
 
 		const std::string filepathStr = filepath.string();
@@ -76,23 +280,11 @@ namespace Kerberos
 		{
 			KBR_CORE_ASSERT(false, "Could not load font: {0}", filepath.string());
 			msdfgen::deinitializeFreetype(ft);
-			return;
+			return false;
 		}
 
-		struct CharsetRange {
-			uint32_t Start;
-			uint32_t End;
-		};
-
-		static constexpr uint32_t ranges[] = { 0x0020, 0x00FF, 0 }; // Basic Latin
-
-		static constexpr CharsetRange charsetRanges[] = {
-			{.Start = 0x0020, .End = 0x007E }, // Basic Latin
-			{.Start = 0x00A0, .End = 0x00FF }, // Latin-1 Supplement
-		};
-
 		msdf_atlas::Charset charset;
-		for (const auto& [Start, End] : charsetRanges)
+		for (const auto& [Start, End] : AtlasSettings::CharsetRanges)
 		{
 			for (uint32_t c = Start; c <= End; ++c)
 			{
@@ -100,57 +292,132 @@ namespace Kerberos
 			}
 		}
 
-		constexpr double fontScale = 1.0f;
-
-		m_MSDFData->FontGeometry = msdf_atlas::FontGeometry(&m_MSDFData->Glyphs);
-		int glyphsLoaded = m_MSDFData->FontGeometry.loadCharset(font, fontScale, charset);
+		std::vector<msdf_atlas::GlyphGeometry> glyphs;
+		msdf_atlas::FontGeometry fontGeometry(&glyphs);
+		fontGeometry.loadCharset(font, AtlasSettings::FontScale, charset);
 
 		msdf_atlas::TightAtlasPacker atlasPacker;
-		atlasPacker.setPixelRange(2.0);
-		atlasPacker.setMiterLimit(1.0);
-		atlasPacker.setSpacing(1);
+		atlasPacker.setPixelRange(AtlasSettings::PixelRange);
+		atlasPacker.setMiterLimit(AtlasSettings::MiterLimit);
+		atlasPacker.setSpacing(AtlasSettings::Spacing);
 		atlasPacker.setDimensionsConstraint(msdf_atlas::DimensionsConstraint::POWER_OF_TWO_RECTANGLE);
 		atlasPacker.setOriginPixelAlignment(true);
-		double emSize = 40.0;
-		atlasPacker.setScale(emSize);
+		atlasPacker.setScale(AtlasSettings::EmSize);
 
-		int remaining = atlasPacker.pack(m_MSDFData->Glyphs.data(), static_cast<int>(m_MSDFData->Glyphs.size()));
+		int remaining = atlasPacker.pack(glyphs.data(), static_cast<int>(glyphs.size()));
 		KBR_CORE_ASSERT(remaining == 0, "Could not pack all glyphs into the atlas! {} glyphs remaining", remaining);
 
 		int width, height;
 		atlasPacker.getDimensions(width, height);
-		emSize = atlasPacker.getScale();
 
 		constexpr uint64_t lcgMultiplier = 6364136223846793005ull;
 		constexpr uint64_t lcgIncrement = 1442695040888963407ull;
 
-		constexpr bool expensiveEdgeColoring = true;
-		constexpr uint64_t coloringSeed = 0x12345678abcdef00ull;
-		if (expensiveEdgeColoring)
+		constexpr uint64_t coloringSeed = AtlasSettings::ColoringSeed;
+		if (AtlasSettings::ExpensiveEdgeColoring)
 		{
-			const int threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency() - 1));
-				msdf_atlas::Workload([&glyphs = m_MSDFData->Glyphs](const int i, int) -> bool {
-					const uint64_t glyphSeed = (lcgMultiplier * (coloringSeed ^ i) + lcgIncrement) * !!coloringSeed;
-					glyphs[i].edgeColoring(&msdfgen::edgeColoringInkTrap, 3.0, glyphSeed);
-					return true;
-				}, 
-				static_cast<int>(m_MSDFData->Glyphs.size())
-			).finish(threadCount);
+			JobSystem::ParallelFor(static_cast<uint32_t>(glyphs.size()), GlyphGrainSize, [&glyphs](const uint32_t begin, const uint32_t end)
+				{
+					for (uint32_t i = begin; i < end; ++i)
+					{
+						const uint64_t glyphSeed = (lcgMultiplier * (coloringSeed ^ i) + lcgIncrement) * !!coloringSeed;
+						glyphs[i].edgeColoring(&msdfgen::edgeColoringInkTrap, AtlasSettings::MaxCornerAngle, glyphSeed);
+					}
+				});
 		}
 		else
 		{
 			uint64_t glyphSeed = coloringSeed;
-			for (msdf_atlas::GlyphGeometry& glyph : m_MSDFData->Glyphs)
+			for (msdf_atlas::GlyphGeometry& glyph : glyphs)
 			{
-				glyph.edgeColoring(&msdfgen::edgeColoringInkTrap, 3.0, glyphSeed);
+				glyph.edgeColoring(&msdfgen::edgeColoringInkTrap, AtlasSettings::MaxCornerAngle, glyphSeed);
 				glyphSeed = glyphSeed * lcgMultiplier + lcgIncrement;
 			}
 		}
 
-		m_AtlasTexture = GenerateAtlas<uint8_t, float, 3, msdf_atlas::msdfGenerator>(m_MSDFData->Glyphs, width, height);
+		bitmap.Width = width;
+		bitmap.Height = height;
+		bitmap.Pixels = GenerateAtlas<uint8_t, float, 3, msdf_atlas::msdfGenerator>(glyphs, width, height);
+
+		/// Bake the glyph data, so the geometry isn't needed after loading
+		const auto& msdfMetrics = fontGeometry.getMetrics();
+		data.Metrics.Ascender = static_cast<float>(msdfMetrics.ascenderY);
+		data.Metrics.Descender = static_cast<float>(msdfMetrics.descenderY);
+		data.Metrics.LineHeight = static_cast<float>(msdfMetrics.lineHeight);
+
+		std::unordered_map<int, uint32_t> indexToCodepoint;
+		for (const msdf_atlas::GlyphGeometry& glyph : glyphs)
+		{
+			GlyphData glyphData;
+			glyph.getQuadAtlasBounds(glyphData.AtlasBounds[0], glyphData.AtlasBounds[1], glyphData.AtlasBounds[2], glyphData.AtlasBounds[3]);
+			glyph.getQuadPlaneBounds(glyphData.PlaneBounds[0], glyphData.PlaneBounds[1], glyphData.PlaneBounds[2], glyphData.PlaneBounds[3]);
+			glyphData.Advance = glyph.getAdvance();
+
+			data.Glyphs.emplace(glyph.getCodepoint(), glyphData);
+			indexToCodepoint.emplace(glyph.getIndex(), glyph.getCodepoint());
+		}
+
+		for (const auto& [indices, kerning] : fontGeometry.getKerning())
+		{
+			const auto first = indexToCodepoint.find(indices.first);
+			const auto second = indexToCodepoint.find(indices.second);
+			if (first == indexToCodepoint.end() || second == indexToCodepoint.end())
+				continue;
+
+			data.Kerning.emplace(static_cast<uint64_t>(first->second) << 32 | second->second, kerning);
+		}
 
 		msdfgen::destroyFont(font);
 		msdfgen::deinitializeFreetype(ft);
+
+		return true;
+	}
+
+	Font::Font(std::string name, const std::filesystem::path& filepath)
+		: m_Name(std::move(name)), m_Filepath(filepath), m_MSDFData(new MSDFData)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		Timer timer("Font::Font", [&](const TimerData& data) {
+			KBR_CORE_INFO("Timer: Loading font {0} from {1} took {2}ms", m_Name, filepath.string(), data.DurationMs);
+			});
+
+		if (!std::filesystem::exists(filepath))
+		{
+			KBR_CORE_ASSERT(false, "Font file does not exist: {0}", filepath.string());
+			return;
+		}
+
+		const uint64_t cacheKey = CreateAtlasCacheKey(filepath);
+		m_AtlasCachePath = std::filesystem::path(GetAtlasCacheDirectory()) / std::format("{}-{:016x}.kbrfont", filepath.stem().string(), cacheKey);
+
+		AtlasBitmap bitmap;
+		if (ReadAtlasCache(m_AtlasCachePath, cacheKey, *m_MSDFData, bitmap))
+		{
+			KBR_CORE_TRACE("Loaded font atlas of {0} from cache: {1}", m_Name, m_AtlasCachePath.string());
+		}
+		else
+		{
+			*m_MSDFData = MSDFData();
+			bitmap = AtlasBitmap();
+
+			if (!GenerateFontAtlas(filepath, *m_MSDFData, bitmap))
+				return;
+
+			if (!WriteAtlasCache(m_AtlasCachePath, cacheKey, *m_MSDFData, bitmap))
+			{
+				KBR_CORE_WARN("Failed to write font atlas cache file: {0}", m_AtlasCachePath.string());
+			}
+		}
+
+		TextureSpecification spec;
+		spec.Width = static_cast<uint32_t>(bitmap.Width);
+		spec.Height = static_cast<uint32_t>(bitmap.Height);
+		spec.Format = ImageFormat::RGB8;
+		spec.GenerateMips = false;
+
+		m_AtlasTexture = Texture2D::Create(spec);
+		m_AtlasTexture->SetData(bitmap.Pixels.data(), static_cast<uint32_t>(bitmap.Pixels.size()));
 	}
 
 	Font::~Font()
@@ -160,48 +427,61 @@ namespace Kerberos
 
 	FontMetrics Font::GetMetrics() const 
 	{
-		const auto& msdfMetrics = m_MSDFData->FontGeometry.getMetrics();
+		return m_MSDFData->Metrics;
+	}
 
-		FontMetrics metrics;
-		metrics.Ascender = static_cast<float>(msdfMetrics.ascenderY);
-		metrics.Descender = static_cast<float>(msdfMetrics.descenderY);
-		metrics.LineHeight = static_cast<float>(msdfMetrics.lineHeight);
-		return metrics;
+	static const GlyphData* FindGlyph(const MSDFData& data, const char character)
+	{
+		const auto it = data.Glyphs.find(static_cast<unsigned char>(character));
+		return it != data.Glyphs.end() ? &it->second : nullptr;
 	}
 
 	bool Font::HasCharacter(const char c) const 
 	{
-		return m_MSDFData->FontGeometry.getGlyph(c) != nullptr;
+		return FindGlyph(*m_MSDFData, c) != nullptr;
 	}
 
 	void Font::GetQuadAtlasBounds(char character, double& al, double& ab, double& ar, double& at) const 
 	{
-		const auto& glyph = m_MSDFData->FontGeometry.getGlyph(character);
+		const GlyphData* glyph = FindGlyph(*m_MSDFData, character);
 		KBR_CORE_ASSERT(glyph, "Font does not contain character: {0}", character);
 
-		glyph->getQuadAtlasBounds(al, ab, ar, at);
-
+		al = glyph->AtlasBounds[0];
+		ab = glyph->AtlasBounds[1];
+		ar = glyph->AtlasBounds[2];
+		at = glyph->AtlasBounds[3];
 	}
 
 	void Font::GetQuadPlaneBounds(char character, double& pl, double& pb, double& pr, double& pt) const 
 	{
-		const auto& glyph = m_MSDFData->FontGeometry.getGlyph(character);
+		const GlyphData* glyph = FindGlyph(*m_MSDFData, character);
 		KBR_CORE_ASSERT(glyph, "Font does not contain character: {0}", character);
 
-		glyph->getQuadPlaneBounds(pl, pb, pr, pt);
+		pl = glyph->PlaneBounds[0];
+		pb = glyph->PlaneBounds[1];
+		pr = glyph->PlaneBounds[2];
+		pt = glyph->PlaneBounds[3];
 	}
 
 	double Font::GetAdvance(char character) const 
 	{
-		const auto& glyph = m_MSDFData->FontGeometry.getGlyph(character);
+		const GlyphData* glyph = FindGlyph(*m_MSDFData, character);
 		KBR_CORE_ASSERT(glyph, "Font does not contain character: {0}", character);
 
-		return glyph->getAdvance();
+		return glyph->Advance;
 	}
 
 	void Font::GetNextAdvance(double& advance, const char character, const char nextCharacter) const 
 	{
-		m_MSDFData->FontGeometry.getAdvance(advance, character, nextCharacter);
+		const GlyphData* glyph = FindGlyph(*m_MSDFData, character);
+		if (!glyph)
+			return;
+
+		advance = glyph->Advance;
+
+		const uint64_t pair = static_cast<uint64_t>(static_cast<unsigned char>(character)) << 32 | static_cast<unsigned char>(nextCharacter);
+		if (const auto it = m_MSDFData->Kerning.find(pair); it != m_MSDFData->Kerning.end())
+			advance += it->second;
 	}
 
 	static Ref<Font> s_DefaultFont = nullptr;
@@ -33,6 +33,9 @@ namespace Kerberos
 		const std::string& GetName() const { return m_Name; }
 		const std::filesystem::path& GetFilepath() const { return m_Filepath; }
 
+		/// The file the generated atlas and glyph data are cached in, so later loads can skip the atlas generation
+		const std::filesystem::path& GetAtlasCachePath() const { return m_AtlasCachePath; }
+
 		bool HasCharacter(char c) const;
 		void GetQuadAtlasBounds(char character, double& al, double& ab, double& ar, double& at) const;
 		void GetQuadPlaneBounds(char character, double& pl, double& pb, double& pr, double& pt) const;
@@ -44,6 +47,7 @@ namespace Kerberos
 	private:
 		std::string m_Name;
 		std::filesystem::path m_Filepath;
+		std::filesystem::path m_AtlasCachePath;
 
 		MSDFData* m_MSDFData = nullptr;
 		Ref<Texture2D> m_AtlasTexture;
@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Platform/D3D11/D3D11Framebuffer.h"
+#include "Platform/Null/NullFramebuffer.h"
 #include "Platform/OpenGL/OpenGLFramebuffer.h"
 #include "Platform/Vulkan/VulkanFramebuffer.h"
 
@@ -24,6 +25,9 @@ namespace Kerberos
 
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanFramebuffer>(spec);
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullFramebuffer>(spec);
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -19,6 +19,10 @@ namespace Kerberos
 		virtual void Init() = 0;
 		virtual void SwapBuffers() = 0;
 
+		/// Makes the context current on the calling thread, for the APIs which bind the context to a thread
+		virtual void MakeCurrent() {}
+		virtual void ReleaseCurrent() {}
+
 	protected:
 		ComputeInfo m_ComputeInfo;
 	};
@@ -1,12 +1,25 @@
 #include "kbrpch.h"
 #include "Mesh.h"
 
+#include "Renderer3D.h"
+
 #include <glm/ext/scalar_constants.hpp>
 
 namespace Kerberos
 {
 	Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
 		: m_Vertices(vertices), m_Indices(indices)
+	{
+		SetupMesh(vertices, indices);
+
+		for (const auto& vertex : vertices)
+		{
+			m_Bounds.Merge(vertex.Position);
+		}
+	}
+
+	Mesh::Mesh(const std::span<const Vertex> vertices, const std::span<const uint32_t> indices, const AABB& bounds)
+		: m_Bounds(bounds), m_Vertices(vertices.begin(), vertices.end()), m_Indices(indices.begin(), indices.end())
 	{
 		SetupMesh(vertices, indices);
 	}
@@ -256,7 +269,7 @@ namespace Kerberos
 		return CreateRef<Mesh>(vertices, indices);
 	}
 
-	void Mesh::SetupMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+	void Mesh::SetupMesh(const std::span<const Vertex> vertices, const std::span<const uint32_t> indices)
 	{
 		m_VertexArray = VertexArray::Create();
 
@@ -266,9 +279,13 @@ namespace Kerberos
 		vertexBuffer->SetData(vertices.data(), vbSize);
 		m_VertexArray->AddVertexBuffer(vertexBuffer);
 
+		/// The per instance data of the instanced draws is read from the shared instance buffer
+		m_VertexArray->AddVertexBuffer(Renderer3D::GetInstanceVertexBuffer());
+
 		const auto indexBuffer = IndexBuffer::Create(indices.data(), static_cast<uint32_t>(indices.size()));
 		m_VertexArray->SetIndexBuffer(indexBuffer);
 
 		m_IndexCount = static_cast<uint32_t>(indices.size());
+		m_VertexCount = static_cast<uint32_t>(vertices.size());
 	}
 }
@@ -1,15 +1,24 @@
 #pragma once
 
+#include "Bounds.h"
 #include "Vertex.h"
 #include "VertexArray.h"
 #include "Kerberos/Assets/Asset.h"
 
+#include <span>
+
 namespace Kerberos
 {
 	class Mesh : public Asset
 	{
 	public:
 		Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+		/**
+		 * Creates the mesh with already known bounds, so the vertices are only copied, and not iterated.
+		 * Used when loading cooked meshes.
+		 */
+		Mesh(std::span<const Vertex> vertices, std::span<const uint32_t> indices, const AABB& bounds);
 		~Mesh() override = default;
 
 		static Ref<Mesh> CreateCube(float size);
@@ -20,32 +29,24 @@ namespace Kerberos
 
 		Ref<VertexArray> GetVertexArray() const { return m_VertexArray; }
 		uint32_t GetIndexCount() const { return m_IndexCount; }
-		uint32_t GetVertexCount() const 
-		{ 
-			if (m_VertexArray && !m_VertexArray->GetVertexBuffers().empty())
-			{
-				uint32_t count = 0;
-				for (const auto& vertexBuffer : m_VertexArray->GetVertexBuffers())
-				{
-					count += vertexBuffer->GetCount();
-				}
-				return count;
-			}
-				
-			return 0; 
-		}
+		uint32_t GetVertexCount() const { return m_VertexCount; }
 
 		const std::vector<Vertex>& GetVertices() const { return m_Vertices; }
 		const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
 
+		/// The bounds of the mesh in its local space, calculated when the mesh is created
+		const AABB& GetBounds() const { return m_Bounds; }
+
 		AssetType GetType() override { return AssetType::Mesh; }
 
 	private:
-		void SetupMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+		void SetupMesh(std::span<const Vertex> vertices, std::span<const uint32_t> indices);
 
 	private:
 		Ref<VertexArray> m_VertexArray;
 		uint32_t m_IndexCount = 0;
+		uint32_t m_VertexCount = 0;
+		AABB m_Bounds;
 
 		std::vector<Vertex> m_Vertices;
 		std::vector<uint32_t> m_Indices;
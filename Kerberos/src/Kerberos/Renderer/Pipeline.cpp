@@ -27,6 +27,10 @@ namespace Kerberos
 			//return CreateRef<D3D12Pipeline>(spec);
 			KBR_CORE_ASSERT(false, "Pipeline is not yet implemented for D3D12");
 			return nullptr;
+
+		case RendererAPI::API::Null:
+			KBR_CORE_ASSERT(false, "Pipeline is not yet implemented for the Null renderer");
+			return nullptr;
 		}
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI for creating a pipeline!");
 		return nullptr;
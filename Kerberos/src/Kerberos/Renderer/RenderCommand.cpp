@@ -3,6 +3,7 @@
 
 #include "RendererAPI.h"
 #include "Platform/D3D11/D3D11RendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
 #include "Platform/Vulkan/VulkanRendererAPI.h"
 
@@ -31,6 +32,10 @@ namespace Kerberos
 			s_RendererAPI = new VulkanRendererAPI();
 			return;
 			}
+
+		case RendererAPI::API::Null:
+			s_RendererAPI = new NullRendererAPI();
+			return;
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI in RenderCommand::SetupRendererAPI");
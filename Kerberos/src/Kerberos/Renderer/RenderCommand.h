@@ -26,6 +26,11 @@ namespace Kerberos
 			s_RendererAPI->DrawIndexed(vertexArray, indexCount); 
 		}
 
+		static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, const uint32_t indexCount, const uint32_t instanceCount, const uint32_t baseInstance = 0)
+		{
+			s_RendererAPI->DrawIndexedInstanced(vertexArray, indexCount, instanceCount, baseInstance);
+		}
+
 		static void DrawArray(const Ref<VertexArray>& vertexArray, const uint32_t vertexCount)
 		{
 			s_RendererAPI->DrawArray(vertexArray, vertexCount);
@@ -0,0 +1,97 @@
+#include "kbrpch.h"
+#include "RenderCommandQueue.h"
+
+namespace Kerberos
+{
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		if (m_FirstCommand)
+		{
+			KBR_CORE_WARN("RenderCommandQueue destroyed with {} commands that were never executed", m_CommandCount);
+		}
+
+		/// The commands which were never executed still own the resources they captured
+		for (CommandHeader* command = m_FirstCommand; command;)
+		{
+			CommandHeader* next = command->Next;
+			command->Execute(command, false);
+			command = next;
+		}
+	}
+
+	void* RenderCommandQueue::CopyData(const void* data, const size_t size)
+	{
+		if (size == 0)
+			return nullptr;
+
+		void* memory = Allocate(size, alignof(std::max_align_t));
+		std::memcpy(memory, data, size);
+		return memory;
+	}
+
+	void RenderCommandQueue::Execute()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		for (CommandHeader* command = m_FirstCommand; command;)
+		{
+			/// The command may record other commands into a different queue, but never into this one
+			CommandHeader* next = command->Next;
+			command->Execute(command, true);
+			command = next;
+		}
+
+		m_FirstCommand = nullptr;
+		m_LastCommand = nullptr;
+		m_CommandCount = 0;
+		m_UsedMemory = 0;
+		m_ChunkIndex = 0;
+		m_ChunkOffset = 0;
+	}
+
+	size_t RenderCommandQueue::GetReservedMemory() const
+	{
+		size_t size = 0;
+		for (const Chunk& chunk : m_Chunks)
+			size += chunk.Size;
+
+		return size;
+	}
+
+	void* RenderCommandQueue::Allocate(const size_t size, const size_t alignment)
+	{
+		m_UsedMemory += size;
+
+		while (m_ChunkIndex < m_Chunks.size())
+		{
+			Chunk& chunk = m_Chunks[m_ChunkIndex];
+
+			const uintptr_t base = reinterpret_cast<uintptr_t>(chunk.Memory.get());
+			const uintptr_t aligned = (base + m_ChunkOffset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+			const size_t end = aligned - base + size;
+
+			if (end <= chunk.Size)
+			{
+				m_ChunkOffset = end;
+				return reinterpret_cast<void*>(aligned);
+			}
+
+			/// Doesn't fit in the rest of the chunk, the following chunks are empty
+			++m_ChunkIndex;
+			m_ChunkOffset = 0;
+		}
+
+		/// Only happens when a frame records more than any frame before it
+		const size_t chunkSize = std::max(ChunkSize, size + alignment);
+		m_Chunks.push_back({ .Memory = std::make_unique<std::byte[]>(chunkSize), .Size = chunkSize });
+
+		Chunk& chunk = m_Chunks.back();
+		const uintptr_t base = reinterpret_cast<uintptr_t>(chunk.Memory.get());
+		const uintptr_t aligned = (base + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+
+		m_ChunkIndex = m_Chunks.size() - 1;
+		m_ChunkOffset = aligned - base + size;
+
+		return reinterpret_cast<void*>(aligned);
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Kerberos
+{
+	/**
+	* A list of render commands, recorded on one thread and executed later on another one.
+	*
+	* The commands and the data they copy are stored in place in large memory chunks.
+	* The chunks are kept when the queue is executed, so once the queue has grown to the size of a frame,
+	* recording the commands doesn't allocate anymore.
+	*/
+	class RenderCommandQueue
+	{
+	public:
+		/// The size of the memory chunks, a bigger command or data gets a chunk of its own
+		static constexpr size_t ChunkSize = 2 * 1024 * 1024;
+
+		RenderCommandQueue() = default;
+		~RenderCommandQueue();
+
+		RenderCommandQueue(const RenderCommandQueue& other) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue& other) = delete;
+
+		/**
+		* @brief Records a command, which is executed when the queue is executed.
+		* Everything the command uses must be captured by value, or copied into the queue with CopyData.
+		*/
+		template<typename F>
+		void Submit(F&& function)
+		{
+			using Fn = std::decay_t<F>;
+
+			constexpr size_t alignment = alignof(Fn) > alignof(CommandHeader) ? alignof(Fn) : alignof(CommandHeader);
+			constexpr size_t offset = GetCommandOffset<Fn>();
+
+			void* memory = Allocate(offset + sizeof(Fn), alignment);
+
+			CommandHeader* header = new (memory) CommandHeader();
+			header->Execute = [](CommandHeader* command, const bool run)
+				{
+					Fn* fn = std::launder(reinterpret_cast<Fn*>(reinterpret_cast<std::byte*>(command) + GetCommandOffset<Fn>()));
+					if (run)
+						(*fn)();
+					fn->~Fn();
+				};
+
+			new (static_cast<std::byte*>(memory) + offset) Fn(std::forward<F>(function));
+
+			if (m_LastCommand)
+				m_LastCommand->Next = header;
+			else
+				m_FirstCommand = header;
+
+			m_LastCommand = header;
+			++m_CommandCount;
+		}
+
+		/// Copies the data into the queue, the copy lives until the queue is executed
+		void* CopyData(const void* data, size_t size);
+
+		/// Executes the commands in the order they were recorded, then resets the queue
+		void Execute();
+
+		bool IsEmpty() const { return m_FirstCommand == nullptr; }
+
+		uint32_t GetCommandCount() const { return m_CommandCount; }
+		/// The memory used by the recorded commands and their data
+		size_t GetUsedMemory() const { return m_UsedMemory; }
+		/// The memory owned by the queue, including the unused chunks
+		size_t GetReservedMemory() const;
+
+	private:
+		struct CommandHeader
+		{
+			/// Runs the command if run is true, then destroys it
+			void (*Execute)(CommandHeader* command, bool run) = nullptr;
+			CommandHeader* Next = nullptr;
+		};
+
+		struct Chunk
+		{
+			std::unique_ptr<std::byte[]> Memory;
+			size_t Size = 0;
+		};
+
+		/// The command is stored right after its header
+		template<typename Fn>
+		static constexpr size_t GetCommandOffset()
+		{
+			return (sizeof(CommandHeader) + alignof(Fn) - 1) & ~(alignof(Fn) - 1);
+		}
+
+		void* Allocate(size_t size, size_t alignment);
+
+	private:
+		std::vector<Chunk> m_Chunks;
+		size_t m_ChunkIndex = 0;
+		size_t m_ChunkOffset = 0;
+
+		CommandHeader* m_FirstCommand = nullptr;
+		CommandHeader* m_LastCommand = nullptr;
+		uint32_t m_CommandCount = 0;
+		size_t m_UsedMemory = 0;
+	};
+}
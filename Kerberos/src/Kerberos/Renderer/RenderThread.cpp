@@ -0,0 +1,236 @@
+#include "kbrpch.h"
+#include "RenderThread.h"
+
+#include "GraphicsContext.h"
+#include "RendererAPI.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Kerberos
+{
+	struct RenderThreadData
+	{
+		GraphicsContext* Context = nullptr;
+		bool Running = false;
+
+		std::thread Thread;
+
+		/// One queue is recorded by the main thread while the other one is executed by the render thread
+		std::array<RenderCommandQueue, 2> Queues;
+		uint32_t SubmissionIndex = 0;
+		uint32_t ExecutionIndex = 1;
+
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		/// The render thread has a queue to execute
+		bool Kicked = false;
+		bool Stop = false;
+
+		/// The commands handed to the render thread since the last frame, including the flushes
+		uint32_t FrameCommandCount = 0;
+		size_t FrameCommandMemory = 0;
+		float FrameMainThreadWaitMs = 0.0f;
+		float LastExecutionMs = 0.0f;
+
+		RenderThreadStats Stats;
+	};
+
+	static RenderThreadData* s_Data = nullptr;
+	static thread_local bool t_IsRenderThread = false;
+
+	using Clock = std::chrono::high_resolution_clock;
+
+	static float ToMs(const Clock::duration duration)
+	{
+		return std::chrono::duration<float, std::milli>(duration).count();
+	}
+
+	static void RenderThreadMain()
+	{
+		t_IsRenderThread = true;
+
+		s_Data->Context->MakeCurrent();
+
+		while (true)
+		{
+			{
+				std::unique_lock lock(s_Data->Mutex);
+				s_Data->Condition.wait(lock, [] { return s_Data->Kicked || s_Data->Stop; });
+
+				if (!s_Data->Kicked)
+					break;
+			}
+
+			const Clock::time_point start = Clock::now();
+			{
+				KBR_PROFILE_SCOPE("RenderThread - Execute");
+				s_Data->Queues[s_Data->ExecutionIndex].Execute();
+			}
+			const float executionMs = ToMs(Clock::now() - start);
+
+			{
+				std::scoped_lock lock(s_Data->Mutex);
+				s_Data->LastExecutionMs = executionMs;
+				s_Data->Kicked = false;
+			}
+			s_Data->Condition.notify_all();
+		}
+
+		s_Data->Context->ReleaseCurrent();
+	}
+
+	/// Hands the recorded queue to the render thread, after it has finished the previous one
+	static void KickQueue()
+	{
+		const Clock::time_point waitStart = Clock::now();
+		RenderThread::WaitForRenderComplete();
+		s_Data->FrameMainThreadWaitMs += ToMs(Clock::now() - waitStart);
+
+		RenderCommandQueue& queue = s_Data->Queues[s_Data->SubmissionIndex];
+		s_Data->FrameCommandCount += queue.GetCommandCount();
+		s_Data->FrameCommandMemory += queue.GetUsedMemory();
+
+		{
+			std::scoped_lock lock(s_Data->Mutex);
+			s_Data->ExecutionIndex = s_Data->SubmissionIndex;
+			s_Data->SubmissionIndex = (s_Data->SubmissionIndex + 1) % static_cast<uint32_t>(s_Data->Queues.size());
+			s_Data->Kicked = true;
+		}
+		s_Data->Condition.notify_all();
+	}
+
+	void RenderThread::Init(RenderThreadPolicy policy, GraphicsContext* context)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		KBR_CORE_ASSERT(!s_Data, "RenderThread is already initialized!");
+		KBR_CORE_ASSERT(context, "RenderThread needs a graphics context!");
+
+		/// The immediate context of D3D11 is not handed between threads yet
+		if (policy == RenderThreadPolicy::MultiThreaded && RendererAPI::GetAPI() == RendererAPI::API::D3D11)
+		{
+			KBR_CORE_WARN("The render thread is not supported with D3D11, the render commands are executed on the main thread");
+			policy = RenderThreadPolicy::SingleThreaded;
+		}
+
+		s_Data = new RenderThreadData();
+		s_Data->Context = context;
+
+		if (policy == RenderThreadPolicy::SingleThreaded)
+		{
+			KBR_CORE_INFO("RenderThread disabled, the render commands are executed on the main thread");
+			return;
+		}
+
+		/// The context can only be current on one thread at a time
+		context->ReleaseCurrent();
+
+		s_Data->Running = true;
+		s_Data->Thread = std::thread(RenderThreadMain);
+
+		KBR_CORE_INFO("RenderThread started");
+	}
+
+	void RenderThread::Shutdown()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (!s_Data)
+			return;
+
+		if (s_Data->Running)
+		{
+			Flush();
+
+			{
+				std::scoped_lock lock(s_Data->Mutex);
+				s_Data->Stop = true;
+			}
+			s_Data->Condition.notify_all();
+			s_Data->Thread.join();
+
+			/// The resources destroyed after this are deleted on the main thread
+			s_Data->Running = false;
+			s_Data->Context->MakeCurrent();
+		}
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	bool RenderThread::IsRunning()
+	{
+		return s_Data && s_Data->Running;
+	}
+
+	bool RenderThread::IsRenderThread()
+	{
+		return t_IsRenderThread;
+	}
+
+	const void* RenderThread::CopyCommandData(const void* data, const size_t size)
+	{
+		if (!IsRunning() || IsRenderThread())
+			return data;
+
+		return GetSubmissionQueue().CopyData(data, size);
+	}
+
+	void RenderThread::Kick()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (!IsRunning())
+			return;
+
+		KickQueue();
+
+		RenderThreadStats& stats = s_Data->Stats;
+		stats.CommandCount = s_Data->FrameCommandCount;
+		stats.CommandMemory = s_Data->FrameCommandMemory;
+		stats.MainThreadWaitMs = s_Data->FrameMainThreadWaitMs;
+		{
+			std::scoped_lock lock(s_Data->Mutex);
+			stats.RenderThreadMs = s_Data->LastExecutionMs;
+		}
+
+		s_Data->FrameCommandCount = 0;
+		s_Data->FrameCommandMemory = 0;
+		s_Data->FrameMainThreadWaitMs = 0.0f;
+	}
+
+	void RenderThread::Flush()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (!IsRunning() || IsRenderThread())
+			return;
+
+		KickQueue();
+		WaitForRenderComplete();
+	}
+
+	void RenderThread::WaitForRenderComplete()
+	{
+		if (!IsRunning() || IsRenderThread())
+			return;
+
+		std::unique_lock lock(s_Data->Mutex);
+		s_Data->Condition.wait(lock, [] { return !s_Data->Kicked; });
+	}
+
+	const RenderThreadStats& RenderThread::GetStats()
+	{
+		static const RenderThreadStats emptyStats;
+		return s_Data ? s_Data->Stats : emptyStats;
+	}
+
+	RenderCommandQueue& RenderThread::GetSubmissionQueue()
+	{
+		return s_Data->Queues[s_Data->SubmissionIndex];
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "RenderCommandQueue.h"
+
+#include <string>
+
+namespace Kerberos
+{
+	class GraphicsContext;
+
+	enum class RenderThreadPolicy : uint8_t
+	{
+		/// The render commands are executed right when they are submitted, on the main thread
+		SingleThreaded,
+		/// The render commands of a frame are executed on the render thread, while the main thread works on the next frame.
+		/// Supported by OpenGL, Vulkan and Null, D3D11 falls back to SingleThreaded
+		MultiThreaded,
+	};
+
+	struct RenderThreadStats
+	{
+		/// The commands and their data recorded in the last frame
+		uint32_t CommandCount = 0;
+		size_t CommandMemory = 0;
+
+		/// The time the render thread spent executing the last frame
+		float RenderThreadMs = 0.0f;
+		/// The time the main thread waited for the render thread in the last frame
+		float MainThreadWaitMs = 0.0f;
+	};
+
+	/**
+	* Owns the graphics context and executes the render commands on a dedicated thread.
+	*
+	* The main thread records the commands of frame N + 1 into one queue while the render thread executes frame N from the other one.
+	* Kick hands the recorded frame to the render thread, and waits for it only if it is still busy with the previous frame.
+	*
+	* The graphics API backends submit every call touching the context through Submit. Until the render thread is started,
+	* or when the policy is SingleThreaded, the commands are executed immediately, so the behaviour is the same as calling the API directly.
+	*/
+	class RenderThread
+	{
+	public:
+		static void Init(RenderThreadPolicy policy, GraphicsContext* context);
+		static void Shutdown();
+
+		/// True if the commands are executed on the render thread
+		static bool IsRunning();
+		static bool IsRenderThread();
+
+		/**
+		* @brief Records a command for the render thread, or executes it immediately if the render thread is not running.
+		* Everything the command uses must be captured by value, the objects submitting it may be destroyed before it is executed.
+		*/
+		template<typename F>
+		static void Submit(F&& function)
+		{
+			if (!IsRunning() || IsRenderThread())
+			{
+				function();
+				return;
+			}
+
+			GetSubmissionQueue().Submit(std::forward<F>(function));
+		}
+
+		/**
+		* @brief Executes the command and everything submitted before it, and waits for them.
+		* Used for creating resources and reading data back, this stalls the main thread until the render thread catches up.
+		*/
+		template<typename F>
+		static void SubmitAndWait(F&& function)
+		{
+			if (!IsRunning() || IsRenderThread())
+			{
+				function();
+				return;
+			}
+
+			GetSubmissionQueue().Submit(std::forward<F>(function));
+			Flush();
+		}
+
+		/**
+		* @brief Copies the data for a command, the copy lives until the frame is executed.
+		* Returns the data itself if the commands are executed immediately.
+		*/
+		static const void* CopyCommandData(const void* data, size_t size);
+
+		static const char* CopyCommandString(const std::string& string)
+		{
+			return static_cast<const char*>(CopyCommandData(string.c_str(), string.size() + 1));
+		}
+
+		/// Hands the commands recorded for the frame to the render thread, it is called once per frame
+		static void Kick();
+
+		/// Executes everything submitted so far, and waits until the render thread is finished
+		static void Flush();
+
+		/// Waits until the render thread has finished the frame it is working on
+		static void WaitForRenderComplete();
+
+		static const RenderThreadStats& GetStats();
+
+	private:
+		static RenderCommandQueue& GetSubmissionQueue();
+	};
+}
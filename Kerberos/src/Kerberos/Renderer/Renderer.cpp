@@ -9,12 +9,12 @@ namespace Kerberos
 	Renderer::SceneData* Renderer::s_SceneData = new SceneData;
 	Ref<UniformBuffer> Renderer::s_CameraBuffer = nullptr;
 
-	void Renderer::Init()
+	void Renderer::Init(const Renderer2DSpecification& renderer2DSpecification)
 	{
 		RenderCommand::SetupRendererAPI();
 		RenderCommand::Init();
 
-		//Renderer2D::Init();
+		Renderer2D::Init(renderer2DSpecification);
 		Renderer3D::Init();
 	}
 
@@ -3,6 +3,7 @@
 #include "Kerberos/Core.h"
 #include "RenderCommand.h"
 #include "OrthographicCamera.h"
+#include "Renderer2D.h"
 #include "Shader.h"
 #include "UniformBuffer.h"
 
@@ -11,7 +12,7 @@ namespace Kerberos
 	class Renderer
 	{
 	public:
-		static void Init();
+		static void Init(const Renderer2DSpecification& renderer2DSpecification = Renderer2DSpecification());
 
 		static void OnWindowResized(const uint32_t width, const uint32_t height);
 
@@ -2,11 +2,21 @@
 #include "Renderer2D.h"
 
 #include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+/// SSE is always available on x64, the quad vertices are written with it
+#if defined(_M_X64) || defined(__SSE2__)
+	#define KBR_RENDERER2D_SSE 1
+	#include <xmmintrin.h>
+#else
+	#define KBR_RENDERER2D_SSE 0
+#endif
 
 #include "Shader.h"
 #include "Texture.h"
 #include "VertexArray.h"
 #include "RenderCommand.h"
+#include "Fence.h"
 #include "Kerberos/Assets/AssetManager.h"
 
 /*
@@ -26,26 +36,74 @@ namespace Kerberos
 		float TilingFactor;
 	};
 
+	/// The SSE path writes every vertex as three rows of four floats: position, color, and the texture coordinates with the index and tiling factor
+	static_assert(sizeof(QuadVertex) == 11 * sizeof(float));
+	static_assert(offsetof(QuadVertex, Color) == 3 * sizeof(float) && offsetof(QuadVertex, TexCoord) == 7 * sizeof(float));
+
+	/// A whole quad in the instanced mode, the vertex shader builds the corners from it
+	struct QuadInstanceVertex
+	{
+		glm::vec3 Center;
+		/// The halves of the transformed x and y axes, in 3D so quads rotated around x or y stay correct
+		glm::vec3 AxisX;
+		glm::vec3 AxisY;
+		/// The texture coordinates of the bottom left corner in xy and the top right corner in zw, multiplied by the tiling factor
+		glm::vec4 TexCoordRect;
+		/// RGBA, 8 bits per channel
+		uint32_t Color;
+		float TexIndex;
+	};
+
+	static_assert(sizeof(QuadInstanceVertex) == 60);
+
+	/// One batch worth of vertices, with its own vertex array sharing the index buffer
+	struct QuadBatchBuffer
+	{
+		Ref<VertexBuffer> QuadVertexBuffer;
+		Ref<VertexArray> QuadVertexArray;
+		/// Signaled after the draw reading the buffer, only used if the buffer is mapped
+		Ref<Fence> DrawFence;
+	};
+
 	struct Renderer2DData
 	{
 		uint32_t MaxQuads = 10000;
 		uint32_t MaxVertices = MaxQuads * 4;
 		uint32_t MaxIndices = MaxQuads * 6;
 		static constexpr uint32_t MaxTextureSlots = 32;
+		/// The last slot is reserved for the texture array, the other ones are sampled from u_Textures
+		static constexpr uint32_t TextureArraySlot = MaxTextureSlots - 1;
+
+		/// The ring of mapped buffers starts with enough for the frames in flight,
+		/// and grows while the GPU is still reading the next one, up to the maximum
+		static constexpr uint32_t MinQuadBatchBuffers = 3;
+		static constexpr uint32_t MaxQuadBatchBuffers = 32;
+
+		Renderer2DSpecification Specification;
+
+		std::vector<QuadBatchBuffer> QuadBatchBuffers;
+		uint32_t QuadBatchBufferIndex = 0;
+		Ref<IndexBuffer> QuadIndexBuffer;
+
+		/// If the backend can't keep the buffers mapped, the vertices are written to the staging buffer and uploaded with SetData
+		bool QuadVertexBuffersMapped = false;
+		uint8_t* QuadStagingBuffer = nullptr;
 
-		Ref<VertexArray> QuadVertexArray;
-		Ref<VertexBuffer> QuadVertexBuffer;
 		Ref<Shader> Shader;
+		ShaderUniform ViewProjectionUniform;
 		Ref<Texture2D> Texture;		 /// Not currently used
 		Ref<Texture2D> WhiteTexture;
 		glm::mat4 ViewProjectionMatrix;
 
 		uint32_t QuadIndexCount = 0;
-		QuadVertex* QuadVertexBufferBase = nullptr;
+		/// Where the next quad of the batch is written, only the pointer of the mode in the specification is used
 		QuadVertex* QuadVertexBufferPtr = nullptr;
+		QuadInstanceVertex* QuadInstanceBufferPtr = nullptr;
 
-		std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
+		std::array<Ref<Texture2D>, TextureArraySlot> TextureSlots;
 		uint32_t TextureSlotIndex = 1; /// 0 is reserved for the white texture
+		/// The texture array of the batch, only one can be bound at a time
+		Ref<Texture2DArray> TextureArray;
 
 		glm::vec4 QuadVertexPositions[4] = {
 			{ -0.5f, -0.5f, 0.0f, 1.0f },
@@ -59,27 +117,240 @@ namespace Kerberos
 
 	static Renderer2DData s_Data;
 
-	void Renderer2D::Init() 
+	static constexpr glm::vec2 QuadTextureCoords[] = {
+		{ 0.0f, 0.0f },
+		{ 1.0f, 0.0f },
+		{ 1.0f, 1.0f },
+		{ 0.0f, 1.0f }
+	};
+
+	/**
+	* The corners of a quad are Center - A - B, Center + A - B, Center + A + B and Center - A + B,
+	* where A and B are the halves of its scaled and rotated x and y axes.
+	* This is the same as transforming the QuadVertexPositions, without building and multiplying the matrices.
+	*/
+	struct QuadAxes
 	{
-		KBR_PROFILE_FUNCTION();
+		glm::vec3 Center;
+		glm::vec3 A;
+		glm::vec3 B;
+	};
 
-		s_Data = Renderer2DData();
+	static QuadAxes GetQuadAxes(const glm::vec3& position, const glm::vec2& size, const float rotation)
+	{
+		const float halfWidth = size.x * 0.5f;
+		const float halfHeight = size.y * 0.5f;
 
-		s_Data.QuadVertexArray = VertexArray::Create();
+		/// Most quads are not rotated, they don't need the sine and cosine
+		if (rotation == 0.0f)
+			return { position, { halfWidth, 0.0f, 0.0f }, { 0.0f, halfHeight, 0.0f } };
 
-		s_Data.QuadVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(QuadVertex));
+		const float angle = glm::radians(rotation);
+		const float cosine = std::cos(angle);
+		const float sine = std::sin(angle);
 
-		s_Data.QuadVertexBuffer->SetLayout({
-			{ ShaderDataType::Float3, "a_Position" },
-			{ ShaderDataType::Float4, "a_Color"},
-			{ ShaderDataType::Float2, "a_TexCoord" },
-			{ ShaderDataType::Float, "a_TexIndex" },
-			{ ShaderDataType::Float, "a_TilingFactor" }
-			});
+		return { position, { halfWidth * cosine, halfWidth * sine, 0.0f }, { -halfHeight * sine, halfHeight * cosine, 0.0f } };
+	}
+
+	static QuadAxes GetQuadAxes(const glm::mat4& transform)
+	{
+		return { glm::vec3(transform[3]), glm::vec3(transform[0]) * 0.5f, glm::vec3(transform[1]) * 0.5f };
+	}
+
+	static void WriteQuadVertices(QuadVertex* vertices, const QuadAxes& axes, const glm::vec4& color, const glm::vec2* textureCoords, const float textureIndex, const float tilingFactor)
+	{
+	#if KBR_RENDERER2D_SSE
+		const __m128 center = _mm_setr_ps(axes.Center.x, axes.Center.y, axes.Center.z, 0.0f);
+		const __m128 a = _mm_setr_ps(axes.A.x, axes.A.y, axes.A.z, 0.0f);
+		const __m128 b = _mm_setr_ps(axes.B.x, axes.B.y, axes.B.z, 0.0f);
+
+		const __m128 bottom = _mm_sub_ps(center, b);
+		const __m128 top = _mm_add_ps(center, b);
+		const __m128 corners[4] = { _mm_sub_ps(bottom, a), _mm_add_ps(bottom, a), _mm_add_ps(top, a), _mm_sub_ps(top, a) };
+
+		const __m128 colorRow = _mm_loadu_ps(&color.x);
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			float* vertex = reinterpret_cast<float*>(vertices + i);
+
+			/// The fourth float of the position row is overwritten by the color right after
+			_mm_storeu_ps(vertex, corners[i]);
+			_mm_storeu_ps(vertex + 3, colorRow);
+			_mm_storeu_ps(vertex + 7, _mm_setr_ps(textureCoords[i].x, textureCoords[i].y, textureIndex, tilingFactor));
+		}
+	#else
+		const glm::vec3 bottom = axes.Center - axes.B;
+		const glm::vec3 top = axes.Center + axes.B;
+		const glm::vec3 corners[4] = { bottom - axes.A, bottom + axes.A, top + axes.A, top - axes.A };
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			vertices[i].Position = corners[i];
+			vertices[i].Color = color;
+			vertices[i].TexCoord = textureCoords[i];
+			vertices[i].TexIndex = textureIndex;
+			vertices[i].TilingFactor = tilingFactor;
+		}
+	#endif
+	}
+
+	static void WriteQuadInstance(QuadInstanceVertex* instance, const QuadAxes& axes, const glm::vec4& color, const glm::vec2* textureCoords, const float textureIndex, const float tilingFactor)
+	{
+		instance->Center = axes.Center;
+		instance->AxisX = axes.A;
+		instance->AxisY = axes.B;
+		instance->TexCoordRect = glm::vec4(textureCoords[0].x, textureCoords[0].y, textureCoords[2].x, textureCoords[2].y) * tilingFactor;
+		instance->Color = glm::packUnorm4x8(color);
+		instance->TexIndex = textureIndex;
+	}
+
+	/// Writes the quad in the format of the current mode, the caller has to make sure the batch has room for it
+	static void WriteQuad(const QuadAxes& axes, const glm::vec4& color, const glm::vec2* textureCoords, const float textureIndex, const float tilingFactor)
+	{
+		if (s_Data.Specification.QuadMode == Renderer2DQuadMode::Instanced)
+		{
+			WriteQuadInstance(s_Data.QuadInstanceBufferPtr, axes, color, textureCoords, textureIndex, tilingFactor);
+			s_Data.QuadInstanceBufferPtr++;
+			return;
+		}
+
+		WriteQuadVertices(s_Data.QuadVertexBufferPtr, axes, color, textureCoords, textureIndex, tilingFactor);
+		s_Data.QuadVertexBufferPtr += 4;
+	}
 
-		s_Data.QuadVertexArray->AddVertexBuffer(s_Data.QuadVertexBuffer);
+	static uint32_t GetQuadDataSize()
+	{
+		return s_Data.Specification.QuadMode == Renderer2DQuadMode::Instanced ? sizeof(QuadInstanceVertex) : 4 * sizeof(QuadVertex);
+	}
+
+	/// Calls writeQuad with the index of every quad, flushing whenever the batch is full
+	template<typename F>
+	static void WriteQuadBatches(const size_t quadCount, F&& writeQuad)
+	{
+		size_t quadIndex = 0;
+		while (quadIndex < quadCount)
+		{
+			if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
+				Renderer2D::Flush();
+
+			const size_t freeQuads = (s_Data.MaxIndices - s_Data.QuadIndexCount) / 6;
+			const size_t batchQuadCount = std::min(freeQuads, quadCount - quadIndex);
 
-		s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxVertices];
+			for (size_t i = 0; i < batchQuadCount; ++i)
+				writeQuad(quadIndex + i);
+
+			s_Data.QuadIndexCount += static_cast<uint32_t>(batchQuadCount) * 6;
+			s_Data.Stats.QuadCount += static_cast<uint32_t>(batchQuadCount);
+			quadIndex += batchQuadCount;
+		}
+	}
+
+	/// Returns the slot of the texture in the batch, adding it if it's not there yet
+	static float GetTextureIndex(const Ref<Texture2D>& texture)
+	{
+		// Check if the texture is already in the texture slots
+		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+		{
+			if (*s_Data.TextureSlots[i].get() == *texture.get())
+				return static_cast<float>(i);
+		}
+
+		if (s_Data.TextureSlotIndex >= Renderer2DData::TextureArraySlot)
+		{
+			Renderer2D::Flush();
+			s_Data.Stats.TextureLimitFlushes++;
+		}
+
+		const float textureIndex = static_cast<float>(s_Data.TextureSlotIndex);
+		s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
+		s_Data.TextureSlotIndex++;
+
+		return textureIndex;
+	}
+
+	/// The layers of the texture array are encoded as negative indices, starting from -1
+	static float GetTextureIndex(const SubTexture2D& subTexture)
+	{
+		if (!subTexture.IsArrayLayer())
+			return GetTextureIndex(subTexture.GetTexture());
+
+		const Ref<Texture2DArray> textureArray = subTexture.GetTextureArray();
+		if (s_Data.TextureArray && s_Data.TextureArray != textureArray)
+		{
+			Renderer2D::Flush();
+			s_Data.Stats.TextureLimitFlushes++;
+		}
+
+		s_Data.TextureArray = textureArray;
+
+		return -static_cast<float>(subTexture.GetArrayLayer() + 1);
+	}
+
+	/// The texture is either a Ref<Texture2D> or a SubTexture2D
+	template<typename TTexture>
+	static void WriteTexturedQuad(const QuadAxes& axes, const TTexture& texture, const glm::vec2* textureCoords, const float tilingFactor)
+	{
+		if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
+		{
+			Renderer2D::Flush();
+		}
+
+		constexpr glm::vec4 defaultColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		const float textureIndex = GetTextureIndex(texture);
+
+		WriteQuad(axes, defaultColor, textureCoords, textureIndex, tilingFactor);
+
+		s_Data.QuadIndexCount += 6;
+
+		s_Data.Stats.QuadCount++;
+	}
+
+	static QuadBatchBuffer CreateQuadBatchBuffer()
+	{
+		QuadBatchBuffer batchBuffer;
+
+		batchBuffer.QuadVertexBuffer = VertexBuffer::CreateMapped(s_Data.MaxQuads * GetQuadDataSize());
+
+		if (s_Data.Specification.QuadMode == Renderer2DQuadMode::Instanced)
+		{
+			batchBuffer.QuadVertexBuffer->SetLayout(BufferLayout({
+				{ ShaderDataType::Float3, "a_Center" },
+				{ ShaderDataType::Float3, "a_AxisX" },
+				{ ShaderDataType::Float3, "a_AxisY" },
+				{ ShaderDataType::Float4, "a_TexCoordRect" },
+				{ ShaderDataType::Int, "a_Color" },
+				{ ShaderDataType::Float, "a_TexIndex" }
+				}, VertexInputRate::Instance));
+		}
+		else
+		{
+			batchBuffer.QuadVertexBuffer->SetLayout({
+				{ ShaderDataType::Float3, "a_Position" },
+				{ ShaderDataType::Float4, "a_Color"},
+				{ ShaderDataType::Float2, "a_TexCoord" },
+				{ ShaderDataType::Float, "a_TexIndex" },
+				{ ShaderDataType::Float, "a_TilingFactor" }
+				});
+		}
+
+		batchBuffer.QuadVertexArray = VertexArray::Create();
+		batchBuffer.QuadVertexArray->AddVertexBuffer(batchBuffer.QuadVertexBuffer);
+		batchBuffer.QuadVertexArray->SetIndexBuffer(s_Data.QuadIndexBuffer);
+
+		if (batchBuffer.QuadVertexBuffer->GetMappedData())
+			batchBuffer.DrawFence = Fence::Create();
+
+		return batchBuffer;
+	}
+
+	void Renderer2D::Init(const Renderer2DSpecification& specification) 
+	{
+		KBR_PROFILE_FUNCTION();
+
+		s_Data = Renderer2DData();
+		s_Data.Specification = specification;
 
 		uint32_t* quadIndices = new uint32_t[s_Data.MaxIndices];
 
@@ -94,19 +365,36 @@ namespace Kerberos
 			quadIndices[i + 5] = offset + 0;
 		}
 
-		const Ref<IndexBuffer> quadIndexBuffer = IndexBuffer::Create(quadIndices, s_Data.MaxIndices);
-		s_Data.QuadVertexArray->SetIndexBuffer(quadIndexBuffer);
+		s_Data.QuadIndexBuffer = IndexBuffer::Create(quadIndices, s_Data.MaxIndices);
 		delete[] quadIndices;
 
+		s_Data.QuadBatchBuffers.push_back(CreateQuadBatchBuffer());
+		s_Data.QuadVertexBuffersMapped = s_Data.QuadBatchBuffers.front().QuadVertexBuffer->GetMappedData() != nullptr;
+
+		if (s_Data.QuadVertexBuffersMapped)
+		{
+			while (s_Data.QuadBatchBuffers.size() < Renderer2DData::MinQuadBatchBuffers)
+				s_Data.QuadBatchBuffers.push_back(CreateQuadBatchBuffer());
+		}
+		else
+		{
+			KBR_CORE_INFO("Renderer2D: the vertex buffers can't be mapped, the quads are uploaded from a staging buffer");
+			s_Data.QuadStagingBuffer = new uint8_t[s_Data.MaxQuads * GetQuadDataSize()];
+		}
+
 		s_Data.WhiteTexture = AssetManager::GetDefaultTexture2D();
 
-		int32_t samplers[Renderer2DData::MaxTextureSlots];
-		for (int32_t i = 0; i < Renderer2DData::MaxTextureSlots; i++)
+		int32_t samplers[Renderer2DData::TextureArraySlot];
+		for (int32_t i = 0; i < static_cast<int32_t>(Renderer2DData::TextureArraySlot); i++)
 			samplers[i] = i;
 
-		s_Data.Shader = Shader::Create("assets/shaders/shader2d.glsl");
+		s_Data.Shader = Shader::Create(specification.QuadMode == Renderer2DQuadMode::Instanced
+			? "assets/shaders/shader2d_instanced.glsl"
+			: "assets/shaders/shader2d.glsl");
 		s_Data.Shader->Bind();
-		s_Data.Shader->SetIntArray("u_Textures", samplers, Renderer2DData::MaxTextureSlots);
+		s_Data.Shader->SetIntArray("u_Textures", samplers, Renderer2DData::TextureArraySlot);
+		s_Data.Shader->SetInt("u_TextureArray", Renderer2DData::TextureArraySlot);
+		s_Data.ViewProjectionUniform = s_Data.Shader->GetUniform("u_ViewProjection");
 
 		// Set first texture slot to the white texture
 		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
@@ -115,6 +403,18 @@ namespace Kerberos
 	void Renderer2D::Shutdown() 
 	{
 		KBR_PROFILE_FUNCTION();
+
+		delete[] s_Data.QuadStagingBuffer;
+		s_Data.QuadStagingBuffer = nullptr;
+
+		s_Data.QuadBatchBuffers.clear();
+		s_Data.QuadIndexBuffer = nullptr;
+		s_Data.TextureArray = nullptr;
+	}
+
+	const Renderer2DSpecification& Renderer2D::GetSpecification()
+	{
+		return s_Data.Specification;
 	}
 
 	void Renderer2D::BeginScene(const OrthographicCamera& camera) 
@@ -125,12 +425,9 @@ namespace Kerberos
 		s_Data.ViewProjectionMatrix = viewProjection;
 
 		s_Data.Shader->Bind();
-		s_Data.Shader->SetMat4("u_ViewProjection", viewProjection);
-
-		s_Data.QuadIndexCount = 0;
-		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
+		s_Data.Shader->SetMat4(s_Data.ViewProjectionUniform, viewProjection);
 
-		s_Data.TextureSlotIndex = 1;
+		StartBatch();
 	}
 
 	void Renderer2D::BeginScene(const Camera& camera, const glm::mat4& transform)
@@ -141,45 +438,97 @@ namespace Kerberos
 		s_Data.ViewProjectionMatrix = viewProjection;
 
 		s_Data.Shader->Bind();
-		s_Data.Shader->SetMat4("u_ViewProjection", viewProjection);
+		s_Data.Shader->SetMat4(s_Data.ViewProjectionUniform, viewProjection);
 
-		s_Data.QuadIndexCount = 0;
-		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
-
-		s_Data.TextureSlotIndex = 1;
+		StartBatch();
 	}
 
 	void Renderer2D::EndScene() 
 	{
 		KBR_PROFILE_FUNCTION();
 
-		const uint32_t dataSize = static_cast<uint32_t>(reinterpret_cast<uint8_t*>(s_Data.QuadVertexBufferPtr) - reinterpret_cast<uint8_t*>(s_Data.QuadVertexBufferBase));
-		s_Data.QuadVertexBuffer->SetData(s_Data.QuadVertexBufferBase, dataSize);
-
 		Flush();
 	}
 
 	void Renderer2D::Flush()
 	{
+		if (s_Data.QuadIndexCount == 0)
+			return;
+
 		KBR_PROFILE_FUNCTION();
 
+		const QuadBatchBuffer& batchBuffer = s_Data.QuadBatchBuffers[s_Data.QuadBatchBufferIndex];
+
+		const uint32_t quadCount = s_Data.QuadIndexCount / 6;
+		const uint32_t dataSize = quadCount * GetQuadDataSize();
+		if (s_Data.QuadVertexBuffersMapped)
+			batchBuffer.QuadVertexBuffer->FlushMappedData(0, dataSize);
+		else
+			batchBuffer.QuadVertexBuffer->SetData(s_Data.QuadStagingBuffer, dataSize);
+
+		s_Data.Stats.VertexDataSize += dataSize;
+
 		// Bind textures
 		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
 			s_Data.TextureSlots[i]->Bind(i);
 
-		RenderCommand::DrawIndexed(s_Data.QuadVertexArray, s_Data.QuadIndexCount);
+		if (s_Data.TextureArray)
+			s_Data.TextureArray->Bind(Renderer2DData::TextureArraySlot);
+
+		/// The instances are drawn with the indices of the first quad
+		if (s_Data.Specification.QuadMode == Renderer2DQuadMode::Instanced)
+			RenderCommand::DrawIndexedInstanced(batchBuffer.QuadVertexArray, 6, quadCount);
+		else
+			RenderCommand::DrawIndexed(batchBuffer.QuadVertexArray, s_Data.QuadIndexCount);
 
 		s_Data.Stats.DrawCalls++;
+
+		if (s_Data.QuadVertexBuffersMapped)
+		{
+			batchBuffer.DrawFence->Signal();
+			NextBatchBuffer();
+		}
+
+		StartBatch();
 	}
 
-	void Renderer2D::FlushAndReset()
+	void Renderer2D::StartBatch()
 	{
-		EndScene();
-
 		s_Data.QuadIndexCount = 0;
-		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
+
+		void* batchData = s_Data.QuadVertexBuffersMapped
+			? s_Data.QuadBatchBuffers[s_Data.QuadBatchBufferIndex].QuadVertexBuffer->GetMappedData()
+			: s_Data.QuadStagingBuffer;
+
+		s_Data.QuadVertexBufferPtr = static_cast<QuadVertex*>(batchData);
+		s_Data.QuadInstanceBufferPtr = static_cast<QuadInstanceVertex*>(batchData);
 
 		s_Data.TextureSlotIndex = 1;
+		s_Data.TextureArray = nullptr;
+	}
+
+	void Renderer2D::NextBatchBuffer()
+	{
+		const uint32_t nextIndex = (s_Data.QuadBatchBufferIndex + 1) % static_cast<uint32_t>(s_Data.QuadBatchBuffers.size());
+
+		if (s_Data.QuadBatchBuffers[nextIndex].DrawFence->IsSignaled())
+		{
+			s_Data.QuadBatchBufferIndex = nextIndex;
+			return;
+		}
+
+		/// The GPU is still reading the next buffer, a new one is put in front of it instead of waiting
+		if (s_Data.QuadBatchBuffers.size() < Renderer2DData::MaxQuadBatchBuffers)
+		{
+			s_Data.QuadBatchBufferIndex++;
+			s_Data.QuadBatchBuffers.insert(s_Data.QuadBatchBuffers.begin() + s_Data.QuadBatchBufferIndex, CreateQuadBatchBuffer());
+			return;
+		}
+
+		s_Data.QuadBatchBuffers[nextIndex].DrawFence->Wait();
+		s_Data.QuadBatchBufferIndex = nextIndex;
+
+		s_Data.Stats.VertexBufferWaits++;
 	}
 
 	/// ----------------- PRIMITIVES -----------------
@@ -192,34 +541,42 @@ namespace Kerberos
 
 		if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
 		{
-			FlushAndReset();
+			Flush();
 		}
 
-		constexpr glm::vec2 textureCoords[] = {
-		{ 0.0f, 0.0f },
-		{ 1.0f, 0.0f },
-		{ 1.0f, 1.0f },
-		{ 0.0f, 1.0f }
-		};
+		constexpr float textureIndex = 0.0f; /// White texture
+		constexpr float tilingFactor = 1.0f;
 
-		for (size_t i = 0; i < 4; ++i)
-		{
-			constexpr float textureIndex = 0.0f; /// White texture
-			constexpr float tilingFactor = 1.0f;
-
-			s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
-			s_Data.QuadVertexBufferPtr->Color = color;
-			s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_Data.QuadVertexBufferPtr++;
-		}
+		WriteQuad(GetQuadAxes(transform), color, QuadTextureCoords, textureIndex, tilingFactor);
 
 		s_Data.QuadIndexCount += 6;
 
 		s_Data.Stats.QuadCount++;
 	}
 
+	void Renderer2D::DrawQuads(const std::span<const QuadInstance> quads)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		WriteQuadBatches(quads.size(), [quads](const size_t i)
+			{
+				const QuadInstance& quad = quads[i];
+				WriteQuad(GetQuadAxes(quad.Position, quad.Size, quad.Rotation), quad.Color, QuadTextureCoords, 0.0f, 1.0f);
+			});
+	}
+
+	void Renderer2D::DrawQuads(const std::span<const glm::mat4> transforms, const std::span<const glm::vec4> colors)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		KBR_CORE_ASSERT(transforms.size() == colors.size(), "Every quad needs a transform and a color!");
+
+		WriteQuadBatches(transforms.size(), [transforms, colors](const size_t i)
+			{
+				WriteQuad(GetQuadAxes(transforms[i]), colors[i], QuadTextureCoords, 0.0f, 1.0f);
+			});
+	}
+
 	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const float rotation, const glm::vec4& color)
 	{
 		DrawQuad({ position.x, position.y, 0.0f }, size, rotation, color);
@@ -229,11 +586,19 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		const glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::rotate(glm::mat4(1.0f), glm::radians(rotation), { 0.0f, 0.0f, 1.0f })
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+		if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
+		{
+			Flush();
+		}
+
+		constexpr float textureIndex = 0.0f; /// White texture
+		constexpr float tilingFactor = 1.0f;
+
+		WriteQuad(GetQuadAxes(position, size, rotation), color, QuadTextureCoords, textureIndex, tilingFactor);
+
+		s_Data.QuadIndexCount += 6;
 
-		DrawQuad(transform, color);
+		s_Data.Stats.QuadCount++;
 
 #if NO_BATCHING
 		s_Data.Shader->Bind();
@@ -265,11 +630,7 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		const glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::rotate(glm::mat4(1.0f), glm::radians(rotation), { 0.0f, 0.0f, 1.0f })
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-		DrawTexturedQuad(transform, texture, tilingFactor, tintColor);
+		WriteTexturedQuad(GetQuadAxes(position, size, rotation), texture, QuadTextureCoords, tilingFactor);
 
 #if NO_BATCHING
 		s_Data.Shader->Bind();
@@ -294,52 +655,7 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
-		{
-			FlushAndReset();
-		}
-
-		constexpr glm::vec4 defaultColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-		constexpr glm::vec2 textureCoords[] = {
-		{ 0.0f, 0.0f },
-		{ 1.0f, 0.0f },
-		{ 1.0f, 1.0f },
-		{ 0.0f, 1.0f }
-		};
-
-		float textureIndex = 0.0f; /// White texture
-
-		// Check if the texture is already in the texture slots
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
-			{
-				textureIndex = static_cast<float>(i);
-				break;
-			}
-		}
-
-		if (textureIndex == 0.0f)
-		{
-			textureIndex = static_cast<float>(s_Data.TextureSlotIndex);
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
-		}
-
-		for (size_t i = 0; i < 4; ++i)
-		{
-			s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
-			s_Data.QuadVertexBufferPtr->Color = defaultColor;
-			s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_Data.QuadVertexBufferPtr++;
-		}
-
-		s_Data.QuadIndexCount += 6;
-
-		s_Data.Stats.QuadCount++;
+		WriteTexturedQuad(GetQuadAxes(transform), texture, QuadTextureCoords, tilingFactor);
 	}
 
 	void Renderer2D::DrawTexturedQuad(const glm::vec2& position, const glm::vec2& size, const float rotation,
@@ -353,12 +669,7 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		const glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::rotate(glm::mat4(1.0f), glm::radians(rotation), { 0.0f, 0.0f, 1.0f })
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-
-		DrawTexturedQuad(transform, subTexture, tilingFactor, tintColor);
+		WriteTexturedQuad(GetQuadAxes(position, size, rotation), *subTexture, subTexture->GetTexCoords(), tilingFactor);
 
 #if NO_BATCHING
 		s_Data.Shader->Bind();
@@ -384,48 +695,7 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
-		{
-			FlushAndReset();
-		}
-
-		constexpr glm::vec4 defaultColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-		const glm::vec2* textureCoords = subTexture->GetTexCoords();
-		const Ref<Texture2D> texture = subTexture->GetTexture();
-
-		float textureIndex = 0.0f; /// White texture
-
-		// Check if the texture is already in the texture slots
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
-			{
-				textureIndex = static_cast<float>(i);
-				break;
-			}
-		}
-
-		if (textureIndex == 0.0f)
-		{
-			textureIndex = static_cast<float>(s_Data.TextureSlotIndex);
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
-		}
-
-		for (size_t i = 0; i < 4; ++i)
-		{
-			s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
-			s_Data.QuadVertexBufferPtr->Color = defaultColor;
-			s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_Data.QuadVertexBufferPtr++;
-		}
-
-		s_Data.QuadIndexCount += 6;
-
-		s_Data.Stats.QuadCount++;
+		WriteTexturedQuad(GetQuadAxes(transform), *subTexture, subTexture->GetTexCoords(), tilingFactor);
 	}
 
 	/// -------------------------------------------------------
@@ -5,18 +5,48 @@
 #include "Texture.h"
 #include "SubTexture2D.h"
 
+#include <span>
+
 namespace Kerberos
 {
+	/// A colored quad for DrawQuads, the same as the arguments of DrawQuad
+	struct QuadInstance
+	{
+		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
+		glm::vec2 Size = { 1.0f, 1.0f };
+		/// In degrees, around the z axis
+		float Rotation = 0.0f;
+		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	};
+
+	/// How the quads are handed to the GPU
+	enum class Renderer2DQuadMode : uint8_t
+	{
+		/// Every quad is expanded to four vertices on the CPU
+		Vertices = 0,
+		/// Every quad is a single instance, the vertex shader expands the unit quad.
+		/// Uploads about a third of the data, but the quads stay parallel to the xy plane and the colors are 8 bits per channel.
+		Instanced,
+	};
+
+	struct Renderer2DSpecification
+	{
+		Renderer2DQuadMode QuadMode = Renderer2DQuadMode::Vertices;
+	};
+
 	class Renderer2D
 	{
 	public:
-		static void Init();
+		static void Init(const Renderer2DSpecification& specification = Renderer2DSpecification());
 		static void Shutdown();
 
+		static const Renderer2DSpecification& GetSpecification();
+
 		static void BeginScene(const OrthographicCamera& camera);
 		static void BeginScene(const Camera& camera, const glm::mat4& transform);
 		static void EndScene();
 
+		/// Draws the quads recorded so far and starts a new batch
 		static void Flush();
 
 		// Primitives
@@ -25,6 +55,14 @@ namespace Kerberos
 		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawQuad(const glm::mat4& transform, const glm::vec4& color);
 
+		/**
+		* @brief Draws many colored quads at once, splitting them into as many batches as needed.
+		* Cheaper than calling DrawQuad for each of them, the batch is only checked once per batch instead of once per quad.
+		*/
+		static void DrawQuads(std::span<const QuadInstance> quads);
+		/// The transforms and colors of the quads, both spans must have the same size
+		static void DrawQuads(std::span<const glm::mat4> transforms, std::span<const glm::vec4> colors);
+
 		static void DrawTexturedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 		static void DrawTexturedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 		static void DrawTexturedQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor);
@@ -39,6 +77,12 @@ namespace Kerberos
 		{
 			uint32_t DrawCalls = 0;
 			uint32_t QuadCount = 0;
+			/// The times every mapped vertex buffer was still read by the GPU, and the CPU had to wait for one
+			uint32_t VertexBufferWaits = 0;
+			/// The vertices or instances written for the quads
+			uint64_t VertexDataSize = 0;
+			/// The batches flushed early, because every texture slot was taken or a different texture array was used
+			uint32_t TextureLimitFlushes = 0;
 			uint32_t GetTotalVertexCount() const { return QuadCount * 4; }
 			uint32_t GetTotalIndexCount() const { return QuadCount * 6; }
 		};
@@ -47,6 +91,8 @@ namespace Kerberos
 		static void ResetStatistics();
 
 	private:
-		static void FlushAndReset();
+		static void StartBatch();
+		/// Moves to the next mapped vertex buffer the GPU is not reading anymore
+		static void NextBatchBuffer();
 	};
 }
@@ -19,6 +19,38 @@ namespace Kerberos
 		alignas(4) float Shininess = 10.f;
 	};
 
+	/// A glyph quad in the space of the font, before the text's transform is applied
+	struct GlyphQuad
+	{
+		glm::vec2 QuadMin;
+		glm::vec2 QuadMax;
+		glm::vec2 TexCoordMin;
+		glm::vec2 TexCoordMax;
+	};
+
+	struct GlyphRun
+	{
+		std::vector<GlyphQuad> Quads;
+		uint64_t LastUsedFrame = 0;
+	};
+
+	/// The glyph runs laid out with a font. The font is kept as a weak reference,
+	/// so a new font allocated at the address of a destroyed one doesn't reuse its runs.
+	struct FontGlyphRuns
+	{
+		std::weak_ptr<Font> RunFont;
+		std::unordered_map<std::string, GlyphRun> Runs;
+	};
+
+	/// The uniforms the renderer sets on the shaders the meshes are drawn with
+	struct MeshShaderUniforms
+	{
+		ShaderUniform Texture;
+		ShaderUniform ShadowMap;
+		ShaderUniform GlobalAmbientColor;
+		ShaderUniform GlobalAmbientIntensity;
+	};
+
 	struct Renderer3DData
 	{
 		Ref<Shader> ActiveShader;
@@ -28,14 +60,37 @@ namespace Kerberos
 		Ref<Shader> WireframeShader = nullptr;
 		Ref<Shader> ShadowMapShader = nullptr;
 
+		/// Resolved once when the shaders are created
+		MeshShaderUniforms GeometryUniforms;
+		MeshShaderUniforms WireframeUniforms;
+		MeshShaderUniforms ShadowMapUniforms;
+
+		static constexpr uint32_t MaxTextQuads = 10000;
+		static constexpr uint32_t MaxTextVertices = MaxTextQuads * 4;
+		static constexpr uint32_t MaxTextIndices = MaxTextQuads * 6;
+
+		/// Glyph runs not used for this many frames are removed from the cache
+		static constexpr uint64_t GlyphRunLifetime = 120;
+
 		Ref<Shader>			TextShader = nullptr;
+		ShaderUniform		TextFontAtlasUniform;
 		Ref<VertexArray>	TextVertexArray = nullptr;
 		Ref<VertexBuffer>	TextVertexBuffer = nullptr;
 		Ref<IndexBuffer>	TextIndexBuffer = nullptr;
 
+		/// The glyph quads of the current text batch, which all use the same font atlas
+		uint32_t TextIndexCount = 0;
+		TextVertex* TextVertexBufferBase = nullptr;
+		TextVertex* TextVertexBufferPtr = nullptr;
+		Ref<Texture2D> TextAtlasTexture = nullptr;
+
+		std::unordered_map<const Font*, FontGlyphRuns> GlyphRunCache;
+		uint64_t TextFrameIndex = 0;
+
 		const DirectionalLight* pSunLight = nullptr;
 
 		Ref<Shader>			SkyboxShader = nullptr;
+		ShaderUniform		SkyboxEntityIDUniform;
 		Ref<TextureCube>	SkyboxTexture = nullptr;
 		Ref<VertexArray>	SkyboxVertexArray = nullptr;
 
@@ -83,9 +138,33 @@ namespace Kerberos
 
 		Ref<UniformBuffer> PerObjectUniformBuffer = nullptr;
 
-		/// The currently active texture, used for binding textures
-		/// This is used to avoid binding the same texture multiple times
-		Ref<Texture2D> ActiveTexture = nullptr;
+		/// The draw packets of the current frame. Each pass appends its packets,
+		/// and sorts and draws the range starting at RenderQueuePassBegin in EndPass.
+		std::vector<Renderer3D::DrawPacket> RenderQueue;
+		size_t RenderQueuePassBegin = 0;
+
+		/// Set by EndScene, so the queue of the last frame stays inspectable until the next frame starts
+		bool ClearRenderQueue = true;
+
+		/// A run of packets drawn with one instanced draw call
+		struct InstanceBatch
+		{
+			const Renderer3D::DrawPacket* Packet = nullptr;
+			uint32_t BaseInstance = 0;
+			uint32_t InstanceCount = 0;
+		};
+
+		static constexpr uint32_t MaxInstances = 16384;
+
+		Ref<VertexBuffer> InstanceVertexBuffer = nullptr;
+		std::vector<InstanceVertex> InstanceData;
+		std::vector<InstanceBatch> InstanceBatches;
+
+		/// The state bound while executing the render queue, so only the changes have to be bound
+		const Shader* BoundShader = nullptr;
+		const Texture2D* BoundTexture = nullptr;
+		const Mesh* BoundMesh = nullptr;
+		const Material* BoundMaterial = nullptr;
 
 		constexpr static uint32_t MaterialTextureSlot = 0;
 		constexpr static uint32_t ShadowMapTextureSlot = 1;
@@ -96,6 +175,27 @@ namespace Kerberos
 
 	static Renderer3D::Statistics s_Stats;
 
+	static MeshShaderUniforms GetMeshShaderUniforms(const Shader& shader)
+	{
+		MeshShaderUniforms uniforms;
+		uniforms.Texture = shader.GetUniform("u_Texture");
+		uniforms.ShadowMap = shader.GetUniform("u_ShadowMap");
+		uniforms.GlobalAmbientColor = shader.GetUniform("u_GlobalAmbientColor");
+		uniforms.GlobalAmbientIntensity = shader.GetUniform("u_GlobalAmbientIntensity");
+		return uniforms;
+	}
+
+	/// The meshes are only drawn with the shaders created in Init, so no names have to be looked up while drawing
+	static const MeshShaderUniforms& FindMeshShaderUniforms(const Shader* shader)
+	{
+		if (shader == s_RendererData.WireframeShader.get())
+			return s_RendererData.WireframeUniforms;
+		if (shader == s_RendererData.ShadowMapShader.get())
+			return s_RendererData.ShadowMapUniforms;
+
+		KBR_CORE_ASSERT(shader == s_RendererData.GeometryShader.get(), "Unknown mesh shader!");
+		return s_RendererData.GeometryUniforms;
+	}
 
 	void Renderer3D::Init() 
 	{
@@ -117,12 +217,16 @@ namespace Kerberos
 		s_RendererData.WireframeShader->SetDebugName("Wireframe");
 		s_RendererData.ShadowMapShader->SetDebugName("Shadow Map");
 		s_RendererData.TextShader->SetDebugName("Text");
+		s_RendererData.TextFontAtlasUniform = s_RendererData.TextShader->GetUniform("u_FontAtlas");
+
+		s_RendererData.GeometryUniforms = GetMeshShaderUniforms(*s_RendererData.GeometryShader);
+		s_RendererData.WireframeUniforms = GetMeshShaderUniforms(*s_RendererData.WireframeShader);
+		s_RendererData.ShadowMapUniforms = GetMeshShaderUniforms(*s_RendererData.ShadowMapShader);
 
 		/// Set the default shader to the base shader
 		s_RendererData.ActiveShader = s_RendererData.GeometryShader;
 
 		s_RendererData.WhiteTexture = AssetManager::GetDefaultTexture2D();
-		s_RendererData.ActiveTexture = s_RendererData.WhiteTexture;
 
 		s_RendererData.SkyboxShader = Shader::Create("assets/shaders/skybox.glsl");
 		const std::vector<float> skyboxVertices = {
@@ -175,19 +279,35 @@ namespace Kerberos
 		});
 		s_RendererData.SkyboxVertexArray->AddVertexBuffer(skyboxVertexBuffer);
 		s_RendererData.SkyboxShader->SetDebugName("Skybox");
+		s_RendererData.SkyboxEntityIDUniform = s_RendererData.SkyboxShader->GetUniform("u_EntityID");
 
 		s_RendererData.TextVertexArray = VertexArray::Create();
 		s_RendererData.TextVertexArray->SetDebugName("Text Vertex Array");
-		const std::array<uint32_t, 6> textIndices = { 0, 1, 2, 2, 3, 0 };
+
+		std::vector<uint32_t> textIndices(Renderer3DData::MaxTextIndices);
+		for (uint32_t i = 0, offset = 0; i < Renderer3DData::MaxTextIndices; i += 6, offset += 4)
+		{
+			textIndices[i + 0] = offset + 0;
+			textIndices[i + 1] = offset + 1;
+			textIndices[i + 2] = offset + 2;
+
+			textIndices[i + 3] = offset + 2;
+			textIndices[i + 4] = offset + 3;
+			textIndices[i + 5] = offset + 0;
+		}
+
 		s_RendererData.TextIndexBuffer = IndexBuffer::Create(textIndices.data(), static_cast<uint32_t>(textIndices.size()));
 		s_RendererData.TextIndexBuffer->SetDebugName("Text Index Buffer");
 		s_RendererData.TextVertexArray->SetIndexBuffer(s_RendererData.TextIndexBuffer);
-		constexpr uint32_t textVertexBufferSize = sizeof(TextVertex) * 4;
+		constexpr uint32_t textVertexBufferSize = sizeof(TextVertex) * Renderer3DData::MaxTextVertices;
 		s_RendererData.TextVertexBuffer = VertexBuffer::Create(textVertexBufferSize);
 		s_RendererData.TextVertexBuffer->SetDebugName("Text Vertex Buffer");
 		s_RendererData.TextVertexBuffer->SetLayout(TextVertex::GetLayout());
 		s_RendererData.TextVertexArray->AddVertexBuffer(s_RendererData.TextVertexBuffer);
 
+		s_RendererData.TextVertexBufferBase = new TextVertex[Renderer3DData::MaxTextVertices];
+		s_RendererData.TextVertexBufferPtr = s_RendererData.TextVertexBufferBase;
+
 		s_RendererData.CameraUniformBuffer = UniformBuffer::Create(sizeof(Renderer3DData::CameraData), 0);
 		s_RendererData.CameraUniformBuffer->SetDebugName("Camera Uniform Buffer");
 
@@ -200,12 +320,24 @@ namespace Kerberos
 		s_RendererData.ShadowUniformBuffer = UniformBuffer::Create(sizeof(Renderer3DData::ShadowDataUbo), 3);
 		s_RendererData.ShadowUniformBuffer->SetDebugName("Shadow Uniform Buffer");
 
+		constexpr uint32_t instanceBufferSize = Renderer3DData::MaxInstances * sizeof(InstanceVertex);
+		s_RendererData.InstanceVertexBuffer = VertexBuffer::Create(instanceBufferSize);
+		s_RendererData.InstanceVertexBuffer->SetDebugName("Instance Vertex Buffer");
+		s_RendererData.InstanceVertexBuffer->SetLayout(InstanceVertex::GetLayout());
+		s_RendererData.InstanceData.reserve(Renderer3DData::MaxInstances);
+
 		ResetStatistics();
 	}
 
 	void Renderer3D::Shutdown() 
 	{
 		KBR_PROFILE_FUNCTION();
+
+		delete[] s_RendererData.TextVertexBufferBase;
+		s_RendererData.TextVertexBufferBase = nullptr;
+		s_RendererData.TextVertexBufferPtr = nullptr;
+
+		s_RendererData.GlyphRunCache.clear();
 	}
 
 	void Renderer3D::BeginShadowPass(const DirectionalLight& light, const ShadowMapSettings& settings, const Ref<Framebuffer>& shadowMapFramebuffer) 
@@ -213,6 +345,7 @@ namespace Kerberos
 		KBR_PROFILE_FUNCTION();
 
 		s_RendererData.CurrentPass = RenderPass::Shadow;
+		BeginRenderQueue();
 
 		s_RendererData.ShadowMapFramebuffer = shadowMapFramebuffer;
 		shadowMapFramebuffer->Bind();
@@ -228,6 +361,10 @@ namespace Kerberos
 
 	void Renderer3D::EndPass() 
 	{
+		KBR_PROFILE_FUNCTION();
+
+		FlushRenderQueue();
+
 		if (s_RendererData.CurrentPass == RenderPass::Shadow)
 		{
 			s_RendererData.ShadowMapFramebuffer->Unbind();
@@ -240,6 +377,7 @@ namespace Kerberos
 		KBR_PROFILE_FUNCTION();
 
 		s_RendererData.CurrentPass = RenderPass::Geometry;
+		BeginRenderQueue();
 
 		const auto& viewProjection = camera.GetViewProjectionMatrix();
 		s_RendererData.CameraData.ViewMatrix = camera.GetViewMatrix();
@@ -283,6 +421,7 @@ namespace Kerberos
 		KBR_PROFILE_FUNCTION();
 
 		s_RendererData.CurrentPass = RenderPass::Geometry;
+		BeginRenderQueue();
 
 		const glm::mat4& viewProjection = camera.GetProjection() * glm::inverse(transform);
 		s_RendererData.CameraData.ViewMatrix = glm::inverse(transform);
@@ -325,6 +464,24 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
+		s_RendererData.ClearRenderQueue = true;
+
+		FlushText();
+		s_RendererData.TextAtlasTexture = nullptr;
+
+		/// Remove the glyph runs that weren't used for a while
+		const uint64_t frameIndex = s_RendererData.TextFrameIndex++;
+		for (auto fontIt = s_RendererData.GlyphRunCache.begin(); fontIt != s_RendererData.GlyphRunCache.end();)
+		{
+			auto& runs = fontIt->second.Runs;
+			std::erase_if(runs, [frameIndex](const auto& entry) { return entry.second.LastUsedFrame + Renderer3DData::GlyphRunLifetime < frameIndex; });
+
+			if (runs.empty() || fontIt->second.RunFont.expired())
+				fontIt = s_RendererData.GlyphRunCache.erase(fontIt);
+			else
+				++fontIt;
+		}
+
 		/// Render the skybox last if enabled
 		if (s_RendererData.SkyboxTexture == nullptr)
 			return;
@@ -341,7 +498,7 @@ namespace Kerberos
 		s_RendererData.CameraUniformBuffer->SetData(&s_RendererData.CameraData.ViewMatrix, sizeof(Renderer3DData::CameraDataUbo::ViewMatrix), viewMatrixOffset);
 
 		/// Set the hovered entity's id to an invalid value
-		s_RendererData.SkyboxShader->SetInt("u_EntityID", -1);
+		s_RendererData.SkyboxShader->SetInt(s_RendererData.SkyboxEntityIDUniform, -1);
 
 		s_RendererData.SkyboxVertexArray->Bind();
 		s_RendererData.SkyboxTexture->Bind(0);
@@ -366,6 +523,8 @@ namespace Kerberos
 			return;
 		}
 
+		s_Stats.SubmittedMeshes++;
+
 		if (s_RendererData.CurrentPass == RenderPass::Shadow && !castShadows)
 		{
 			/// Skip rendering this mesh in shadow pass if it doesn't cast shadows
@@ -373,60 +532,41 @@ namespace Kerberos
 		}
 
 		//const Ref<Shader> shaderToUse = material->MaterialShader ? material->MaterialShader : s_RendererData.ActiveShader;
-		const Ref<Shader> shaderToUse = s_RendererData.ActiveShader;
-		shaderToUse->Bind();
-
-		s_RendererData.PerObjectData.ModelMatrix = transform;
-		s_RendererData.PerObjectData.EntityID = entityID;
-		s_RendererData.PerObjectData.Material = { .Diffuse = material->Diffuse,
-			.Specular = material->Specular, .Ambient = material->Ambient, .Shininess = material->Shininess };
-
-		s_RendererData.PerObjectUniformBuffer->SetData(&s_RendererData.PerObjectData, sizeof(Renderer3DData::PerObjectData), 0);
-
-		const Ref<Texture2D> textureToUse = texture ? texture : s_RendererData.WhiteTexture;
-		constexpr int textureSlot = Renderer3DData::MaterialTextureSlot;
-		if (s_RendererData.ActiveTexture != textureToUse)
-		{
-			s_RendererData.ActiveTexture = textureToUse;
-			textureToUse->Bind(textureSlot);
-		}
-		shaderToUse->SetInt("u_Texture", textureSlot);
-
-		mesh->GetVertexArray()->Bind();
-		
-		RenderCommand::DrawIndexed(mesh->GetVertexArray(), mesh->GetIndexCount());
-
-		s_Stats.DrawCalls++;
-		s_Stats.DrawnMeshes++;
-		s_Stats.Vertices += mesh->GetVertexCount();
-		s_Stats.Faces += mesh->GetIndexCount() / 3;
+		Shader* shaderToUse = s_RendererData.ActiveShader.get();
+
+		/// The shadow pass only writes depth, so meshes with different materials can be drawn together
+		const bool usesMaterial = s_RendererData.CurrentPass != RenderPass::Shadow;
+		const Texture2D* textureToUse = usesMaterial ? (texture ? texture.get() : s_RendererData.WhiteTexture.get()) : nullptr;
+		const Material* materialToUse = usesMaterial ? material.get() : nullptr;
+
+		DrawPacket& packet = s_RendererData.RenderQueue.emplace_back();
+		packet.SortKey = CreateSortKey(s_RendererData.CurrentPass, shaderToUse, textureToUse, mesh.get(), materialToUse, transform);
+		packet.DrawMesh = mesh.get();
+		packet.DrawMaterial = materialToUse;
+		packet.DrawTexture = textureToUse;
+		packet.DrawShader = shaderToUse;
+		packet.Transform = transform;
+		packet.EntityID = entityID;
+		packet.Pass = s_RendererData.CurrentPass;
 	}
 
-	void Renderer3D::SubmitText(const std::string& text, const Ref<Font>& font, const glm::mat4& transform,
-		const glm::vec4& color, const float fontSize, int entityID)
+	/// Lays out the glyphs of the text in the space of the font
+	static void LayoutGlyphRun(const Font& font, const std::string& text, std::vector<GlyphQuad>& quads)
 	{
-		const Ref<Texture2D> fontAtlas = font->GetAtlasTexture();
-		const FontMetrics& metrics = font->GetMetrics();
-
-		constexpr int fontAtlasTextureSlot = Renderer3DData::FontAtlasTextureSlot;
-		s_RendererData.TextShader->Bind();
-		s_RendererData.TextShader->SetInt("u_FontAtlas", fontAtlasTextureSlot);
-		fontAtlas->Bind(fontAtlasTextureSlot);
-
-		float textScale = fontSize * 0.1f;
-		glm::mat4 scaledTransform = transform * glm::scale(glm::mat4(1.0f), glm::vec3(textScale));
+		KBR_PROFILE_FUNCTION();
 
-		s_RendererData.PerObjectData.ModelMatrix = scaledTransform;
-		s_RendererData.PerObjectData.EntityID = entityID; // Currently this is not used, we submit the entity ID per vertex
+		const FontMetrics& metrics = font.GetMetrics();
+		const Ref<Texture2D> fontAtlas = font.GetAtlasTexture();
 
-		/*constexpr int modelMatrixOffset = offsetof(Renderer3DData::PerObjectDataUbo, ModelMatrix);
-		s_RendererData.PerObjectUniformBuffer->SetData(&s_RendererData.PerObjectData, sizeof(Renderer3DData::PerObjectData.ModelMatrix), modelMatrixOffset);*/
-		s_RendererData.PerObjectUniformBuffer->SetData(&s_RendererData.PerObjectData, sizeof(Renderer3DData::PerObjectData), 0);
+		const float texelWidth = 1.0f / static_cast<float>(fontAtlas->GetWidth());
+		const float texelHeight = 1.0f / static_cast<float>(fontAtlas->GetHeight());
 
 		double x = 0.0;
 		const double fsScale = 1.0 / (metrics.Ascender - metrics.Descender);
 		double y = 0.0;
 
+		quads.reserve(text.size());
+
 		for (size_t i = 0; i < text.size(); ++i)
 		{
 			char character = text[i];
@@ -441,11 +581,11 @@ namespace Kerberos
 				continue;
 			}
 
-			const bool hasGlyph = font->HasCharacter(character);
+			const bool hasGlyph = font.HasCharacter(character);
 			if (!hasGlyph) 
 			{
 				constexpr char placeholderChar = '?';
-				if (!font->HasCharacter(placeholderChar))
+				if (!font.HasCharacter(placeholderChar))
 				{
 					KBR_CORE_WARN("Font does not contain character '{}' and no placeholder character '{}' found!", character, placeholderChar);
 					return;
@@ -458,12 +598,12 @@ namespace Kerberos
 			}
 
 			double al, ab, ar, at;
-			font->GetQuadAtlasBounds(character, al, ab, ar, at);
+			font.GetQuadAtlasBounds(character, al, ab, ar, at);
 			glm::vec2 texCoordMin(static_cast<float>(al), static_cast<float>(ab));
 			glm::vec2 texCoordMax(static_cast<float>(ar), static_cast<float>(at));
 
 			double pl, pb, pr, pt;
-			font->GetQuadPlaneBounds(character, pl, pb, pr, pt);
+			font.GetQuadPlaneBounds(character, pl, pb, pr, pt);
 			glm::vec2 quadMin(static_cast<float>(pl), static_cast<float>(pb));
 			glm::vec2 quadMax(static_cast<float>(pr), static_cast<float>(pt));
 
@@ -472,46 +612,16 @@ namespace Kerberos
 			quadMin += glm::vec2(x, y);
 			quadMax += glm::vec2(x, y);
 
-			float texelWidth = 1.0f / static_cast<float>(fontAtlas->GetWidth());
-			float texelHeight = 1.0f / static_cast<float>(fontAtlas->GetHeight());
 			texCoordMin *= glm::vec2(texelWidth, texelHeight);
 			texCoordMax *= glm::vec2(texelWidth, texelHeight);
 
-			std::array<TextVertex, 4> vertices;
-			vertices[0].Position = glm::vec3(quadMin, 0.0f);
-			vertices[0].Color = color;
-			vertices[0].TexCoord = texCoordMin;
-			vertices[0].EntityID = entityID;
-
-			vertices[1].Position = glm::vec3(quadMin.x, quadMax.y, 0.0f);
-			vertices[1].Color = color;
-			vertices[1].TexCoord = { texCoordMin.x, texCoordMax.y };
-			vertices[1].EntityID = entityID;
-
-			vertices[2].Position = glm::vec3(quadMax, 0.0f);
-			vertices[2].Color = color;
-			vertices[2].TexCoord = texCoordMax;
-			vertices[2].EntityID = entityID;
-
-			vertices[3].Position = glm::vec3(quadMax.x, quadMin.y, 0.0f);
-			vertices[3].Color = color;
-			vertices[3].TexCoord = { texCoordMax.x, texCoordMin.y };
-			vertices[3].EntityID = entityID;
-
-			constexpr uint32_t vbSize = static_cast<uint32_t>(vertices.size()) * sizeof(TextVertex);
-			s_RendererData.TextVertexBuffer->SetData(vertices.data(), vbSize);
-
-			RenderCommand::DrawIndexed(s_RendererData.TextVertexArray, 6);
-
-			s_Stats.Vertices += 4;
-			s_Stats.Faces += 2;
-			s_Stats.DrawCalls++;
+			quads.push_back({ quadMin, quadMax, texCoordMin, texCoordMax });
 
 			if (i < text.size() - 1)
 			{
-				double advance = font->GetAdvance(character);
+				double advance = font.GetAdvance(character);
 				char nextCharacter = text[i + 1];
-				font->GetNextAdvance(advance, character, nextCharacter);
+				font.GetNextAdvance(advance, character, nextCharacter);
 
 				float kerningOffset = 0.0f;
 				x += fsScale * advance + kerningOffset;
@@ -519,15 +629,139 @@ namespace Kerberos
 		}
 	}
 
+	/// Returns the cached glyph run of the text, laying it out if it isn't cached yet
+	static const GlyphRun& GetGlyphRun(const Ref<Font>& font, const std::string& text)
+	{
+		FontGlyphRuns& fontRuns = s_RendererData.GlyphRunCache[font.get()];
+		if (fontRuns.RunFont.lock() != font)
+		{
+			fontRuns.RunFont = font;
+			fontRuns.Runs.clear();
+		}
+
+		auto it = fontRuns.Runs.find(text);
+		if (it == fontRuns.Runs.end())
+		{
+			it = fontRuns.Runs.emplace(text, GlyphRun{}).first;
+			LayoutGlyphRun(*font, text, it->second.Quads);
+		}
+
+		it->second.LastUsedFrame = s_RendererData.TextFrameIndex;
+		return it->second;
+	}
+
+	void Renderer3D::SubmitText(const std::string& text, const Ref<Font>& font, const glm::mat4& transform,
+		const glm::vec4& color, const float fontSize, const int entityID)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		const GlyphRun& run = GetGlyphRun(font, text);
+		if (run.Quads.empty())
+			return;
+
+		/// The batch uses a single atlas, so a different font starts a new batch
+		const Ref<Texture2D> fontAtlas = font->GetAtlasTexture();
+		if (s_RendererData.TextAtlasTexture != fontAtlas)
+		{
+			FlushText();
+			s_RendererData.TextAtlasTexture = fontAtlas;
+		}
+
+		/// The runs are laid out in the space of the font, the size only scales them
+		const float textScale = fontSize * 0.1f;
+		const glm::mat4 scaledTransform = transform * glm::scale(glm::mat4(1.0f), glm::vec3(textScale));
+
+		for (const GlyphQuad& quad : run.Quads)
+		{
+			if (s_RendererData.TextIndexCount >= Renderer3DData::MaxTextIndices)
+				FlushText();
+
+			TextVertex*& vertex = s_RendererData.TextVertexBufferPtr;
+
+			vertex->Position = glm::vec3(scaledTransform * glm::vec4(quad.QuadMin, 0.0f, 1.0f));
+			vertex->Color = color;
+			vertex->TexCoord = quad.TexCoordMin;
+			vertex->EntityID = entityID;
+			vertex++;
+
+			vertex->Position = glm::vec3(scaledTransform * glm::vec4(quad.QuadMin.x, quad.QuadMax.y, 0.0f, 1.0f));
+			vertex->Color = color;
+			vertex->TexCoord = { quad.TexCoordMin.x, quad.TexCoordMax.y };
+			vertex->EntityID = entityID;
+			vertex++;
+
+			vertex->Position = glm::vec3(scaledTransform * glm::vec4(quad.QuadMax, 0.0f, 1.0f));
+			vertex->Color = color;
+			vertex->TexCoord = quad.TexCoordMax;
+			vertex->EntityID = entityID;
+			vertex++;
+
+			vertex->Position = glm::vec3(scaledTransform * glm::vec4(quad.QuadMax.x, quad.QuadMin.y, 0.0f, 1.0f));
+			vertex->Color = color;
+			vertex->TexCoord = { quad.TexCoordMax.x, quad.TexCoordMin.y };
+			vertex->EntityID = entityID;
+			vertex++;
+
+			s_RendererData.TextIndexCount += 6;
+		}
+	}
+
+	void Renderer3D::FlushText()
+	{
+		if (s_RendererData.TextIndexCount == 0)
+			return;
+
+		KBR_PROFILE_FUNCTION();
+
+		const auto vertexCount = static_cast<uint32_t>(s_RendererData.TextVertexBufferPtr - s_RendererData.TextVertexBufferBase);
+		s_RendererData.TextVertexBuffer->SetData(s_RendererData.TextVertexBufferBase, vertexCount * sizeof(TextVertex));
+
+		constexpr int fontAtlasTextureSlot = Renderer3DData::FontAtlasTextureSlot;
+		s_RendererData.TextShader->Bind();
+		s_RendererData.TextShader->SetInt(s_RendererData.TextFontAtlasUniform, fontAtlasTextureSlot);
+		s_RendererData.TextAtlasTexture->Bind(fontAtlasTextureSlot);
+
+		RenderCommand::DrawIndexed(s_RendererData.TextVertexArray, s_RendererData.TextIndexCount);
+
+		s_Stats.Vertices += vertexCount;
+		s_Stats.Faces += s_RendererData.TextIndexCount / 3;
+		s_Stats.DrawCalls++;
+
+		s_RendererData.TextIndexCount = 0;
+		s_RendererData.TextVertexBufferPtr = s_RendererData.TextVertexBufferBase;
+	}
+
+	const Ref<VertexBuffer>& Renderer3D::GetInstanceVertexBuffer()
+	{
+		KBR_CORE_ASSERT(s_RendererData.InstanceVertexBuffer, "Renderer3D has to be initialized before creating meshes!");
+		return s_RendererData.InstanceVertexBuffer;
+	}
+
+	const std::vector<Renderer3D::DrawPacket>& Renderer3D::GetRenderQueue()
+	{
+		return s_RendererData.RenderQueue;
+	}
+
+	void Renderer3D::AddCulledMeshes(const uint32_t count)
+	{
+		s_Stats.CulledMeshes += count;
+	}
+
+	const glm::mat4& Renderer3D::GetShadowLightSpaceMatrix()
+	{
+		return s_RendererData.ShadowData.LightSpaceMatrix;
+	}
+
 	void Renderer3D::SetGlobalAmbientLight(const glm::vec3& color, const float intensity) 
 	{
 		s_RendererData.LightsData.GlobalAmbientColor = color;
 		s_RendererData.LightsData.GlobalAmbientIntensity = intensity;
 		if (s_RendererData.ActiveShader)
 		{
+			const MeshShaderUniforms& uniforms = FindMeshShaderUniforms(s_RendererData.ActiveShader.get());
 			s_RendererData.ActiveShader->Bind();
-			s_RendererData.ActiveShader->SetFloat3("u_GlobalAmbientColor", s_RendererData.LightsData.GlobalAmbientColor);
-			s_RendererData.ActiveShader->SetFloat("u_GlobalAmbientIntensity", s_RendererData.LightsData.GlobalAmbientIntensity);
+			s_RendererData.ActiveShader->SetFloat3(uniforms.GlobalAmbientColor, s_RendererData.LightsData.GlobalAmbientColor);
+			s_RendererData.ActiveShader->SetFloat(uniforms.GlobalAmbientIntensity, s_RendererData.LightsData.GlobalAmbientIntensity);
 		}
 	}
 
@@ -547,6 +781,11 @@ namespace Kerberos
 		s_Stats.DrawnMeshes = 0;
 		s_Stats.Faces = 0;
 		s_Stats.Vertices = 0;
+		s_Stats.SubmittedMeshes = 0;
+		s_Stats.CulledMeshes = 0;
+		s_Stats.ShaderBinds = 0;
+		s_Stats.TextureBinds = 0;
+		s_Stats.VertexArrayBinds = 0;
 	}
 
 	void Renderer3D::SetupShadowCamera(const DirectionalLight& light, const ShadowMapSettings& settings)
@@ -581,6 +820,166 @@ namespace Kerberos
 		/*auto shadowMapTexture = s_RendererData.ShadowMapFramebuffer->GetDepthAttachmentRendererID();*/
 		constexpr int shadowMapTextureSlot = Renderer3DData::ShadowMapTextureSlot;
 		s_RendererData.ShadowMapFramebuffer->BindDepthTexture(shadowMapTextureSlot);
-		s_RendererData.ActiveShader->SetInt("u_ShadowMap", shadowMapTextureSlot);
+		s_RendererData.ActiveShader->SetInt(FindMeshShaderUniforms(s_RendererData.ActiveShader.get()).ShadowMap, shadowMapTextureSlot);
+	}
+
+	void Renderer3D::BeginRenderQueue()
+	{
+		if (s_RendererData.ClearRenderQueue)
+		{
+			s_RendererData.RenderQueue.clear();
+			s_RendererData.ClearRenderQueue = false;
+		}
+
+		s_RendererData.RenderQueuePassBegin = s_RendererData.RenderQueue.size();
+	}
+
+	void Renderer3D::FlushRenderQueue()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		auto& queue = s_RendererData.RenderQueue;
+		const auto passBegin = queue.begin() + static_cast<std::ptrdiff_t>(s_RendererData.RenderQueuePassBegin);
+		if (passBegin == queue.end())
+			return;
+
+		std::sort(passBegin, queue.end(), [](const DrawPacket& a, const DrawPacket& b) { return a.SortKey < b.SortKey; });
+
+		s_RendererData.BoundShader = nullptr;
+		s_RendererData.BoundTexture = nullptr;
+		s_RendererData.BoundMesh = nullptr;
+		s_RendererData.BoundMaterial = nullptr;
+
+		auto& instances = s_RendererData.InstanceData;
+		auto& batches = s_RendererData.InstanceBatches;
+		instances.clear();
+		batches.clear();
+
+		const auto canBatch = [](const DrawPacket& a, const DrawPacket& b)
+			{
+				return a.DrawShader == b.DrawShader && a.DrawTexture == b.DrawTexture
+					&& a.DrawMesh == b.DrawMesh && a.DrawMaterial == b.DrawMaterial;
+			};
+
+		/// Consecutive packets with the same state are merged into one batch.
+		/// When the instance buffer fills up, the batches collected so far are drawn first.
+		for (auto it = passBegin; it != queue.end(); ++it)
+		{
+			if (instances.size() == Renderer3DData::MaxInstances)
+				DrawInstanceBatches();
+
+			const DrawPacket& packet = *it;
+			if (batches.empty() || !canBatch(*batches.back().Packet, packet))
+				batches.push_back({ &packet, static_cast<uint32_t>(instances.size()), 0 });
+
+			instances.push_back({ packet.Transform, packet.EntityID });
+			batches.back().InstanceCount++;
+		}
+
+		DrawInstanceBatches();
+
+		/// Leave the active shader bound for the draws following the pass
+		s_RendererData.ActiveShader->Bind();
+	}
+
+	void Renderer3D::DrawInstanceBatches()
+	{
+		auto& instances = s_RendererData.InstanceData;
+		auto& batches = s_RendererData.InstanceBatches;
+		if (batches.empty())
+			return;
+
+		s_RendererData.InstanceVertexBuffer->SetData(instances.data(), static_cast<uint32_t>(instances.size() * sizeof(InstanceVertex)));
+
+		constexpr int textureSlot = Renderer3DData::MaterialTextureSlot;
+
+		for (const auto& batch : batches)
+		{
+			const DrawPacket& packet = *batch.Packet;
+
+			if (packet.DrawShader != s_RendererData.BoundShader)
+			{
+				packet.DrawShader->Bind();
+				packet.DrawShader->SetInt(FindMeshShaderUniforms(packet.DrawShader).Texture, textureSlot);
+				s_RendererData.BoundShader = packet.DrawShader;
+				s_Stats.ShaderBinds++;
+			}
+
+			if (packet.DrawTexture && packet.DrawTexture != s_RendererData.BoundTexture)
+			{
+				packet.DrawTexture->Bind(textureSlot);
+				s_RendererData.BoundTexture = packet.DrawTexture;
+				s_Stats.TextureBinds++;
+			}
+
+			const Ref<VertexArray>& vertexArray = packet.DrawMesh->GetVertexArray();
+			if (packet.DrawMesh != s_RendererData.BoundMesh)
+			{
+				vertexArray->Bind();
+				s_RendererData.BoundMesh = packet.DrawMesh;
+				s_Stats.VertexArrayBinds++;
+			}
+
+			/// The model matrix and entity id come from the instance buffer, only the material has to be uploaded
+			if (packet.DrawMaterial && packet.DrawMaterial != s_RendererData.BoundMaterial)
+			{
+				const Material& material = *packet.DrawMaterial;
+				s_RendererData.PerObjectData.Material = { .Diffuse = material.Diffuse,
+					.Specular = material.Specular, .Ambient = material.Ambient, .Shininess = material.Shininess };
+
+				constexpr int materialOffset = offsetof(Renderer3DData::PerObjectDataUbo, Material);
+				s_RendererData.PerObjectUniformBuffer->SetData(&s_RendererData.PerObjectData.Material, sizeof(MaterialUbo), materialOffset);
+				s_RendererData.BoundMaterial = packet.DrawMaterial;
+			}
+
+			RenderCommand::DrawIndexedInstanced(vertexArray, packet.DrawMesh->GetIndexCount(), batch.InstanceCount, batch.BaseInstance);
+
+			s_Stats.DrawCalls++;
+			s_Stats.DrawnMeshes += batch.InstanceCount;
+			s_Stats.Vertices += packet.DrawMesh->GetVertexCount() * batch.InstanceCount;
+			s_Stats.Faces += packet.DrawMesh->GetIndexCount() / 3 * batch.InstanceCount;
+		}
+
+		instances.clear();
+		batches.clear();
+	}
+
+	/// Hashes a pointer into the given number of bits, so the same resources get the same part of the key
+	static uint64_t HashPointer(const void* pointer, const uint32_t bits)
+	{
+		uint64_t value = reinterpret_cast<uintptr_t>(pointer);
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+
+		return value & ((1ull << bits) - 1);
+	}
+
+	uint64_t Renderer3D::CreateSortKey(const RenderPass pass, const Shader* shader, const Texture2D* texture, const Mesh* mesh, const Material* material, const glm::mat4& transform)
+	{
+		constexpr uint32_t depthBits = 18;
+		constexpr uint32_t materialBits = 10;
+		constexpr uint32_t meshBits = 12;
+		constexpr uint32_t textureBits = 12;
+		constexpr uint32_t shaderBits = 10;
+
+		/// Sort front to back by the depth of the object's origin, so early depth testing rejects more fragments
+		const glm::mat4& viewProjection = pass == RenderPass::Shadow
+			? s_RendererData.ShadowData.LightSpaceMatrix
+			: s_RendererData.CameraData.ViewProjectionMatrix;
+
+		const glm::vec4 clipPosition = viewProjection * transform[3];
+		const float ndcDepth = clipPosition.w > 0.0f ? clipPosition.z / clipPosition.w : 1.0f;
+		const float depth = glm::clamp(ndcDepth * 0.5f + 0.5f, 0.0f, 1.0f);
+		const uint64_t quantizedDepth = static_cast<uint64_t>(depth * static_cast<float>((1u << depthBits) - 1));
+
+		uint64_t key = static_cast<uint64_t>(pass);
+		key = (key << shaderBits) | HashPointer(shader, shaderBits);
+		key = (key << textureBits) | HashPointer(texture, textureBits);
+		key = (key << meshBits) | HashPointer(mesh, meshBits);
+		key = (key << materialBits) | HashPointer(material, materialBits);
+		key = (key << depthBits) | quantizedDepth;
+
+		return key;
 	}
 }
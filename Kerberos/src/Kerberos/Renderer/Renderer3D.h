@@ -42,12 +42,33 @@ namespace Kerberos
 		static void BeginGeometryPass(const EditorCamera& camera, const DirectionalLight* sun, const std::vector<PointLight>& pointLights, const Ref<TextureCube>& skyboxTexture);
         static void BeginGeometryPass(const Camera& camera, const glm::mat4& transform, const DirectionalLight* sun, const std::vector<PointLight>& pointLights, const Ref<TextureCube>& skyboxTexture);
 		
+		/// Sorts and draws the meshes submitted in the current pass
 		static void EndPass();
         static void EndScene();
 
+		/**
+		 * @brief Records a mesh into the render queue of the current pass
+		 *
+		 * The mesh is drawn in EndPass, so the mesh, material and texture have to stay alive until then.
+		 */
 		static void SubmitMesh(const Ref<Mesh>& mesh, const glm::mat4& transform, const Ref<Material>& material, const Ref<Texture2D>& texture = nullptr, float tilingFactor = 1.0f, int entityID = -1, bool castShadows = true);
+		/**
+		 * @brief Adds the glyphs of the text to the text batch, which is drawn at EndScene, or when the batch is full
+		 *
+		 * The layout of the glyphs is cached per font and string, so unchanged text isn't laid out again every frame.
+		 */
 		static void SubmitText(const std::string& text, const Ref<Font>& font, const glm::mat4& transform, const glm::vec4& color, float fontSize, int entityID = -1);
 
+		/// The buffer the per instance data of the mesh draws is streamed through.
+		/// Every mesh vertex array has it attached after its own vertex buffer.
+		static const Ref<VertexBuffer>& GetInstanceVertexBuffer();
+
+		/// Records meshes that were skipped by culling before being submitted, for the statistics
+		static void AddCulledMeshes(uint32_t count);
+
+		/// The light space matrix of the current shadow pass, valid after BeginShadowPass
+		static const glm::mat4& GetShadowLightSpaceMatrix();
+
 		static void SetGlobalAmbientLight(const glm::vec3& color, float intensity);
 		static void SetShowWireframe(bool showWireframe);
 
@@ -57,14 +78,59 @@ namespace Kerberos
             uint32_t DrawnMeshes = 0;
             uint32_t Vertices = 0;
 			uint32_t Faces = 0;
+
+			/// Meshes submitted to the renderer, in all passes
+			uint32_t SubmittedMeshes = 0;
+			/// Meshes skipped by culling, in all passes
+			uint32_t CulledMeshes = 0;
+
+			/// State changes made while executing the render queues
+			uint32_t ShaderBinds = 0;
+			uint32_t TextureBinds = 0;
+			uint32_t VertexArrayBinds = 0;
         };
 
 		static Statistics GetStatistics();
 		static void ResetStatistics();
 
+		/**
+		* A mesh draw recorded by SubmitMesh.
+		* The packets of a pass are sorted by their key before drawing, so the draws
+		* sharing a shader, texture, mesh and material end up next to each other,
+		* and are drawn with a single instanced draw call.
+		* The shadow pass doesn't use the texture and material, so they are null there.
+		*/
+		struct DrawPacket
+		{
+			/// Pass (2 bits) | shader (10 bits) | texture (12 bits) | mesh (12 bits) | material (10 bits) | depth (18 bits)
+			uint64_t SortKey = 0;
+
+			const Mesh* DrawMesh = nullptr;
+			const Material* DrawMaterial = nullptr;
+			const Texture2D* DrawTexture = nullptr;
+			Shader* DrawShader = nullptr;
+
+			glm::mat4 Transform{ 1.0f };
+			int EntityID = -1;
+			RenderPass Pass = RenderPass::Geometry;
+		};
+
+		/**
+		 * @brief Returns the draw packets recorded in the last frame, in the order they were drawn
+		 *
+		 * The queue is kept until the first pass of the next frame begins.
+		 */
+		static const std::vector<DrawPacket>& GetRenderQueue();
+
 	private:
 		static void SetupShadowCamera(const DirectionalLight& light, const ShadowMapSettings& settings);
 		static void BindShadowMap();
+
+		static void BeginRenderQueue();
+		static void FlushRenderQueue();
+		static void DrawInstanceBatches();
+		static void FlushText();
+		static uint64_t CreateSortKey(RenderPass pass, const Shader* shader, const Texture2D* texture, const Mesh* mesh, const Material* material, const glm::mat4& transform);
 	};
 }
 
@@ -4,4 +4,9 @@
 namespace Kerberos
 {
 	RendererAPI::API RendererAPI::s_API = API::OpenGL;
+
+	void RendererAPI::SetAPI(const API api)
+	{
+		s_API = api;
+	}
 }
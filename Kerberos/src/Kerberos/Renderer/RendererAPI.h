@@ -28,6 +28,8 @@ namespace Kerberos
 			D3D11 = 1,
 			D3D12 = 2,
 			Vulkan = 3,
+			/// Records the calls without a GPU, for profiling the CPU side of the renderer
+			Null = 4,
 		};
 
 		virtual ~RendererAPI() = default;
@@ -44,9 +46,16 @@ namespace Kerberos
 		virtual void SetDepthFunc(DepthFunc func) = 0;
 
 		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+		/**
+		 * @brief Draws the vertex array instanceCount times.
+		 * The per instance attributes are read starting at baseInstance.
+		 */
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance = 0) = 0;
 		virtual void DrawArray(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) = 0;
 
 		static API GetAPI() { return s_API; }
+		/// Selects the backend, it has to be called before the application creates its window
+		static void SetAPI(API api);
 	private:
 		static API s_API;
 	};
@@ -4,6 +4,7 @@
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 #include "Platform/D3D11/D3D11Shader.h"
+#include "Platform/Null/NullShader.h"
 #include "Platform/Vulkan/VulkanShader.h"
 
 namespace Kerberos
@@ -24,6 +25,9 @@ namespace Kerberos
 
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanShader>(filepath);
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullShader>(filepath);
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -46,6 +50,9 @@ namespace Kerberos
 
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanShader>(name, vertexSrc, fragmentSrc);
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullShader>(name, vertexSrc, fragmentSrc);
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -9,6 +9,18 @@
 
 namespace Kerberos
 {
+	/**
+	* A uniform of a shader, looked up once with Shader::GetUniform.
+	* Setting a uniform through its handle skips the name lookup the string overloads do on every call.
+	*/
+	struct ShaderUniform
+	{
+		/// -1 if the shader has no uniform with the name, setting it is ignored then
+		int32_t Location = -1;
+
+		bool IsValid() const { return Location >= 0; }
+	};
+
 	class Shader
 	{
 	public:
@@ -24,6 +36,16 @@ namespace Kerberos
 		virtual void SetFloat4(const std::string& name, const glm::vec4& value) = 0;
 		virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
 
+		/// The handle stays valid as long as the shader is alive
+		virtual ShaderUniform GetUniform(const std::string& name) const = 0;
+
+		virtual void SetInt(ShaderUniform uniform, int value) = 0;
+		virtual void SetIntArray(ShaderUniform uniform, const int* values, uint32_t count) = 0;
+		virtual void SetFloat(ShaderUniform uniform, float value) = 0;
+		virtual void SetFloat3(ShaderUniform uniform, const glm::vec3& value) = 0;
+		virtual void SetFloat4(ShaderUniform uniform, const glm::vec4& value) = 0;
+		virtual void SetMat4(ShaderUniform uniform, const glm::mat4& value) = 0;
+
 		virtual void SetMaterial(const std::string& name, const Ref<Material>& material) = 0;
 
 		virtual const std::string& GetName() const = 0;
@@ -7,10 +7,15 @@ namespace Kerberos
 	SubTexture2D::SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max)
 		: m_Texture(texture)
 	{
-		m_TexCoords[0] = { min.x, min.y };
-		m_TexCoords[1] = { max.x, min.y };
-		m_TexCoords[2] = { max.x, max.y };
-		m_TexCoords[3] = { min.x, max.y };
+		SetTexCoords(min, max);
+	}
+
+	SubTexture2D::SubTexture2D(const Ref<Texture2DArray>& textureArray, const uint32_t layer, const glm::vec2& min, const glm::vec2& max)
+		: m_TextureArray(textureArray), m_ArrayLayer(layer)
+	{
+		KBR_CORE_ASSERT(layer < textureArray->GetLayerCount(), "Layer index out of range!");
+
+		SetTexCoords(min, max);
 	}
 
 
@@ -21,4 +26,12 @@ namespace Kerberos
 
 		return CreateRef<SubTexture2D>(texture, min, max);
 	}
-}
\ No newline at end of file
+
+	void SubTexture2D::SetTexCoords(const glm::vec2& min, const glm::vec2& max)
+	{
+		m_TexCoords[0] = { min.x, min.y };
+		m_TexCoords[1] = { max.x, min.y };
+		m_TexCoords[2] = { max.x, max.y };
+		m_TexCoords[3] = { min.x, max.y };
+	}
+}
@@ -10,10 +10,17 @@ namespace Kerberos
 	{
 	public:
 		SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max);
+		/// A region of one layer of a texture array, like the sub textures of a TextureAtlas
+		SubTexture2D(const Ref<Texture2DArray>& textureArray, uint32_t layer, const glm::vec2& min, const glm::vec2& max);
 
+		/// Null for the sub textures of texture arrays
 		Ref<Texture2D> GetTexture() const { return m_Texture; }
 		const glm::vec2* GetTexCoords() const { return m_TexCoords; }
 
+		Ref<Texture2DArray> GetTextureArray() const { return m_TextureArray; }
+		uint32_t GetArrayLayer() const { return m_ArrayLayer; }
+		bool IsArrayLayer() const { return m_TextureArray != nullptr; }
+
 		template<typename T>
 		T& As()
 		{
@@ -21,8 +28,13 @@ namespace Kerberos
 		}
 
 		static Ref<SubTexture2D> CreateFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize, const glm::vec2& spriteSize);
+	private:
+		void SetTexCoords(const glm::vec2& min, const glm::vec2& max);
+
 	private:
 		Ref<Texture2D> m_Texture;
+		Ref<Texture2DArray> m_TextureArray;
+		uint32_t m_ArrayLayer = 0;
 		glm::vec2 m_TexCoords[4];
 	};
 }
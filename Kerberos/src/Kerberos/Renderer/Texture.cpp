@@ -3,6 +3,7 @@
 #include "Renderer.h"
 #include "Kerberos/Core.h"
 #include "Platform/D3D11/D3D11Texture.h"
+#include "Platform/Null/NullTexture.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 #include "Platform/Vulkan/VulkanTexture.h"
 
@@ -24,6 +25,54 @@ namespace Kerberos
 
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanTexture2D>(spec, data);
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullTexture2D>(spec, data);
+		}
+
+		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	bool Texture2DArray::IsSupported()
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+		case RendererAPI::API::Null:
+			return true;
+
+		case RendererAPI::API::D3D11:
+		case RendererAPI::API::D3D12:
+		case RendererAPI::API::Vulkan:
+			return false;
+		}
+
+		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return false;
+	}
+
+	Ref<Texture2DArray> Texture2DArray::Create(const TextureSpecification& spec, const uint32_t layerCount)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLTexture2DArray>(spec, layerCount);
+
+		case RendererAPI::API::D3D11:
+			KBR_CORE_ASSERT(false, "Texture arrays are not implemented for D3D11 yet!");
+			return nullptr;
+
+		case RendererAPI::API::D3D12:
+			KBR_CORE_ASSERT(false, "D3D12 is not implemented yet!");
+			return nullptr;
+
+		case RendererAPI::API::Vulkan:
+			KBR_CORE_ASSERT(false, "Texture arrays are not implemented for Vulkan yet!");
+			return nullptr;
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullTexture2DArray>(spec, layerCount);
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -57,4 +57,25 @@ namespace Kerberos
 
 		AssetType GetType() override { return AssetType::Texture2D; }
 	};
+
+	/**
+	* Layers of the same size and format, bound to a single slot and sampled with the layer index.
+	* Used by TextureAtlas, so the pages of an atlas only take up one texture slot.
+	*/
+	class Texture2DArray : public Texture
+	{
+	public:
+		virtual uint32_t GetLayerCount() const = 0;
+
+		/// Uploads the whole layer
+		virtual void SetLayerData(uint32_t layer, const void* data, uint32_t size) = 0;
+
+		/// Not an asset of its own, it's built from the Texture2D assets
+		AssetType GetType() override { return AssetType::Texture2D; }
+
+		/// Whether the current renderer backend has texture arrays
+		static bool IsSupported();
+
+		static Ref<Texture2DArray> Create(const TextureSpecification& spec, uint32_t layerCount);
+	};
 }
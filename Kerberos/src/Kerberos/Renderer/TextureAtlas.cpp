@@ -0,0 +1,400 @@
+#include "kbrpch.h"
+#include "TextureAtlas.h"
+
+#include "Kerberos/Assets/Importers/TextureImporter.h"
+#include "Kerberos/Core/BinaryStream.h"
+
+#include <stb_image.h>
+
+#include <array>
+#include <format>
+#include <fstream>
+#include <numeric>
+
+namespace Kerberos
+{
+	static constexpr uint32_t TextureAtlasFileVersion = 1;
+	static constexpr std::array<char, 4> TextureAtlasFileMagic = { 'K', 'A', 'T', 'L' };
+
+	/// Upper limits for the packed atlases and for the values read from a baked atlas, a file exceeding them has to be baked again
+	static constexpr uint32_t MaxAtlasPageSize = 16384;
+	static constexpr uint32_t MaxAtlasPages = 2048;
+
+	/// Where an image is in the atlas, in the texture coordinates of its page
+	struct AtlasRegion
+	{
+		uint32_t Page = 0;
+		glm::vec2 Min = { 0.0f, 0.0f };
+		glm::vec2 Max = { 0.0f, 0.0f };
+	};
+
+	struct PackedAtlas
+	{
+		uint32_t PageWidth = 0;
+		uint32_t PageHeight = 0;
+		/// RGBA8 pixels of every page
+		std::vector<std::vector<uint8_t>> Pages;
+		/// In the order the images were added
+		std::vector<AtlasRegion> Regions;
+	};
+
+	/// Copies the image to the page, and repeats its edge pixels into the padding around it
+	static void CopyImage(const std::vector<uint8_t>& pixels, const uint32_t width, const uint32_t height,
+		std::vector<uint8_t>& page, const uint32_t pageWidth, const uint32_t x, const uint32_t y, const uint32_t padding)
+	{
+		const int32_t paddedRows = static_cast<int32_t>(padding);
+		const size_t rowSize = static_cast<size_t>(width) * 4;
+
+		for (int32_t row = -paddedRows; row < static_cast<int32_t>(height) + paddedRows; ++row)
+		{
+			const uint32_t sourceRow = static_cast<uint32_t>(std::clamp(row, 0, static_cast<int32_t>(height) - 1));
+			const uint8_t* source = pixels.data() + sourceRow * rowSize;
+			uint8_t* destination = page.data() + (static_cast<size_t>(static_cast<int32_t>(y) + row) * pageWidth + x) * 4;
+
+			std::memcpy(destination, source, rowSize);
+
+			for (uint32_t column = 1; column <= padding; ++column)
+			{
+				std::memcpy(destination - column * 4, source, 4);
+				std::memcpy(destination + rowSize + (column - 1) * 4, source + rowSize - 4, 4);
+			}
+		}
+	}
+
+	TextureAtlasBuilder::TextureAtlasBuilder(const TextureAtlasSpecification& spec)
+		: m_Specification(spec)
+	{
+		KBR_CORE_ASSERT(spec.Padding < MaxAtlasPageSize / 2, "TextureAtlasBuilder: the padding is larger than a page!");
+
+		m_Specification.PageWidth = std::min(m_Specification.PageWidth, MaxAtlasPageSize);
+		m_Specification.PageHeight = std::min(m_Specification.PageHeight, MaxAtlasPageSize);
+	}
+
+	uint32_t TextureAtlasBuilder::Add(const TextureSpecification& spec, const void* data)
+	{
+		KBR_CORE_ASSERT(data, "TextureAtlasBuilder: the image has no data!");
+		KBR_CORE_ASSERT(spec.Width > 0 && spec.Height > 0, "TextureAtlasBuilder: the image is empty!");
+
+		/// The pages only grow up to the largest size an atlas can be loaded with
+		const uint32_t maxImageSize = MaxAtlasPageSize - 2 * m_Specification.Padding;
+		if (spec.Width > maxImageSize || spec.Height > maxImageSize)
+		{
+			KBR_CORE_ERROR("TextureAtlasBuilder: the image is larger than {0}x{0}, it is replaced by a white pixel", maxImageSize);
+
+			constexpr uint8_t white[4] = { 255, 255, 255, 255 };
+			return Add(TextureSpecification{ 1, 1, ImageFormat::RGBA8 }, white);
+		}
+
+		Image image;
+		image.Width = spec.Width;
+		image.Height = spec.Height;
+
+		const size_t pixelCount = static_cast<size_t>(spec.Width) * spec.Height;
+		const uint8_t* source = static_cast<const uint8_t*>(data);
+		image.Pixels.resize(pixelCount * 4);
+
+		switch (spec.Format)
+		{
+		case ImageFormat::RGBA8:
+			std::memcpy(image.Pixels.data(), source, pixelCount * 4);
+			break;
+
+		case ImageFormat::RGB8:
+			for (size_t i = 0; i < pixelCount; ++i)
+			{
+				image.Pixels[i * 4 + 0] = source[i * 3 + 0];
+				image.Pixels[i * 4 + 1] = source[i * 3 + 1];
+				image.Pixels[i * 4 + 2] = source[i * 3 + 2];
+				image.Pixels[i * 4 + 3] = 255;
+			}
+			break;
+
+		case ImageFormat::R8:
+			for (size_t i = 0; i < pixelCount; ++i)
+			{
+				image.Pixels[i * 4 + 0] = source[i];
+				image.Pixels[i * 4 + 1] = source[i];
+				image.Pixels[i * 4 + 2] = source[i];
+				image.Pixels[i * 4 + 3] = 255;
+			}
+			break;
+
+		case ImageFormat::RGBA32F:
+		case ImageFormat::None:
+		{
+			KBR_CORE_ERROR("TextureAtlasBuilder: only 8 bit images can be packed, the image is replaced by a white pixel");
+
+			constexpr uint8_t white[4] = { 255, 255, 255, 255 };
+			return Add(TextureSpecification{ 1, 1, ImageFormat::RGBA8 }, white);
+		}
+		}
+
+		m_Images.push_back(std::move(image));
+
+		return static_cast<uint32_t>(m_Images.size() - 1);
+	}
+
+	uint32_t TextureAtlasBuilder::Add(const std::filesystem::path& filepath)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		const auto [spec, data] = TextureImporter::LoadTextureData(filepath, true, 4);
+		if (!data)
+		{
+			KBR_CORE_WARN("TextureAtlasBuilder: {0} is replaced by a white pixel", filepath.string());
+
+			constexpr uint8_t white[4] = { 255, 255, 255, 255 };
+			return Add(TextureSpecification{ 1, 1, ImageFormat::RGBA8 }, white);
+		}
+
+		const uint32_t index = Add(spec, data.Data);
+
+		stbi_image_free(data.Data);
+
+		return index;
+	}
+
+	PackedAtlas TextureAtlasBuilder::Pack() const
+	{
+		KBR_PROFILE_FUNCTION();
+
+		const uint32_t padding = m_Specification.Padding;
+
+		PackedAtlas packed;
+		packed.PageWidth = m_Specification.PageWidth;
+		packed.PageHeight = m_Specification.PageHeight;
+		for (const Image& image : m_Images)
+		{
+			packed.PageWidth = std::max(packed.PageWidth, image.Width + 2 * padding);
+			packed.PageHeight = std::max(packed.PageHeight, image.Height + 2 * padding);
+		}
+
+		packed.Regions.resize(m_Images.size());
+
+		/// Shelf packing: the images are placed in rows from the tallest one, a new row is started when the current one is full
+		std::vector<uint32_t> order(m_Images.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::ranges::stable_sort(order, [this](const uint32_t a, const uint32_t b)
+			{
+				return m_Images[a].Height > m_Images[b].Height;
+			});
+
+		uint32_t shelfX = 0;
+		uint32_t shelfY = 0;
+		uint32_t shelfHeight = 0;
+
+		for (const uint32_t index : order)
+		{
+			const Image& image = m_Images[index];
+			const uint32_t paddedWidth = image.Width + 2 * padding;
+			const uint32_t paddedHeight = image.Height + 2 * padding;
+
+			if (shelfX + paddedWidth > packed.PageWidth)
+			{
+				shelfY += shelfHeight;
+				shelfX = 0;
+				shelfHeight = 0;
+			}
+
+			if (packed.Pages.empty() || shelfY + paddedHeight > packed.PageHeight)
+			{
+				packed.Pages.emplace_back(static_cast<size_t>(packed.PageWidth) * packed.PageHeight * 4, 0);
+				shelfX = 0;
+				shelfY = 0;
+				shelfHeight = 0;
+			}
+
+			const uint32_t x = shelfX + padding;
+			const uint32_t y = shelfY + padding;
+			CopyImage(image.Pixels, image.Width, image.Height, packed.Pages.back(), packed.PageWidth, x, y, padding);
+
+			AtlasRegion& region = packed.Regions[index];
+			region.Page = static_cast<uint32_t>(packed.Pages.size() - 1);
+			region.Min = { static_cast<float>(x) / static_cast<float>(packed.PageWidth), static_cast<float>(y) / static_cast<float>(packed.PageHeight) };
+			region.Max = { static_cast<float>(x + image.Width) / static_cast<float>(packed.PageWidth), static_cast<float>(y + image.Height) / static_cast<float>(packed.PageHeight) };
+
+			shelfX += paddedWidth;
+			shelfHeight = std::max(shelfHeight, paddedHeight);
+		}
+
+		return packed;
+	}
+
+	Ref<TextureAtlas> TextureAtlasBuilder::Build(const std::string& debugName) const
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (m_Images.empty())
+		{
+			KBR_CORE_WARN("TextureAtlasBuilder: no images were added to {0}", debugName);
+			return nullptr;
+		}
+
+		PackedAtlas packed = Pack();
+
+		return TextureAtlas::Create(packed, m_Specification.UseTextureArray, debugName);
+	}
+
+	bool TextureAtlasBuilder::Bake(const std::filesystem::path& filepath) const
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (m_Images.empty())
+		{
+			KBR_CORE_WARN("TextureAtlasBuilder: no images were added to {0}", filepath.string());
+			return false;
+		}
+
+		const PackedAtlas packed = Pack();
+		if (packed.Pages.size() > MaxAtlasPages)
+		{
+			KBR_CORE_ERROR("TextureAtlasBuilder: {0} would have more than {1} pages, use larger pages", filepath.string(), MaxAtlasPages);
+			return false;
+		}
+
+		if (filepath.has_parent_path())
+			std::filesystem::create_directories(filepath.parent_path());
+
+		std::ofstream out(filepath, std::ios::binary);
+		if (!out)
+			return false;
+
+		WritePod(out, TextureAtlasFileMagic);
+		WritePod(out, TextureAtlasFileVersion);
+		WritePod(out, packed.PageWidth);
+		WritePod(out, packed.PageHeight);
+		WritePod(out, static_cast<uint32_t>(packed.Pages.size()));
+		WritePod(out, static_cast<uint32_t>(packed.Regions.size()));
+
+		for (const AtlasRegion& region : packed.Regions)
+			WritePod(out, region);
+
+		for (const std::vector<uint8_t>& page : packed.Pages)
+			out.write(reinterpret_cast<const char*>(page.data()), static_cast<std::streamsize>(page.size()));
+
+		return static_cast<bool>(out);
+	}
+
+	Ref<TextureAtlas> TextureAtlas::Load(const std::filesystem::path& filepath, const bool useTextureArray)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		std::ifstream in(filepath, std::ios::binary | std::ios::ate);
+		if (!in)
+		{
+			KBR_CORE_ERROR("Failed to open texture atlas: {0}", filepath.string());
+			return nullptr;
+		}
+
+		const uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+		in.seekg(0, std::ios::beg);
+
+		std::array<char, 4> magic{};
+		uint32_t version = 0;
+		ReadPod(in, magic);
+		ReadPod(in, version);
+		if (!in || magic != TextureAtlasFileMagic || version != TextureAtlasFileVersion)
+		{
+			KBR_CORE_ERROR("{0} is not a texture atlas of version {1}, it has to be baked again", filepath.string(), TextureAtlasFileVersion);
+			return nullptr;
+		}
+
+		PackedAtlas packed;
+		uint32_t pageCount = 0;
+		uint32_t regionCount = 0;
+		ReadPod(in, packed.PageWidth);
+		ReadPod(in, packed.PageHeight);
+		ReadPod(in, pageCount);
+		ReadPod(in, regionCount);
+
+		/// The sizes are checked against the bytes left in the file before anything is allocated, so a corrupt file is rejected
+		const uint64_t pageSize = static_cast<uint64_t>(packed.PageWidth) * packed.PageHeight * 4;
+		const std::streamoff headerSize = in.tellg();
+		const uint64_t expectedSize = static_cast<uint64_t>(headerSize) + regionCount * static_cast<uint64_t>(sizeof(AtlasRegion)) + pageCount * pageSize;
+
+		if (!in || headerSize < 0
+			|| packed.PageWidth == 0 || packed.PageWidth > MaxAtlasPageSize
+			|| packed.PageHeight == 0 || packed.PageHeight > MaxAtlasPageSize
+			|| pageCount == 0 || pageCount > MaxAtlasPages
+			|| expectedSize != fileSize)
+		{
+			KBR_CORE_ERROR("Texture atlas {0} is corrupt, it has to be baked again", filepath.string());
+			return nullptr;
+		}
+
+		packed.Regions.resize(regionCount);
+		for (AtlasRegion& region : packed.Regions)
+		{
+			ReadPod(in, region);
+
+			const bool validCoords = region.Min.x >= 0.0f && region.Min.y >= 0.0f && region.Max.x <= 1.0f && region.Max.y <= 1.0f
+				&& region.Min.x <= region.Max.x && region.Min.y <= region.Max.y;
+			if (!in || region.Page >= pageCount || !validCoords)
+			{
+				KBR_CORE_ERROR("Texture atlas {0} is corrupt, it has to be baked again", filepath.string());
+				return nullptr;
+			}
+		}
+
+		packed.Pages.resize(pageCount);
+		for (std::vector<uint8_t>& page : packed.Pages)
+		{
+			page.resize(pageSize);
+			in.read(reinterpret_cast<char*>(page.data()), static_cast<std::streamsize>(page.size()));
+		}
+
+		if (!in)
+		{
+			KBR_CORE_ERROR("Failed to read texture atlas: {0}", filepath.string());
+			return nullptr;
+		}
+
+		return Create(packed, useTextureArray, filepath.stem().string());
+	}
+
+	Ref<TextureAtlas> TextureAtlas::Create(PackedAtlas& packed, const bool useTextureArray, const std::string& debugName)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		Ref<TextureAtlas> atlas = CreateRef<TextureAtlas>();
+		atlas->m_PageCount = static_cast<uint32_t>(packed.Pages.size());
+		atlas->m_SubTextures.reserve(packed.Regions.size());
+
+		TextureSpecification pageSpec;
+		pageSpec.Width = packed.PageWidth;
+		pageSpec.Height = packed.PageHeight;
+		pageSpec.Format = ImageFormat::RGBA8;
+
+		const uint32_t pageSize = packed.PageWidth * packed.PageHeight * 4;
+
+		if (useTextureArray && Texture2DArray::IsSupported())
+		{
+			atlas->m_TextureArray = Texture2DArray::Create(pageSpec, atlas->m_PageCount);
+			atlas->m_TextureArray->SetDebugName(debugName);
+
+			for (uint32_t page = 0; page < atlas->m_PageCount; ++page)
+				atlas->m_TextureArray->SetLayerData(page, packed.Pages[page].data(), pageSize);
+
+			for (const AtlasRegion& region : packed.Regions)
+				atlas->m_SubTextures.push_back(CreateRef<SubTexture2D>(atlas->m_TextureArray, region.Page, region.Min, region.Max));
+		}
+		else
+		{
+			for (uint32_t page = 0; page < atlas->m_PageCount; ++page)
+			{
+				Buffer data;
+				data.Data = packed.Pages[page].data();
+				data.Size = pageSize;
+
+				Ref<Texture2D> texture = Texture2D::Create(pageSpec, data);
+				texture->SetDebugName(std::format("{} - page {}", debugName, page));
+				atlas->m_Pages.push_back(texture);
+			}
+
+			for (const AtlasRegion& region : packed.Regions)
+				atlas->m_SubTextures.push_back(CreateRef<SubTexture2D>(atlas->m_Pages[region.Page], region.Min, region.Max));
+		}
+
+		return atlas;
+	}
+}
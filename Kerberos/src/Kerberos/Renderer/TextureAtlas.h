@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Kerberos/Core.h"
+#include "Texture.h"
+#include "SubTexture2D.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Kerberos
+{
+	struct PackedAtlas;
+
+	struct TextureAtlasSpecification
+	{
+		/// The minimum size of the pages, they grow to fit the largest image. Both are limited to 16384, larger images can't be added.
+		uint32_t PageWidth = 2048;
+		uint32_t PageHeight = 2048;
+		/// The edge pixels of the images are repeated into the padding, so filtering doesn't bleed in the neighbours
+		uint32_t Padding = 1;
+		/// Store the pages in a Texture2DArray if the backend supports it, so the whole atlas takes one texture slot
+		bool UseTextureArray = true;
+	};
+
+	/**
+	* The pages of packed images, and a SubTexture2D for every image added to the builder.
+	* The sub textures are in the order the images were added.
+	*/
+	class TextureAtlas
+	{
+	public:
+		const std::vector<Ref<SubTexture2D>>& GetSubTextures() const { return m_SubTextures; }
+		const Ref<SubTexture2D>& GetSubTexture(const uint32_t index) const { return m_SubTextures[index]; }
+
+		uint32_t GetPageCount() const { return m_PageCount; }
+		bool UsesTextureArray() const { return m_TextureArray != nullptr; }
+
+		/// Only set if the atlas uses a texture array
+		const Ref<Texture2DArray>& GetTextureArray() const { return m_TextureArray; }
+		/// Only filled if the atlas doesn't use a texture array
+		const std::vector<Ref<Texture2D>>& GetPages() const { return m_Pages; }
+
+		/**
+		* @brief Loads an atlas baked by TextureAtlasBuilder::Bake.
+		* @return nullptr if the file is missing, corrupt or was written by a different version, the atlas has to be built again then
+		*/
+		static Ref<TextureAtlas> Load(const std::filesystem::path& filepath, bool useTextureArray = true);
+
+	private:
+		/// Uploads the packed pages and creates the sub textures
+		static Ref<TextureAtlas> Create(PackedAtlas& packed, bool useTextureArray, const std::string& debugName);
+
+	private:
+		std::vector<Ref<SubTexture2D>> m_SubTextures;
+		std::vector<Ref<Texture2D>> m_Pages;
+		Ref<Texture2DArray> m_TextureArray;
+		uint32_t m_PageCount = 0;
+
+		friend class TextureAtlasBuilder;
+	};
+
+	/**
+	* Packs images into the pages of a TextureAtlas, so the sprites drawn by Renderer2D share a few textures instead of one each.
+	* The atlas can be built at runtime with Build, or baked to a file with Bake and loaded later with TextureAtlas::Load.
+	*/
+	class TextureAtlasBuilder
+	{
+	public:
+		explicit TextureAtlasBuilder(const TextureAtlasSpecification& spec = TextureAtlasSpecification());
+
+		/**
+		* @brief Adds an image, the R8 and RGB8 formats are converted to RGBA8.
+		* @return The index of its sub texture in the atlas
+		*/
+		uint32_t Add(const TextureSpecification& spec, const void* data);
+		/// Loads the image from a file, if it can't be loaded a white pixel is added in its place
+		uint32_t Add(const std::filesystem::path& filepath);
+
+		uint32_t GetImageCount() const { return static_cast<uint32_t>(m_Images.size()); }
+
+		Ref<TextureAtlas> Build(const std::string& debugName = "TextureAtlas") const;
+
+		/// Writes the packed pages to a file, without creating any GPU resources
+		bool Bake(const std::filesystem::path& filepath) const;
+
+	private:
+		PackedAtlas Pack() const;
+
+	private:
+		struct Image
+		{
+			uint32_t Width = 0;
+			uint32_t Height = 0;
+			/// RGBA8 pixels
+			std::vector<uint8_t> Pixels;
+		};
+
+		TextureAtlasSpecification m_Specification;
+		std::vector<Image> m_Images;
+	};
+}
@@ -4,6 +4,7 @@
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLTextureCube.h"
 #include "Platform/D3D11/D3D11TextureCube.h"
+#include "Platform/Null/NullTextureCube.h"
 #include "Platform/Vulkan/VulkanTextureCube.h"
 
 namespace Kerberos
@@ -24,6 +25,9 @@ namespace Kerberos
 
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanTextureCube>(data);
+
+		case RendererAPI::API::Null:
+			return CreateRef<NullTextureCube>(data);
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
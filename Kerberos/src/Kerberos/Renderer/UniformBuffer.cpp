@@ -3,6 +3,7 @@
 
 #include "Kerberos/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLUniformBuffer.h"
+#include "Platform/Null/NullUniformBuffer.h"
 #include "Platform/Vulkan/VulkanUniformBuffer.h"
 
 namespace Kerberos 
@@ -24,6 +25,9 @@ namespace Kerberos
 			case RendererAPI::API::D3D12:
 				KBR_CORE_ASSERT(false, "D3D12 Uniform buffer is not yet implemented!"); 
 				return nullptr;
+
+			case RendererAPI::API::Null:
+				return CreateRef<NullUniformBuffer>(size, binding);
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
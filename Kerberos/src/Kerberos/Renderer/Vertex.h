@@ -42,4 +42,20 @@ namespace Kerberos
 			};
 		}
 	};
+
+	/// Per instance data of the instanced mesh draws
+	struct InstanceVertex
+	{
+		glm::mat4 Model;
+		int EntityID = -1;
+
+		static BufferLayout GetLayout()
+		{
+			return BufferLayout(
+			{
+				{ ShaderDataType::Mat4, "a_InstanceModel"    },
+				{ ShaderDataType::Int,  "a_InstanceEntityID" },
+			}, VertexInputRate::Instance);
+		}
+	};
 }
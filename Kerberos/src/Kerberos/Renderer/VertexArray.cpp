@@ -4,6 +4,7 @@
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
 #include "Platform/D3D11/D3D11VertexArray.h"
+#include "Platform/Null/NullVertexArray.h"
 #include "Platform/Vulkan/VulkanVertexArray.h"
 
 namespace Kerberos
@@ -24,6 +25,9 @@ namespace Kerberos
 		
 			case RendererAPI::API::Vulkan:
 				return CreateRef<VulkanVertexArray>();
+
+			case RendererAPI::API::Null:
+				return CreateRef<NullVertexArray>();
 		}
 
 		KBR_CORE_ASSERT(false, "Unknown RendererAPI!");
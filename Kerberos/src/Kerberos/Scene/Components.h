@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <entt.hpp>
 #include <glm/glm.hpp>
 #include <glm/ext/matrix_transform.hpp>
 
@@ -40,6 +41,23 @@ namespace Kerberos
 
 		glm::mat4 WorldTransform = glm::mat4(1.0f);
 
+		/**
+		* Set to force a recalculation of the world transform of this entity and its subtree,
+		* even if the local translation, rotation and scale did not change.
+		*/
+		bool Dirty = true;
+
+		/// The local values the WorldTransform was last calculated from, used for change detection
+		glm::vec3 CachedTranslation = glm::vec3(0.0f);
+		glm::vec3 CachedRotation = glm::vec3(0.0f);
+		glm::vec3 CachedScale = glm::vec3(1.0f);
+
+		/// The index of the last transform update in which the WorldTransform was recalculated
+		uint64_t LastUpdatedFrame = 0;
+
+		/// Incremented every time the WorldTransform changes, so data derived from it knows when to update
+		uint32_t WorldTransformVersion = 0;
+
 		TransformComponent() = default;
 		~TransformComponent() = default;
 		TransformComponent(const TransformComponent&) = default;
@@ -61,6 +79,22 @@ namespace Kerberos
 
 			return transform;
 		}
+
+		bool IsLocalTransformDirty() const
+		{
+			return Dirty || Translation != CachedTranslation || Rotation != CachedRotation || Scale != CachedScale;
+		}
+
+		void UpdateWorldTransform(const glm::mat4& parentTransform)
+		{
+			WorldTransform = parentTransform * GetTransform();
+
+			CachedTranslation = Translation;
+			CachedRotation = Rotation;
+			CachedScale = Scale;
+			Dirty = false;
+			++WorldTransformVersion;
+		}
 	};
 
 	struct SpriteRendererComponent
@@ -175,6 +209,14 @@ namespace Kerberos
 		bool Visible = true;
 		bool CastShadows = true;
 
+		/// The bounds of the mesh in world space, updated by the Scene when the transform or the mesh changes
+		AABB WorldBounds;
+
+		/// Runtime culling data, owned by the Scene
+		int32_t BVHProxy = -1;
+		const Mesh* BoundsMesh = nullptr;
+		uint32_t BoundsTransformVersion = 0;
+
 		StaticMeshComponent()
 		{
 			// TODO: This creates a brand-new material and mesh every time. We should probably have a default material and mesh in the renderer and use that instead.
@@ -225,12 +267,26 @@ namespace Kerberos
 		{}
 	};
 
+	/**
+	* Links the entity into the scene hierarchy with first-child/next-sibling handles.
+	* The handles are only valid inside the owning scene's registry, the hierarchy is serialized
+	* using the UUIDs of the entities. Use the Scene to modify the links.
+	*/
 	struct HierarchyComponent
 	{
-		UUID Parent = UUID::Invalid();
-		std::vector<UUID> Children;
+		entt::entity Parent = entt::null;
+		entt::entity FirstChild = entt::null;
+		entt::entity LastChild = entt::null;
+		entt::entity PrevSibling = entt::null;
+		entt::entity NextSibling = entt::null;
+		uint32_t ChildCount = 0;
+
+		/// The distance from the root of the hierarchy, root entities have a depth of 0
+		uint32_t Depth = 0;
 
 		HierarchyComponent() = default;
+
+		bool HasParent() const { return Parent != entt::null; }
 	};
 
 	struct EnvironmentComponent
@@ -3,6 +3,7 @@
 #include "Kerberos/Core.h"
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 
 namespace Kerberos { class Mesh; }
@@ -31,6 +32,15 @@ namespace Kerberos
 		/// Pointer to the physics engine's runtime body
 		void* RuntimeBody = nullptr;
 
+		/// The pose of the body before the last physics step, the rendered transform is interpolated from it
+		glm::vec3 PreviousPosition = glm::vec3(0.0f);
+		glm::quat PreviousRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+		/// The offset of the collider and the world scale of the entity, cached when the body is created or updated,
+		/// so syncing the transforms doesn't have to look up the collider or decompose the world transform
+		glm::vec3 ColliderOffset = glm::vec3(0.0f);
+		glm::vec3 WorldScale = glm::vec3(1.0f);
+
 		/// TODO: add a physics body id, so when not interacting directly with the runtime body we can just use the id to send data to the physics engine
 
 		bool IsDirty = true;
@@ -0,0 +1,323 @@
+#include "kbrpch.h"
+#include "DynamicBVH.h"
+
+namespace Kerberos
+{
+	int32_t DynamicBVH::CreateProxy(const AABB& bounds, const entt::entity entity)
+	{
+		const int32_t proxyId = AllocateNode();
+
+		Node& node = m_Nodes[proxyId];
+		node.Bounds = bounds.Expanded(BoundsMargin);
+		node.Entity = entity;
+		node.Height = 0;
+
+		InsertLeaf(proxyId);
+		++m_ProxyCount;
+
+		return proxyId;
+	}
+
+	void DynamicBVH::DestroyProxy(const int32_t proxyId)
+	{
+		KBR_CORE_ASSERT(proxyId >= 0 && proxyId < static_cast<int32_t>(m_Nodes.size()), "Invalid BVH proxy id!");
+		KBR_CORE_ASSERT(m_Nodes[proxyId].IsLeaf(), "BVH proxy is not a leaf!");
+
+		RemoveLeaf(proxyId);
+		FreeNode(proxyId);
+		--m_ProxyCount;
+	}
+
+	bool DynamicBVH::MoveProxy(const int32_t proxyId, const AABB& bounds)
+	{
+		KBR_CORE_ASSERT(proxyId >= 0 && proxyId < static_cast<int32_t>(m_Nodes.size()), "Invalid BVH proxy id!");
+		KBR_CORE_ASSERT(m_Nodes[proxyId].IsLeaf(), "BVH proxy is not a leaf!");
+
+		const AABB fatBounds = bounds.Expanded(BoundsMargin);
+
+		/// Keep the proxy where it is while the bounds fit into the fat bounds,
+		/// unless the fat bounds became much larger than needed
+		const AABB& currentBounds = m_Nodes[proxyId].Bounds;
+		if (currentBounds.Contains(bounds) && currentBounds.GetSurfaceArea() <= 4.0f * fatBounds.GetSurfaceArea())
+			return false;
+
+		RemoveLeaf(proxyId);
+		m_Nodes[proxyId].Bounds = fatBounds;
+		InsertLeaf(proxyId);
+
+		return true;
+	}
+
+	void DynamicBVH::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = NullNode;
+		m_FreeList = NullNode;
+		m_ProxyCount = 0;
+	}
+
+	int32_t DynamicBVH::AllocateNode()
+	{
+		if (m_FreeList == NullNode)
+		{
+			m_Nodes.emplace_back();
+			return static_cast<int32_t>(m_Nodes.size()) - 1;
+		}
+
+		const int32_t nodeId = m_FreeList;
+		m_FreeList = m_Nodes[nodeId].Parent;
+		m_Nodes[nodeId] = Node();
+
+		return nodeId;
+	}
+
+	void DynamicBVH::FreeNode(const int32_t nodeId)
+	{
+		m_Nodes[nodeId] = Node();
+		m_Nodes[nodeId].Parent = m_FreeList;
+		m_FreeList = nodeId;
+	}
+
+	void DynamicBVH::InsertLeaf(const int32_t leaf)
+	{
+		if (m_Root == NullNode)
+		{
+			m_Root = leaf;
+			m_Nodes[leaf].Parent = NullNode;
+			return;
+		}
+
+		/// Find the best sibling for the leaf, using the surface area heuristic
+		const AABB leafBounds = m_Nodes[leaf].Bounds;
+		int32_t index = m_Root;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			const Node& node = m_Nodes[index];
+
+			const float area = node.Bounds.GetSurfaceArea();
+			const float combinedArea = AABB::Merge(node.Bounds, leafBounds).GetSurfaceArea();
+
+			/// Cost of creating a new parent for this node and the leaf
+			const float cost = 2.0f * combinedArea;
+
+			/// Minimum cost of pushing the leaf further down the tree
+			const float inheritanceCost = 2.0f * (combinedArea - area);
+
+			const auto descendCost = [this, &leafBounds, inheritanceCost](const int32_t child)
+				{
+					const Node& childNode = m_Nodes[child];
+					const float mergedArea = AABB::Merge(leafBounds, childNode.Bounds).GetSurfaceArea();
+					if (childNode.IsLeaf())
+						return mergedArea + inheritanceCost;
+
+					return mergedArea - childNode.Bounds.GetSurfaceArea() + inheritanceCost;
+				};
+
+			const float cost1 = descendCost(node.Child1);
+			const float cost2 = descendCost(node.Child2);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? node.Child1 : node.Child2;
+		}
+
+		const int32_t sibling = index;
+
+		/// Allocating can reallocate the nodes, so no references are kept across it
+		const int32_t oldParent = m_Nodes[sibling].Parent;
+		const int32_t newParent = AllocateNode();
+
+		Node& parentNode = m_Nodes[newParent];
+		parentNode.Parent = oldParent;
+		parentNode.Bounds = AABB::Merge(leafBounds, m_Nodes[sibling].Bounds);
+		parentNode.Height = m_Nodes[sibling].Height + 1;
+		parentNode.Child1 = sibling;
+		parentNode.Child2 = leaf;
+
+		if (oldParent != NullNode)
+		{
+			if (m_Nodes[oldParent].Child1 == sibling)
+				m_Nodes[oldParent].Child1 = newParent;
+			else
+				m_Nodes[oldParent].Child2 = newParent;
+		}
+		else
+		{
+			m_Root = newParent;
+		}
+
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		RefitAncestors(newParent);
+	}
+
+	void DynamicBVH::RemoveLeaf(const int32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = NullNode;
+			return;
+		}
+
+		const int32_t parent = m_Nodes[leaf].Parent;
+		const int32_t grandParent = m_Nodes[parent].Parent;
+		const int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+		/// Replace the parent with the sibling
+		if (grandParent != NullNode)
+		{
+			if (m_Nodes[grandParent].Child1 == parent)
+				m_Nodes[grandParent].Child1 = sibling;
+			else
+				m_Nodes[grandParent].Child2 = sibling;
+
+			m_Nodes[sibling].Parent = grandParent;
+			FreeNode(parent);
+
+			RefitAncestors(grandParent);
+		}
+		else
+		{
+			m_Root = sibling;
+			m_Nodes[sibling].Parent = NullNode;
+			FreeNode(parent);
+		}
+
+		m_Nodes[leaf].Parent = NullNode;
+	}
+
+	void DynamicBVH::RefitAncestors(int32_t nodeId)
+	{
+		while (nodeId != NullNode)
+		{
+			nodeId = Balance(nodeId);
+
+			Node& node = m_Nodes[nodeId];
+			const Node& child1 = m_Nodes[node.Child1];
+			const Node& child2 = m_Nodes[node.Child2];
+
+			node.Height = 1 + std::max(child1.Height, child2.Height);
+			node.Bounds = AABB::Merge(child1.Bounds, child2.Bounds);
+
+			nodeId = node.Parent;
+		}
+	}
+
+	int32_t DynamicBVH::Balance(const int32_t nodeId)
+	{
+		Node& a = m_Nodes[nodeId];
+		if (a.IsLeaf() || a.Height < 2)
+			return nodeId;
+
+		const int32_t iB = a.Child1;
+		const int32_t iC = a.Child2;
+		Node& b = m_Nodes[iB];
+		Node& c = m_Nodes[iC];
+
+		const int32_t balance = c.Height - b.Height;
+
+		/// Rotate C up
+		if (balance > 1)
+		{
+			const int32_t iF = c.Child1;
+			const int32_t iG = c.Child2;
+			Node& f = m_Nodes[iF];
+			Node& g = m_Nodes[iG];
+
+			c.Child1 = nodeId;
+			c.Parent = a.Parent;
+			a.Parent = iC;
+
+			if (c.Parent != NullNode)
+			{
+				if (m_Nodes[c.Parent].Child1 == nodeId)
+					m_Nodes[c.Parent].Child1 = iC;
+				else
+					m_Nodes[c.Parent].Child2 = iC;
+			}
+			else
+			{
+				m_Root = iC;
+			}
+
+			if (f.Height > g.Height)
+			{
+				c.Child2 = iF;
+				a.Child2 = iG;
+				g.Parent = nodeId;
+				a.Bounds = AABB::Merge(b.Bounds, g.Bounds);
+				c.Bounds = AABB::Merge(a.Bounds, f.Bounds);
+
+				a.Height = 1 + std::max(b.Height, g.Height);
+				c.Height = 1 + std::max(a.Height, f.Height);
+			}
+			else
+			{
+				c.Child2 = iG;
+				a.Child2 = iF;
+				f.Parent = nodeId;
+				a.Bounds = AABB::Merge(b.Bounds, f.Bounds);
+				c.Bounds = AABB::Merge(a.Bounds, g.Bounds);
+
+				a.Height = 1 + std::max(b.Height, f.Height);
+				c.Height = 1 + std::max(a.Height, g.Height);
+			}
+
+			return iC;
+		}
+
+		/// Rotate B up
+		if (balance < -1)
+		{
+			const int32_t iD = b.Child1;
+			const int32_t iE = b.Child2;
+			Node& d = m_Nodes[iD];
+			Node& e = m_Nodes[iE];
+
+			b.Child1 = nodeId;
+			b.Parent = a.Parent;
+			a.Parent = iB;
+
+			if (b.Parent != NullNode)
+			{
+				if (m_Nodes[b.Parent].Child1 == nodeId)
+					m_Nodes[b.Parent].Child1 = iB;
+				else
+					m_Nodes[b.Parent].Child2 = iB;
+			}
+			else
+			{
+				m_Root = iB;
+			}
+
+			if (d.Height > e.Height)
+			{
+				b.Child2 = iD;
+				a.Child1 = iE;
+				e.Parent = nodeId;
+				a.Bounds = AABB::Merge(c.Bounds, e.Bounds);
+				b.Bounds = AABB::Merge(a.Bounds, d.Bounds);
+
+				a.Height = 1 + std::max(c.Height, e.Height);
+				b.Height = 1 + std::max(a.Height, d.Height);
+			}
+			else
+			{
+				b.Child2 = iE;
+				a.Child1 = iD;
+				d.Parent = nodeId;
+				a.Bounds = AABB::Merge(c.Bounds, d.Bounds);
+				b.Bounds = AABB::Merge(a.Bounds, e.Bounds);
+
+				a.Height = 1 + std::max(c.Height, d.Height);
+				b.Height = 1 + std::max(a.Height, e.Height);
+			}
+
+			return iB;
+		}
+
+		return nodeId;
+	}
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Kerberos/Renderer/Bounds.h"
+
+#include <entt.hpp>
+
+namespace Kerberos
+{
+	/**
+	* Dynamic bounding volume hierarchy of entity bounds, used for culling.
+	*
+	* The leaves store enlarged ("fat") bounds, so entities moving only a little
+	* don't have to be reinserted every frame. Inserting uses the surface area heuristic,
+	* and the tree is kept balanced with rotations.
+	*/
+	class DynamicBVH
+	{
+	public:
+		static constexpr int32_t NullNode = -1;
+
+		/// Bounds inserted into the tree are enlarged by this margin on every side
+		static constexpr float BoundsMargin = 0.1f;
+
+		DynamicBVH() = default;
+
+		/**
+		 * @brief Inserts the bounds of an entity into the tree
+		 *
+		 * @return The id of the proxy, which has to be used to move or destroy it
+		 */
+		int32_t CreateProxy(const AABB& bounds, entt::entity entity);
+		void DestroyProxy(int32_t proxyId);
+
+		/**
+		 * @brief Updates the bounds of a proxy
+		 *
+		 * @return True if the proxy had to be reinserted, because the new bounds are not inside its fat bounds
+		 */
+		bool MoveProxy(int32_t proxyId, const AABB& bounds);
+
+		void Clear();
+
+		uint32_t GetProxyCount() const { return m_ProxyCount; }
+		int32_t GetHeight() const { return m_Root == NullNode ? 0 : m_Nodes[m_Root].Height; }
+
+		/**
+		 * @brief Calls the function with the entity of every proxy that intersects the frustum
+		 *
+		 * Subtrees that are completely inside the frustum are accepted without testing their children.
+		 */
+		template<typename Fn>
+		void Query(const Frustum& frustum, Fn&& fn) const
+		{
+			if (m_Root == NullNode)
+				return;
+
+			struct StackEntry
+			{
+				int32_t Node;
+				bool Inside;
+			};
+
+			std::vector<StackEntry> stack;
+			stack.reserve(64);
+			stack.push_back({ m_Root, false });
+
+			while (!stack.empty())
+			{
+				const StackEntry entry = stack.back();
+				stack.pop_back();
+
+				const Node& node = m_Nodes[entry.Node];
+
+				bool inside = entry.Inside;
+				if (!inside)
+				{
+					const Frustum::Containment containment = frustum.Classify(node.Bounds);
+					if (containment == Frustum::Containment::Outside)
+						continue;
+
+					inside = containment == Frustum::Containment::Inside;
+				}
+
+				if (node.IsLeaf())
+				{
+					fn(node.Entity);
+					continue;
+				}
+
+				stack.push_back({ node.Child1, inside });
+				stack.push_back({ node.Child2, inside });
+			}
+		}
+
+	private:
+		struct Node
+		{
+			AABB Bounds;
+			entt::entity Entity = entt::null;
+
+			/// The parent of the node, or the next free node when the node is in the free list
+			int32_t Parent = NullNode;
+			int32_t Child1 = NullNode;
+			int32_t Child2 = NullNode;
+
+			/// Leaves have a height of 0, free nodes -1
+			int32_t Height = -1;
+
+			bool IsLeaf() const { return Child1 == NullNode; }
+		};
+
+		int32_t AllocateNode();
+		void FreeNode(int32_t nodeId);
+
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+
+		/// Refits the bounds and heights from the node up to the root, balancing the tree on the way
+		void RefitAncestors(int32_t nodeId);
+		int32_t Balance(int32_t nodeId);
+
+	private:
+		std::vector<Node> m_Nodes;
+		int32_t m_Root = NullNode;
+		int32_t m_FreeList = NullNode;
+		uint32_t m_ProxyCount = 0;
+	};
+}
@@ -13,19 +13,29 @@
 
 #include <glm/gtx/matrix_decompose.hpp>
 
+#include <numeric>
+
 #include "Kerberos/Application.h"
 #include "Kerberos/Assets/AssetManager.h"
+#include "Kerberos/Internal/JobSystem.h"
+#include "Kerberos/Project/Project.h"
 #include "Kerberos/Renderer/RenderCommand.h"
 #include "Kerberos/Scripting/ScriptEngine.h"
 
 #define USE_MAP_FOR_UUID 1
 
+/// Hierarchy levels with at least this many entities have their transforms calculated in parallel
+static constexpr size_t PARALLEL_TRANSFORM_THRESHOLD = 2048;
+/// The minimum number of transforms calculated by a single job
+static constexpr uint32_t PARALLEL_TRANSFORM_GRAIN_SIZE = 512;
+
 namespace Kerberos
 {
 	Scene::Scene() 
 		: m_PhysicsSystem(new PhysicsSystem()) 
 	{
 		m_Registry = entt::basic_registry();
+		m_Registry.on_destroy<StaticMeshComponent>().connect<&Scene::OnStaticMeshDestroyed>(*this);
 
 		m_ShadowMapFramebuffer = Framebuffer::Create(FramebufferSpecification{
 			.Width = 1024,
@@ -46,11 +56,14 @@ namespace Kerberos
 			}
 		});
 		m_EditorFramebuffer->SetDebugName("EditorFramebuffer");
+
+		RegisterRuntimeSystems();
 	}
 
 	Scene::~Scene()
 	{
 		/// Destroy all entities in the scene
+		m_Registry.on_destroy<StaticMeshComponent>().disconnect(*this);
 		m_Registry.clear<entt::entity>();
 	}
 
@@ -58,7 +71,7 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		m_PhysicsSystem->Initialize(shared_from_this());
+		InitializePhysics();
 
 		ScriptEngine::OnRuntimeStart(shared_from_this());
 
@@ -79,7 +92,7 @@ namespace Kerberos
 
 	void Scene::OnSimulationStart()
 	{
-		m_PhysicsSystem->Initialize(shared_from_this());
+		InitializePhysics();
 	}
 
 	void Scene::OnSimulationStop() const 
@@ -87,6 +100,17 @@ namespace Kerberos
 		m_PhysicsSystem->Cleanup();
 	}
 
+	void Scene::InitializePhysics()
+	{
+		/// Without an active project the physics keeps the settings it was given
+		if (const Ref<Project> project = Project::GetActive())
+		{
+			m_PhysicsSystem->SetSettings(project->GetInfo().Physics);
+		}
+
+		m_PhysicsSystem->Initialize(shared_from_this());
+	}
+
 	void Scene::SetScenePaused(const bool isPaused)
 	{
 		m_IsScenePaused = isPaused;
@@ -112,45 +136,110 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		if (!m_IsScenePaused)
-		{
-			UpdateScripts(ts);
+		m_RuntimeSystems.Run(ts);
+	}
 
-			m_PhysicsSystem->Update(ts);
+	void Scene::RegisterRuntimeSystems()
+	{
+		/// The views of the systems running in parallel must not create the storages, so they are created up front
+		m_Registry.storage<CameraComponent>();
+		m_Registry.storage<PointLightComponent>();
+		m_Registry.storage<StaticMeshComponent>();
 
-			Application::Get().GetAudioManager()->Update();
-		}
+		/// The scripts can access anything, through Mono too
+		m_RuntimeSystems.AddSystem("Scripts", SystemAccess().Everything().OnMainThread(), [this](const Timestep ts)
+			{
+				if (!m_IsScenePaused)
+					UpdateScripts(ts);
+			});
+
+		/// Creating the bodies of new entities can load mesh assets, which creates GPU resources
+		m_RuntimeSystems.AddSystem("Physics", SystemAccess().Read<IDComponent>().Write<TransformComponent, RigidBody3DComponent, IPhysicsSystem>().OnMainThread(),
+			[this](const Timestep ts)
+			{
+				if (!m_IsScenePaused)
+					m_PhysicsSystem->Update(ts);
+			});
 
-		/// Render the scene
+		/// The events only hold the ids of the entities, so the scripts can destroy entities in the callbacks
+		m_RuntimeSystems.AddSystem("Contact events", SystemAccess().Everything().OnMainThread(), [this](Timestep)
+			{
+				if (m_IsScenePaused)
+					return;
 
-		const Camera* mainCamera = nullptr;
-		glm::mat4 mainCameraTransform;
+				for (const ContactEvent& event : m_PhysicsSystem->GetContactEvents())
+				{
+					ScriptEngine::OnContactEvent(event);
+				}
+			});
 
-		{
-			const auto view = m_Registry.view<CameraComponent, TransformComponent>();
-			for (const auto entity : view)
+		m_RuntimeSystems.AddSystem("Audio", SystemAccess().Write<AudioManager>(), [this](Timestep)
+			{
+				if (!m_IsScenePaused)
+					Application::Get().GetAudioManager()->Update();
+			});
+
+		m_RuntimeSystems.AddSystem("Camera selection", SystemAccess().Read<CameraComponent, TransformComponent>().Write<RuntimeCameraData>(), [this](Timestep)
+			{
+				m_RuntimeCamera = {};
+
+				const auto view = m_Registry.view<CameraComponent, TransformComponent>();
+				for (const auto entity : view)
+				{
+					auto [camera, transform] = view.get<CameraComponent, TransformComponent>(entity);
+					if (camera.IsPrimary)
+					{
+						m_RuntimeCamera.MainCamera = &camera.Camera;
+						m_RuntimeCamera.MainCameraTransform = transform.GetTransform();
+						break;
+					}
+				}
+			});
+
+		m_RuntimeSystems.AddSystem("Point lights", SystemAccess().Read<PointLightComponent, TransformComponent>().Write<RuntimeLightData>(), [this](Timestep)
 			{
-				auto [camera, transform] = view.get<CameraComponent, TransformComponent>(entity);
-				if (camera.IsPrimary)
+				m_RuntimeLights.PointLights.clear();
+
+				if (!m_Is3D)
+					return;
+
+				const auto view = m_Registry.view<PointLightComponent, TransformComponent>();
+				for (const auto entity : view)
 				{
-					mainCamera = &camera.Camera;
-					mainCameraTransform = transform.GetTransform();
-					break;
+					const auto& light = view.get<PointLightComponent>(entity);
+					if (light.IsEnabled)
+					{
+						m_RuntimeLights.PointLights.push_back(light.Light);
+					}
 				}
-			}
-		}
+			});
 
-		if (mainCamera)
-		{
-			if (m_Is3D)
+		m_RuntimeSystems.AddSystem("Mesh bounds", SystemAccess().Read<TransformComponent>().Write<StaticMeshComponent, DynamicBVH>(), [this](Timestep)
 			{
-				Render3DRuntime(mainCamera, mainCameraTransform);
-			}
-			else
+				if (m_Is3D)
+					UpdateMeshBounds();
+			});
+
+		/// Uses the graphics API, and only reads what the systems above gathered
+		m_RuntimeSystems.AddSystem("Render submission",
+			SystemAccess()
+				.Read<TransformComponent, StaticMeshComponent, SpriteRendererComponent, EnvironmentComponent, TextComponent, DynamicBVH, RuntimeCameraData, RuntimeLightData>()
+				.Write<DirectionalLightComponent>()
+				.OnMainThread(),
+			[this](Timestep)
 			{
-				Render2DRuntime(mainCamera, mainCameraTransform);
-			}
-		}
+				if (!m_RuntimeCamera.MainCamera)
+					return;
+
+				if (m_Is3D)
+				{
+					Render3DRuntime(m_RuntimeCamera.MainCamera, m_RuntimeCamera.MainCameraTransform, m_RuntimeLights.PointLights);
+				}
+				else
+				{
+					Render2DRuntime(m_RuntimeCamera.MainCamera, m_RuntimeCamera.MainCameraTransform);
+				}
+			});
 	}
 
 	Entity Scene::CreateEntity(const std::string& name)
@@ -158,6 +247,7 @@ namespace Kerberos
 		const auto enttId = m_Registry.create();
 		Entity entity = { enttId, this };
 		m_RootEntities.insert(enttId);
+		m_HierarchyChanged = true;
 
 		entity.AddComponent<TransformComponent>();
 		entity.AddComponent<HierarchyComponent>();
@@ -178,6 +268,7 @@ namespace Kerberos
 		const auto enttId = m_Registry.create();
 		Entity entity = { enttId, this };
 		m_RootEntities.insert(enttId);
+		m_HierarchyChanged = true;
 
 		entity.AddComponent<TransformComponent>();
 		entity.AddComponent<HierarchyComponent>();
@@ -198,22 +289,29 @@ namespace Kerberos
 	void Scene::DestroyEntity(const Entity entity)
 	{
 		const entt::entity enttId = static_cast<entt::entity>(entity);
-		if (m_RootEntities.contains(enttId))
+
+		UnlinkFromParent(enttId);
+
+		/// Collect the whole subtree first, so the links are not modified while they are traversed
+		std::vector<entt::entity> subtree{ enttId };
+		for (size_t i = 0; i < subtree.size(); ++i)
 		{
-			m_RootEntities.erase(enttId);
+			ForEachChild(subtree[i], [&subtree](const entt::entity child) { subtree.push_back(child); });
 		}
 
-		/// Destroy all children entities
-		const auto children = GetChildren(entity);
-		for (const auto& child : children)
+		for (const entt::entity id : subtree)
 		{
-			DestroyEntity(child);
+			m_RootEntities.erase(id);
+#if USE_MAP_FOR_UUID
+			m_UUIDToEntityMap.erase(m_Registry.get<IDComponent>(id).ID);
+#endif
 		}
 
-		m_Registry.destroy(enttId);
+		m_Registry.destroy(subtree.begin(), subtree.end());
+		m_HierarchyChanged = true;
 	}
 
-	void Scene::DuplicateEntity(const Entity entity, const bool duplicateChildren)
+	Entity Scene::DuplicateEntity(const Entity entity, const bool duplicateChildren)
 	{
 		KBR_PROFILE_FUNCTION();
 
@@ -317,10 +415,12 @@ namespace Kerberos
 			const auto children = GetChildren(entity);
 			for (const auto& child : children)
 			{
-				DuplicateEntity(child, true);
-				SetParent(child, newEntity, false);
+				const Entity childCopy = DuplicateEntity(child, true);
+				SetParent(childCopy, newEntity, false);
 			}
 		}
+
+		return newEntity;
 	}
 
 	void Scene::CreateChild(const Entity entity)
@@ -353,15 +453,23 @@ namespace Kerberos
 
 	void Scene::SetParent(const Entity child, const Entity parent, bool keepWorldTransform)
 	{
-		RemoveParent(child);
+		const entt::entity childId = static_cast<entt::entity>(child);
+		const entt::entity parentId = static_cast<entt::entity>(parent);
+
+		if (childId == parentId || IsDescendantOf(parentId, childId))
+		{
+			KBR_CORE_WARN("Cannot set {} as the parent of {}, because it is one of its descendants!", parent.GetName(), child.GetName());
+			return;
+		}
+
+		UnlinkFromParent(childId);
 
-		m_RootEntities.erase(static_cast<entt::entity>(child));
+		m_RootEntities.erase(childId);
 
-		auto& childHierarchy = child.GetComponent<HierarchyComponent>();
-		auto& parentHierarchy = parent.GetComponent<HierarchyComponent>();
+		LinkChild(childId, parentId);
 
-		childHierarchy.Parent = parent.GetUUID();
-		parentHierarchy.Children.emplace_back(child.GetUUID());
+		child.GetComponent<TransformComponent>().Dirty = true;
+		m_HierarchyChanged = true;
 	}
 
 	Entity Scene::GetParent(const Entity child) const
@@ -369,9 +477,9 @@ namespace Kerberos
 		KBR_PROFILE_FUNCTION();
 
 		const auto& childHierarchy = child.GetComponent<HierarchyComponent>();
-		if (childHierarchy.Parent.IsValid())
+		if (childHierarchy.HasParent())
 		{
-			return GetEntityByUUID(childHierarchy.Parent);
+			return { childHierarchy.Parent, const_cast<Scene*>(this) };
 		}
 		return {};
 	}
@@ -380,19 +488,16 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		auto& childHierarchy = child.GetComponent<HierarchyComponent>();
-		if (childHierarchy.Parent.IsValid())
+		const entt::entity childId = static_cast<entt::entity>(child);
+		if (child.GetComponent<HierarchyComponent>().HasParent())
 		{
-			auto& parentHierarchy = GetEntityByUUID(childHierarchy.Parent).GetComponent<HierarchyComponent>();
-			const auto it = std::ranges::find(parentHierarchy.Children, child.GetUUID());
-			if (it != parentHierarchy.Children.end())
-			{
-				parentHierarchy.Children.erase(it);
-			}
+			UnlinkFromParent(childId);
 
-			childHierarchy.Parent = UUID::Invalid();
 			/// The child is a root entity now
-			m_RootEntities.insert(static_cast<entt::entity>(child));
+			m_RootEntities.insert(childId);
+
+			child.GetComponent<TransformComponent>().Dirty = true;
+			m_HierarchyChanged = true;
 		}
 	}
 
@@ -403,12 +508,72 @@ namespace Kerberos
 		const auto& parentHierarchy = parent.GetComponent<HierarchyComponent>();
 
 		std::vector<Entity> children;
-		for (const auto& child : parentHierarchy.Children)
+		children.reserve(parentHierarchy.ChildCount);
+		ForEachChild(static_cast<entt::entity>(parent), [this, &children](const entt::entity child)
+			{
+				children.emplace_back(child, const_cast<Scene*>(this));
+			});
+		return children;
+	}
+
+	void Scene::LinkChild(const entt::entity child, const entt::entity parent)
+	{
+		auto& childHierarchy = m_Registry.get<HierarchyComponent>(child);
+		auto& parentHierarchy = m_Registry.get<HierarchyComponent>(parent);
+
+		childHierarchy.Parent = parent;
+		childHierarchy.PrevSibling = parentHierarchy.LastChild;
+		childHierarchy.NextSibling = entt::null;
+
+		if (parentHierarchy.LastChild != entt::null)
 		{
-			Entity entity = GetEntityByUUID(child);
-			children.push_back(entity);
+			m_Registry.get<HierarchyComponent>(parentHierarchy.LastChild).NextSibling = child;
 		}
-		return children;
+		else
+		{
+			parentHierarchy.FirstChild = child;
+		}
+
+		parentHierarchy.LastChild = child;
+		++parentHierarchy.ChildCount;
+	}
+
+	void Scene::UnlinkFromParent(const entt::entity child)
+	{
+		auto& childHierarchy = m_Registry.get<HierarchyComponent>(child);
+		if (!childHierarchy.HasParent())
+			return;
+
+		auto& parentHierarchy = m_Registry.get<HierarchyComponent>(childHierarchy.Parent);
+
+		if (childHierarchy.PrevSibling != entt::null)
+			m_Registry.get<HierarchyComponent>(childHierarchy.PrevSibling).NextSibling = childHierarchy.NextSibling;
+		else
+			parentHierarchy.FirstChild = childHierarchy.NextSibling;
+
+		if (childHierarchy.NextSibling != entt::null)
+			m_Registry.get<HierarchyComponent>(childHierarchy.NextSibling).PrevSibling = childHierarchy.PrevSibling;
+		else
+			parentHierarchy.LastChild = childHierarchy.PrevSibling;
+
+		--parentHierarchy.ChildCount;
+
+		childHierarchy.Parent = entt::null;
+		childHierarchy.PrevSibling = entt::null;
+		childHierarchy.NextSibling = entt::null;
+	}
+
+	bool Scene::IsDescendantOf(const entt::entity entity, const entt::entity ancestor) const
+	{
+		entt::entity current = m_Registry.get<HierarchyComponent>(entity).Parent;
+		while (current != entt::null)
+		{
+			if (current == ancestor)
+				return true;
+
+			current = m_Registry.get<HierarchyComponent>(current).Parent;
+		}
+		return false;
 	}
 
 	void Scene::OnViewportResize(const uint32_t width, const uint32_t height)
@@ -561,20 +726,32 @@ namespace Kerberos
 
 	void Scene::Render2DRuntime(const Camera* mainCamera, const glm::mat4& mainCameraTransform)
 	{
-		Renderer2D::BeginScene(*mainCamera, mainCameraTransform);
+		KBR_PROFILE_FUNCTION();
 
 		const auto view = m_Registry.view<TransformComponent, SpriteRendererComponent>();
+
+		/// Gathered first, so the quads are written in bulk instead of one DrawQuad call each
+		std::vector<glm::mat4>& transforms = m_RuntimeSprites.Transforms;
+		std::vector<glm::vec4>& colors = m_RuntimeSprites.Colors;
+		transforms.clear();
+		colors.clear();
+		transforms.reserve(view.size_hint());
+		colors.reserve(view.size_hint());
+
 		for (const auto entity : view)
 		{
 			auto [transform, sprite] = view.get<TransformComponent, SpriteRendererComponent>(entity);
 
-			Renderer2D::DrawQuad(transform.WorldTransform, sprite.Color);
+			transforms.push_back(transform.WorldTransform);
+			colors.push_back(sprite.Color);
 		}
 
+		Renderer2D::BeginScene(*mainCamera, mainCameraTransform);
+		Renderer2D::DrawQuads(transforms, colors);
 		Renderer2D::EndScene();
 	}
 
-	void Scene::Render3DRuntime(const Camera* mainCamera, const glm::mat4& mainCameraTransform)
+	void Scene::Render3DRuntime(const Camera* mainCamera, const glm::mat4& mainCameraTransform, const std::vector<PointLight>& pointLights)
 	{
 		KBR_PROFILE_FUNCTION();
 
@@ -601,37 +778,14 @@ namespace Kerberos
 
 			Renderer3D::BeginShadowPass(dlc->Light, shadowSettings, m_ShadowMapFramebuffer);
 
-			/// Render all shadow-casting meshes
-			const auto meshView = m_Registry.view<StaticMeshComponent, TransformComponent>();
-			for (auto entity : meshView)
-			{
-				auto& meshComp = meshView.get<StaticMeshComponent>(entity);
-				auto& transformComp = meshView.get<TransformComponent>(entity);
-
-				if (meshComp.StaticMesh && meshComp.MeshMaterial && meshComp.Visible)
-				{
-					Renderer3D::SubmitMesh(meshComp.StaticMesh, transformComp.WorldTransform,
-						meshComp.MeshMaterial, meshComp.MeshTexture, 1.0f,
-						static_cast<int>(entity), meshComp.CastShadows);
-				}
-			}
+			/// Render all shadow-casting meshes inside the light's frustum
+			SubmitVisibleMeshes(Frustum::FromViewProjection(Renderer3D::GetShadowLightSpaceMatrix()), true);
 
 			dlc->NeedsUpdate = false;
 
 			Renderer3D::EndPass();
 		}
 
-		std::vector<PointLight> pointLights;
-		const auto pointLightView = m_Registry.view<PointLightComponent, TransformComponent>();
-		for (const auto entity : pointLightView)
-		{
-			auto [light, transform] = pointLightView.get<PointLightComponent, TransformComponent>(entity);
-			if (light.IsEnabled)
-			{
-				pointLights.push_back(light.Light);
-			}
-		}
-
 		Ref<TextureCube> skyboxTexture = nullptr;
 		const auto skyboxView = m_Registry.view<EnvironmentComponent>();
 		for (const auto entity : skyboxView)
@@ -656,16 +810,7 @@ namespace Kerberos
 
 		Renderer3D::BeginGeometryPass(*mainCamera, mainCameraTransform, &dlc->Light, pointLights, skyboxTexture);
 
-		const auto view = m_Registry.view<TransformComponent, StaticMeshComponent>();
-		for (const auto entity : view)
-		{
-			auto [transform, mesh] = view.get<TransformComponent, StaticMeshComponent>(entity);
-
-			if (mesh.Visible)
-			{
-				Renderer3D::SubmitMesh(mesh.StaticMesh, transform.WorldTransform, mesh.MeshMaterial, mesh.MeshTexture);
-			}
-		}
+		SubmitVisibleMeshes(Frustum::FromViewProjection(mainCamera->GetProjection() * glm::inverse(mainCameraTransform)), false);
 
 		Renderer3D::EndPass();
 
@@ -682,6 +827,10 @@ namespace Kerberos
 
 	void Scene::Render3DEditor(const EditorCamera& camera)
 	{
+		KBR_PROFILE_FUNCTION();
+
+		UpdateMeshBounds();
+
 		DirectionalLightComponent* dlc = nullptr;
 		const auto sunView = m_Registry.view<DirectionalLightComponent, TransformComponent>();
 		for (const auto entity : sunView)
@@ -705,20 +854,8 @@ namespace Kerberos
 
 			Renderer3D::BeginShadowPass(dlc->Light, shadowSettings, m_ShadowMapFramebuffer);
 
-			/// Render all shadow-casting meshes
-			const auto meshView = m_Registry.view<StaticMeshComponent, TransformComponent>();
-			for (auto entity : meshView)
-			{
-				auto& meshComp = meshView.get<StaticMeshComponent>(entity);
-				auto& transformComp = meshView.get<TransformComponent>(entity);
-
-				if (meshComp.StaticMesh && meshComp.MeshMaterial && meshComp.Visible)
-				{
-					Renderer3D::SubmitMesh(meshComp.StaticMesh, transformComp.WorldTransform,
-						meshComp.MeshMaterial, meshComp.MeshTexture, 1.0f,
-						static_cast<int>(entity), meshComp.CastShadows);
-				}
-			}
+			/// Render all shadow-casting meshes inside the light's frustum
+			SubmitVisibleMeshes(Frustum::FromViewProjection(Renderer3D::GetShadowLightSpaceMatrix()), true);
 
 			dlc->NeedsUpdate = false;
 
@@ -760,16 +897,7 @@ namespace Kerberos
 
 		Renderer3D::BeginGeometryPass(camera, &dlc->Light, pointLights, skyboxTexture);
 
-		const auto view = m_Registry.view<TransformComponent, StaticMeshComponent>();
-		for (const auto entity : view)
-		{
-			auto [transform, mesh] = view.get<TransformComponent, StaticMeshComponent>(entity);
-
-			if (mesh.Visible)
-			{
-				Renderer3D::SubmitMesh(mesh.StaticMesh, transform.WorldTransform, mesh.MeshMaterial, mesh.MeshTexture, 1.0f, static_cast<int>(entity), mesh.CastShadows);
-			}
-		}
+		SubmitVisibleMeshes(Frustum::FromViewProjection(camera.GetViewProjectionMatrix()), true);
 
 		Renderer3D::EndPass();
 
@@ -784,6 +912,77 @@ namespace Kerberos
 		Renderer3D::EndScene();
 	}
 
+	void Scene::UpdateMeshBounds()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		const auto view = m_Registry.view<TransformComponent, StaticMeshComponent>();
+		for (const auto entity : view)
+		{
+			auto [transform, mesh] = view.get<TransformComponent, StaticMeshComponent>(entity);
+
+			if (!mesh.StaticMesh || !mesh.StaticMesh->GetBounds().IsValid())
+			{
+				if (mesh.BVHProxy != DynamicBVH::NullNode)
+				{
+					m_MeshBVH.DestroyProxy(mesh.BVHProxy);
+					mesh.BVHProxy = DynamicBVH::NullNode;
+				}
+				mesh.BoundsMesh = nullptr;
+				continue;
+			}
+
+			if (mesh.BVHProxy != DynamicBVH::NullNode && mesh.BoundsMesh == mesh.StaticMesh.get()
+				&& mesh.BoundsTransformVersion == transform.WorldTransformVersion)
+			{
+				continue;
+			}
+
+			mesh.WorldBounds = mesh.StaticMesh->GetBounds().Transform(transform.WorldTransform);
+			mesh.BoundsMesh = mesh.StaticMesh.get();
+			mesh.BoundsTransformVersion = transform.WorldTransformVersion;
+
+			if (mesh.BVHProxy == DynamicBVH::NullNode)
+			{
+				mesh.BVHProxy = m_MeshBVH.CreateProxy(mesh.WorldBounds, entity);
+			}
+			else
+			{
+				m_MeshBVH.MoveProxy(mesh.BVHProxy, mesh.WorldBounds);
+			}
+		}
+	}
+
+	void Scene::SubmitVisibleMeshes(const Frustum& frustum, const bool submitEntityIDs)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		uint32_t intersecting = 0;
+		m_MeshBVH.Query(frustum, [this, submitEntityIDs, &intersecting](const entt::entity entity)
+			{
+				++intersecting;
+
+				const auto [transform, mesh] = m_Registry.get<TransformComponent, StaticMeshComponent>(entity);
+				if (!mesh.Visible || !mesh.MeshMaterial)
+					return;
+
+				Renderer3D::SubmitMesh(mesh.StaticMesh, transform.WorldTransform, mesh.MeshMaterial, mesh.MeshTexture, 1.0f,
+					submitEntityIDs ? static_cast<int>(entity) : -1, mesh.CastShadows);
+			});
+
+		Renderer3D::AddCulledMeshes(m_MeshBVH.GetProxyCount() - intersecting);
+	}
+
+	void Scene::OnStaticMeshDestroyed(entt::registry& registry, const entt::entity entity)
+	{
+		auto& mesh = registry.get<StaticMeshComponent>(entity);
+		if (mesh.BVHProxy != DynamicBVH::NullNode)
+		{
+			m_MeshBVH.DestroyProxy(mesh.BVHProxy);
+			mesh.BVHProxy = DynamicBVH::NullNode;
+		}
+	}
+
 	void Scene::UpdateScripts(Timestep ts) 
 	{
 		KBR_PROFILE_FUNCTION();
@@ -818,15 +1017,14 @@ namespace Kerberos
 	void Scene::UpdateChildTransforms(const Entity parent, const glm::mat4& parentTransform)
 	{
 		auto& tsc = parent.GetComponent<TransformComponent>();
-		const glm::mat4 localTransform = tsc.GetTransform();
-		tsc.WorldTransform = parentTransform * localTransform;
+		tsc.UpdateWorldTransform(parentTransform);
 
 		//tsc.Translation = Physics::ExtractTranslationFromMatrix(tsc.WorldTransform);
 
-		for (const auto& child : GetChildren(parent))
-		{
-			UpdateChildTransforms(child, tsc.WorldTransform);
-		}
+		ForEachChild(static_cast<entt::entity>(parent), [this, &tsc](const entt::entity child)
+			{
+				UpdateChildTransforms({ child, this }, tsc.WorldTransform);
+			});
 	}
 
 	bool Scene::ShouldRenderShadows(const DirectionalLightComponent* dlc) const
@@ -857,24 +1055,132 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		const auto view = m_Registry.view<TransformComponent>();
-		for (const auto id : view)
+		if (m_HierarchyChanged || m_TransformLevelsEntityCount != m_Registry.storage<TransformComponent>().size())
 		{
-			const Entity entity{ id, this };
-			const UUID parentUUID = entity.GetComponent<HierarchyComponent>().Parent;
+			RebuildTransformLevels();
+		}
+
+		const uint64_t frameIndex = ++m_TransformFrameIndex;
+		auto& transforms = m_Registry.storage<TransformComponent>();
+
+		/// Each level only reads the transforms of the previous level, which is already finished,
+		/// so the entities inside a level can be processed independently.
+		const auto updateNode = [&transforms, frameIndex](const TransformNode& node) -> uint32_t
+			{
+				auto& tc = transforms.get(node.Entity);
+
+				if (node.Parent == entt::null)
+				{
+					if (!tc.IsLocalTransformDirty())
+						return 0;
 
-			/// Only calculate the transforms of root entities, since the UpdateChildTransforms
-			/// function will handle all the children
-			if (!parentUUID.IsValid())
+					tc.UpdateWorldTransform(glm::mat4(1.0f));
+				}
+				else
+				{
+					const auto& parentTc = transforms.get(node.Parent);
+					if (parentTc.LastUpdatedFrame != frameIndex && !tc.IsLocalTransformDirty())
+						return 0;
+
+					tc.UpdateWorldTransform(parentTc.WorldTransform);
+				}
+
+				tc.LastUpdatedFrame = frameIndex;
+				return 1;
+			};
+
+		uint32_t recomputed = 0;
+		size_t total = 0;
+		for (const auto& level : m_TransformLevels)
+		{
+			if (level.size() >= PARALLEL_TRANSFORM_THRESHOLD)
 			{
-				UpdateChildTransforms(entity, glm::mat4(1.0f));
+				std::atomic<uint32_t> levelRecomputed = 0;
+				JobSystem::ParallelFor(static_cast<uint32_t>(level.size()), PARALLEL_TRANSFORM_GRAIN_SIZE, [&level, &updateNode, &levelRecomputed](const uint32_t begin, const uint32_t end)
+					{
+						uint32_t chunkRecomputed = 0;
+						for (uint32_t i = begin; i < end; ++i)
+						{
+							chunkRecomputed += updateNode(level[i]);
+						}
+						levelRecomputed.fetch_add(chunkRecomputed, std::memory_order_relaxed);
+					});
+				recomputed += levelRecomputed.load(std::memory_order_relaxed);
+			}
+			else
+			{
+				recomputed += std::transform_reduce(level.begin(), level.end(), 0u, std::plus<>(), updateNode);
 			}
+			total += level.size();
 		}
+
+		m_TransformStatistics.Recomputed = recomputed;
+		m_TransformStatistics.Skipped = static_cast<uint32_t>(total) - recomputed;
+		m_TransformStatistics.Levels = static_cast<uint32_t>(m_TransformLevels.size());
 	}
 
 	void Scene::CalculateEntityTransform(const Entity& entity)
 	{
-		UpdateChildTransforms(entity, glm::mat4(1.0f));
+		const Entity parent = GetParent(entity);
+		const glm::mat4 parentTransform = parent ? parent.GetComponent<TransformComponent>().WorldTransform : glm::mat4(1.0f);
+
+		UpdateChildTransforms(entity, parentTransform);
+	}
+
+	void Scene::RebuildTransformLevels()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		for (auto& level : m_TransformLevels)
+		{
+			level.clear();
+		}
+		m_HierarchyOrder.clear();
+
+		/// Depth-first traversal of every root, using an explicit stack of the next sibling to visit
+		std::vector<TransformNode> stack;
+		const auto view = m_Registry.view<TransformComponent, HierarchyComponent>();
+		for (const auto root : view)
+		{
+			if (view.get<HierarchyComponent>(root).HasParent())
+				continue;
+
+			stack.push_back({ root, entt::null });
+			while (!stack.empty())
+			{
+				const TransformNode node = stack.back();
+				stack.pop_back();
+
+				auto& hierarchy = m_Registry.get<HierarchyComponent>(node.Entity);
+				hierarchy.Depth = node.Parent == entt::null ? 0 : m_Registry.get<HierarchyComponent>(node.Parent).Depth + 1;
+
+				if (hierarchy.Depth >= m_TransformLevels.size())
+				{
+					m_TransformLevels.resize(hierarchy.Depth + 1);
+				}
+				m_TransformLevels[hierarchy.Depth].push_back(node);
+				m_HierarchyOrder.push_back(node.Entity);
+
+				/// Push the children in reverse, so they are visited in order
+				for (entt::entity child = hierarchy.LastChild; child != entt::null; child = m_Registry.get<HierarchyComponent>(child).PrevSibling)
+				{
+					stack.push_back({ child, node.Entity });
+				}
+			}
+		}
+
+		while (!m_TransformLevels.empty() && m_TransformLevels.back().empty())
+		{
+			m_TransformLevels.pop_back();
+		}
+
+		/// Keep the components in depth-first order, so parents are stored before their children,
+		/// and the transforms of a level are accessed in increasing memory order
+		m_Registry.storage<HierarchyComponent>().sort_as(m_HierarchyOrder.begin(), m_HierarchyOrder.end());
+		m_Registry.storage<TransformComponent>().sort_as(m_HierarchyOrder.begin(), m_HierarchyOrder.end());
+
+		m_TransformLevelsEntityCount = m_Registry.storage<TransformComponent>().size();
+		m_HierarchyChanged = false;
 	}
 
 	Entity Scene::FindEntityByName(const std::string_view name) 
@@ -929,7 +1235,11 @@ namespace Kerberos
 
 	template <>
 	void Scene::OnComponentAdded<StaticMeshComponent>(Entity entity, StaticMeshComponent& component)
-	{}
+	{
+		/// The culling data is copied along with the component when duplicating, but the new entity is not in the BVH yet
+		component.BVHProxy = DynamicBVH::NullNode;
+		component.BoundsMesh = nullptr;
+	}
 
 	template <>
 	void Scene::OnComponentAdded<DirectionalLightComponent>(Entity entity, DirectionalLightComponent& component)
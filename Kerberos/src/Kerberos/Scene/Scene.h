@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Components.h"
+#include "DynamicBVH.h"
 #include "EditorCamera.h"
+#include "SystemScheduler.h"
 #include "Kerberos/Renderer/Camera.h"
 #include "Kerberos/Renderer/Framebuffer.h"
 #include "Kerberos/Core/Timestep.h"
@@ -18,6 +20,16 @@ namespace Kerberos
 	class Entity;
 	class HierarchyPanel;
 
+	struct TransformStatistics
+	{
+		/// Number of world transforms recalculated during the last transform update
+		uint32_t Recomputed = 0;
+		/// Number of world transforms that were up to date and skipped
+		uint32_t Skipped = 0;
+		/// Number of hierarchy levels processed
+		uint32_t Levels = 0;
+	};
+
 	class Scene : public std::enable_shared_from_this<Scene>, public Asset
 	{
 	public:
@@ -57,8 +69,9 @@ namespace Kerberos
 		 *
 		 * @param entity The entity to duplicate
 		 * @param duplicateChildren If true, duplicates the children of the entity as well
+		 * @return Entity The newly created entity
 		 */
-		void DuplicateEntity(Entity entity, bool duplicateChildren);
+		Entity DuplicateEntity(Entity entity, bool duplicateChildren);
 
 		void CreateChild(Entity entity);
 
@@ -69,6 +82,23 @@ namespace Kerberos
 		void RemoveParent(Entity child);
 		std::vector<Entity> GetChildren(Entity parent) const;
 
+		/**
+		 * @brief Calls the function for every direct child of the entity, without allocating
+		 *
+		 * The hierarchy must not be modified from the callback.
+		 */
+		template<typename Fn>
+		void ForEachChild(const entt::entity parent, Fn&& fn) const
+		{
+			entt::entity child = m_Registry.get<HierarchyComponent>(parent).FirstChild;
+			while (child != entt::null)
+			{
+				const entt::entity next = m_Registry.get<HierarchyComponent>(child).NextSibling;
+				fn(child);
+				child = next;
+			}
+		}
+
 		const std::set<entt::entity>& GetRootEntities() const { return m_RootEntities; }
 
 		void OnViewportResize(uint32_t width, uint32_t height);
@@ -77,9 +107,27 @@ namespace Kerberos
 		void SetEnableShadowMapping(const bool enable) { m_EnableShadowMapping = enable; }
 
 		Entity GetPrimaryCameraEntity();
+
+		/**
+		 * @brief Recalculates the world transforms of the entities whose local transform or parent changed
+		 *
+		 * The hierarchy is processed level by level (breadth-first), and large levels are processed in parallel.
+		 */
 		void CalculateEntityTransforms();
 		void CalculateEntityTransform(const Entity& entity);
 
+		const TransformStatistics& GetTransformStatistics() const { return m_TransformStatistics; }
+
+		/// The timings of the systems of the last runtime update
+		const FrameTimeBreakdown& GetFrameTimeBreakdown() const { return m_RuntimeSystems.GetFrameTimeBreakdown(); }
+
+		/**
+		 * @brief Updates the world bounds of the static meshes whose transform or mesh changed,
+		 * and moves them in the bounding volume hierarchy used for culling.
+		 */
+		void UpdateMeshBounds();
+		const DynamicBVH& GetMeshBVH() const { return m_MeshBVH; }
+
 		Entity FindEntityByName(std::string_view name);
 
 		Ref<Framebuffer> GetOmniShadowMapFramebuffer() const { return m_OmniShadowMapFramebuffer; }
@@ -99,13 +147,42 @@ namespace Kerberos
 		void OnComponentAdded(Entity entity, T& component);
 
 		void Render2DRuntime(const Camera* mainCamera, const glm::mat4& mainCameraTransform);
-		void Render3DRuntime(const Camera* mainCamera, const glm::mat4& mainCameraTransform);
+		void Render3DRuntime(const Camera* mainCamera, const glm::mat4& mainCameraTransform, const std::vector<PointLight>& pointLights);
 		void Render3DEditor(const EditorCamera& camera);
 
+		/**
+		 * @brief Adds the systems of OnUpdateRuntime to the scheduler, with the components they access
+		 *
+		 * The systems gathering the data of the frame run in parallel, and the render submission uses what they gathered.
+		 */
+		void RegisterRuntimeSystems();
+
 		void UpdateScripts(Timestep ts);
+		/// Initializes the physics with the settings of the active project
+		void InitializePhysics();
+
+		/**
+		 * @brief Submits the static meshes intersecting the frustum to the current Renderer3D pass
+		 *
+		 * @param frustum The frustum of the camera or light of the pass
+		 * @param submitEntityIDs If true, the entity IDs are submitted for mouse picking
+		 */
+		void SubmitVisibleMeshes(const Frustum& frustum, bool submitEntityIDs);
+		void OnStaticMeshDestroyed(entt::registry& registry, entt::entity entity);
 
 		void UpdateChildTransforms(Entity parent, const glm::mat4& parentTransform);
 
+		void LinkChild(entt::entity child, entt::entity parent);
+		void UnlinkFromParent(entt::entity child);
+		bool IsDescendantOf(entt::entity entity, entt::entity ancestor) const;
+
+		/**
+		 * @brief Rebuilds the breadth-first list of hierarchy levels used by CalculateEntityTransforms,
+		 * updates the depth of every HierarchyComponent, and sorts the hierarchy and transform storages
+		 * in depth-first order, so that every subtree is contiguous in memory.
+		 */
+		void RebuildTransformLevels();
+
 		bool ShouldRenderShadows(const DirectionalLightComponent* dlc) const;
 
 		template<typename Component>
@@ -134,8 +211,49 @@ namespace Kerberos
 
 		std::set<entt::entity> m_RootEntities;
 
+		struct TransformNode
+		{
+			entt::entity Entity = entt::null;
+			entt::entity Parent = entt::null;
+		};
+
+		/// The entities grouped by their depth in the hierarchy, rebuilt when the hierarchy changes
+		std::vector<std::vector<TransformNode>> m_TransformLevels;
+		/// All the entities of the hierarchy in depth-first order
+		std::vector<entt::entity> m_HierarchyOrder;
+		size_t m_TransformLevelsEntityCount = 0;
+		bool m_HierarchyChanged = true;
+		uint64_t m_TransformFrameIndex = 0;
+		TransformStatistics m_TransformStatistics;
+
+		DynamicBVH m_MeshBVH;
+
 		IPhysicsSystem* m_PhysicsSystem;
 
+		/// The data gathered for the render submission of the runtime, each of them is written by a single system
+		struct RuntimeCameraData
+		{
+			const Camera* MainCamera = nullptr;
+			glm::mat4 MainCameraTransform{ 1.0f };
+		};
+
+		struct RuntimeLightData
+		{
+			std::vector<PointLight> PointLights;
+		};
+
+		/// The sprites handed to Renderer2D::DrawQuads, kept between frames so they are only allocated once
+		struct RuntimeSpriteData
+		{
+			std::vector<glm::mat4> Transforms;
+			std::vector<glm::vec4> Colors;
+		};
+
+		RuntimeCameraData m_RuntimeCamera;
+		RuntimeLightData m_RuntimeLights;
+		RuntimeSpriteData m_RuntimeSprites;
+		SystemScheduler m_RuntimeSystems;
+
 		friend class Entity;
 		friend class PhysicsSystem;
 		friend class HierarchyPanel;
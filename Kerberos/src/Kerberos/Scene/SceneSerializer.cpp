@@ -6,6 +6,7 @@
 #include "Kerberos/Scene/Components/PhysicsComponents.h"
 #include "Kerberos/Scene/Components/AudioComponents.h"
 #include "Kerberos/Assets/AssetManager.h"
+#include "Kerberos/Core/MappedFile.h"
 #include "Kerberos/Scripting/ScriptEngine.h"
 #include "Kerberos/Scripting/ScriptUtils.h"
 #include "Kerberos/Scripting/ScriptClass.h"
@@ -13,6 +14,7 @@
 #include <yaml-cpp/yaml.h>
 #include <glm/glm.hpp>
 
+#include <bit>
 #include <fstream>
 
 
@@ -105,7 +107,7 @@ namespace Kerberos
 		return out;
 	}
 
-	static void SerializeEntity(YAML::Emitter& out, const Entity entity)
+	static void SerializeEntity(YAML::Emitter& out, const Entity entity, const Scene& scene)
 	{
 		out << YAML::BeginMap;
 
@@ -174,12 +176,13 @@ namespace Kerberos
 		{
 			out << YAML::Key << "HierarchyComponent";
 			out << YAML::BeginMap;
-			const auto& hierarchy = entity.GetComponent<HierarchyComponent>();
-			out << YAML::Key << "Parent" << YAML::Value << hierarchy.Parent;
+			/// The runtime links are entity handles, the hierarchy is stored with the UUIDs of the entities
+			const Entity parent = scene.GetParent(entity);
+			out << YAML::Key << "Parent" << YAML::Value << (parent ? parent.GetUUID() : UUID::Invalid());
 			out << YAML::Key << "Children" << YAML::Value << YAML::BeginSeq;
-			for (const auto& child : hierarchy.Children)
+			for (const auto& child : scene.GetChildren(entity))
 			{
-				out << child;
+				out << child.GetUUID();
 			}
 			out << YAML::EndSeq;
 			out << YAML::EndMap;
@@ -467,7 +470,7 @@ namespace Kerberos
 			if (!entity)
 				continue;
 
-			SerializeEntity(out, entity);
+			SerializeEntity(out, entity, *m_Scene);
 		}
 		out << YAML::EndSeq;
 		out << YAML::EndMap;
@@ -494,9 +497,44 @@ namespace Kerberos
 		}
 	}
 
-	void SceneSerializer::SerializeRuntime(const std::filesystem::path& filepath)
+	/**
+	* Starts loading every asset referenced by the entities in the background,
+	* so they are decoded in parallel, instead of one by one when the components are deserialized.
+	*/
+	static void RequestEntityAssets(const YAML::Node& entities)
 	{
-		throw std::logic_error("Not implemented");
+		KBR_PROFILE_FUNCTION();
+
+		const auto requestAsset = [](const YAML::Node& handleNode)
+			{
+				if (!handleNode)
+					return;
+
+				const AssetHandle handle = AssetHandle(handleNode.as<uint64_t>());
+				if (handle.IsValid())
+					AssetManager::GetAssetAsync(handle);
+			};
+
+		for (const auto& entity : entities)
+		{
+			if (auto staticMeshComponent = entity["StaticMeshComponent"])
+			{
+				requestAsset(staticMeshComponent["Mesh"]);
+				requestAsset(staticMeshComponent["Texture"]);
+			}
+
+			if (auto meshColliderComponent = entity["MeshCollider3DComponent"])
+				requestAsset(meshColliderComponent["Mesh"]);
+
+			if (auto environmentComponent = entity["EnvironmentComponent"])
+				requestAsset(environmentComponent["SkyboxTexture"]);
+
+			if (auto audioSource3DComponent = entity["AudioSource3DComponent"])
+				requestAsset(audioSource3DComponent["SoundAsset"]);
+
+			if (auto audioSource2DComponent = entity["AudioSource2DComponent"])
+				requestAsset(audioSource2DComponent["SoundAsset"]);
+		}
 	}
 
 	bool SceneSerializer::Deserialize(const std::filesystem::path& filepath) const
@@ -514,8 +552,13 @@ namespace Kerberos
 
 		auto sceneName = data["Scene"].as<std::string>();
 
+		/// The hierarchy can only be linked after every entity is created
+		std::vector<std::pair<Entity, std::vector<UUID>>> entityChildren;
+
 		if (auto entities = data["Entities"])
 		{
+			RequestEntityAssets(entities);
+
 			for (const auto& entity : entities)
 			{
 				uint64_t uuid = entity["Entity"].as<uint64_t>();
@@ -561,21 +604,17 @@ namespace Kerberos
 
 				if (auto hierarchyComponent = entity["HierarchyComponent"])
 				{
-					/// The entity must have a HierarchyComponent already when created
-					auto& hierarchy = deserializedEntity.GetComponent<HierarchyComponent>();
-					const UUID parentId = static_cast<UUID>(hierarchyComponent["Parent"].as<uint64_t>());
-
-					hierarchy.Parent = parentId;
-					if (parentId.IsValid())
+					/// The entity must have a HierarchyComponent already when created,
+					/// the children are linked once every entity is deserialized
+					std::vector<UUID> children;
+					for (const auto& child : hierarchyComponent["Children"])
 					{
-						/// If the entity has a parent, it should not be a root entity
-						m_Scene->m_RootEntities.erase(static_cast<entt::entity>(deserializedEntity));
+						children.emplace_back(child.as<uint64_t>());
 					}
 
-					for (const auto& child : hierarchyComponent["Children"])
+					if (!children.empty())
 					{
-						const uint64_t childUUID = child.as<uint64_t>();
-						hierarchy.Children.emplace_back(childUUID);
+						entityChildren.emplace_back(deserializedEntity, std::move(children));
 					}
 				}
 
@@ -723,17 +762,6 @@ namespace Kerberos
 					capsuleCollider.Offset = capsuleColliderComponent["Offset"].as<glm::vec3>();
 				}
 
-				if (auto meshColliderComponent = entity["MeshCollider3DComponent"])
-				{
-					auto& meshCollider = deserializedEntity.AddComponent<MeshCollider3DComponent>();
-					meshCollider.IsTrigger = meshColliderComponent["IsTrigger"].as<bool>();
-					const AssetHandle meshHandle = AssetHandle(meshColliderComponent["Mesh"].as<uint64_t>());
-					if (meshHandle.IsValid())
-					{
-						meshCollider.Mesh = AssetManager::GetAsset<Mesh>(meshHandle);
-					}
-				}
-
 				if (auto staticMeshComponent = entity["StaticMeshComponent"])
 				{
 					auto& staticMesh = deserializedEntity.AddComponent<StaticMeshComponent>();
@@ -771,6 +799,18 @@ namespace Kerberos
 					}
 				}
 
+				/// The mesh collider takes the mesh of the static mesh when it's added, so that has to be loaded first
+				if (auto meshColliderComponent = entity["MeshCollider3DComponent"])
+				{
+					auto& meshCollider = deserializedEntity.AddComponent<MeshCollider3DComponent>();
+					meshCollider.IsTrigger = meshColliderComponent["IsTrigger"].as<bool>();
+					const AssetHandle meshHandle = AssetHandle(meshColliderComponent["Mesh"].as<uint64_t>());
+					if (meshHandle.IsValid())
+					{
+						meshCollider.Mesh = AssetManager::GetAsset<Mesh>(meshHandle);
+					}
+				}
+
 				if (auto environmentComponent = entity["EnvironmentComponent"])
 				{
 					auto& environment = deserializedEntity.AddComponent<EnvironmentComponent>();
@@ -789,7 +829,9 @@ namespace Kerberos
 				if (auto audioSource3DComponent = entity["AudioSource3DComponent"])
 				{
 					auto& audioSource3D = deserializedEntity.AddComponent<AudioSource3DComponent>();
-					audioSource3D.SoundAsset = AssetManager::GetAsset<Sound>(AssetHandle(audioSource3DComponent["SoundAsset"].as<uint64_t>()));
+					const AssetHandle soundHandle = AssetHandle(audioSource3DComponent["SoundAsset"].as<uint64_t>());
+					if (soundHandle.IsValid())
+						audioSource3D.SoundAsset = AssetManager::GetAsset<Sound>(soundHandle);
 					audioSource3D.Loop = audioSource3DComponent["Loop"].as<bool>();
 					audioSource3D.Volume = audioSource3DComponent["Volume"].as<float>();
 				}
@@ -797,7 +839,9 @@ namespace Kerberos
 				if (auto audioSource2DComponent = entity["AudioSource2DComponent"])
 				{
 					auto& audioSource2D = deserializedEntity.AddComponent<AudioSource2DComponent>();
-					audioSource2D.SoundAsset = AssetManager::GetAsset<Sound>(AssetHandle(audioSource2DComponent["SoundAsset"].as<uint64_t>()));
+					const AssetHandle soundHandle = AssetHandle(audioSource2DComponent["SoundAsset"].as<uint64_t>());
+					if (soundHandle.IsValid())
+						audioSource2D.SoundAsset = AssetManager::GetAsset<Sound>(soundHandle);
 					audioSource2D.Loop = audioSource2DComponent["Loop"].as<bool>();
 					audioSource2D.Volume = audioSource2DComponent["Volume"].as<float>();
 				}
@@ -810,11 +854,1141 @@ namespace Kerberos
 			}
 		}
 
+		for (const auto& [parent, children] : entityChildren)
+		{
+			for (const UUID childUUID : children)
+			{
+				const auto it = m_Scene->m_UUIDToEntityMap.find(childUUID);
+				if (it == m_Scene->m_UUIDToEntityMap.end())
+				{
+					KBR_CORE_WARN("Child entity {} of entity {} was not found!", static_cast<uint64_t>(childUUID), static_cast<uint64_t>(parent.GetUUID()));
+					continue;
+				}
+
+				m_Scene->SetParent(it->second, parent, false);
+			}
+		}
+
 		return true;
 	}
 
+	/**
+	* The binary scene format used by SerializeRuntime and DeserializeRuntime.
+	*
+	* The file starts with a header, followed by chunks. The strings (tags, texts, script names) are stored once
+	* in the string table chunk, and referenced by their index. The entity chunk stores the UUID and tag of every entity,
+	* and every component chunk stores the indices of the entities having the component, followed by the component records.
+	* Unknown chunks are skipped, so chunks can be added without breaking older files.
+	* Everything is stored in little-endian, the byte order of every platform the engine runs on.
+	*/
+	namespace BinaryScene
+	{
+		static_assert(std::endian::native == std::endian::little, "The binary scene format is only implemented for little-endian platforms");
+
+		/// Increment when the layout of a chunk changes
+		static constexpr uint32_t Version = 1;
+		static constexpr std::array<char, 4> Magic = { 'K', 'S', 'C', 'N' };
+
+		enum class ChunkType : uint32_t
+		{
+			StringTable = 0,
+			Entities,
+			Hierarchy,
+			Transform,
+			SpriteRenderer,
+			Camera,
+			Script,
+			DirectionalLight,
+			PointLight,
+			SpotLight,
+			RigidBody3D,
+			BoxCollider3D,
+			SphereCollider3D,
+			CapsuleCollider3D,
+			StaticMesh,
+			MeshCollider3D,
+			Environment,
+			Text,
+			AudioSource3D,
+			AudioSource2D,
+			AudioListener,
+		};
+
+		struct Header
+		{
+			std::array<char, 4> Magic;
+			uint32_t Version;
+			uint32_t EntityCount;
+			uint32_t ChunkCount;
+		};
+
+		struct ChunkHeader
+		{
+			ChunkType Type;
+			/// The number of entries in the chunk
+			uint32_t Count;
+			/// The size of the chunk, without the header
+			uint64_t Size;
+		};
+
+		struct EntityRecord
+		{
+			uint64_t UUID;
+			uint32_t Tag;
+		};
+
+		struct HierarchyRecord
+		{
+			uint32_t Parent;
+			uint32_t Child;
+		};
+
+		struct TransformRecord
+		{
+			glm::vec3 Translation;
+			glm::vec3 Rotation;
+			glm::vec3 Scale;
+		};
+
+		struct CameraRecord
+		{
+			int32_t ProjectionType;
+			float PerspectiveFOV;
+			float PerspectiveNear;
+			float PerspectiveFar;
+			float OrthographicSize;
+			float OrthographicNear;
+			float OrthographicFar;
+			uint8_t IsPrimary;
+			uint8_t FixedAspectRatio;
+		};
+
+		struct ScriptRecord
+		{
+			uint32_t ClassName;
+			uint32_t FieldCount;
+		};
+
+		/// The fields of the scripts follow the script records, in the same order
+		struct ScriptFieldRecord
+		{
+			uint32_t Name;
+			uint32_t Type;
+			/// The value of the field, or the index of the string for string fields
+			std::array<std::byte, 16> Data;
+		};
+
+		struct DirectionalLightRecord
+		{
+			glm::vec3 Color;
+			glm::vec3 Direction;
+			float Intensity;
+		};
+
+		struct PointLightRecord
+		{
+			glm::vec3 Color;
+			glm::vec3 Position;
+			float Intensity;
+			float Constant;
+			float Linear;
+			float Quadratic;
+		};
+
+		struct SpotLightRecord
+		{
+			glm::vec3 Color;
+			glm::vec3 Position;
+			glm::vec3 Direction;
+			float Intensity;
+			float Constant;
+			float Linear;
+			float Quadratic;
+			float CutOffAngleRadians;
+			float OuterCutOffAngleRadians;
+		};
+
+		struct RigidBody3DRecord
+		{
+			float Mass;
+			int32_t Type;
+			glm::vec3 Velocity;
+			glm::vec3 AngularVelocity;
+			uint8_t UseGravity;
+			float Friction;
+			float Restitution;
+		};
+
+		struct BoxCollider3DRecord
+		{
+			glm::vec3 Size;
+			glm::vec3 Offset;
+		};
+
+		struct SphereCollider3DRecord
+		{
+			float Radius;
+			glm::vec3 Offset;
+		};
+
+		struct CapsuleCollider3DRecord
+		{
+			float Radius;
+			float Height;
+			glm::vec3 Offset;
+		};
+
+		struct StaticMeshRecord
+		{
+			uint64_t Mesh;
+			uint64_t Texture;
+			uint8_t HasMaterial;
+			glm::vec3 Ambient;
+			glm::vec3 Diffuse;
+			glm::vec3 Specular;
+			float Shininess;
+		};
+
+		struct MeshCollider3DRecord
+		{
+			uint64_t Mesh;
+			uint8_t IsTrigger;
+		};
+
+		struct EnvironmentRecord
+		{
+			uint64_t SkyboxTexture;
+			uint8_t IsSkyboxEnabled;
+		};
+
+		struct TextRecord
+		{
+			uint32_t Text;
+			float FontSize;
+			glm::vec4 Color;
+		};
+
+		struct AudioSourceRecord
+		{
+			uint64_t SoundAsset;
+			uint8_t Loop;
+			float Volume;
+		};
+
+		class Writer
+		{
+		public:
+			template<typename T>
+			void Write(const T& value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				WriteBytes(&value, sizeof(T));
+			}
+
+			template<typename T>
+			void Write(const std::vector<T>& values)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				WriteBytes(values.data(), values.size() * sizeof(T));
+			}
+
+			void WriteBytes(const void* data, const size_t size)
+			{
+				const auto* bytes = static_cast<const uint8_t*>(data);
+				m_Data.insert(m_Data.end(), bytes, bytes + size);
+			}
+
+			const std::vector<uint8_t>& GetData() const { return m_Data; }
+
+		private:
+			std::vector<uint8_t> m_Data;
+		};
+
+		/// Reads from a memory block, every read is bounds checked, and fails the reader instead of reading past the end
+		class Reader
+		{
+		public:
+			Reader(const uint8_t* data, const uint64_t size)
+				: m_Data(data), m_Size(size)
+			{}
+
+			template<typename T>
+			bool Read(T& value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				if (!Has(sizeof(T)))
+					return false;
+
+				memcpy(&value, m_Data + m_Offset, sizeof(T));
+				m_Offset += sizeof(T);
+				return true;
+			}
+
+			template<typename T>
+			bool Read(std::vector<T>& values, const size_t count)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				if (!Has(count * sizeof(T)))
+					return false;
+
+				values.resize(count);
+				memcpy(values.data(), m_Data + m_Offset, count * sizeof(T));
+				m_Offset += count * sizeof(T);
+				return true;
+			}
+
+			bool ReadString(std::string_view& value, const uint32_t length)
+			{
+				if (!Has(length))
+					return false;
+
+				value = std::string_view(reinterpret_cast<const char*>(m_Data + m_Offset), length);
+				m_Offset += length;
+				return true;
+			}
+
+			bool Skip(const uint64_t size)
+			{
+				if (!Has(size))
+					return false;
+
+				m_Offset += size;
+				return true;
+			}
+
+			uint64_t GetOffset() const { return m_Offset; }
+			bool Has(const uint64_t size) const { return size <= m_Size - m_Offset; }
+
+		private:
+			const uint8_t* m_Data;
+			uint64_t m_Size;
+			uint64_t m_Offset = 0;
+		};
+
+		class StringTable
+		{
+		public:
+			uint32_t Add(const std::string& string)
+			{
+				const auto [it, inserted] = m_Indices.try_emplace(string, static_cast<uint32_t>(m_Strings.size()));
+				if (inserted)
+					m_Strings.push_back(&it->first);
+
+				return it->second;
+			}
+
+			void Write(Writer& out) const
+			{
+				for (const std::string* string : m_Strings)
+				{
+					out.Write(static_cast<uint32_t>(string->size()));
+					out.WriteBytes(string->data(), string->size());
+				}
+			}
+
+			uint32_t GetCount() const { return static_cast<uint32_t>(m_Strings.size()); }
+
+		private:
+			std::unordered_map<std::string, uint32_t> m_Indices;
+			std::vector<const std::string*> m_Strings;
+		};
+
+		/**
+		* Writes a chunk of every entity having the component. The record of a component is created by the function.
+		*/
+		template<typename Component, typename Record, typename Fn>
+		static void WriteComponentChunk(Writer& out, uint32_t& chunkCount, const entt::registry& registry, const std::vector<uint32_t>& entityIndices, const ChunkType type, Fn&& toRecord)
+		{
+			std::vector<uint32_t> indices;
+			std::vector<Record> records;
+
+			for (const auto [entity, component] : registry.view<const Component>().each())
+			{
+				indices.push_back(entityIndices[entt::to_entity(entity)]);
+
+				Record record{};
+				toRecord(entity, component, record);
+				records.push_back(record);
+			}
+
+			if (records.empty())
+				return;
+
+			out.Write(ChunkHeader{ .Type = type, .Count = static_cast<uint32_t>(records.size()), .Size = (sizeof(uint32_t) + sizeof(Record)) * records.size() });
+			out.Write(indices);
+			out.Write(records);
+			++chunkCount;
+		}
+
+		/**
+		* Reads a component chunk, and inserts all the components into the registry at once.
+		* The component of a record is filled by the function, starting from a default constructed component,
+		* except for the static mesh, whose default cube and material would only be replaced by the ones of the record.
+		*/
+		template<typename Component, typename Record, typename Fn>
+		static bool ReadComponentChunk(Reader& in, const ChunkHeader& header, entt::registry& registry, const std::vector<entt::entity>& entities, Fn&& fromRecord)
+		{
+			std::vector<uint32_t> indices;
+			std::vector<Record> records;
+			if (!in.Read(indices, header.Count) || !in.Read(records, header.Count))
+				return false;
+
+			std::vector<entt::entity> targets;
+			std::vector<Component> components;
+			targets.reserve(header.Count);
+			components.reserve(header.Count);
+			for (uint32_t i = 0; i < header.Count; ++i)
+			{
+				if (indices[i] >= entities.size())
+					return false;
+
+				if constexpr (std::is_same_v<Component, StaticMeshComponent>)
+					components.emplace_back(nullptr, nullptr);
+				else
+					components.emplace_back();
+
+				targets.push_back(entities[indices[i]]);
+				fromRecord(targets.back(), records[i], components.back());
+			}
+
+			registry.insert<Component>(targets.begin(), targets.end(), components.begin());
+			return true;
+		}
+
+		/**
+		* Reads the indices and records of a chunk, without inserting anything, used to look ahead at the asset handles.
+		*/
+		template<typename Record>
+		static std::vector<Record> PeekRecords(Reader in, const ChunkHeader& header)
+		{
+			std::vector<Record> records;
+			if (!in.Skip(static_cast<uint64_t>(header.Count) * sizeof(uint32_t)) || !in.Read(records, header.Count))
+				return {};
+
+			return records;
+		}
+
+		template<typename T>
+		static Ref<T> GetAsset(const uint64_t handle)
+		{
+			const AssetHandle assetHandle(handle);
+			return assetHandle.IsValid() ? AssetManager::GetAsset<T>(assetHandle) : nullptr;
+		}
+
+		static void RequestAsset(const uint64_t handle)
+		{
+			if (const AssetHandle assetHandle(handle); assetHandle.IsValid())
+				AssetManager::GetAssetAsync(assetHandle);
+		}
+	}
+
+	void SceneSerializer::SerializeRuntime(const std::filesystem::path& filepath)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		using namespace BinaryScene;
+
+		const entt::registry& registry = m_Scene->m_Registry;
+
+		/// Map the entities to their index in the entity chunk, the component chunks refer to them by that index
+		std::vector<entt::entity> entities;
+		std::vector<uint32_t> entityIndices;
+		for (const auto entity : registry.view<const IDComponent>())
+		{
+			const auto id = entt::to_entity(entity);
+			if (id >= entityIndices.size())
+				entityIndices.resize(static_cast<size_t>(id) + 1, std::numeric_limits<uint32_t>::max());
+
+			entityIndices[id] = static_cast<uint32_t>(entities.size());
+			entities.push_back(entity);
+		}
+
+		StringTable strings;
+		Writer chunks;
+		uint32_t chunkCount = 0;
+
+		{
+			std::vector<EntityRecord> records;
+			records.reserve(entities.size());
+			for (const auto entity : entities)
+			{
+				const auto* tag = registry.try_get<TagComponent>(entity);
+				records.push_back({ .UUID = static_cast<uint64_t>(registry.get<IDComponent>(entity).ID), .Tag = strings.Add(tag ? tag->Tag : std::string()) });
+			}
+
+			chunks.Write(ChunkHeader{ .Type = ChunkType::Entities, .Count = static_cast<uint32_t>(records.size()), .Size = sizeof(EntityRecord) * records.size() });
+			chunks.Write(records);
+			++chunkCount;
+		}
+
+		{
+			/// The children are stored in sibling order, so linking them one by one restores the order
+			std::vector<HierarchyRecord> records;
+			for (const auto entity : entities)
+			{
+				m_Scene->ForEachChild(entity, [&](const entt::entity child)
+					{
+						records.push_back({ .Parent = entityIndices[entt::to_entity(entity)], .Child = entityIndices[entt::to_entity(child)] });
+					});
+			}
+
+			if (!records.empty())
+			{
+				chunks.Write(ChunkHeader{ .Type = ChunkType::Hierarchy, .Count = static_cast<uint32_t>(records.size()), .Size = sizeof(HierarchyRecord) * records.size() });
+				chunks.Write(records);
+				++chunkCount;
+			}
+		}
+
+		WriteComponentChunk<TransformComponent, TransformRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::Transform,
+			[](entt::entity, const TransformComponent& transform, TransformRecord& record)
+			{
+				record.Translation = transform.Translation;
+				record.Rotation = transform.Rotation;
+				record.Scale = transform.Scale;
+			});
+
+		WriteComponentChunk<SpriteRendererComponent, glm::vec4>(chunks, chunkCount, registry, entityIndices, ChunkType::SpriteRenderer,
+			[](entt::entity, const SpriteRendererComponent& spriteRenderer, glm::vec4& record)
+			{
+				record = spriteRenderer.Color;
+			});
+
+		WriteComponentChunk<CameraComponent, CameraRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::Camera,
+			[](entt::entity, const CameraComponent& camera, CameraRecord& record)
+			{
+				record.ProjectionType = static_cast<int32_t>(camera.Camera.GetProjectionType());
+				record.PerspectiveFOV = camera.Camera.GetPerspectiveFov();
+				record.PerspectiveNear = camera.Camera.GetPerspectiveNearClip();
+				record.PerspectiveFar = camera.Camera.GetPerspectiveFarClip();
+				record.OrthographicSize = camera.Camera.GetOrthographicSize();
+				record.OrthographicNear = camera.Camera.GetOrthographicNearClip();
+				record.OrthographicFar = camera.Camera.GetOrthographicFarClip();
+				record.IsPrimary = camera.IsPrimary;
+				record.FixedAspectRatio = camera.FixedAspectRatio;
+			});
+
+		{
+			/// The script fields have a variable count, so they are stored after the script records
+			std::vector<uint32_t> indices;
+			std::vector<ScriptRecord> records;
+			std::vector<ScriptFieldRecord> fields;
+			for (const auto [entity, script] : registry.view<const ScriptComponent>().each())
+			{
+				const auto& fieldInitializers = ScriptEngine::GetScriptFieldInitializerMap(Entity{ entity, m_Scene.get() });
+
+				indices.push_back(entityIndices[entt::to_entity(entity)]);
+				records.push_back({ .ClassName = strings.Add(script.ClassName), .FieldCount = static_cast<uint32_t>(fieldInitializers.size()) });
+
+				for (const auto& [name, field] : fieldInitializers)
+				{
+					ScriptFieldRecord record{ .Name = strings.Add(name), .Type = static_cast<uint32_t>(field.Field.Type), .Data = {} };
+					if (field.Field.Type == ScriptFieldType::String)
+					{
+						const uint32_t string = strings.Add(field.GetValue<std::string>());
+						memcpy(record.Data.data(), &string, sizeof(string));
+					}
+					else
+					{
+						record.Data = field.GetValue<std::array<std::byte, 16>>();
+					}
+
+					fields.push_back(record);
+				}
+			}
+
+			if (!records.empty())
+			{
+				const uint64_t size = (sizeof(uint32_t) + sizeof(ScriptRecord)) * records.size() + sizeof(ScriptFieldRecord) * fields.size();
+				chunks.Write(ChunkHeader{ .Type = ChunkType::Script, .Count = static_cast<uint32_t>(records.size()), .Size = size });
+				chunks.Write(indices);
+				chunks.Write(records);
+				chunks.Write(fields);
+				++chunkCount;
+			}
+		}
+
+		WriteComponentChunk<DirectionalLightComponent, DirectionalLightRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::DirectionalLight,
+			[](entt::entity, const DirectionalLightComponent& directionalLight, DirectionalLightRecord& record)
+			{
+				record.Color = directionalLight.Light.Color;
+				record.Direction = directionalLight.Light.Direction;
+				record.Intensity = directionalLight.Light.Intensity;
+			});
+
+		WriteComponentChunk<PointLightComponent, PointLightRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::PointLight,
+			[](entt::entity, const PointLightComponent& pointLight, PointLightRecord& record)
+			{
+				record.Color = pointLight.Light.Color;
+				record.Position = pointLight.Light.Position;
+				record.Intensity = pointLight.Light.Intensity;
+				record.Constant = pointLight.Light.Constant;
+				record.Linear = pointLight.Light.Linear;
+				record.Quadratic = pointLight.Light.Quadratic;
+			});
+
+		WriteComponentChunk<SpotLightComponent, SpotLightRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::SpotLight,
+			[](entt::entity, const SpotLightComponent& spotLight, SpotLightRecord& record)
+			{
+				record.Color = spotLight.Light.Color;
+				record.Position = spotLight.Light.Position;
+				record.Direction = spotLight.Light.Direction;
+				record.Intensity = spotLight.Light.Intensity;
+				record.Constant = spotLight.Light.Constant;
+				record.Linear = spotLight.Light.Linear;
+				record.Quadratic = spotLight.Light.Quadratic;
+				record.CutOffAngleRadians = spotLight.Light.CutOffAngleRadians;
+				record.OuterCutOffAngleRadians = spotLight.Light.OuterCutOffAngleRadians;
+			});
+
+		WriteComponentChunk<RigidBody3DComponent, RigidBody3DRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::RigidBody3D,
+			[](entt::entity, const RigidBody3DComponent& rigidBody, RigidBody3DRecord& record)
+			{
+				record.Mass = rigidBody.Mass;
+				record.Type = static_cast<int32_t>(rigidBody.Type);
+				record.Velocity = rigidBody.Velocity;
+				record.AngularVelocity = rigidBody.AngularVelocity;
+				record.UseGravity = rigidBody.UseGravity;
+				record.Friction = rigidBody.Friction;
+				record.Restitution = rigidBody.Restitution;
+			});
+
+		WriteComponentChunk<BoxCollider3DComponent, BoxCollider3DRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::BoxCollider3D,
+			[](entt::entity, const BoxCollider3DComponent& boxCollider, BoxCollider3DRecord& record)
+			{
+				record.Size = boxCollider.Size;
+				record.Offset = boxCollider.Offset;
+			});
+
+		WriteComponentChunk<SphereCollider3DComponent, SphereCollider3DRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::SphereCollider3D,
+			[](entt::entity, const SphereCollider3DComponent& sphereCollider, SphereCollider3DRecord& record)
+			{
+				record.Radius = sphereCollider.Radius;
+				record.Offset = sphereCollider.Offset;
+			});
+
+		WriteComponentChunk<CapsuleCollider3DComponent, CapsuleCollider3DRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::CapsuleCollider3D,
+			[](entt::entity, const CapsuleCollider3DComponent& capsuleCollider, CapsuleCollider3DRecord& record)
+			{
+				record.Radius = capsuleCollider.Radius;
+				record.Height = capsuleCollider.Height;
+				record.Offset = capsuleCollider.Offset;
+			});
+
+		/// Written before the mesh colliders, which fall back to the mesh of the static mesh when loaded
+		WriteComponentChunk<StaticMeshComponent, StaticMeshRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::StaticMesh,
+			[](entt::entity, const StaticMeshComponent& staticMesh, StaticMeshRecord& record)
+			{
+				record.Mesh = staticMesh.StaticMesh ? static_cast<uint64_t>(staticMesh.StaticMesh->GetHandle()) : static_cast<uint64_t>(UUID::Invalid());
+				record.Texture = staticMesh.MeshTexture ? static_cast<uint64_t>(staticMesh.MeshTexture->GetHandle()) : static_cast<uint64_t>(UUID::Invalid());
+				if (const auto& material = staticMesh.MeshMaterial)
+				{
+					record.HasMaterial = true;
+					record.Ambient = material->Ambient;
+					record.Diffuse = material->Diffuse;
+					record.Specular = material->Specular;
+					record.Shininess = material->Shininess;
+				}
+			});
+
+		WriteComponentChunk<MeshCollider3DComponent, MeshCollider3DRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::MeshCollider3D,
+			[](entt::entity, const MeshCollider3DComponent& meshCollider, MeshCollider3DRecord& record)
+			{
+				record.Mesh = meshCollider.Mesh ? static_cast<uint64_t>(meshCollider.Mesh->GetHandle()) : static_cast<uint64_t>(UUID::Invalid());
+				record.IsTrigger = meshCollider.IsTrigger;
+			});
+
+		WriteComponentChunk<EnvironmentComponent, EnvironmentRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::Environment,
+			[](entt::entity, const EnvironmentComponent& environment, EnvironmentRecord& record)
+			{
+				record.SkyboxTexture = static_cast<uint64_t>(environment.SkyboxTexture);
+				record.IsSkyboxEnabled = environment.IsSkyboxEnabled;
+			});
+
+		WriteComponentChunk<TextComponent, TextRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::Text,
+			[&strings](entt::entity, const TextComponent& text, TextRecord& record)
+			{
+				record.Text = strings.Add(text.Text);
+				record.FontSize = text.FontSize;
+				record.Color = text.Color;
+			});
+
+		const auto toAudioSourceRecord = [](entt::entity, const auto& audioSource, AudioSourceRecord& record)
+			{
+				record.SoundAsset = audioSource.SoundAsset ? static_cast<uint64_t>(audioSource.SoundAsset->GetHandle()) : static_cast<uint64_t>(UUID::Invalid());
+				record.Loop = audioSource.Loop;
+				record.Volume = audioSource.Volume;
+			};
+
+		WriteComponentChunk<AudioSource3DComponent, AudioSourceRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::AudioSource3D, toAudioSourceRecord);
+		WriteComponentChunk<AudioSource2DComponent, AudioSourceRecord>(chunks, chunkCount, registry, entityIndices, ChunkType::AudioSource2D, toAudioSourceRecord);
+
+		WriteComponentChunk<AudioListenerComponent, float>(chunks, chunkCount, registry, entityIndices, ChunkType::AudioListener,
+			[](entt::entity, const AudioListenerComponent& audioListener, float& record)
+			{
+				record = audioListener.Volume;
+			});
+
+		/// The string table is written first, but it is only complete after every chunk is built
+		Writer stringChunk;
+		strings.Write(stringChunk);
+
+		Writer out;
+		out.Write(Header{ .Magic = Magic, .Version = Version, .EntityCount = static_cast<uint32_t>(entities.size()), .ChunkCount = chunkCount + 1 });
+		out.Write(ChunkHeader{ .Type = ChunkType::StringTable, .Count = strings.GetCount(), .Size = stringChunk.GetData().size() });
+		out.Write(stringChunk.GetData());
+		out.Write(chunks.GetData());
+
+		std::ofstream fout(filepath, std::ios::binary);
+		if (!fout)
+		{
+			KBR_CORE_ERROR("Failed to open {0} for writing the scene", filepath.string());
+			return;
+		}
+
+		fout.write(reinterpret_cast<const char*>(out.GetData().data()), static_cast<std::streamsize>(out.GetData().size()));
+	}
+
 	bool SceneSerializer::DeserializeRuntime(const std::filesystem::path& filepath) const
 	{
-		throw std::logic_error("Not implemented");
+		KBR_PROFILE_FUNCTION();
+
+		using namespace BinaryScene;
+
+		const MappedFile file(filepath);
+		if (!file.IsValid())
+		{
+			KBR_CORE_ERROR("Failed to open scene file {0}", filepath.string());
+			return false;
+		}
+
+		Reader in(file.GetData(), file.GetSize());
+
+		Header header{};
+		if (!in.Read(header) || header.Magic != Magic)
+		{
+			KBR_CORE_ERROR("Invalid binary scene file {0}", filepath.string());
+			return false;
+		}
+
+		if (header.Version != Version)
+		{
+			KBR_CORE_ERROR("Binary scene file {0} has version {1}, expected {2}", filepath.string(), header.Version, Version);
+			return false;
+		}
+
+		/// Locate every chunk first, so the assets can be requested before any component is created
+		struct ChunkLocation
+		{
+			ChunkHeader Header;
+			uint64_t Offset;
+		};
+
+		/// The counts come from the file, so they are checked against its size before allocating anything
+		if (!in.Has(static_cast<uint64_t>(header.ChunkCount) * sizeof(ChunkHeader)))
+		{
+			KBR_CORE_ERROR("Binary scene file {0} is truncated", filepath.string());
+			return false;
+		}
+
+		std::vector<ChunkLocation> chunks;
+		chunks.reserve(header.ChunkCount);
+		for (uint32_t i = 0; i < header.ChunkCount; ++i)
+		{
+			ChunkHeader chunkHeader{};
+			if (!in.Read(chunkHeader) || !in.Has(chunkHeader.Size))
+			{
+				KBR_CORE_ERROR("Binary scene file {0} is truncated", filepath.string());
+				return false;
+			}
+
+			chunks.push_back({ .Header = chunkHeader, .Offset = in.GetOffset() });
+			in.Skip(chunkHeader.Size);
+		}
+
+		const auto chunkReader = [&file](const ChunkLocation& chunk)
+			{
+				return Reader(file.GetData() + chunk.Offset, chunk.Header.Size);
+			};
+
+		for (const ChunkLocation& chunk : chunks)
+		{
+			switch (chunk.Header.Type)
+			{
+			case ChunkType::StaticMesh:
+				for (const StaticMeshRecord& record : PeekRecords<StaticMeshRecord>(chunkReader(chunk), chunk.Header))
+				{
+					RequestAsset(record.Mesh);
+					RequestAsset(record.Texture);
+				}
+				break;
+			case ChunkType::MeshCollider3D:
+				for (const MeshCollider3DRecord& record : PeekRecords<MeshCollider3DRecord>(chunkReader(chunk), chunk.Header))
+					RequestAsset(record.Mesh);
+				break;
+			case ChunkType::Environment:
+				for (const EnvironmentRecord& record : PeekRecords<EnvironmentRecord>(chunkReader(chunk), chunk.Header))
+					RequestAsset(record.SkyboxTexture);
+				break;
+			case ChunkType::AudioSource3D:
+			case ChunkType::AudioSource2D:
+				for (const AudioSourceRecord& record : PeekRecords<AudioSourceRecord>(chunkReader(chunk), chunk.Header))
+					RequestAsset(record.SoundAsset);
+				break;
+			default:
+				break;
+			}
+		}
+
+		entt::registry& registry = m_Scene->m_Registry;
+
+		std::vector<std::string_view> strings;
+		std::vector<entt::entity> entities;
+
+		const auto getString = [&strings](const uint32_t index)
+			{
+				return index < strings.size() ? std::string(strings[index]) : std::string();
+			};
+
+		for (const ChunkLocation& chunk : chunks)
+		{
+			Reader chunkIn = chunkReader(chunk);
+			bool valid = true;
+
+			switch (chunk.Header.Type)
+			{
+			case ChunkType::StringTable:
+			{
+				/// Every string has at least its length
+				if (!chunkIn.Has(static_cast<uint64_t>(chunk.Header.Count) * sizeof(uint32_t)))
+				{
+					valid = false;
+					break;
+				}
+
+				strings.reserve(chunk.Header.Count);
+				for (uint32_t i = 0; i < chunk.Header.Count && valid; ++i)
+				{
+					uint32_t length = 0;
+					std::string_view string;
+					valid = chunkIn.Read(length) && chunkIn.ReadString(string, length);
+					strings.push_back(string);
+				}
+				break;
+			}
+			case ChunkType::Entities:
+			{
+				std::vector<EntityRecord> records;
+				if (!entities.empty() || !chunkIn.Read(records, chunk.Header.Count))
+				{
+					valid = false;
+					break;
+				}
+
+				/// Create all the entities, and their default components at once
+				entities.resize(records.size());
+				registry.create(entities.begin(), entities.end());
+
+				std::vector<IDComponent> ids(records.size());
+				std::vector<TagComponent> tags(records.size());
+				for (size_t i = 0; i < records.size(); ++i)
+				{
+					ids[i].ID = UUID(records[i].UUID);
+					tags[i].Tag = getString(records[i].Tag);
+					if (tags[i].Tag.empty())
+						tags[i].Tag = "Entity";
+				}
+
+				registry.insert<TransformComponent>(entities.begin(), entities.end());
+				registry.insert<HierarchyComponent>(entities.begin(), entities.end());
+				registry.insert<IDComponent>(entities.begin(), entities.end(), ids.begin());
+				registry.insert<TagComponent>(entities.begin(), entities.end(), tags.begin());
+
+				m_Scene->m_RootEntities.insert(entities.begin(), entities.end());
+				m_Scene->m_HierarchyChanged = true;
+
+#if USE_MAP_FOR_UUID
+				m_Scene->m_UUIDToEntityMap.reserve(m_Scene->m_UUIDToEntityMap.size() + entities.size());
+				for (size_t i = 0; i < entities.size(); ++i)
+				{
+					m_Scene->m_UUIDToEntityMap[ids[i].ID] = Entity{ entities[i], m_Scene.get() };
+				}
+#endif
+				break;
+			}
+			case ChunkType::Hierarchy:
+			{
+				std::vector<HierarchyRecord> records;
+				valid = chunkIn.Read(records, chunk.Header.Count);
+				for (const auto& [parent, child] : records)
+				{
+					if (!valid || parent >= entities.size() || child >= entities.size())
+					{
+						valid = false;
+						break;
+					}
+
+					m_Scene->SetParent(Entity{ entities[child], m_Scene.get() }, Entity{ entities[parent], m_Scene.get() }, false);
+				}
+				break;
+			}
+			case ChunkType::Transform:
+			{
+				/// The entities already have a transform, so the values are assigned in place
+				std::vector<uint32_t> indices;
+				std::vector<TransformRecord> records;
+				valid = chunkIn.Read(indices, chunk.Header.Count) && chunkIn.Read(records, chunk.Header.Count);
+				for (uint32_t i = 0; valid && i < chunk.Header.Count; ++i)
+				{
+					if (indices[i] >= entities.size())
+					{
+						valid = false;
+						break;
+					}
+
+					auto& transform = registry.get<TransformComponent>(entities[indices[i]]);
+					transform.Translation = records[i].Translation;
+					transform.Rotation = records[i].Rotation;
+					transform.Scale = records[i].Scale;
+				}
+				break;
+			}
+			case ChunkType::SpriteRenderer:
+				valid = ReadComponentChunk<SpriteRendererComponent, glm::vec4>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const glm::vec4& record, SpriteRendererComponent& spriteRenderer)
+					{
+						spriteRenderer.Color = record;
+					});
+				break;
+			case ChunkType::Camera:
+				valid = ReadComponentChunk<CameraComponent, CameraRecord>(chunkIn, chunk.Header, registry, entities,
+					[this](entt::entity, const CameraRecord& record, CameraComponent& camera)
+					{
+						camera.Camera.SetProjectionType(static_cast<SceneCamera::ProjectionType>(record.ProjectionType));
+						camera.Camera.SetPerspectiveFov(record.PerspectiveFOV);
+						camera.Camera.SetPerspectiveNearClip(record.PerspectiveNear);
+						camera.Camera.SetPerspectiveFarClip(record.PerspectiveFar);
+						camera.Camera.SetOrthographicSize(record.OrthographicSize);
+						camera.Camera.SetOrthographicNearClip(record.OrthographicNear);
+						camera.Camera.SetOrthographicFarClip(record.OrthographicFar);
+						camera.Camera.SetViewportSize(m_Scene->m_ViewportWidth, m_Scene->m_ViewportHeight);
+						camera.IsPrimary = record.IsPrimary;
+						camera.FixedAspectRatio = record.FixedAspectRatio;
+					});
+				break;
+			case ChunkType::Script:
+			{
+				std::vector<uint32_t> indices;
+				std::vector<ScriptRecord> records;
+				if (!chunkIn.Read(indices, chunk.Header.Count) || !chunkIn.Read(records, chunk.Header.Count))
+				{
+					valid = false;
+					break;
+				}
+
+				std::vector<entt::entity> targets;
+				std::vector<ScriptComponent> scripts(records.size());
+				targets.reserve(records.size());
+				for (size_t i = 0; i < records.size() && valid; ++i)
+				{
+					std::vector<ScriptFieldRecord> fields;
+					if (indices[i] >= entities.size() || !chunkIn.Read(fields, records[i].FieldCount))
+					{
+						valid = false;
+						break;
+					}
+
+					targets.push_back(entities[indices[i]]);
+					scripts[i].ClassName = getString(records[i].ClassName);
+
+					auto& scriptFieldInitializers = ScriptEngine::GetScriptFieldInitializerMap(Entity{ targets.back(), m_Scene.get() });
+					for (const ScriptFieldRecord& field : fields)
+					{
+						ScriptFieldInitializer initializer;
+						initializer.Field.Name = getString(field.Name);
+						initializer.Field.Type = static_cast<ScriptFieldType>(field.Type);
+						if (initializer.Field.Type == ScriptFieldType::String)
+						{
+							uint32_t string = 0;
+							memcpy(&string, field.Data.data(), sizeof(string));
+							initializer.SetValue<std::string>(getString(string));
+						}
+						else
+						{
+							initializer.SetValue(field.Data);
+						}
+
+						scriptFieldInitializers[initializer.Field.Name] = initializer;
+					}
+				}
+
+				if (valid)
+					registry.insert<ScriptComponent>(targets.begin(), targets.end(), scripts.begin());
+				break;
+			}
+			case ChunkType::DirectionalLight:
+				valid = ReadComponentChunk<DirectionalLightComponent, DirectionalLightRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const DirectionalLightRecord& record, DirectionalLightComponent& directionalLight)
+					{
+						directionalLight.Light.Color = record.Color;
+						directionalLight.Light.Direction = record.Direction;
+						directionalLight.Light.Intensity = record.Intensity;
+					});
+				break;
+			case ChunkType::PointLight:
+				valid = ReadComponentChunk<PointLightComponent, PointLightRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const PointLightRecord& record, PointLightComponent& pointLight)
+					{
+						pointLight.Light.Color = record.Color;
+						pointLight.Light.Position = record.Position;
+						pointLight.Light.Intensity = record.Intensity;
+						pointLight.Light.Constant = record.Constant;
+						pointLight.Light.Linear = record.Linear;
+						pointLight.Light.Quadratic = record.Quadratic;
+					});
+				break;
+			case ChunkType::SpotLight:
+				valid = ReadComponentChunk<SpotLightComponent, SpotLightRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const SpotLightRecord& record, SpotLightComponent& spotLight)
+					{
+						spotLight.Light.Color = record.Color;
+						spotLight.Light.Position = record.Position;
+						spotLight.Light.Direction = record.Direction;
+						spotLight.Light.Intensity = record.Intensity;
+						spotLight.Light.Constant = record.Constant;
+						spotLight.Light.Linear = record.Linear;
+						spotLight.Light.Quadratic = record.Quadratic;
+						spotLight.Light.CutOffAngleRadians = record.CutOffAngleRadians;
+						spotLight.Light.OuterCutOffAngleRadians = record.OuterCutOffAngleRadians;
+					});
+				break;
+			case ChunkType::RigidBody3D:
+				valid = ReadComponentChunk<RigidBody3DComponent, RigidBody3DRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const RigidBody3DRecord& record, RigidBody3DComponent& rigidBody)
+					{
+						rigidBody.Mass = record.Mass;
+						rigidBody.Type = static_cast<RigidBody3DComponent::BodyType>(record.Type);
+						rigidBody.Velocity = record.Velocity;
+						rigidBody.AngularVelocity = record.AngularVelocity;
+						rigidBody.UseGravity = record.UseGravity;
+						rigidBody.Friction = record.Friction;
+						rigidBody.Restitution = record.Restitution;
+					});
+				break;
+			case ChunkType::BoxCollider3D:
+				valid = ReadComponentChunk<BoxCollider3DComponent, BoxCollider3DRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const BoxCollider3DRecord& record, BoxCollider3DComponent& boxCollider)
+					{
+						boxCollider.Size = record.Size;
+						boxCollider.Offset = record.Offset;
+					});
+				break;
+			case ChunkType::SphereCollider3D:
+				valid = ReadComponentChunk<SphereCollider3DComponent, SphereCollider3DRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const SphereCollider3DRecord& record, SphereCollider3DComponent& sphereCollider)
+					{
+						sphereCollider.Radius = record.Radius;
+						sphereCollider.Offset = record.Offset;
+					});
+				break;
+			case ChunkType::CapsuleCollider3D:
+				valid = ReadComponentChunk<CapsuleCollider3DComponent, CapsuleCollider3DRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const CapsuleCollider3DRecord& record, CapsuleCollider3DComponent& capsuleCollider)
+					{
+						capsuleCollider.Radius = record.Radius;
+						capsuleCollider.Height = record.Height;
+						capsuleCollider.Offset = record.Offset;
+					});
+				break;
+			case ChunkType::StaticMesh:
+				valid = ReadComponentChunk<StaticMeshComponent, StaticMeshRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const StaticMeshRecord& record, StaticMeshComponent& staticMesh)
+					{
+						staticMesh.MeshMaterial = CreateRef<Material>();
+						if (record.HasMaterial)
+						{
+							staticMesh.MeshMaterial->Ambient = record.Ambient;
+							staticMesh.MeshMaterial->Diffuse = record.Diffuse;
+							staticMesh.MeshMaterial->Specular = record.Specular;
+							staticMesh.MeshMaterial->Shininess = record.Shininess;
+						}
+
+						staticMesh.MeshTexture = GetAsset<Texture2D>(record.Texture);
+						staticMesh.StaticMesh = GetAsset<Mesh>(record.Mesh);
+						if (!staticMesh.StaticMesh)
+						{
+							KBR_CORE_WARN("AssetHandle for mesh is invalid, using default cube mesh.");
+							staticMesh.StaticMesh = AssetManager::GetDefaultCubeMesh();
+						}
+					});
+				break;
+			case ChunkType::MeshCollider3D:
+				valid = ReadComponentChunk<MeshCollider3DComponent, MeshCollider3DRecord>(chunkIn, chunk.Header, registry, entities,
+					[&registry](const entt::entity entity, const MeshCollider3DRecord& record, MeshCollider3DComponent& meshCollider)
+					{
+						meshCollider.IsTrigger = record.IsTrigger;
+						meshCollider.Mesh = GetAsset<Mesh>(record.Mesh);
+						if (!meshCollider.Mesh)
+						{
+							if (const auto* staticMesh = registry.try_get<StaticMeshComponent>(entity))
+								meshCollider.Mesh = staticMesh->StaticMesh;
+						}
+					});
+				break;
+			case ChunkType::Environment:
+				valid = ReadComponentChunk<EnvironmentComponent, EnvironmentRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const EnvironmentRecord& record, EnvironmentComponent& environment)
+					{
+						environment.SkyboxTexture = AssetHandle(record.SkyboxTexture);
+						environment.IsSkyboxEnabled = record.IsSkyboxEnabled;
+					});
+				break;
+			case ChunkType::Text:
+				valid = ReadComponentChunk<TextComponent, TextRecord>(chunkIn, chunk.Header, registry, entities,
+					[&getString](entt::entity, const TextRecord& record, TextComponent& text)
+					{
+						text.Text = getString(record.Text);
+						text.FontSize = record.FontSize;
+						text.Color = record.Color;
+					});
+				break;
+			case ChunkType::AudioSource3D:
+				valid = ReadComponentChunk<AudioSource3DComponent, AudioSourceRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const AudioSourceRecord& record, AudioSource3DComponent& audioSource)
+					{
+						audioSource.SoundAsset = GetAsset<Sound>(record.SoundAsset);
+						audioSource.Loop = record.Loop;
+						audioSource.Volume = record.Volume;
+					});
+				break;
+			case ChunkType::AudioSource2D:
+				valid = ReadComponentChunk<AudioSource2DComponent, AudioSourceRecord>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const AudioSourceRecord& record, AudioSource2DComponent& audioSource)
+					{
+						audioSource.SoundAsset = GetAsset<Sound>(record.SoundAsset);
+						audioSource.Loop = record.Loop;
+						audioSource.Volume = record.Volume;
+					});
+				break;
+			case ChunkType::AudioListener:
+				valid = ReadComponentChunk<AudioListenerComponent, float>(chunkIn, chunk.Header, registry, entities,
+					[](entt::entity, const float& record, AudioListenerComponent& audioListener)
+					{
+						audioListener.Volume = record;
+					});
+				break;
+			default:
+				KBR_CORE_WARN("Skipping unknown chunk {0} in scene file {1}", static_cast<uint32_t>(chunk.Header.Type), filepath.string());
+				break;
+			}
+
+			if (!valid)
+			{
+				KBR_CORE_ERROR("Chunk {0} of binary scene file {1} is corrupted", static_cast<uint32_t>(chunk.Header.Type), filepath.string());
+				return false;
+			}
+		}
+
+		return true;
 	}
 }
@@ -0,0 +1,243 @@
+#include "kbrpch.h"
+#include "SystemScheduler.h"
+
+#include "Kerberos/Internal/JobSystem.h"
+
+#include <exception>
+#include <thread>
+#include <utility>
+
+namespace Kerberos
+{
+	static bool Intersects(const std::vector<entt::id_type>& a, const std::vector<entt::id_type>& b)
+	{
+		/// The systems only access a few types, a linear search is faster than anything else here
+		return std::ranges::any_of(a, [&b](const entt::id_type type) { return std::ranges::find(b, type) != b.end(); });
+	}
+
+	bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+	{
+		if (Exclusive || other.Exclusive)
+			return true;
+
+		return Intersects(Writes, other.Writes) || Intersects(Writes, other.Reads) || Intersects(Reads, other.Writes);
+	}
+
+	void SystemScheduler::AddSystem(std::string name, SystemAccess access, SystemFunction function)
+	{
+		m_Systems.push_back({ .Name = std::move(name), .Access = std::move(access), .Function = std::move(function) });
+		m_GraphDirty = true;
+	}
+
+	void SystemScheduler::Clear()
+	{
+		m_Systems.clear();
+		m_GraphDirty = true;
+	}
+
+	void SystemScheduler::Run(const Timestep ts)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (m_Systems.empty())
+			return;
+
+		if (m_GraphDirty)
+		{
+			BuildGraph();
+		}
+
+		const Clock::time_point frameStart = Clock::now();
+		m_Timestep = ts;
+
+		/// Without workers the systems run one after the other, in the order they were added
+		if (JobSystem::GetWorkerCount() == 0)
+		{
+			for (System& system : m_Systems)
+			{
+				InvokeSystem(system);
+			}
+
+			CalculateBreakdown(frameStart);
+			RethrowException();
+			return;
+		}
+
+		const uint32_t systemCount = static_cast<uint32_t>(m_Systems.size());
+		m_FinishedCount.store(0, std::memory_order_relaxed);
+		for (uint32_t i = 0; i < systemCount; ++i)
+		{
+			m_RemainingDependencies[i].store(static_cast<uint32_t>(m_Systems[i].Dependencies.size()), std::memory_order_relaxed);
+		}
+
+		for (uint32_t i = 0; i < systemCount; ++i)
+		{
+			if (m_Systems[i].Dependencies.empty())
+			{
+				Schedule(i);
+			}
+		}
+
+		while (m_FinishedCount.load(std::memory_order_acquire) < systemCount)
+		{
+			uint32_t systemIndex;
+			if (TryPopMainThreadSystem(systemIndex))
+			{
+				RunSystem(systemIndex);
+				continue;
+			}
+
+			if (!JobSystem::TryRunJob(JobPriority::High))
+				std::this_thread::yield();
+		}
+
+		CalculateBreakdown(frameStart);
+		RethrowException();
+	}
+
+	void SystemScheduler::BuildGraph()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		for (System& system : m_Systems)
+		{
+			system.Dependencies.clear();
+			system.Dependents.clear();
+		}
+
+		/// Only the conflicts with earlier systems are edges, so the systems are already in topological order
+		for (uint32_t i = 0; i < m_Systems.size(); ++i)
+		{
+			for (uint32_t j = 0; j < i; ++j)
+			{
+				if (m_Systems[i].Access.ConflictsWith(m_Systems[j].Access))
+				{
+					m_Systems[i].Dependencies.push_back(j);
+					m_Systems[j].Dependents.push_back(i);
+				}
+			}
+		}
+
+		m_RemainingDependencies = std::make_unique<std::atomic<uint32_t>[]>(m_Systems.size());
+		m_GraphDirty = false;
+	}
+
+	void SystemScheduler::Schedule(const uint32_t systemIndex)
+	{
+		if (m_Systems[systemIndex].Access.MainThread)
+		{
+			std::scoped_lock lock(m_MainThreadMutex);
+			m_MainThreadQueue.push_back(systemIndex);
+			return;
+		}
+
+		JobSystem::Submit([this, systemIndex] { RunSystem(systemIndex); }, JobPriority::High);
+	}
+
+	void SystemScheduler::RunSystem(const uint32_t systemIndex)
+	{
+		System& system = m_Systems[systemIndex];
+
+		/// Doesn't throw, so the dependents are always released, otherwise Run would wait for them forever
+		InvokeSystem(system);
+
+		for (const uint32_t dependent : system.Dependents)
+		{
+			if (m_RemainingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				Schedule(dependent);
+			}
+		}
+
+		/// The system must not be touched after this, Run may already have returned
+		m_FinishedCount.fetch_add(1, std::memory_order_release);
+	}
+
+	void SystemScheduler::InvokeSystem(System& system)
+	{
+		KBR_PROFILE_SCOPE(system.Name.c_str());
+
+		system.Start = Clock::now();
+		try
+		{
+			system.Function(m_Timestep);
+		}
+		catch (...)
+		{
+			std::scoped_lock lock(m_ExceptionMutex);
+			if (!m_Exception)
+				m_Exception = std::current_exception();
+		}
+		system.End = Clock::now();
+	}
+
+	void SystemScheduler::RethrowException()
+	{
+		if (std::exception_ptr exception = std::exchange(m_Exception, nullptr))
+			std::rethrow_exception(exception);
+	}
+
+	bool SystemScheduler::TryPopMainThreadSystem(uint32_t& outSystemIndex)
+	{
+		std::scoped_lock lock(m_MainThreadMutex);
+
+		if (m_MainThreadQueue.empty())
+			return false;
+
+		/// Run them in the order they were added, when several of them are ready
+		const auto first = std::ranges::min_element(m_MainThreadQueue);
+		outSystemIndex = *first;
+		m_MainThreadQueue.erase(first);
+
+		return true;
+	}
+
+	void SystemScheduler::CalculateBreakdown(const Clock::time_point frameStart)
+	{
+		const auto toMs = [](const Clock::duration duration) { return std::chrono::duration<float, std::milli>(duration).count(); };
+
+		const size_t systemCount = m_Systems.size();
+
+		m_Breakdown.Systems.resize(systemCount);
+		m_Breakdown.TotalWorkMs = 0.0f;
+
+		/// The longest chain ending with every system, the systems are in topological order
+		std::vector<float> pathMs(systemCount, 0.0f);
+		std::vector<int32_t> pathPrevious(systemCount, -1);
+		Clock::time_point frameEnd = frameStart;
+
+		for (size_t i = 0; i < systemCount; ++i)
+		{
+			const System& system = m_Systems[i];
+			SystemTiming& timing = m_Breakdown.Systems[i];
+
+			timing.Name = system.Name;
+			timing.StartMs = toMs(system.Start - frameStart);
+			timing.DurationMs = toMs(system.End - system.Start);
+			timing.MainThread = system.Access.MainThread;
+			timing.OnCriticalPath = false;
+
+			m_Breakdown.TotalWorkMs += timing.DurationMs;
+			frameEnd = std::max(frameEnd, system.End);
+
+			for (const uint32_t dependency : system.Dependencies)
+			{
+				if (pathMs[dependency] > pathMs[i])
+				{
+					pathMs[i] = pathMs[dependency];
+					pathPrevious[i] = static_cast<int32_t>(dependency);
+				}
+			}
+			pathMs[i] += timing.DurationMs;
+		}
+
+		const auto last = std::ranges::max_element(pathMs);
+		m_Breakdown.CriticalPathMs = *last;
+		m_Breakdown.WallMs = toMs(frameEnd - frameStart);
+
+		for (int32_t i = static_cast<int32_t>(std::distance(pathMs.begin(), last)); i >= 0; i = pathPrevious[i])
+		{
+			m_Breakdown.Systems[i].OnCriticalPath = true;
+		}
+	}
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Kerberos/Core/Timestep.h"
+
+#include <entt.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Kerberos
+{
+	/**
+	* The components and other resources a system reads and writes.
+	* Any type can be used as a resource, like the AudioManager, or the data one system hands to another.
+	*/
+	struct SystemAccess
+	{
+		std::vector<entt::id_type> Reads;
+		std::vector<entt::id_type> Writes;
+
+		/// The system can touch anything, like the scripts, so it runs alone
+		bool Exclusive = false;
+		/// The system must run on the main thread, like the ones calling into Mono or the graphics API
+		bool MainThread = false;
+
+		template<typename... T>
+		SystemAccess& Read()
+		{
+			(Reads.push_back(entt::type_hash<T>::value()), ...);
+			return *this;
+		}
+
+		template<typename... T>
+		SystemAccess& Write()
+		{
+			(Writes.push_back(entt::type_hash<T>::value()), ...);
+			return *this;
+		}
+
+		SystemAccess& OnMainThread()
+		{
+			MainThread = true;
+			return *this;
+		}
+
+		SystemAccess& Everything()
+		{
+			Exclusive = true;
+			return *this;
+		}
+
+		/// Two systems conflict if one of them writes something the other one reads or writes
+		bool ConflictsWith(const SystemAccess& other) const;
+	};
+
+	struct SystemTiming
+	{
+		std::string Name;
+		/// From the start of the frame
+		float StartMs = 0.0f;
+		float DurationMs = 0.0f;
+		bool MainThread = false;
+		bool OnCriticalPath = false;
+	};
+
+	struct FrameTimeBreakdown
+	{
+		/// From the start of the first system to the end of the last one
+		float WallMs = 0.0f;
+		/// The sum of the durations of the systems, the time they would take one after the other
+		float TotalWorkMs = 0.0f;
+		/// The longest chain of dependent systems, the frame can't be shorter than this with any number of threads
+		float CriticalPathMs = 0.0f;
+
+		std::vector<SystemTiming> Systems;
+	};
+
+	/**
+	* Runs the systems of a frame as a task graph.
+	*
+	* A system depends on the systems added before it whose accesses conflict with its own,
+	* so the result is the same as running them one after the other in the order they were added.
+	* The independent systems run at the same time on the job system, the ones which must run on the main thread
+	* are run by the thread calling Run, which works on the queued jobs while it waits for them.
+	*/
+	class SystemScheduler
+	{
+	public:
+		using SystemFunction = std::function<void(Timestep ts)>;
+
+		SystemScheduler() = default;
+
+		SystemScheduler(const SystemScheduler& other) = delete;
+		SystemScheduler& operator=(const SystemScheduler& other) = delete;
+
+		void AddSystem(std::string name, SystemAccess access, SystemFunction function);
+		void Clear();
+
+		/**
+		* Runs all the systems and waits until they are finished.
+		* When a system throws, the others still run, and the first exception is rethrown once they are finished.
+		*/
+		void Run(Timestep ts);
+
+		/// The timings of the last run
+		const FrameTimeBreakdown& GetFrameTimeBreakdown() const { return m_Breakdown; }
+
+	private:
+		using Clock = std::chrono::high_resolution_clock;
+
+		struct System
+		{
+			std::string Name;
+			SystemAccess Access;
+			SystemFunction Function;
+
+			std::vector<uint32_t> Dependencies;
+			std::vector<uint32_t> Dependents;
+
+			Clock::time_point Start;
+			Clock::time_point End;
+		};
+
+		void BuildGraph();
+		void Schedule(uint32_t systemIndex);
+		void RunSystem(uint32_t systemIndex);
+		/// Runs the function of the system, and keeps the first exception thrown by a system
+		void InvokeSystem(System& system);
+		void RethrowException();
+		bool TryPopMainThreadSystem(uint32_t& outSystemIndex);
+		void CalculateBreakdown(Clock::time_point frameStart);
+
+	private:
+		std::vector<System> m_Systems;
+		bool m_GraphDirty = true;
+
+		/// The number of unfinished dependencies of every system during a run
+		std::unique_ptr<std::atomic<uint32_t>[]> m_RemainingDependencies;
+		std::atomic<uint32_t> m_FinishedCount = 0;
+		Timestep m_Timestep;
+
+		/// The main thread systems whose dependencies are finished
+		std::mutex m_MainThreadMutex;
+		std::vector<uint32_t> m_MainThreadQueue;
+
+		/// The first exception thrown by a system during a run
+		std::mutex m_ExceptionMutex;
+		std::exception_ptr m_Exception;
+
+		FrameTimeBreakdown m_Breakdown;
+	};
+}
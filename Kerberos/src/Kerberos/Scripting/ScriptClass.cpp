@@ -27,6 +27,11 @@ namespace Kerberos
 		return method;
 	}
 
+	MonoMethod* ScriptClass::FindMethod(const std::string& name, const int paramCount) const
+	{
+		return mono_class_get_method_from_name(m_MonoClass, name.c_str(), paramCount);
+	}
+
 	MonoObject* ScriptClass::InvokeMethod(MonoMethod* method, MonoObject* instance, void** params) const
 	{
 		MonoObject* exception = nullptr;
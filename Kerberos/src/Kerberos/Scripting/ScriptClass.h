@@ -86,6 +86,8 @@ namespace Kerberos
 		MonoObject* Instantiate() const;
 
 		MonoMethod* GetMethod(const std::string& name, int paramCount) const;
+		/// Same as GetMethod, but returns nullptr without asserting, for the callbacks a script doesn't have to override
+		MonoMethod* FindMethod(const std::string& name, int paramCount) const;
 		MonoObject* InvokeMethod(MonoMethod* method, MonoObject* instance, void** params = nullptr) const;
 
 		const std::unordered_map<std::string, ScriptField>& GetSerializedFields() const { return m_SerializedFields; }
@@ -157,6 +157,17 @@ namespace Kerberos
 		s_ScriptData->EntityInstances[entity.GetUUID()]->InvokeOnUpdate(deltaTime);
 	}
 
+	void ScriptEngine::OnContactEvent(const ContactEvent& event)
+	{
+		const auto& instances = s_ScriptData->EntityInstances;
+
+		if (const auto it = instances.find(event.Entity1); it != instances.end())
+			it->second->InvokeOnContact(event.Type, event.Entity2);
+
+		if (const auto it = instances.find(event.Entity2); it != instances.end())
+			it->second->InvokeOnContact(event.Type, event.Entity1);
+	}
+
 	bool ScriptEngine::ClassExists(const std::string& className) 
 	{
 		return s_ScriptData->EntityClasses.contains(className);
@@ -23,6 +23,7 @@ namespace Kerberos { class ScriptClass;				}
 namespace Kerberos { class ScriptInstance;			}
 namespace Kerberos { class ScriptInterface;			}
 namespace Kerberos { struct ScriptFieldInitializer;	}
+namespace Kerberos { struct ContactEvent;				}
 
 namespace Kerberos
 {
@@ -38,6 +39,8 @@ namespace Kerberos
 
 		static void OnCreateEntity(Entity entity);
 		static void OnUpdateEntity(Entity entity, float deltaTime);
+		/// Calls the contact callbacks of the scripts of both entities of the event, if they have one
+		static void OnContactEvent(const ContactEvent& event);
 
 		static bool ClassExists(const std::string& className);
 		static void CreateScriptFieldInitializers(Entity entity, const std::string& className);
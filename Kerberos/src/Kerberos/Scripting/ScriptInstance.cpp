@@ -16,6 +16,11 @@ namespace Kerberos
 
 		m_OnCreateMethod = m_ScriptClass->GetMethod("OnCreate", 0);
 		m_OnUpdateMethod = m_ScriptClass->GetMethod("OnUpdate", 1);
+		m_OnCollisionEnterMethod = m_ScriptClass->FindMethod("OnCollisionEnter", 1);
+		m_OnCollisionStayMethod = m_ScriptClass->FindMethod("OnCollisionStay", 1);
+		m_OnCollisionExitMethod = m_ScriptClass->FindMethod("OnCollisionExit", 1);
+		m_OnTriggerEnterMethod = m_ScriptClass->FindMethod("OnTriggerEnter", 1);
+		m_OnTriggerExitMethod = m_ScriptClass->FindMethod("OnTriggerExit", 1);
 		m_Constructor = m_ScriptClass->GetMethod(".ctor", 1);
 
 		UUID entityID = m_Entity.GetUUID();
@@ -44,6 +49,26 @@ namespace Kerberos
 		}
 	}
 
+	void ScriptInstance::InvokeOnContact(const ContactEventType type, UUID otherID) const
+	{
+		MonoMethod* method = nullptr;
+		switch (type)
+		{
+		case ContactEventType::CollisionEnter:	method = m_OnCollisionEnterMethod;	break;
+		case ContactEventType::CollisionStay:	method = m_OnCollisionStayMethod;	break;
+		case ContactEventType::CollisionExit:	method = m_OnCollisionExitMethod;	break;
+		case ContactEventType::TriggerEnter:	method = m_OnTriggerEnterMethod;	break;
+		case ContactEventType::TriggerExit:		method = m_OnTriggerExitMethod;		break;
+		}
+
+		/// The contact methods are not necessarily overridden
+		if (method)
+		{
+			void* params = &otherID;
+			m_ScriptClass->InvokeMethod(method, m_Instance, &params);
+		}
+	}
+
 	void ScriptInstance::InitializeValues(const std::unordered_map<std::string, ScriptFieldInitializer>& values) const 
 	{
 		for (const auto& [name, initializer] : values)
@@ -2,6 +2,7 @@
 
 #include "Kerberos/Core.h"
 #include "Kerberos/Scene/Entity.h"
+#include "Kerberos/Physics/IPhysicsSystem.h"
 #include "ScriptClass.h"
 
 extern "C" {
@@ -25,6 +26,8 @@ namespace Kerberos
 
 		void InvokeOnCreate() const;
 		void InvokeOnUpdate(float deltaTime) const;
+		/// Calls the collision or trigger callback of the event type, with the id of the other entity
+		void InvokeOnContact(ContactEventType type, UUID otherID) const;
 
 
 		template<typename T>
@@ -62,6 +65,11 @@ namespace Kerberos
 		MonoObject* m_Instance = nullptr;
 		MonoMethod* m_OnCreateMethod = nullptr;
 		MonoMethod* m_OnUpdateMethod = nullptr;
+		MonoMethod* m_OnCollisionEnterMethod = nullptr;
+		MonoMethod* m_OnCollisionStayMethod = nullptr;
+		MonoMethod* m_OnCollisionExitMethod = nullptr;
+		MonoMethod* m_OnTriggerEnterMethod = nullptr;
+		MonoMethod* m_OnTriggerExitMethod = nullptr;
 		/// Constructor with the UUID parameter
 		MonoMethod* m_Constructor = nullptr;
 
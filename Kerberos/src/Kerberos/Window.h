@@ -5,6 +5,8 @@
 
 namespace Kerberos
 {
+	class GraphicsContext;
+
 	struct WindowProps
 	{
 		std::string Title;
@@ -39,6 +41,7 @@ namespace Kerberos
 		virtual bool IsVSync() const = 0;
 
 		virtual void* GetNativeWindow() const = 0;
+		virtual GraphicsContext* GetGraphicsContext() const = 0;
 
 		static Scope<Window> Create(const WindowProps& props = WindowProps());
 	};
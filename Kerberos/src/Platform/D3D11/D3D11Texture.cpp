@@ -51,7 +51,7 @@ namespace Kerberos
 
 		int width, height, channels;
 
-		stbi_set_flip_vertically_on_load(true);
+		stbi_set_flip_vertically_on_load_thread(true);
 
 		stbi_uc* imageData = nullptr;
 		{
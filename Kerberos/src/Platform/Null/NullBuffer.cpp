@@ -0,0 +1,82 @@
+#include "kbrpch.h"
+#include "NullBuffer.h"
+
+#include "NullRendererAPI.h"
+#include "Kerberos/Renderer/RenderThread.h"
+
+namespace Kerberos
+{
+	/// --------- Vertex Buffer --------- ///
+
+	NullVertexBuffer::NullVertexBuffer(const float* vertices, const uint32_t size)
+		: m_RendererID(NullRendererAPI::CreateRendererID()), m_Count(size / sizeof(float) / 3), m_Data(size)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		std::memcpy(m_Data.data(), vertices, size);
+
+		RenderThread::Submit([rendererID = m_RendererID, size]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadBuffer, rendererID, size);
+			});
+	}
+
+	NullVertexBuffer::NullVertexBuffer(const uint32_t size, const bool persistentlyMapped)
+		: m_RendererID(NullRendererAPI::CreateRendererID()), m_Count(0), m_Data(size)
+	{
+		if (persistentlyMapped)
+			m_MappedData = m_Data.data();
+	}
+
+	void NullVertexBuffer::SetData(const void* data, const uint32_t size)
+	{
+		KBR_CORE_ASSERT(size <= m_Data.size(), "Data size exceeds the size of the vertex buffer!");
+
+		std::memcpy(m_Data.data(), data, size);
+
+		RenderThread::Submit([rendererID = m_RendererID, size]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadBuffer, rendererID, size);
+			});
+	}
+
+	void NullVertexBuffer::FlushMappedData(const uint32_t offset, const uint32_t size)
+	{
+		KBR_CORE_ASSERT(m_MappedData, "The vertex buffer is not mapped!");
+		KBR_CORE_ASSERT(offset + size <= m_Data.size(), "The range exceeds the size of the vertex buffer!");
+
+		RenderThread::Submit([rendererID = m_RendererID, size]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadBuffer, rendererID, size);
+			});
+	}
+
+	void NullVertexBuffer::Bind() const
+	{
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindVertexBuffer, rendererID);
+			});
+	}
+
+	/// --------- Index Buffer --------- ///
+
+	NullIndexBuffer::NullIndexBuffer(const uint32_t* indices, const uint32_t count)
+		: m_RendererID(NullRendererAPI::CreateRendererID()), m_Count(count), m_Indices(indices, indices + count)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		RenderThread::Submit([rendererID = m_RendererID, size = static_cast<uint64_t>(count) * sizeof(uint32_t)]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadBuffer, rendererID, size);
+			});
+	}
+
+	void NullIndexBuffer::Bind() const
+	{
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindIndexBuffer, rendererID);
+			});
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Kerberos/Renderer/Buffer.h"
+
+namespace Kerberos
+{
+	/// Keeps the vertex data in CPU memory
+	class NullVertexBuffer final : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(const float* vertices, uint32_t size);
+		explicit NullVertexBuffer(uint32_t size, bool persistentlyMapped = false);
+		~NullVertexBuffer() override = default;
+
+		void SetData(const void* data, uint32_t size) override;
+
+		void* GetMappedData() const override { return m_MappedData; }
+		void FlushMappedData(uint32_t offset, uint32_t size) override;
+
+		void Bind() const override;
+		void Unbind() const override {}
+
+		void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+		const BufferLayout& GetLayout() const override { return m_Layout; }
+		uint32_t GetCount() const override { return m_Count; }
+
+		void SetDebugName(const std::string& name) override {}
+
+	private:
+		uint32_t m_RendererID;
+		BufferLayout m_Layout;
+		uint32_t m_Count;
+		std::vector<uint8_t> m_Data;
+		void* m_MappedData = nullptr;
+	};
+
+	/// Keeps the indices in CPU memory
+	class NullIndexBuffer final : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(const uint32_t* indices, uint32_t count);
+		~NullIndexBuffer() override = default;
+
+		void Bind() const override;
+		void Unbind() const override {}
+
+		uint32_t GetCount() const override { return m_Count; }
+
+		void SetDebugName(const std::string& name) override {}
+
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Count;
+		std::vector<uint32_t> m_Indices;
+	};
+}
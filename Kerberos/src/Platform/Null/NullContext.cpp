@@ -0,0 +1,10 @@
+#include "kbrpch.h"
+#include "NullContext.h"
+
+namespace Kerberos
+{
+	void NullContext::Init()
+	{
+		KBR_CORE_INFO("Null Renderer: the render commands are only recorded, nothing is drawn");
+	}
+}
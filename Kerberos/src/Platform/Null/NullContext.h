@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Kerberos/Renderer/GraphicsContext.h"
+
+namespace Kerberos
+{
+	/// The context of the Null backend, there is nothing to present
+	class NullContext final : public GraphicsContext
+	{
+	public:
+		void Init() override;
+		void SwapBuffers() override {}
+	};
+}
@@ -0,0 +1,33 @@
+#include "kbrpch.h"
+#include "NullFence.h"
+
+#include "Kerberos/Renderer/RenderThread.h"
+
+namespace Kerberos
+{
+	NullFence::NullFence()
+		: m_Signaled(CreateRef<std::atomic<bool>>(true))
+	{
+	}
+
+	void NullFence::Signal()
+	{
+		m_Signaled = CreateRef<std::atomic<bool>>(false);
+
+		RenderThread::Submit([signaled = m_Signaled]
+			{
+				signaled->store(true, std::memory_order_release);
+			});
+	}
+
+	bool NullFence::IsSignaled()
+	{
+		return m_Signaled->load(std::memory_order_acquire);
+	}
+
+	void NullFence::Wait()
+	{
+		if (!IsSignaled())
+			RenderThread::Flush();
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Kerberos/Renderer/Fence.h"
+
+#include <atomic>
+
+namespace Kerberos
+{
+	/// There is no GPU to wait for, the fence is signaled once the render thread has executed the commands before it
+	class NullFence final : public Fence
+	{
+	public:
+		NullFence();
+		~NullFence() override = default;
+
+		void Signal() override;
+		bool IsSignaled() override;
+		void Wait() override;
+
+	private:
+		Ref<std::atomic<bool>> m_Signaled;
+	};
+}
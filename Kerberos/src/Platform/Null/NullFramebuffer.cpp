@@ -0,0 +1,127 @@
+#include "kbrpch.h"
+#include "NullFramebuffer.h"
+
+#include "NullRendererAPI.h"
+#include "Kerberos/Renderer/RenderThread.h"
+
+#include <bit>
+
+namespace Kerberos
+{
+	static bool IsDepthFormat(const FramebufferTextureFormat format)
+	{
+		switch (format)
+		{
+		case FramebufferTextureFormat::DEPTH24:
+		case FramebufferTextureFormat::DEPTH24STENCIL8:
+			return true;
+		case FramebufferTextureFormat::None:
+		case FramebufferTextureFormat::RGBA8:
+		case FramebufferTextureFormat::RED_INTEGER:
+			return false;
+		}
+
+		KBR_CORE_ASSERT(false, "Unknown framebuffer texture format!");
+		return false;
+	}
+
+	NullFramebuffer::NullFramebuffer(const FramebufferSpecification& spec)
+		: m_RendererID(NullRendererAPI::CreateRendererID()), m_Specification(spec)
+	{
+		for (const auto& format : spec.Attachments.Attachments)
+		{
+			if (IsDepthFormat(format.TextureFormat))
+			{
+				m_DepthAttachment = NullRendererAPI::CreateRendererID();
+			}
+			else
+			{
+				m_ColorAttachments.push_back(NullRendererAPI::CreateRendererID());
+				m_ClearValues.push_back(0);
+			}
+		}
+	}
+
+	void NullFramebuffer::Bind()
+	{
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindFramebuffer, rendererID);
+			});
+	}
+
+	void NullFramebuffer::Unbind()
+	{
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				NullRendererAPI::RecordCommand(NullCommand::UnbindFramebuffer, rendererID);
+			});
+	}
+
+	void NullFramebuffer::Resize(const uint32_t width, const uint32_t height)
+	{
+		if (width == 0 || height == 0)
+		{
+			KBR_CORE_WARN("Attempted to resize framebuffer to {0}, {1}", width, height);
+			return;
+		}
+
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+	}
+
+	int NullFramebuffer::ReadPixel(const uint32_t attachmentIndex, const int x, const int y)
+	{
+		KBR_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "attachmenIndex is out of bounds");
+
+		/// Stalls like a real read back does, so the cost of picking shows up in the profiles
+		RenderThread::SubmitAndWait([attachment = m_ColorAttachments[attachmentIndex], x, y]
+			{
+				NullRendererAPI::RecordCommand(NullCommand::ReadPixel, attachment, static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 | static_cast<uint32_t>(y));
+			});
+
+		return m_ClearValues[attachmentIndex];
+	}
+
+	void NullFramebuffer::BindColorTexture(const uint32_t slot, const uint32_t index) const
+	{
+		KBR_CORE_ASSERT(index < m_ColorAttachments.size(), "Index out of bounds!");
+
+		RenderThread::Submit([slot, attachment = m_ColorAttachments[index]]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindTexture, attachment, slot);
+			});
+	}
+
+	void NullFramebuffer::BindDepthTexture(const uint32_t slot) const
+	{
+		KBR_CORE_ASSERT(m_DepthAttachment != 0, "Depth attachment is not set!");
+
+		RenderThread::Submit([slot, attachment = m_DepthAttachment]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindTexture, attachment, slot);
+			});
+	}
+
+	void NullFramebuffer::ClearAttachment(const uint32_t attachmentIndex, const int value)
+	{
+		KBR_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "attachmenIndex is out of bounds");
+
+		m_ClearValues[attachmentIndex] = value;
+
+		RenderThread::Submit([attachment = m_ColorAttachments[attachmentIndex], value]
+			{
+				NullRendererAPI::RecordCommand(NullCommand::ClearAttachment, attachment, static_cast<uint32_t>(value));
+			});
+	}
+
+	void NullFramebuffer::ClearDepthAttachment(const float value) const
+	{
+		KBR_CORE_ASSERT(m_DepthAttachment != 0, "Depth attachment is not set!");
+
+		RenderThread::Submit([attachment = m_DepthAttachment, value]
+			{
+				NullRendererAPI::RecordCommand(NullCommand::ClearAttachment, attachment, std::bit_cast<uint32_t>(value));
+			});
+	}
+}
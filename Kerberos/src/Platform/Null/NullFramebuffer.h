@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Kerberos/Renderer/Framebuffer.h"
+
+namespace Kerberos
+{
+	/**
+	* A framebuffer without any storage. Reading a pixel returns the value the attachment was last cleared to,
+	* since nothing is ever rendered into it.
+	*/
+	class NullFramebuffer final : public Framebuffer
+	{
+	public:
+		explicit NullFramebuffer(const FramebufferSpecification& spec);
+		~NullFramebuffer() override = default;
+
+		void Bind() override;
+		void Unbind() override;
+
+		void Resize(uint32_t width, uint32_t height) override;
+
+		int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+
+		void BindColorTexture(uint32_t slot, uint32_t index) const override;
+		void BindDepthTexture(uint32_t slot) const override;
+
+		void ClearAttachment(uint32_t attachmentIndex, int value) override;
+		void ClearDepthAttachment(float value) const override;
+
+		uint64_t GetColorAttachmentRendererID(const uint32_t index = 0) const override
+		{
+			KBR_CORE_ASSERT(index < m_ColorAttachments.size(), "Index out of bounds!");
+			return m_ColorAttachments.at(index);
+		}
+
+		uint64_t GetDepthAttachmentRendererID() const override
+		{
+			KBR_CORE_ASSERT(m_DepthAttachment != 0, "Depth attachment is not set!");
+			return m_DepthAttachment;
+		}
+
+		FramebufferSpecification& GetSpecification() override { return m_Specification; }
+		const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+		void SetDebugName(const std::string& name) const override {}
+
+	private:
+		uint32_t m_RendererID;
+
+		FramebufferSpecification m_Specification;
+
+		std::vector<uint32_t> m_ColorAttachments;
+		/// The value each color attachment was last cleared to
+		std::vector<int> m_ClearValues;
+		uint32_t m_DepthAttachment = 0;
+	};
+}
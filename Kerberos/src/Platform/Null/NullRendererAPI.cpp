@@ -0,0 +1,172 @@
+#include "kbrpch.h"
+#include "NullRendererAPI.h"
+
+#include "Kerberos/Core/Hash.h"
+#include "Kerberos/Renderer/RenderThread.h"
+
+#include <atomic>
+#include <bit>
+
+namespace Kerberos
+{
+	/// Only written by the thread executing the commands, the main thread reads them after a flush
+	static NullRendererStatistics s_Statistics;
+	static std::atomic<uint32_t> s_NextRendererID = 1;
+
+	/// The resources are numbered in the order they are first used since the statistics were reset
+	static std::unordered_map<uint32_t, uint32_t> s_CanonicalRendererIDs;
+
+	void NullRendererAPI::Init()
+	{
+		ResetStatistics();
+
+		RenderThread::Submit([]
+			{
+				RecordCommand(NullCommand::Init);
+			});
+	}
+
+	void NullRendererAPI::SetViewport(const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height)
+	{
+		RenderThread::Submit([x, y, width, height]
+			{
+				RecordCommand(NullCommand::SetViewport, static_cast<uint64_t>(x) << 32 | y, static_cast<uint64_t>(width) << 32 | height);
+			});
+	}
+
+	void NullRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+		RenderThread::Submit([color]
+			{
+				RecordCommand(NullCommand::SetClearColor,
+					static_cast<uint64_t>(std::bit_cast<uint32_t>(color.r)) << 32 | std::bit_cast<uint32_t>(color.g),
+					static_cast<uint64_t>(std::bit_cast<uint32_t>(color.b)) << 32 | std::bit_cast<uint32_t>(color.a));
+			});
+	}
+
+	void NullRendererAPI::Clear()
+	{
+		RenderThread::Submit([]
+			{
+				RecordCommand(NullCommand::Clear);
+			});
+	}
+
+	void NullRendererAPI::ClearDepth()
+	{
+		RenderThread::Submit([]
+			{
+				RecordCommand(NullCommand::ClearDepth);
+			});
+	}
+
+	void NullRendererAPI::SetDepthTest(const bool enabled)
+	{
+		RenderThread::Submit([enabled]
+			{
+				RecordCommand(NullCommand::SetDepthTest, enabled);
+			});
+	}
+
+	void NullRendererAPI::SetDepthFunc(const DepthFunc func)
+	{
+		RenderThread::Submit([func]
+			{
+				RecordCommand(NullCommand::SetDepthFunc, static_cast<uint64_t>(func));
+			});
+	}
+
+	void NullRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, const uint32_t indexCount)
+	{
+		vertexArray->Bind();
+
+		const uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		RenderThread::Submit([count]
+			{
+				RecordCommand(NullCommand::DrawIndexed, count);
+
+				++s_Statistics.DrawCalls;
+				s_Statistics.IndexCount += count;
+				++s_Statistics.InstanceCount;
+			});
+	}
+
+	void NullRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, const uint32_t indexCount, const uint32_t instanceCount, const uint32_t baseInstance)
+	{
+		vertexArray->Bind();
+
+		const uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		RenderThread::Submit([count, instanceCount, baseInstance]
+			{
+				RecordCommand(NullCommand::DrawIndexedInstanced, count, static_cast<uint64_t>(instanceCount) << 32 | baseInstance);
+
+				++s_Statistics.DrawCalls;
+				s_Statistics.IndexCount += static_cast<uint64_t>(count) * instanceCount;
+				s_Statistics.InstanceCount += instanceCount;
+			});
+	}
+
+	void NullRendererAPI::DrawArray(const Ref<VertexArray>& vertexArray, const uint32_t vertexCount)
+	{
+		vertexArray->Bind();
+
+		RenderThread::Submit([vertexCount]
+			{
+				RecordCommand(NullCommand::DrawArray, vertexCount);
+
+				++s_Statistics.DrawCalls;
+				++s_Statistics.InstanceCount;
+			});
+	}
+
+	NullRendererStatistics NullRendererAPI::GetStatistics()
+	{
+		RenderThread::Flush();
+		return s_Statistics;
+	}
+
+	void NullRendererAPI::ResetStatistics()
+	{
+		RenderThread::Flush();
+
+		s_Statistics = NullRendererStatistics();
+		s_Statistics.CommandHash = FNVOffsetBasis;
+		s_CanonicalRendererIDs.clear();
+	}
+
+	uint32_t NullRendererAPI::CreateRendererID()
+	{
+		return s_NextRendererID.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static uint32_t GetCanonicalRendererID(const uint32_t rendererID)
+	{
+		const auto [it, inserted] = s_CanonicalRendererIDs.try_emplace(rendererID, static_cast<uint32_t>(s_CanonicalRendererIDs.size()) + 1);
+		return it->second;
+	}
+
+	void NullRendererAPI::RecordCommand(const NullCommand command, const uint64_t argument0, const uint64_t argument1)
+	{
+		++s_Statistics.CommandCount;
+
+		s_Statistics.CommandHash = HashValue(static_cast<uint64_t>(command), s_Statistics.CommandHash);
+		s_Statistics.CommandHash = HashValue(argument0, s_Statistics.CommandHash);
+		s_Statistics.CommandHash = HashValue(argument1, s_Statistics.CommandHash);
+	}
+
+	void NullRendererAPI::RecordUpload(const NullCommand command, const uint64_t target, const uint64_t size)
+	{
+		/// The uniforms are identified by the hash of their name
+		RecordCommand(command, command == NullCommand::UploadUniform ? target : GetCanonicalRendererID(static_cast<uint32_t>(target)), size);
+
+		s_Statistics.BytesUploaded += size;
+		++s_Statistics.Uploads;
+	}
+
+	void NullRendererAPI::RecordBind(const NullCommand command, const uint32_t rendererID, const uint32_t slot)
+	{
+		RecordCommand(command, GetCanonicalRendererID(rendererID), slot);
+
+		++s_Statistics.Binds;
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Kerberos/Renderer/RendererAPI.h"
+
+namespace Kerberos
+{
+	/// The commands the Null backend records, they identify the calls in the command hash
+	enum class NullCommand : uint8_t
+	{
+		Init = 0,
+		SetViewport,
+		SetClearColor,
+		Clear,
+		ClearDepth,
+		SetDepthTest,
+		SetDepthFunc,
+		DrawIndexed,
+		DrawIndexedInstanced,
+		DrawArray,
+
+		BindVertexBuffer,
+		BindIndexBuffer,
+		BindVertexArray,
+		BindTexture,
+		BindShader,
+		BindFramebuffer,
+		UnbindFramebuffer,
+
+		UploadBuffer,
+		UploadTexture,
+		UploadUniform,
+		ClearAttachment,
+		ReadPixel,
+	};
+
+	struct NullRendererStatistics
+	{
+		/// The vertex, index, uniform and texture data handed to the backend
+		uint64_t BytesUploaded = 0;
+		uint32_t Uploads = 0;
+
+		uint32_t Binds = 0;
+
+		uint32_t DrawCalls = 0;
+		uint64_t IndexCount = 0;
+		uint64_t InstanceCount = 0;
+
+		uint32_t CommandCount = 0;
+		/// A hash of every command and its arguments, in the order they were executed.
+		/// Recording the same frame twice results in the same hash, no matter which thread executed it.
+		/// The bound and uploaded resources are hashed by the order of their first use, not by their id,
+		/// so the frame hashes the same when it goes to other buffers of a ring in the same pattern.
+		uint64_t CommandHash = 0;
+	};
+
+	/**
+	* A renderer backend without a GPU. Every call is submitted to the render thread like the other backends do,
+	* but instead of calling a graphics API the commands only update the statistics.
+	* This makes the CPU cost of the renderer measurable on machines without a graphics driver.
+	*/
+	class NullRendererAPI final : public RendererAPI
+	{
+	public:
+		void Init() override;
+
+		void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+		void SetClearColor(const glm::vec4& color) override;
+		void Clear() override;
+		void ClearDepth() override;
+
+		void SetDepthTest(bool enabled) override;
+		void SetDepthFunc(DepthFunc func) override;
+
+		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance = 0) override;
+		void DrawArray(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
+
+		/// Flushes the render thread, so the statistics include everything submitted so far
+		static NullRendererStatistics GetStatistics();
+		static void ResetStatistics();
+
+		/// The ids of the Null resources, they are never reused
+		static uint32_t CreateRendererID();
+
+		/// Called by the commands of the Null resources, on the thread executing them
+		static void RecordCommand(NullCommand command, uint64_t argument0 = 0, uint64_t argument1 = 0);
+		/// The target is the id of the resource, or the hash of the name for uniforms
+		static void RecordUpload(NullCommand command, uint64_t target, uint64_t size);
+		static void RecordBind(NullCommand command, uint32_t rendererID, uint32_t slot = 0);
+	};
+}
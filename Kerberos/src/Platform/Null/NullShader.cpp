@@ -0,0 +1,133 @@
+#include "kbrpch.h"
+#include "NullShader.h"
+
+#include "NullRendererAPI.h"
+#include "Kerberos/Renderer/Material.h"
+#include "Kerberos/Renderer/RenderThread.h"
+
+#include <filesystem>
+
+namespace Kerberos
+{
+	NullShader::NullShader(const std::string& filepath)
+		: m_RendererID(NullRendererAPI::CreateRendererID())
+	{
+		const std::filesystem::path path = filepath;
+		m_Name = path.stem().string();
+	}
+
+	NullShader::NullShader(std::string name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: m_RendererID(NullRendererAPI::CreateRendererID()), m_Name(std::move(name))
+	{
+	}
+
+	void NullShader::Bind() const
+	{
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindShader, rendererID);
+			});
+	}
+
+	void NullShader::SetInt(const std::string& name, int value)
+	{
+		UploadUniform(name, sizeof(int));
+	}
+
+	void NullShader::SetIntArray(const std::string& name, int* values, const uint32_t count)
+	{
+		UploadUniform(name, count * sizeof(int));
+	}
+
+	void NullShader::SetFloat(const std::string& name, float value)
+	{
+		UploadUniform(name, sizeof(float));
+	}
+
+	void NullShader::SetFloat3(const std::string& name, const glm::vec3& value)
+	{
+		UploadUniform(name, sizeof(glm::vec3));
+	}
+
+	void NullShader::SetFloat4(const std::string& name, const glm::vec4& value)
+	{
+		UploadUniform(name, sizeof(glm::vec4));
+	}
+
+	void NullShader::SetMat4(const std::string& name, const glm::mat4& value)
+	{
+		UploadUniform(name, sizeof(glm::mat4));
+	}
+
+	ShaderUniform NullShader::GetUniform(const std::string& name) const
+	{
+		const size_t nameHash = std::hash<std::string>{}(name);
+
+		const auto it = std::ranges::find(m_UniformNameHashes, nameHash);
+		if (it != m_UniformNameHashes.end())
+			return { static_cast<int32_t>(it - m_UniformNameHashes.begin()) };
+
+		m_UniformNameHashes.push_back(nameHash);
+		return { static_cast<int32_t>(m_UniformNameHashes.size() - 1) };
+	}
+
+	void NullShader::SetInt(const ShaderUniform uniform, int value)
+	{
+		UploadUniform(uniform, sizeof(int));
+	}
+
+	void NullShader::SetIntArray(const ShaderUniform uniform, const int* values, const uint32_t count)
+	{
+		UploadUniform(uniform, count * sizeof(int));
+	}
+
+	void NullShader::SetFloat(const ShaderUniform uniform, float value)
+	{
+		UploadUniform(uniform, sizeof(float));
+	}
+
+	void NullShader::SetFloat3(const ShaderUniform uniform, const glm::vec3& value)
+	{
+		UploadUniform(uniform, sizeof(glm::vec3));
+	}
+
+	void NullShader::SetFloat4(const ShaderUniform uniform, const glm::vec4& value)
+	{
+		UploadUniform(uniform, sizeof(glm::vec4));
+	}
+
+	void NullShader::SetMat4(const ShaderUniform uniform, const glm::mat4& value)
+	{
+		UploadUniform(uniform, sizeof(glm::mat4));
+	}
+
+	void NullShader::SetMaterial(const std::string& name, const Ref<Material>& material)
+	{
+		UploadUniform(name + ".ambient", sizeof(glm::vec3));
+		UploadUniform(name + ".diffuse", sizeof(glm::vec3));
+		UploadUniform(name + ".specular", sizeof(glm::vec3));
+		UploadUniform(name + ".shininess", sizeof(float));
+	}
+
+	void NullShader::UploadUniform(const std::string& name, const uint32_t size)
+	{
+		UploadUniform(std::hash<std::string>{}(name), size);
+	}
+
+	void NullShader::UploadUniform(const size_t nameHash, const uint32_t size)
+	{
+		/// The uniform is applied to the bound shader, which is already part of the command hash
+		RenderThread::Submit([nameHash, size]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadUniform, nameHash, size);
+			});
+	}
+
+	void NullShader::UploadUniform(const ShaderUniform uniform, const uint32_t size) const
+	{
+		if (!uniform.IsValid())
+			return;
+
+		UploadUniform(m_UniformNameHashes[uniform.Location], size);
+	}
+}
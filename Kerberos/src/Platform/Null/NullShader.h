@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Kerberos/Renderer/Shader.h"
+
+namespace Kerberos
+{
+	/// Never compiles the sources, setting a uniform only records the upload
+	class NullShader final : public Shader
+	{
+	public:
+		explicit NullShader(const std::string& filepath);
+		NullShader(std::string name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		~NullShader() override = default;
+
+		void Bind() const override;
+		void Unbind() const override {}
+
+		const std::string& GetName() const override { return m_Name; }
+
+		void SetInt(const std::string& name, int value) override;
+		void SetIntArray(const std::string& name, int* values, uint32_t count) override;
+		void SetFloat(const std::string& name, float value) override;
+		void SetFloat3(const std::string& name, const glm::vec3& value) override;
+		void SetFloat4(const std::string& name, const glm::vec4& value) override;
+		void SetMat4(const std::string& name, const glm::mat4& value) override;
+
+		ShaderUniform GetUniform(const std::string& name) const override;
+
+		void SetInt(ShaderUniform uniform, int value) override;
+		void SetIntArray(ShaderUniform uniform, const int* values, uint32_t count) override;
+		void SetFloat(ShaderUniform uniform, float value) override;
+		void SetFloat3(ShaderUniform uniform, const glm::vec3& value) override;
+		void SetFloat4(ShaderUniform uniform, const glm::vec4& value) override;
+		void SetMat4(ShaderUniform uniform, const glm::mat4& value) override;
+
+		void SetMaterial(const std::string& name, const Ref<Material>& material) override;
+
+		void SetDebugName(const std::string& name) const override {}
+
+	private:
+		static void UploadUniform(const std::string& name, uint32_t size);
+		static void UploadUniform(size_t nameHash, uint32_t size);
+		void UploadUniform(ShaderUniform uniform, uint32_t size) const;
+
+	private:
+		uint32_t m_RendererID;
+		std::string m_Name;
+
+		/// The locations of the handles index into the name hashes, so both ways of setting a uniform record the same upload
+		mutable std::vector<size_t> m_UniformNameHashes;
+	};
+}
@@ -0,0 +1,102 @@
+#include "kbrpch.h"
+#include "NullTexture.h"
+
+#include "NullRendererAPI.h"
+#include "Kerberos/Renderer/RenderThread.h"
+
+namespace Kerberos
+{
+	static constexpr uint32_t BytesPerPixel(const ImageFormat format)
+	{
+		switch (format)
+		{
+		case ImageFormat::RGB8:		return 3;
+		case ImageFormat::RGBA8:	return 4;
+		case ImageFormat::R8:		return 1;
+		case ImageFormat::RGBA32F:	return 16;
+		case ImageFormat::None:
+			break;
+		}
+
+		KBR_CORE_ASSERT(false, "BytesPerPixel - unsupported format");
+		return 0;
+	}
+
+	NullTexture2D::NullTexture2D(const TextureSpecification& spec, const Buffer data)
+		: m_Spec(spec), m_RendererID(NullRendererAPI::CreateRendererID()),
+		m_Data(static_cast<size_t>(spec.Width) * spec.Height * BytesPerPixel(spec.Format))
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (data)
+		{
+			NullTexture2D::SetData(data.Data, static_cast<uint32_t>(data.Size));
+		}
+	}
+
+	void NullTexture2D::Bind(const uint32_t slot) const
+	{
+		RenderThread::Submit([slot, rendererID = m_RendererID]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindTexture, rendererID, slot);
+			});
+	}
+
+	void NullTexture2D::SetData(void* data, const uint32_t size)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		KBR_CORE_ASSERT(size == m_Data.size(), "Data must be the entire texture!");
+
+		std::memcpy(m_Data.data(), data, size);
+
+		RenderThread::Submit([rendererID = m_RendererID, size]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadTexture, rendererID, size);
+			});
+	}
+
+	NullTexture2DArray::NullTexture2DArray(const TextureSpecification& spec, const uint32_t layerCount)
+		: m_Spec(spec), m_LayerCount(layerCount), m_RendererID(NullRendererAPI::CreateRendererID()),
+		m_Data(static_cast<size_t>(spec.Width) * spec.Height * BytesPerPixel(spec.Format) * layerCount)
+	{
+	}
+
+	void NullTexture2DArray::Bind(const uint32_t slot) const
+	{
+		RenderThread::Submit([slot, rendererID = m_RendererID]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindTexture, rendererID, slot);
+			});
+	}
+
+	void NullTexture2DArray::SetData(void* data, const uint32_t size)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		KBR_CORE_ASSERT(size == m_Data.size(), "Data must be the entire texture array!");
+
+		std::memcpy(m_Data.data(), data, size);
+
+		RenderThread::Submit([rendererID = m_RendererID, size]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadTexture, rendererID, size);
+			});
+	}
+
+	void NullTexture2DArray::SetLayerData(const uint32_t layer, const void* data, const uint32_t size)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		const size_t layerSize = m_Data.size() / m_LayerCount;
+		KBR_CORE_ASSERT(layer < m_LayerCount, "Layer index out of range!");
+		KBR_CORE_ASSERT(size == layerSize, "Data must be the entire layer!");
+
+		std::memcpy(m_Data.data() + layer * layerSize, data, size);
+
+		RenderThread::Submit([rendererID = m_RendererID, size]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadTexture, rendererID, size);
+			});
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Kerberos/Renderer/Texture.h"
+
+namespace Kerberos
+{
+	/// Keeps the pixels in CPU memory
+	class NullTexture2D final : public Texture2D
+	{
+	public:
+		NullTexture2D(const TextureSpecification& spec, Buffer data);
+		~NullTexture2D() override = default;
+
+		uint32_t GetWidth() const override { return m_Spec.Width; }
+		uint32_t GetHeight() const override { return m_Spec.Height; }
+		const TextureSpecification& GetSpecification() const override { return m_Spec; }
+
+		uint64_t GetRendererID() const override { return m_RendererID; }
+
+		void Bind(uint32_t slot = 0) const override;
+
+		void SetData(void* data, uint32_t size) override;
+
+		bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == other.GetRendererID();
+		}
+
+		void SetDebugName(const std::string& name) const override {}
+
+	private:
+		TextureSpecification m_Spec;
+		uint32_t m_RendererID;
+		std::vector<uint8_t> m_Data;
+	};
+
+	/// Keeps the pixels of every layer in CPU memory
+	class NullTexture2DArray final : public Texture2DArray
+	{
+	public:
+		NullTexture2DArray(const TextureSpecification& spec, uint32_t layerCount);
+		~NullTexture2DArray() override = default;
+
+		uint32_t GetWidth() const override { return m_Spec.Width; }
+		uint32_t GetHeight() const override { return m_Spec.Height; }
+		const TextureSpecification& GetSpecification() const override { return m_Spec; }
+		uint32_t GetLayerCount() const override { return m_LayerCount; }
+
+		uint64_t GetRendererID() const override { return m_RendererID; }
+
+		void Bind(uint32_t slot = 0) const override;
+
+		void SetData(void* data, uint32_t size) override;
+		void SetLayerData(uint32_t layer, const void* data, uint32_t size) override;
+
+		bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == other.GetRendererID();
+		}
+
+		void SetDebugName(const std::string& name) const override {}
+
+	private:
+		TextureSpecification m_Spec;
+		uint32_t m_LayerCount;
+		uint32_t m_RendererID;
+		std::vector<uint8_t> m_Data;
+	};
+}
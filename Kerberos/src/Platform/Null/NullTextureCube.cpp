@@ -0,0 +1,39 @@
+#include "kbrpch.h"
+#include "NullTextureCube.h"
+
+#include "NullRendererAPI.h"
+#include "Kerberos/Renderer/RenderThread.h"
+
+namespace Kerberos
+{
+	NullTextureCube::NullTextureCube(const CubemapData& data)
+		: m_RendererID(NullRendererAPI::CreateRendererID()), m_Name(data.Name)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		uint64_t size = 0;
+		for (size_t i = 0; i < data.Faces.size(); i++)
+		{
+			m_FacesSpecifications[i] = data.Faces[i].Specification;
+			size += data.Faces[i].Buffer.Size;
+		}
+
+		RenderThread::Submit([rendererID = m_RendererID, size]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadTexture, rendererID, size);
+			});
+	}
+
+	void NullTextureCube::Bind(const uint32_t slot) const
+	{
+		RenderThread::Submit([slot, rendererID = m_RendererID]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindTexture, rendererID, slot);
+			});
+	}
+
+	void NullTextureCube::SetData(void* data, uint32_t size)
+	{
+		throw std::runtime_error("NullTextureCube::SetData() is not yet implemented.");
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Kerberos/Renderer/TextureCube.h"
+
+namespace Kerberos
+{
+	/// Only keeps the specification of the faces, the pixels are dropped after they were counted
+	class NullTextureCube final : public TextureCube
+	{
+	public:
+		explicit NullTextureCube(const CubemapData& data);
+		~NullTextureCube() override = default;
+
+		void Bind(uint32_t slot = 0) const override;
+
+		uint64_t GetRendererID() const override { return m_RendererID; }
+		const std::string& GetName() const override { return m_Name; }
+		/// Assuming all faces have the same size
+		uint32_t GetWidth() const override { return m_FacesSpecifications[0].Width; }
+		uint32_t GetHeight() const override { return m_FacesSpecifications[0].Height; }
+		const TextureSpecification& GetSpecification() const override { return m_FacesSpecifications[0]; }
+
+		void SetData(void* data, uint32_t size) override;
+
+		bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == other.GetRendererID();
+		}
+
+		void SetDebugName(const std::string& name) const override {}
+
+	private:
+		uint32_t m_RendererID;
+		std::string m_Name;
+		std::array<TextureSpecification, 6> m_FacesSpecifications;
+	};
+}
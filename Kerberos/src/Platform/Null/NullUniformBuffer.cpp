@@ -0,0 +1,25 @@
+#include "kbrpch.h"
+#include "NullUniformBuffer.h"
+
+#include "NullRendererAPI.h"
+#include "Kerberos/Renderer/RenderThread.h"
+
+namespace Kerberos
+{
+	NullUniformBuffer::NullUniformBuffer(const uint32_t size, uint32_t binding)
+		: m_RendererID(NullRendererAPI::CreateRendererID()), m_Data(size)
+	{
+	}
+
+	void NullUniformBuffer::SetData(const void* data, const uint32_t size, const uint32_t offset)
+	{
+		KBR_CORE_ASSERT(offset + size <= m_Data.size(), "Data size exceeds the size of the uniform buffer!");
+
+		std::memcpy(m_Data.data() + offset, data, size);
+
+		RenderThread::Submit([rendererID = m_RendererID, size]
+			{
+				NullRendererAPI::RecordUpload(NullCommand::UploadBuffer, rendererID, size);
+			});
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Kerberos/Renderer/UniformBuffer.h"
+
+namespace Kerberos
+{
+	/// Keeps the uniform data in CPU memory
+	class NullUniformBuffer final : public UniformBuffer
+	{
+	public:
+		NullUniformBuffer(uint32_t size, uint32_t binding);
+		~NullUniformBuffer() override = default;
+
+		void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+
+		void SetDebugName(const std::string& debugName) override {}
+
+	private:
+		uint32_t m_RendererID;
+		std::vector<uint8_t> m_Data;
+	};
+}
@@ -0,0 +1,33 @@
+#include "kbrpch.h"
+#include "NullVertexArray.h"
+
+#include "NullRendererAPI.h"
+#include "Kerberos/Renderer/RenderThread.h"
+
+namespace Kerberos
+{
+	NullVertexArray::NullVertexArray()
+		: m_RendererID(NullRendererAPI::CreateRendererID())
+	{
+	}
+
+	void NullVertexArray::Bind() const
+	{
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				NullRendererAPI::RecordBind(NullCommand::BindVertexArray, rendererID);
+			});
+	}
+
+	void NullVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		KBR_CORE_ASSERT(!vertexBuffer->GetLayout().GetElements().empty(), "Vertex buffer has no layout!");
+
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void NullVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
+	{
+		m_IndexBuffer = indexBuffer;
+	}
+}
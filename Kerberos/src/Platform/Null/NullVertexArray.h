@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Kerberos/Renderer/VertexArray.h"
+
+namespace Kerberos
+{
+	class NullVertexArray final : public VertexArray
+	{
+	public:
+		NullVertexArray();
+		~NullVertexArray() override = default;
+
+		void Bind() const override;
+		void Unbind() const override {}
+
+		void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+		void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
+
+		const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
+		const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
+
+		void SetDebugName(const std::string& name) override {}
+
+	private:
+		uint32_t m_RendererID;
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+}
@@ -1,6 +1,8 @@
 #include "kbrpch.h"
 #include "OpenGLBuffer.h"
 
+#include "Kerberos/Renderer/RenderThread.h"
+
 #include <glad/glad.h>
 
 namespace Kerberos
@@ -11,61 +13,114 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RenderThread::SubmitAndWait([this, vertices, size]
+			{
+				glGenBuffers(1, &m_RendererID);
+				glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 
-		// TODO: Specify the buffer usage as a parameter
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+				// TODO: Specify the buffer usage as a parameter
+				glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+			});
 
 		/// Assuming each vertex has 3 components (x, y, z)
 		m_Count = size / sizeof(float) / 3;
 	}
 
-	OpenGLVertexBuffer::OpenGLVertexBuffer(const uint32_t size) 
+	OpenGLVertexBuffer::OpenGLVertexBuffer(const uint32_t size, const bool persistentlyMapped) 
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-
-		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		if (persistentlyMapped)
+		{
+			/// Flushed explicitly instead of being coherent, so the driver only has to make the written ranges visible
+			RenderThread::SubmitAndWait([this, size]
+				{
+					constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+
+					glCreateBuffers(1, &m_RendererID);
+					glNamedBufferStorage(m_RendererID, size, nullptr, flags);
+					m_MappedData = glMapNamedBufferRange(m_RendererID, 0, size, flags | GL_MAP_FLUSH_EXPLICIT_BIT);
+				});
+
+			KBR_CORE_ASSERT(m_MappedData, "Failed to map the vertex buffer!");
+			return;
+		}
+
+		RenderThread::SubmitAndWait([this, size]
+			{
+				glGenBuffers(1, &m_RendererID);
+				glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+
+				glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+			});
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer() 
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glDeleteBuffers(1, &m_RendererID);
+		RenderThread::Submit([rendererID = m_RendererID, mapped = m_MappedData != nullptr]
+			{
+				if (mapped)
+					glUnmapNamedBuffer(rendererID);
+
+				glDeleteBuffers(1, &rendererID);
+			});
 	}
 
 	void OpenGLVertexBuffer::SetData(const void* data, const uint32_t size)
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		const void* commandData = RenderThread::CopyCommandData(data, size);
+		RenderThread::Submit([rendererID = m_RendererID, commandData, size]
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, rendererID);
+				glBufferSubData(GL_ARRAY_BUFFER, 0, size, commandData);
+			});
 
 		/// Assuming each vertex has 3 components (x, y, z)
 		m_Count = size / sizeof(float) / 3;
 	}
 
+	void OpenGLVertexBuffer::FlushMappedData(const uint32_t offset, const uint32_t size)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		KBR_CORE_ASSERT(m_MappedData, "The vertex buffer is not mapped!");
+
+		RenderThread::Submit([rendererID = m_RendererID, offset, size]
+			{
+				glFlushMappedNamedBufferRange(rendererID, offset, size);
+			});
+	}
+
 	void OpenGLVertexBuffer::Bind() const 
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, rendererID);
+			});
 	}
 
 	void OpenGLVertexBuffer::Unbind() const 
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderThread::Submit([]
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, 0);
+			});
 	}
 
 	void OpenGLVertexBuffer::SetDebugName(const std::string& name) 
 	{
-		glObjectLabel(GL_BUFFER, m_RendererID, static_cast<GLsizei>(name.size()), name.c_str());
+		RenderThread::Submit([rendererID = m_RendererID, name]
+			{
+				glObjectLabel(GL_BUFFER, rendererID, static_cast<GLsizei>(name.size()), name.c_str());
+			});
 	}
 
 	/// --------- Index Buffer --------- ///
@@ -75,36 +130,51 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RenderThread::SubmitAndWait([this, indices, count]
+			{
+				glGenBuffers(1, &m_RendererID);
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 
-		// TODO: Specify the buffer usage as a parameter
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(count * sizeof(uint32_t)), indices, GL_STATIC_DRAW);
+				// TODO: Specify the buffer usage as a parameter
+				glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(count * sizeof(uint32_t)), indices, GL_STATIC_DRAW);
+			});
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer() 
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glDeleteBuffers(1, &m_RendererID);
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				glDeleteBuffers(1, &rendererID);
+			});
 	}
 
 	void OpenGLIndexBuffer::Bind() const 
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID);
+			});
 	}
 
 	void OpenGLIndexBuffer::Unbind() const 
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		RenderThread::Submit([]
+			{
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			});
 	}
 
 	void OpenGLIndexBuffer::SetDebugName(const std::string& name) 
 	{
-		glObjectLabel(GL_BUFFER, m_RendererID, static_cast<GLsizei>(name.size()), name.c_str());
+		RenderThread::Submit([rendererID = m_RendererID, name]
+			{
+				glObjectLabel(GL_BUFFER, rendererID, static_cast<GLsizei>(name.size()), name.c_str());
+			});
 	}
 }
@@ -8,11 +8,15 @@ namespace Kerberos
 	{
 	public:
 		OpenGLVertexBuffer(const float* vertices, uint32_t size);
-		explicit OpenGLVertexBuffer(uint32_t size);
+		/// A persistently mapped buffer is written through GetMappedData, instead of SetData
+		explicit OpenGLVertexBuffer(uint32_t size, bool persistentlyMapped = false);
 		~OpenGLVertexBuffer() override;
 
 		void SetData(const void* data, uint32_t size) override;
 
+		void* GetMappedData() const override { return m_MappedData; }
+		void FlushMappedData(uint32_t offset, uint32_t size) override;
+
 		void Bind() const override;
 		void Unbind() const override;
 
@@ -26,6 +30,7 @@ namespace Kerberos
 		uint32_t m_RendererID;
 		BufferLayout m_Layout;
 		uint32_t m_Count;
+		void* m_MappedData = nullptr;
 	};
 
 	class OpenGLIndexBuffer final : public IndexBuffer
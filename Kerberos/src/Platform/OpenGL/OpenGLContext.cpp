@@ -51,6 +51,16 @@ namespace Kerberos
 		glfwSwapBuffers(m_WindowHandle);
 	}
 
+	void OpenGLContext::MakeCurrent()
+	{
+		glfwMakeContextCurrent(m_WindowHandle);
+	}
+
+	void OpenGLContext::ReleaseCurrent()
+	{
+		glfwMakeContextCurrent(nullptr);
+	}
+
 	void OpenGLContext::QueryComputeInfo()
 	{
 		int maxWorkGroupCount[3];
@@ -14,6 +14,9 @@ namespace Kerberos
 		void Init() override;
 		void SwapBuffers() override;
 
+		void MakeCurrent() override;
+		void ReleaseCurrent() override;
+
 	private:
 		void QueryComputeInfo();
 
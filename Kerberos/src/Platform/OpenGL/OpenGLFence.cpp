@@ -0,0 +1,103 @@
+#include "kbrpch.h"
+#include "OpenGLFence.h"
+
+#include "Kerberos/Renderer/RenderThread.h"
+
+#include <glad/glad.h>
+
+namespace Kerberos
+{
+	/// The fences waiting for the GPU, only used by the thread executing the render commands
+	static std::vector<Ref<OpenGLFence::SyncState>> s_PendingFences;
+
+	static void RetireFence(OpenGLFence::SyncState& state)
+	{
+		glDeleteSync(static_cast<GLsync>(state.Sync));
+		state.Sync = nullptr;
+		state.Signaled.store(true, std::memory_order_release);
+	}
+
+	/// Marks the fences the GPU has passed as signaled, without waiting for the others
+	static void PollPendingFences()
+	{
+		std::erase_if(s_PendingFences, [](const Ref<OpenGLFence::SyncState>& state)
+			{
+				const GLenum result = glClientWaitSync(static_cast<GLsync>(state->Sync), 0, 0);
+				if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+					return false;
+
+				RetireFence(*state);
+				return true;
+			});
+	}
+
+	OpenGLFence::OpenGLFence()
+		: m_State(CreateRef<SyncState>())
+	{
+		m_State->Signaled = true;
+		m_StatePool.push_back(m_State);
+	}
+
+	Ref<OpenGLFence::SyncState> OpenGLFence::AcquireState()
+	{
+		/// Only held by the pool, so neither the render thread nor m_State refers to it anymore
+		for (const Ref<SyncState>& state : m_StatePool)
+		{
+			if (state.use_count() == 1 && state->Signaled.load(std::memory_order_acquire))
+			{
+				state->Signaled.store(false, std::memory_order_relaxed);
+				return state;
+			}
+		}
+
+		m_StatePool.push_back(CreateRef<SyncState>());
+		return m_StatePool.back();
+	}
+
+	void OpenGLFence::Signal()
+	{
+		/// Not the current state, the render thread may still be polling it
+		m_State = AcquireState();
+
+		RenderThread::Submit([state = m_State]
+			{
+				state->Sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				s_PendingFences.push_back(state);
+
+				PollPendingFences();
+			});
+	}
+
+	bool OpenGLFence::IsSignaled()
+	{
+		if (m_State->Signaled.load(std::memory_order_acquire))
+			return true;
+
+		/// Checked again the next time the render thread executes the commands
+		RenderThread::Submit([]
+			{
+				PollPendingFences();
+			});
+
+		return false;
+	}
+
+	void OpenGLFence::Wait()
+	{
+		if (m_State->Signaled.load(std::memory_order_acquire))
+			return;
+
+		KBR_PROFILE_FUNCTION();
+
+		RenderThread::SubmitAndWait([state = m_State]
+			{
+				if (state->Signaled.load(std::memory_order_relaxed))
+					return;
+
+				glClientWaitSync(static_cast<GLsync>(state->Sync), GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+
+				/// Retired here, the other pending fences were signaled before this one
+				PollPendingFences();
+			});
+	}
+}
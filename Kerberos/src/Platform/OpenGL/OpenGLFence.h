@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Kerberos/Renderer/Fence.h"
+
+#include <atomic>
+
+namespace Kerberos
+{
+	/**
+	* Wraps a GL sync object. The sync object lives on the render thread, which polls it whenever it executes commands,
+	* so the main thread can check the fence without touching the context.
+	*/
+	class OpenGLFence final : public Fence
+	{
+	public:
+		OpenGLFence();
+		~OpenGLFence() override = default;
+
+		void Signal() override;
+		bool IsSignaled() override;
+		void Wait() override;
+
+		/// The state of one Signal, the render thread still holds it after the fence is signaled again or destroyed
+		struct SyncState
+		{
+			void* Sync = nullptr;
+			std::atomic<bool> Signaled = false;
+		};
+
+	private:
+		/// Reuses a state the render thread is done with, so signaling the fence every frame doesn't allocate
+		Ref<SyncState> AcquireState();
+
+	private:
+		Ref<SyncState> m_State;
+		/// Every state created by this fence, the render thread may still hold the ones not signaled yet
+		std::vector<Ref<SyncState>> m_StatePool;
+	};
+}
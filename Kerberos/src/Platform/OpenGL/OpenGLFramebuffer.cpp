@@ -1,6 +1,8 @@
 #include "kbrpch.h"
 #include "OpenGLFramebuffer.h"
 
+#include "Kerberos/Renderer/RenderThread.h"
+
 #include <glad/glad.h>
 
 namespace Kerberos
@@ -146,13 +148,22 @@ namespace Kerberos
 
 	OpenGLFramebuffer::~OpenGLFramebuffer() 
 	{
-		glDeleteFramebuffers(1, &m_RendererID);
-		glDeleteTextures(static_cast<int>(m_ColorAttachments.size()), m_ColorAttachments.data());
-		//glDeleteRenderbuffers(1, &m_DepthAttachment);
-		glDeleteTextures(1, &m_DepthAttachment);
+		RenderThread::Submit([rendererID = m_RendererID, colorAttachments = std::move(m_ColorAttachments), depthAttachment = m_DepthAttachment]
+			{
+				glDeleteFramebuffers(1, &rendererID);
+				glDeleteTextures(static_cast<int>(colorAttachments.size()), colorAttachments.data());
+				//glDeleteRenderbuffers(1, &m_DepthAttachment);
+				glDeleteTextures(1, &depthAttachment);
+			});
 	}
 
 	void OpenGLFramebuffer::Invalidate() 
+	{
+		/// The attachment IDs are read on the main thread, so they are recreated before returning
+		RenderThread::SubmitAndWait([this] { InvalidateAttachments(); });
+	}
+
+	void OpenGLFramebuffer::InvalidateAttachments() 
 	{
 		/// Check if the framebuffer is already created
 		if (m_RendererID)
@@ -277,13 +288,19 @@ namespace Kerberos
 
 	void OpenGLFramebuffer::Bind() 
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, static_cast<int>(m_Specification.Width), static_cast<int>(m_Specification.Height));
+		RenderThread::Submit([rendererID = m_RendererID, width = m_Specification.Width, height = m_Specification.Height]
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, rendererID);
+				glViewport(0, 0, static_cast<int>(width), static_cast<int>(height));
+			});
 	}
 
 	void OpenGLFramebuffer::Unbind() 
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		RenderThread::Submit([]
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			});
 	}
 
 	void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height) 
@@ -304,10 +321,13 @@ namespace Kerberos
 	{
 		KBR_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "attachmenIndex is out of bounds");
 
-		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
-
+		/// Waits for the commands rendering into the framebuffer
 		int pixelData;
-		glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
+		RenderThread::SubmitAndWait([attachmentIndex, x, y, &pixelData]
+			{
+				glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+				glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
+			});
 		return pixelData;
 	}
 
@@ -315,14 +335,20 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 		KBR_CORE_ASSERT(index < m_ColorAttachments.size(), "Index out of bounds!");
-		glBindTextureUnit(slot, m_ColorAttachments[index]);
+		RenderThread::Submit([slot, attachment = m_ColorAttachments[index]]
+			{
+				glBindTextureUnit(slot, attachment);
+			});
 	}
 
 	void OpenGLFramebuffer::BindDepthTexture(const uint32_t slot) const 
 	{
 		KBR_PROFILE_FUNCTION();
 		KBR_CORE_ASSERT(m_DepthAttachment != 0, "Depth attachment is not set!");
-		glBindTextureUnit(slot, m_DepthAttachment);
+		RenderThread::Submit([slot, attachment = m_DepthAttachment]
+			{
+				glBindTextureUnit(slot, attachment);
+			});
 	}
 
 	void OpenGLFramebuffer::ClearAttachment(const uint32_t attachmentIndex, const int value) 
@@ -331,14 +357,20 @@ namespace Kerberos
 
 		const auto& spec = m_ColorAttachmentSpecs[attachmentIndex];
 
-		glClearTexImage(m_ColorAttachments[attachmentIndex], 0, Utils::ToGLFormat(spec.TextureFormat), GL_INT, &value);
+		RenderThread::Submit([attachment = m_ColorAttachments[attachmentIndex], format = Utils::ToGLFormat(spec.TextureFormat), value]
+			{
+				glClearTexImage(attachment, 0, format, GL_INT, &value);
+			});
 	}
 
 	void OpenGLFramebuffer::ClearDepthAttachment(const float value) const 
 	{
 		KBR_CORE_ASSERT(m_DepthAttachment != 0, "Depth attachment is not set!");
 
-		glClearTexImage(m_DepthAttachment, 0, GL_DEPTH_COMPONENT, GL_FLOAT, &value);
+		RenderThread::Submit([attachment = m_DepthAttachment, value]
+			{
+				glClearTexImage(attachment, 0, GL_DEPTH_COMPONENT, GL_FLOAT, &value);
+			});
 		//glClearBufferfi(GL_DEPTH_STENCIL, 0, value, 0);
 		//glClearDepth(value);
 
@@ -349,20 +381,23 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		if (m_RendererID)
-		{
-			glObjectLabel(GL_FRAMEBUFFER, m_RendererID, -1, name.c_str());
-		}
-		for (size_t i = 0; i < m_ColorAttachments.size(); ++i)
-		{
-			const auto colorAttachment = m_ColorAttachments[i];
-			const std::string colorAttachmentName = name + " Color Attachment " + std::to_string(i);
-			glObjectLabel(GL_TEXTURE, colorAttachment, -1, colorAttachmentName.c_str());
-		}
-		if (m_DepthAttachment)
-		{
-			const std::string depthAttachmentName = name + " Depth Attachment";
-			glObjectLabel(GL_TEXTURE, m_DepthAttachment, -1, depthAttachmentName.c_str());
-		}
+		RenderThread::Submit([rendererID = m_RendererID, colorAttachments = m_ColorAttachments, depthAttachment = m_DepthAttachment, name]
+			{
+				if (rendererID)
+				{
+					glObjectLabel(GL_FRAMEBUFFER, rendererID, -1, name.c_str());
+				}
+				for (size_t i = 0; i < colorAttachments.size(); ++i)
+				{
+					const auto colorAttachment = colorAttachments[i];
+					const std::string colorAttachmentName = name + " Color Attachment " + std::to_string(i);
+					glObjectLabel(GL_TEXTURE, colorAttachment, -1, colorAttachmentName.c_str());
+				}
+				if (depthAttachment)
+				{
+					const std::string depthAttachmentName = name + " Depth Attachment";
+					glObjectLabel(GL_TEXTURE, depthAttachment, -1, depthAttachmentName.c_str());
+				}
+			});
 	}
 }
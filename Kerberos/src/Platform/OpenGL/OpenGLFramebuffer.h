@@ -44,6 +44,10 @@ namespace Kerberos
 
 		void SetDebugName(const std::string& name) const override;
 
+	private:
+		/// Recreates the framebuffer and its attachments, it must be called on the render thread
+		void InvalidateAttachments();
+
 	private:
 		RendererID m_RendererID = 0;
 
@@ -1,6 +1,8 @@
 #include "kbrpch.h"
 #include "OpenGLRendererAPI.h"
 
+#include "Kerberos/Renderer/RenderThread.h"
+
 #include <glad/glad.h>
 
 namespace Kerberos
@@ -57,59 +59,77 @@ namespace Kerberos
 
 	void OpenGLRendererAPI::Init() 
 	{
-	#ifdef KBR_DEBUG
-		glEnable(GL_DEBUG_OUTPUT);
-		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-		glDebugMessageCallback(OpenGLMessageCallback, nullptr);
+		RenderThread::Submit([]
+			{
+		#ifdef KBR_DEBUG
+				glEnable(GL_DEBUG_OUTPUT);
+				glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+				glDebugMessageCallback(OpenGLMessageCallback, nullptr);
 
-		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
-	#endif
+				glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+		#endif
 
 
-		//glEnable(GL_BLEND);
-		//glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				//glEnable(GL_BLEND);
+				//glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		glEnable(GL_DEPTH_TEST);
-		glDepthFunc(GL_LESS);
+				glEnable(GL_DEPTH_TEST);
+				glDepthFunc(GL_LESS);
 
-		/*glEnable(GL_POLYGON_OFFSET_FILL);
-		glPolygonOffset(1.0f, 1.0f);*/
-		//glEnable(GL_LINE_SMOOTH);
+				/*glEnable(GL_POLYGON_OFFSET_FILL);
+				glPolygonOffset(1.0f, 1.0f);*/
+				//glEnable(GL_LINE_SMOOTH);
 
-		glFrontFace(GL_CCW);
-		/*glEnable(GL_CULL_FACE);
-		glCullFace(GL_FRONT);*/
+				glFrontFace(GL_CCW);
+				/*glEnable(GL_CULL_FACE);
+				glCullFace(GL_FRONT);*/
 
-		/*glEnable(GL_FRAMEBUFFER_SRGB);*/
+				/*glEnable(GL_FRAMEBUFFER_SRGB);*/
+			});
 	}
 
 	void OpenGLRendererAPI::SetViewport(const uint32_t x, const uint32_t y, const uint32_t width,
 		const uint32_t height) 
 	{
-		glViewport(static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height));
+		RenderThread::Submit([x, y, width, height]
+			{
+				glViewport(static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height));
+			});
 	}
 
 	void OpenGLRendererAPI::SetClearColor(const glm::vec4& color) 
 	{
-		glClearColor(color.r, color.g, color.b, color.a);
+		RenderThread::Submit([color]
+			{
+				glClearColor(color.r, color.g, color.b, color.a);
+			});
 	}
 
 	void OpenGLRendererAPI::Clear()
 	{
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		RenderThread::Submit([]
+			{
+				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			});
 	}
 
 	void OpenGLRendererAPI::ClearDepth() 
 	{
-		glClear(GL_DEPTH_BUFFER_BIT);
+		RenderThread::Submit([]
+			{
+				glClear(GL_DEPTH_BUFFER_BIT);
+			});
 	}
 
 	void OpenGLRendererAPI::SetDepthTest(const bool enabled) 
 	{
-		if (enabled)
-			glEnable(GL_DEPTH_TEST);
-		else
-			glDisable(GL_DEPTH_TEST);
+		RenderThread::Submit([enabled]
+			{
+				if (enabled)
+					glEnable(GL_DEPTH_TEST);
+				else
+					glDisable(GL_DEPTH_TEST);
+			});
 	}
 
 	void OpenGLRendererAPI::SetDepthFunc(const DepthFunc func)
@@ -128,7 +148,10 @@ namespace Kerberos
 		default:                       KBR_CORE_ASSERT(false, "Unknown depth function!"); break;
 		}
 
-		glDepthFunc(glFunc);
+		RenderThread::Submit([glFunc]
+			{
+				glDepthFunc(glFunc);
+			});
 	}
 
 	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, const uint32_t indexCount)
@@ -136,13 +159,30 @@ namespace Kerberos
 		vertexArray->Bind();
 
 		const uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_TRIANGLES, static_cast<int>(count), GL_UNSIGNED_INT, nullptr);
+		RenderThread::Submit([count]
+			{
+				glDrawElements(GL_TRIANGLES, static_cast<int>(count), GL_UNSIGNED_INT, nullptr);
+			});
+	}
+
+	void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, const uint32_t indexCount, const uint32_t instanceCount, const uint32_t baseInstance)
+	{
+		vertexArray->Bind();
+
+		const uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		RenderThread::Submit([count, instanceCount, baseInstance]
+			{
+				glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<int>(count), GL_UNSIGNED_INT, nullptr, static_cast<int>(instanceCount), baseInstance);
+			});
 	}
 
 	void OpenGLRendererAPI::DrawArray(const Ref<VertexArray>& vertexArray, const uint32_t vertexCount)
 	{
 		vertexArray->Bind();
 
-		glDrawArrays(GL_TRIANGLES, 0, static_cast<int>(vertexCount));
+		RenderThread::Submit([vertexCount]
+			{
+				glDrawArrays(GL_TRIANGLES, 0, static_cast<int>(vertexCount));
+			});
 	}
 }
@@ -2,6 +2,7 @@
 #include "OpenGLShader.h"
 
 #include "Kerberos/Core.h"
+#include "Kerberos/Renderer/RenderThread.h"
 
 #include <fstream>
 #include <filesystem>
@@ -122,7 +123,7 @@ namespace Kerberos
 
 			CompileOrGetVulkanBinaries(shaderSources);
 			CompileOrGetOpenGLBinaries();
-			CreateProgram();
+			RenderThread::SubmitAndWait([this] { CreateProgram(); });
 		}
 
 		const std::filesystem::path path = filepath;
@@ -140,66 +141,113 @@ namespace Kerberos
 
 		CompileOrGetVulkanBinaries(sources);
 		CompileOrGetOpenGLBinaries();
-		CreateProgram();
+		RenderThread::SubmitAndWait([this] { CreateProgram(); });
 		//Compile(sources);
 	}
 
 	OpenGLShader::~OpenGLShader()
 	{
-		glDeleteProgram(m_RendererID);
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				glDeleteProgram(rendererID);
+			});
 	}
 
 	void OpenGLShader::Bind() const
 	{
-		glUseProgram(m_RendererID);
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				glUseProgram(rendererID);
+			});
 	}
 
 	void OpenGLShader::Unbind() const
 	{
-		glUseProgram(0);
+		RenderThread::Submit([]
+			{
+				glUseProgram(0);
+			});
 	}
 
 	void OpenGLShader::SetInt(const std::string& name, const int value)
 	{
-		UploadUniformInt(name, value);
+		UploadUniformInt(GetUniformLocation(name), value);
 	}
 
 	void OpenGLShader::SetIntArray(const std::string& name, int* values, const uint32_t count)
 	{
-		UploadUniformIntArray(name, values, count);
+		UploadUniformIntArray(GetUniformLocation(name), values, count);
 	}
 
 	void OpenGLShader::SetFloat(const std::string& name, const float value)
 	{
-		UploadUniformFloat(name, value);
+		UploadUniformFloat(GetUniformLocation(name), value);
 	}
 
 	void OpenGLShader::SetFloat3(const std::string& name, const glm::vec3& value)
 	{
-		UploadUniformFloat3(name, value);
+		UploadUniformFloat3(GetUniformLocation(name), value);
 	}
 
 	void OpenGLShader::SetFloat4(const std::string& name, const glm::vec4& value)
 	{
-		UploadUniformFloat4(name, value);
+		UploadUniformFloat4(GetUniformLocation(name), value);
 	}
 
 	void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value)
 	{
-		UploadUniformMat4(name, value);
+		UploadUniformMat4(GetUniformLocation(name), value);
+	}
+
+	ShaderUniform OpenGLShader::GetUniform(const std::string& name) const
+	{
+		return { GetUniformLocation(name) };
+	}
+
+	void OpenGLShader::SetInt(const ShaderUniform uniform, const int value)
+	{
+		UploadUniformInt(uniform.Location, value);
+	}
+
+	void OpenGLShader::SetIntArray(const ShaderUniform uniform, const int* values, const uint32_t count)
+	{
+		UploadUniformIntArray(uniform.Location, values, count);
+	}
+
+	void OpenGLShader::SetFloat(const ShaderUniform uniform, const float value)
+	{
+		UploadUniformFloat(uniform.Location, value);
+	}
+
+	void OpenGLShader::SetFloat3(const ShaderUniform uniform, const glm::vec3& value)
+	{
+		UploadUniformFloat3(uniform.Location, value);
+	}
+
+	void OpenGLShader::SetFloat4(const ShaderUniform uniform, const glm::vec4& value)
+	{
+		UploadUniformFloat4(uniform.Location, value);
+	}
+
+	void OpenGLShader::SetMat4(const ShaderUniform uniform, const glm::mat4& value)
+	{
+		UploadUniformMat4(uniform.Location, value);
 	}
 
 	void OpenGLShader::SetMaterial(const std::string& name, const Ref<Material>& material)
 	{
-		UploadUniformFloat3(name + ".ambient", material->Ambient);
-		UploadUniformFloat3(name + ".diffuse", material->Diffuse);
-		UploadUniformFloat3(name + ".specular", material->Specular);
-		UploadUniformFloat(name + ".shininess", material->Shininess);
+		UploadUniformFloat3(GetUniformLocation(name + ".ambient"), material->Ambient);
+		UploadUniformFloat3(GetUniformLocation(name + ".diffuse"), material->Diffuse);
+		UploadUniformFloat3(GetUniformLocation(name + ".specular"), material->Specular);
+		UploadUniformFloat(GetUniformLocation(name + ".shininess"), material->Shininess);
 	}
 
 	void OpenGLShader::SetDebugName(const std::string& name) const 
 	{
-		glObjectLabel(GL_PROGRAM, m_RendererID, -1, (name + "Shader Program").c_str());
+		RenderThread::Submit([rendererID = m_RendererID, label = name + "Shader Program"]
+			{
+				glObjectLabel(GL_PROGRAM, rendererID, -1, label.c_str());
+			});
 		/// The shaders are deleted after the program is created, so we can't label them.
 		//for (const auto& [stage, shaderId] : m_OpenGLShaderIDs)
 		//{
@@ -215,52 +263,77 @@ namespace Kerberos
 
 	}
 
-	void OpenGLShader::UploadUniformInt(const std::string& name, const int value) const
+	GLint OpenGLShader::GetUniformLocation(const std::string& name) const
+	{
+		const auto it = m_UniformLocations.find(name);
+		return it != m_UniformLocations.end() ? it->second : -1;
+	}
+
+	/// Setting the location -1 is ignored by OpenGL, so the uniforms the shader doesn't have are not checked for
+
+	void OpenGLShader::UploadUniformInt(const GLint location, const int value)
 	{
-		const GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1i(location, value);
+		RenderThread::Submit([location, value]
+			{
+				glUniform1i(location, value);
+			});
 	}
 
-	void OpenGLShader::UploadUniformIntArray(const std::string& name, const int* values, const uint32_t count) const
+	void OpenGLShader::UploadUniformIntArray(const GLint location, const int* values, const uint32_t count)
 	{
-		const GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1iv(location, static_cast<int>(count), values);
+		const int* commandValues = static_cast<const int*>(RenderThread::CopyCommandData(values, count * sizeof(int)));
+		RenderThread::Submit([location, commandValues, count]
+			{
+				glUniform1iv(location, static_cast<int>(count), commandValues);
+			});
 	}
 
-	void OpenGLShader::UploadUniformFloat(const std::string& name, const float value) const
+	void OpenGLShader::UploadUniformFloat(const GLint location, const float value)
 	{
-		const GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1f(location, value);
+		RenderThread::Submit([location, value]
+			{
+				glUniform1f(location, value);
+			});
 	}
 
-	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& vector) const
+	void OpenGLShader::UploadUniformFloat2(const GLint location, const glm::vec2& vector)
 	{
-		const GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform2f(location, vector.x, vector.y);
+		RenderThread::Submit([location, vector]
+			{
+				glUniform2f(location, vector.x, vector.y);
+			});
 	}
 
-	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& vector) const
+	void OpenGLShader::UploadUniformFloat3(const GLint location, const glm::vec3& vector)
 	{
-		const GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform3f(location, vector.x, vector.y, vector.z);
+		RenderThread::Submit([location, vector]
+			{
+				glUniform3f(location, vector.x, vector.y, vector.z);
+			});
 	}
 
-	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& vector) const
+	void OpenGLShader::UploadUniformFloat4(const GLint location, const glm::vec4& vector)
 	{
-		const GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform4f(location, vector.x, vector.y, vector.z, vector.w);
+		RenderThread::Submit([location, vector]
+			{
+				glUniform4f(location, vector.x, vector.y, vector.z, vector.w);
+			});
 	}
 
-	void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix) const
+	void OpenGLShader::UploadUniformMat3(const GLint location, const glm::mat3& matrix)
 	{
-		const GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		RenderThread::Submit([location, matrix]
+			{
+				glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+			});
 	}
 
-	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix) const
+	void OpenGLShader::UploadUniformMat4(const GLint location, const glm::mat4& matrix)
 	{
-		const GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		RenderThread::Submit([location, matrix]
+			{
+				glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+			});
 	}
 
 	std::string OpenGLShader::ReadFile(const std::string& filepath)
@@ -387,6 +460,8 @@ namespace Kerberos
 
 		// Assign the programId to the class member only when compilation succeeded
 		m_RendererID = program;
+
+		CacheUniformLocations(program);
 	}
 
 	void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources) 
@@ -705,6 +780,45 @@ namespace Kerberos
 		}
 
 		m_RendererID = program;
+
+		CacheUniformLocations(program);
+	}
+
+	void OpenGLShader::CacheUniformLocations(const GLuint program)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		m_UniformLocations.clear();
+
+		GLint uniformCount = 0;
+		GLint maxNameLength = 0;
+		glGetProgramInterfaceiv(program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformCount);
+		glGetProgramInterfaceiv(program, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength);
+
+		std::vector<GLchar> nameBuffer(std::max(maxNameLength, 1));
+		for (GLint i = 0; i < uniformCount; ++i)
+		{
+			constexpr GLenum locationProperty = GL_LOCATION;
+			GLint location = -1;
+			glGetProgramResourceiv(program, GL_UNIFORM, static_cast<GLuint>(i), 1, &locationProperty, 1, nullptr, &location);
+
+			/// The members of uniform blocks have no location, they are set through the uniform buffers
+			if (location < 0)
+				continue;
+
+			GLsizei nameLength = 0;
+			glGetProgramResourceName(program, GL_UNIFORM, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()), &nameLength, nameBuffer.data());
+
+			std::string name(nameBuffer.data(), nameLength);
+
+			/// Arrays are listed by their first element, but they are set by the name of the array
+			if (name.ends_with("[0]"))
+				m_UniformLocations[name.substr(0, name.size() - 3)] = location;
+
+			m_UniformLocations[std::move(name)] = location;
+		}
+
+		KBR_CORE_TRACE("  Cached the locations of {0} uniforms", m_UniformLocations.size());
 	}
 
 	void OpenGLShader::Reflect(const GLenum stage, const std::vector<uint32_t>& shaderData) 
@@ -28,6 +28,15 @@ namespace Kerberos
 		void SetFloat4(const std::string& name, const glm::vec4& value) override;
 		void SetMat4(const std::string& name, const glm::mat4& value) override;
 
+		ShaderUniform GetUniform(const std::string& name) const override;
+
+		void SetInt(ShaderUniform uniform, int value) override;
+		void SetIntArray(ShaderUniform uniform, const int* values, uint32_t count) override;
+		void SetFloat(ShaderUniform uniform, float value) override;
+		void SetFloat3(ShaderUniform uniform, const glm::vec3& value) override;
+		void SetFloat4(ShaderUniform uniform, const glm::vec4& value) override;
+		void SetMat4(ShaderUniform uniform, const glm::mat4& value) override;
+
 		void SetMaterial(const std::string& name, const Ref<Material>& material) override;
 
 		void SetDebugName(const std::string& name) const override;
@@ -41,17 +50,22 @@ namespace Kerberos
 		void CompileOrGetOpenGLBinaries();
 		void CreateProgram();
 		void Reflect(GLenum stage, const std::vector<uint32_t>& shaderData);
+		/// Queries the locations of the active uniforms of the linked program, called on the render thread
+		void CacheUniformLocations(GLuint program);
 
-		void UploadUniformInt(const std::string& name, int value) const;
-		void UploadUniformIntArray(const std::string& name, const int* values, uint32_t count) const;
+		/// -1 if the program has no active uniform with the name
+		GLint GetUniformLocation(const std::string& name) const;
 
-		void UploadUniformFloat(const std::string& name, float value) const;
-		void UploadUniformFloat2(const std::string& name, const glm::vec2& vector) const;
-		void UploadUniformFloat3(const std::string& name, const glm::vec3& vector) const;
-		void UploadUniformFloat4(const std::string& name, const glm::vec4& vector) const;
+		static void UploadUniformInt(GLint location, int value);
+		static void UploadUniformIntArray(GLint location, const int* values, uint32_t count);
 
-		void UploadUniformMat3(const std::string& name, const glm::mat3& matrix) const;
-		void UploadUniformMat4(const std::string& name, const glm::mat4& matrix) const;
+		static void UploadUniformFloat(GLint location, float value);
+		static void UploadUniformFloat2(GLint location, const glm::vec2& vector);
+		static void UploadUniformFloat3(GLint location, const glm::vec3& vector);
+		static void UploadUniformFloat4(GLint location, const glm::vec4& vector);
+
+		static void UploadUniformMat3(GLint location, const glm::mat3& matrix);
+		static void UploadUniformMat4(GLint location, const glm::mat4& matrix);
 
 	private:
 		uint32_t m_RendererID;
@@ -63,5 +77,8 @@ namespace Kerberos
 		std::unordered_map<GLenum, uint32_t> m_OpenGLShaderIDs;
 
 		std::unordered_map<GLenum, std::string> m_OpenGLSourceCode;
+
+		/// Filled once the program is linked, and only read afterwards
+		std::unordered_map<std::string, GLint> m_UniformLocations;
 	};
 }
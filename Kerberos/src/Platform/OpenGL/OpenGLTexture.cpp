@@ -1,6 +1,8 @@
 #include "kbrpch.h"
 #include "OpenGLTexture.h"
 
+#include "Kerberos/Renderer/RenderThread.h"
+
 #include "stb_image.h"
 #include "TextureUtils.h"
 
@@ -13,7 +15,7 @@ namespace Kerberos
 
 		int width, height, channels;
 
-		stbi_set_flip_vertically_on_load(true);
+		stbi_set_flip_vertically_on_load_thread(true);
 
 		stbi_uc* data = nullptr;
 		{
@@ -47,23 +49,26 @@ namespace Kerberos
 		m_InternalFormat = internalFormat;
 		m_DataFormat = dataFormat;
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, internalFormat, static_cast<int>(m_Spec.Width), static_cast<int>(m_Spec.Height));
-
-		/// Set the texture wrapping/filtering options (on the currently bound texture object)
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		/// Upload the texture data to the GPU
-		glTextureSubImage2D(m_RendererID, 
-			0, 
-			0, 
-			0, 
-			static_cast<int>(m_Spec.Width), 
-			static_cast<int>(m_Spec.Height), 
-			dataFormat, 
-			GL_UNSIGNED_BYTE, 
-			data);
+		RenderThread::SubmitAndWait([this, internalFormat, dataFormat, data]
+			{
+				glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+				glTextureStorage2D(m_RendererID, 1, internalFormat, static_cast<int>(m_Spec.Width), static_cast<int>(m_Spec.Height));
+
+				/// Set the texture wrapping/filtering options (on the currently bound texture object)
+				glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+				/// Upload the texture data to the GPU
+				glTextureSubImage2D(m_RendererID, 
+					0, 
+					0, 
+					0, 
+					static_cast<int>(m_Spec.Width), 
+					static_cast<int>(m_Spec.Height), 
+					dataFormat, 
+					GL_UNSIGNED_BYTE, 
+					data);
+			});
 
 		stbi_image_free(data);
 	}
@@ -78,16 +83,19 @@ namespace Kerberos
 		/// Data format is the format of the texture data we provide to OpenGL
 		const GLenum dataFormat = TextureUtils::KBRImageFormatToGLDataFormat(spec.Format);
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, internalFormat, static_cast<int>(m_Spec.Width), static_cast<int>(m_Spec.Height));
+		RenderThread::SubmitAndWait([this, internalFormat]
+			{
+				glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+				glTextureStorage2D(m_RendererID, 1, internalFormat, static_cast<int>(m_Spec.Width), static_cast<int>(m_Spec.Height));
+
+				/// Set the texture wrapping/filtering options (on the currently bound texture object)
+				glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			});
 
 		m_InternalFormat = internalFormat;
 		m_DataFormat = dataFormat;
 
-		/// Set the texture wrapping/filtering options (on the currently bound texture object)
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
 		if (data)
 		{
 			/// Upload the texture data to the GPU
@@ -99,14 +107,20 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glDeleteTextures(1, &m_RendererID);
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				glDeleteTextures(1, &rendererID);
+			});
 	}
 
 	void OpenGLTexture2D::Bind(const uint32_t slot) const 
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glBindTextureUnit(slot, m_RendererID);
+		RenderThread::Submit([slot, rendererID = m_RendererID]
+			{
+				glBindTextureUnit(slot, rendererID);
+			});
 	}
 
 	void OpenGLTexture2D::SetData(void* data, const uint32_t size) 
@@ -116,7 +130,11 @@ namespace Kerberos
 		const uint32_t bytesPerPixel = TextureUtils::BytesPerPixel(m_Spec.Format);
 		KBR_CORE_ASSERT(size == m_Spec.Width * m_Spec.Height * bytesPerPixel, "Data must be the entire texture!");
 
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, static_cast<int>(m_Spec.Width), static_cast<int>(m_Spec.Height), m_DataFormat, GL_UNSIGNED_BYTE, data);
+		const void* commandData = RenderThread::CopyCommandData(data, size);
+		RenderThread::Submit([rendererID = m_RendererID, width = m_Spec.Width, height = m_Spec.Height, dataFormat = m_DataFormat, commandData]
+			{
+				glTextureSubImage2D(rendererID, 0, 0, 0, static_cast<int>(width), static_cast<int>(height), dataFormat, GL_UNSIGNED_BYTE, commandData);
+			});
 	}
 
 	void OpenGLTexture2D::SetDebugName(const std::string& name) const {
@@ -124,7 +142,92 @@ namespace Kerberos
 
 		if (m_RendererID)
 		{
-			glObjectLabel(GL_TEXTURE, m_RendererID, -1, name.c_str());
+			RenderThread::Submit([rendererID = m_RendererID, name]
+				{
+					glObjectLabel(GL_TEXTURE, rendererID, -1, name.c_str());
+				});
+		}
+	}
+
+	OpenGLTexture2DArray::OpenGLTexture2DArray(const TextureSpecification& spec, const uint32_t layerCount)
+		: m_Spec(spec), m_LayerCount(layerCount)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		const GLenum internalFormat = TextureUtils::KBRImageFormatToGLInternalFormat(spec.Format);
+		m_DataFormat = TextureUtils::KBRImageFormatToGLDataFormat(spec.Format);
+
+		RenderThread::SubmitAndWait([this, internalFormat]
+			{
+				glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_RendererID);
+				glTextureStorage3D(m_RendererID, 1, internalFormat, static_cast<int>(m_Spec.Width), static_cast<int>(m_Spec.Height), static_cast<int>(m_LayerCount));
+
+				glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			});
+	}
+
+	OpenGLTexture2DArray::~OpenGLTexture2DArray()
+	{
+		KBR_PROFILE_FUNCTION();
+
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				glDeleteTextures(1, &rendererID);
+			});
+	}
+
+	void OpenGLTexture2DArray::Bind(const uint32_t slot) const
+	{
+		KBR_PROFILE_FUNCTION();
+
+		RenderThread::Submit([slot, rendererID = m_RendererID]
+			{
+				glBindTextureUnit(slot, rendererID);
+			});
+	}
+
+	void OpenGLTexture2DArray::SetData(void* data, const uint32_t size)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		const uint32_t bytesPerPixel = TextureUtils::BytesPerPixel(m_Spec.Format);
+		KBR_CORE_ASSERT(size == m_Spec.Width * m_Spec.Height * bytesPerPixel * m_LayerCount, "Data must be the entire texture array!");
+
+		const void* commandData = RenderThread::CopyCommandData(data, size);
+		RenderThread::Submit([rendererID = m_RendererID, width = m_Spec.Width, height = m_Spec.Height, layerCount = m_LayerCount, dataFormat = m_DataFormat, commandData]
+			{
+				glTextureSubImage3D(rendererID, 0, 0, 0, 0, static_cast<int>(width), static_cast<int>(height), static_cast<int>(layerCount), dataFormat, GL_UNSIGNED_BYTE, commandData);
+			});
+	}
+
+	void OpenGLTexture2DArray::SetLayerData(const uint32_t layer, const void* data, const uint32_t size)
+	{
+		KBR_PROFILE_FUNCTION();
+
+		const uint32_t bytesPerPixel = TextureUtils::BytesPerPixel(m_Spec.Format);
+		KBR_CORE_ASSERT(layer < m_LayerCount, "Layer index out of range!");
+		KBR_CORE_ASSERT(size == m_Spec.Width * m_Spec.Height * bytesPerPixel, "Data must be the entire layer!");
+
+		const void* commandData = RenderThread::CopyCommandData(data, size);
+		RenderThread::Submit([rendererID = m_RendererID, layer, width = m_Spec.Width, height = m_Spec.Height, dataFormat = m_DataFormat, commandData]
+			{
+				glTextureSubImage3D(rendererID, 0, 0, 0, static_cast<int>(layer), static_cast<int>(width), static_cast<int>(height), 1, dataFormat, GL_UNSIGNED_BYTE, commandData);
+			});
+	}
+
+	void OpenGLTexture2DArray::SetDebugName(const std::string& name) const
+	{
+		KBR_PROFILE_FUNCTION();
+
+		if (m_RendererID)
+		{
+			RenderThread::Submit([rendererID = m_RendererID, name]
+				{
+					glObjectLabel(GL_TEXTURE, rendererID, -1, name.c_str());
+				});
 		}
 	}
 }
@@ -37,4 +37,38 @@ namespace Kerberos
 		GLenum m_InternalFormat;
 		GLenum m_DataFormat;
 	};
+
+	class OpenGLTexture2DArray : public Texture2DArray
+	{
+	public:
+		OpenGLTexture2DArray(const TextureSpecification& spec, uint32_t layerCount);
+		~OpenGLTexture2DArray() override;
+
+		uint32_t GetWidth() const override { return m_Spec.Width; }
+		uint32_t GetHeight() const override { return m_Spec.Height; }
+		const TextureSpecification& GetSpecification() const override { return m_Spec; }
+		uint32_t GetLayerCount() const override { return m_LayerCount; }
+
+		uint64_t GetRendererID() const override { return m_RendererID; }
+
+		void Bind(uint32_t slot = 0) const override;
+
+		/// Uploads every layer
+		void SetData(void* data, uint32_t size) override;
+		void SetLayerData(uint32_t layer, const void* data, uint32_t size) override;
+
+		bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == other.GetRendererID();
+		}
+
+		void SetDebugName(const std::string& name) const override;
+
+	private:
+		TextureSpecification m_Spec;
+		uint32_t m_LayerCount;
+		uint32_t m_RendererID = 0;
+
+		GLenum m_DataFormat;
+	};
 }
@@ -1,6 +1,8 @@
 #include "kbrpch.h"
 #include "OpenGLTextureCube.h"
 
+#include "Kerberos/Renderer/RenderThread.h"
+
 #include <stb_image.h>
 
 #include "TextureUtils.h"
@@ -41,68 +43,77 @@ namespace Kerberos
 	{
 		KBR_CORE_ASSERT(faces.size() == 6, "OpenGLTextureCube must have 6 faces.");
 
-        glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+        RenderThread::SubmitAndWait([this, &faces]
+            {
+                glGenTextures(1, &m_RendererID);
+                glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
 
-        int width, height, nrChannels;
-        for (unsigned int i = 0; i < faces.size(); i++)
-        {
-            stbi_uc* data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
+                int width, height, nrChannels;
+                for (unsigned int i = 0; i < faces.size(); i++)
+                {
+                    stbi_uc* data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
 
-            const auto [InternalFormat, DataFormat] = Utils::GetFormats(nrChannels, m_SRGB);
+                    const auto [InternalFormat, DataFormat] = Utils::GetFormats(nrChannels, m_SRGB);
 
-            if (data)
-            {
-                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, InternalFormat, width, height, 0, DataFormat, GL_UNSIGNED_BYTE, data);
+                    if (data)
+                    {
+                        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, InternalFormat, width, height, 0, DataFormat, GL_UNSIGNED_BYTE, data);
 
-                stbi_image_free(data);
-            }
-            else
-            {
-				KBR_ASSERT(false, "Failed to load texture at path: {0}", faces[i]);
-                stbi_image_free(data);
-            }
-        }
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+                        stbi_image_free(data);
+                    }
+                    else
+                    {
+                        KBR_ASSERT(false, "Failed to load texture at path: {0}", faces[i]);
+                        stbi_image_free(data);
+                    }
+                }
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            });
 	}
 
 	OpenGLTextureCube::OpenGLTextureCube(const CubemapData& data) 
     {
-        glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+        RenderThread::SubmitAndWait([this, &data]
+            {
+                glGenTextures(1, &m_RendererID);
+                glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
 
-        for (size_t i = 0; i < data.Faces.size(); i++)
-        {
-            const auto& [Specification, Buffer] = data.Faces[i];
-            /// Internal format is how OpenGL will store the texture data internally (in the GPU)
-            const GLenum internalFormat = TextureUtils::KBRImageFormatToGLInternalFormat(Specification.Format);
-            /// Data format is the format of the texture data we provide to OpenGL
-            const GLenum dataFormat = TextureUtils::KBRImageFormatToGLDataFormat(Specification.Format);
+                for (size_t i = 0; i < data.Faces.size(); i++)
+                {
+                    const auto& [Specification, Buffer] = data.Faces[i];
+                    /// Internal format is how OpenGL will store the texture data internally (in the GPU)
+                    const GLenum internalFormat = TextureUtils::KBRImageFormatToGLInternalFormat(Specification.Format);
+                    /// Data format is the format of the texture data we provide to OpenGL
+                    const GLenum dataFormat = TextureUtils::KBRImageFormatToGLDataFormat(Specification.Format);
 
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, static_cast<int>(internalFormat),
-                static_cast<int>(Specification.Width), static_cast<int>(Specification.Height),
-                0, dataFormat, GL_UNSIGNED_BYTE, Buffer.Data);
+                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, static_cast<int>(internalFormat),
+                        static_cast<int>(Specification.Width), static_cast<int>(Specification.Height),
+                        0, dataFormat, GL_UNSIGNED_BYTE, Buffer.Data);
 
 
-            m_FacesSpecifications[i] = Specification;
-        }
+                    m_FacesSpecifications[i] = Specification;
+                }
 
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            });
     }
 
 	OpenGLTextureCube::~OpenGLTextureCube() 
     {
         KBR_PROFILE_FUNCTION();
 
-        glDeleteTextures(1, &m_RendererID);
+        RenderThread::Submit([rendererID = m_RendererID]
+            {
+                glDeleteTextures(1, &rendererID);
+            });
     }
 
 	void OpenGLTextureCube::Bind(const uint32_t slot) const 
@@ -110,8 +121,11 @@ namespace Kerberos
 		KBR_PROFILE_FUNCTION();
 
         KBR_ASSERT(slot < 32, "OpenGLTextureCube slot must be less than 32.");
-        glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+        RenderThread::Submit([slot, rendererID = m_RendererID]
+            {
+                glActiveTexture(GL_TEXTURE0 + slot);
+                glBindTexture(GL_TEXTURE_CUBE_MAP, rendererID);
+            });
     }
 
 	uint32_t OpenGLTextureCube::GetWidth() const 
@@ -132,6 +146,9 @@ namespace Kerberos
     }
 
 	void OpenGLTextureCube::SetDebugName(const std::string& name) const {
-		glObjectLabel(GL_TEXTURE, m_RendererID, -1, name.c_str());
+        RenderThread::Submit([rendererID = m_RendererID, name]
+            {
+                glObjectLabel(GL_TEXTURE, rendererID, -1, name.c_str());
+            });
     }
 }
@@ -2,6 +2,8 @@
 
 #include "OpenGLVertexArray.h"
 
+#include "Kerberos/Renderer/RenderThread.h"
+
 #include <glad/glad.h>
 
 namespace Kerberos
@@ -31,28 +33,40 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glCreateVertexArrays(1, &m_RendererID);
+		RenderThread::SubmitAndWait([this]
+			{
+				glCreateVertexArrays(1, &m_RendererID);
+			});
 	}
 
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glDeleteVertexArrays(1, &m_RendererID);
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				glDeleteVertexArrays(1, &rendererID);
+			});
 	}
 
 	void OpenGLVertexArray::Bind() const
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		RenderThread::Submit([rendererID = m_RendererID]
+			{
+				glBindVertexArray(rendererID);
+			});
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
 		KBR_PROFILE_FUNCTION();
 
-		glBindVertexArray(0);
+		RenderThread::Submit([]
+			{
+				glBindVertexArray(0);
+			});
 	}
 
 	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
@@ -61,24 +75,83 @@ namespace Kerberos
 
 		KBR_CORE_ASSERT(!vertexBuffer->GetLayout().GetElements().empty(), "Vertex Buffer has no layout!");
 
-		glBindVertexArray(m_RendererID);
+		Bind();
 		vertexBuffer->Bind();
 
-		uint32_t index = 0;
-		const auto& layout = vertexBuffer->GetLayout();
+		/// The attributes are set up on the render thread, so the layout is copied
+		const BufferLayout layout = vertexBuffer->GetLayout();
+		const uint32_t firstAttribute = m_VertexBufferIndex;
+
 		for (const auto& element : layout)
 		{
-			glEnableVertexAttribArray(index);
-			glVertexAttribPointer(index,
-				static_cast<int>(element.GetComponentCount()),
-				ShaderDataTypeToOpenGLBaseType(element.Type),
-				element.Normalized ? GL_TRUE : GL_FALSE,
-				static_cast<int>(layout.GetStride()),
-				reinterpret_cast<const void*>(element.Offset));
-
-			index++;
+			/// Matrices take one attribute per column
+			if (element.Type == ShaderDataType::Mat3)
+				m_VertexBufferIndex += 3;
+			else if (element.Type == ShaderDataType::Mat4)
+				m_VertexBufferIndex += 4;
+			else
+				m_VertexBufferIndex++;
 		}
 
+		RenderThread::Submit([layout, attributeIndex = firstAttribute]() mutable
+			{
+				const GLuint divisor = layout.GetInputRate() == VertexInputRate::Instance ? 1 : 0;
+				const auto stride = static_cast<int>(layout.GetStride());
+
+				for (const auto& element : layout)
+				{
+					switch (element.Type)
+					{
+					case ShaderDataType::Int:
+					case ShaderDataType::Int2:
+					case ShaderDataType::Int3:
+					case ShaderDataType::Int4:
+					{
+						glEnableVertexAttribArray(attributeIndex);
+						glVertexAttribIPointer(attributeIndex,
+							static_cast<int>(element.GetComponentCount()),
+							ShaderDataTypeToOpenGLBaseType(element.Type),
+							stride,
+							reinterpret_cast<const void*>(static_cast<uintptr_t>(element.Offset)));
+						glVertexAttribDivisor(attributeIndex, divisor);
+						attributeIndex++;
+						break;
+					}
+					case ShaderDataType::Mat3:
+					case ShaderDataType::Mat4:
+					{
+						const uint32_t columnCount = element.Type == ShaderDataType::Mat3 ? 3 : 4;
+						for (uint32_t column = 0; column < columnCount; column++)
+						{
+							glEnableVertexAttribArray(attributeIndex);
+							glVertexAttribPointer(attributeIndex,
+								static_cast<int>(columnCount),
+								ShaderDataTypeToOpenGLBaseType(element.Type),
+								element.Normalized ? GL_TRUE : GL_FALSE,
+								stride,
+								reinterpret_cast<const void*>(static_cast<uintptr_t>(element.Offset) + sizeof(float) * columnCount * column));
+							glVertexAttribDivisor(attributeIndex, divisor);
+							attributeIndex++;
+						}
+						break;
+					}
+					default:
+					{
+						glEnableVertexAttribArray(attributeIndex);
+						glVertexAttribPointer(attributeIndex,
+							static_cast<int>(element.GetComponentCount()),
+							ShaderDataTypeToOpenGLBaseType(element.Type),
+							element.Normalized ? GL_TRUE : GL_FALSE,
+							stride,
+							reinterpret_cast<const void*>(static_cast<uintptr_t>(element.Offset)));
+						glVertexAttribDivisor(attributeIndex, divisor);
+						attributeIndex++;
+						break;
+					}
+					}
+				}
+			});
+
 		m_VertexBuffers.push_back(vertexBuffer);
 	}
 
@@ -86,13 +159,16 @@ namespace Kerberos
 	{
 		KBR_PROFILE_FUNCTION();
 		
-		glBindVertexArray(m_RendererID);
+		Bind();
 		indexBuffer->Bind();
 		m_IndexBuffer = indexBuffer;
 	}
 
 	void OpenGLVertexArray::SetDebugName(const std::string& name) 
 	{
-		glObjectLabel(GL_VERTEX_ARRAY, m_RendererID, static_cast<GLsizei>(name.size()), name.c_str());
+		RenderThread::Submit([rendererID = m_RendererID, name]
+			{
+				glObjectLabel(GL_VERTEX_ARRAY, rendererID, static_cast<GLsizei>(name.size()), name.c_str());
+			});
 	}
 }
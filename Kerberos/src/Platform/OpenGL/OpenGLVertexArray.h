@@ -23,6 +23,8 @@ namespace Kerberos
 
 	private:
 		uint32_t m_RendererID;
+		/// The next free attribute index, so multiple vertex buffers don't overlap
+		uint32_t m_VertexBufferIndex = 0;
 		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
 		Ref<IndexBuffer> m_IndexBuffer;
 	};
@@ -4,6 +4,7 @@
 #include "Kerberos/Core.h"
 
 #include <cstring>
+#include <ranges>
 #include <backends/imgui_impl_vulkan.h>
 
 #include "imgui.h"
@@ -85,6 +86,11 @@ namespace Kerberos
 
 		vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
 
+		for (const VkCommandPool commandPool : m_OneTimeCommandPools | std::views::values)
+		{
+			vkDestroyCommandPool(m_Device, commandPool, nullptr);
+		}
+
 		vkDestroyDevice(m_Device, nullptr);
 
 		if (enableValidationLayers)
@@ -162,6 +168,8 @@ namespace Kerberos
 		submitInfo.signalSemaphoreCount = 1;
 		submitInfo.pSignalSemaphores = signalSemaphores;
 
+		std::unique_lock queueLock(m_QueueMutex);
+
 		if (const VkResult result = vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, m_InFlightFences[m_CurrentFrame]); result != VK_SUCCESS) {
 			KBR_CORE_ERROR("Failed to submit draw command buffer! Result: {0}", VulkanHelpers::VkResultToString(result));
 			KBR_CORE_ASSERT(false, "Failed to submit draw command buffer!");
@@ -178,7 +186,10 @@ namespace Kerberos
 		presentInfo.pSwapchains = swapChains;
 		presentInfo.pImageIndices = &imageIndex;
 
-		if (const VkResult result = vkQueuePresentKHR(m_PresentQueue, &presentInfo); result != VK_SUCCESS)
+		const VkResult presentResult = vkQueuePresentKHR(m_PresentQueue, &presentInfo);
+		queueLock.unlock();
+
+		if (const VkResult result = presentResult; result != VK_SUCCESS)
 		{
 			if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
 			{
@@ -326,7 +337,7 @@ namespace Kerberos
 
 		vkCmdDrawIndexed(commandBuffer, m_IndexBuffer->GetCount(), 1, 0, 0, 0);
 
-		ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
+		ImGui_ImplVulkan_RenderDrawData(m_ImGuiDrawData ? m_ImGuiDrawData : ImGui::GetDrawData(), commandBuffer);
 
 		vkCmdEndRenderPass(commandBuffer);
 
@@ -1032,11 +1043,35 @@ namespace Kerberos
 		return m_CommandBuffers[m_CurrentFrame];
 	}
 
+	VkCommandPool VulkanContext::GetOneTimeCommandPool() const
+	{
+		std::scoped_lock lock(m_OneTimeCommandPoolMutex);
+
+		VkCommandPool& commandPool = m_OneTimeCommandPools[std::this_thread::get_id()];
+		if (commandPool != VK_NULL_HANDLE)
+			return commandPool;
+
+		const VkCommandPoolCreateInfo poolInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+			.queueFamilyIndex = m_GraphicsQueueFamilyIndex,
+		};
+
+		if (const VkResult result = vkCreateCommandPool(m_Device, &poolInfo, nullptr, &commandPool); result != VK_SUCCESS)
+		{
+			KBR_CORE_ASSERT(false, "Failed to create one-time command pool! Result: {0}", VulkanHelpers::VkResultToString(result));
+			throw std::runtime_error("failed to create one-time command pool!");
+		}
+
+		return commandPool;
+	}
+
 	VkCommandBuffer VulkanContext::GetOneTimeCommandBuffer() const 
 	{
 		VkCommandBufferAllocateInfo allocInfo{};
 		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-		allocInfo.commandPool = m_CommandPool;
+		allocInfo.commandPool = GetOneTimeCommandPool();
 		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 		allocInfo.commandBufferCount = 1;
 
@@ -1086,10 +1121,14 @@ namespace Kerberos
 			throw std::runtime_error("failed to create fence!");
 		}
 
-		if (const VkResult result = vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, fence); result != VK_SUCCESS)
 		{
-			KBR_CORE_ASSERT(false, "Failed to submit command buffer! Result: {0}", VulkanHelpers::VkResultToString(result));
-			throw std::runtime_error("failed to submit command buffer!");
+			std::scoped_lock queueLock(m_QueueMutex);
+
+			if (const VkResult result = vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, fence); result != VK_SUCCESS)
+			{
+				KBR_CORE_ASSERT(false, "Failed to submit command buffer! Result: {0}", VulkanHelpers::VkResultToString(result));
+				throw std::runtime_error("failed to submit command buffer!");
+			}
 		}
 
 		if (const VkResult result = vkWaitForFences(m_Device, 1, &fence, VK_TRUE, fenceWaitTimeout); result != VK_SUCCESS)
@@ -1099,6 +1138,8 @@ namespace Kerberos
 		}
 
 		vkDestroyFence(m_Device, fence, nullptr);
+
+		vkFreeCommandBuffers(m_Device, GetOneTimeCommandPool(), 1, &commandBuffer);
 	}
 
 	uint64_t VulkanContext::GetBufferDeviceAddress(const VkBuffer buffer) const 
@@ -11,6 +11,12 @@
 
 #include "VulkanBuffer.h"
 
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+struct ImDrawData;
+
 namespace Kerberos
 {
 	class VulkanContext : public GraphicsContext
@@ -54,15 +60,26 @@ namespace Kerberos
 
 		VkDescriptorPool GetImGuiDescriptorPool() const { return m_ImGuiDescriptorPool; }
 
+		/// The ImGui draw data recorded into the next frame, it must stay valid until the frame is submitted
+		void SetImGuiDrawData(ImDrawData* drawData) { m_ImGuiDrawData = drawData; }
+
+		/**
+		* @brief The graphics queue is used by the render thread and by the main thread when it uploads resources,
+		* but it must be externally synchronized, so it must be locked when submitting to it.
+		*/
+		std::mutex& GetQueueMutex() const { return m_QueueMutex; }
+
 		/**
 		* @brief Returns a one-time use command buffer that can be used to record commands.
-		* The command buffer must be submitted using SubmitCommandBuffer() after recording.
+		* The command buffer must be submitted using SubmitCommandBuffer() after recording, on the same thread.
+		* It is allocated from a command pool of the calling thread, so the main thread can upload resources
+		* while the render thread records the frame.
 		*/
 		[[nodiscard]]
 		VkCommandBuffer GetOneTimeCommandBuffer() const;
 
 		/**
-		* Submit a command buffer for execution.
+		* Submit a one-time command buffer for execution, waits until it is executed and frees it.
 		*/
 		void SubmitCommandBuffer(VkCommandBuffer commandBuffer) const;
 
@@ -93,6 +110,8 @@ namespace Kerberos
 		void CreateFramebuffers();
 		void CreateCommandPool();
 		void CreateCommandBuffers();
+		/// The command pool of the calling thread for the one-time command buffers, created on its first use
+		VkCommandPool GetOneTimeCommandPool() const;
 		void CreateSyncObjects();
 		void CreateImGuiDescriptorPool();
 
@@ -152,6 +171,13 @@ namespace Kerberos
 
 		uint32_t m_CurrentFrame = 0;
 
+		ImDrawData* m_ImGuiDrawData = nullptr;
+		mutable std::mutex m_QueueMutex;
+
+		/// A command pool must only be used by one thread at a time, so every thread recording one-time command buffers has its own
+		mutable std::mutex m_OneTimeCommandPoolMutex;
+		mutable std::unordered_map<std::thread::id, VkCommandPool> m_OneTimeCommandPools;
+
 		Scope<VertexBuffer> m_VertexBuffer;
 		Scope<IndexBuffer> m_IndexBuffer;
 
@@ -105,5 +105,9 @@ namespace Kerberos
 	{
 	}
 
+	void VulkanRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance)
+	{
+	}
+
 	void VulkanRendererAPI::DrawArray(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) {}
 }
@@ -22,6 +22,7 @@ namespace Kerberos
 		void SetDepthFunc(DepthFunc func) override;
 
 		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance = 0) override;
 		void DrawArray(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
 
 	private:
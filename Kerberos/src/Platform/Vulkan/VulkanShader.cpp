@@ -255,6 +255,41 @@ namespace Kerberos
 
 	}
 
+	ShaderUniform VulkanShader::GetUniform(const std::string& name) const
+	{
+		return {};
+	}
+
+	void VulkanShader::SetInt(ShaderUniform uniform, int value)
+	{
+
+	}
+
+	void VulkanShader::SetIntArray(ShaderUniform uniform, const int* values, uint32_t count)
+	{
+
+	}
+
+	void VulkanShader::SetFloat(ShaderUniform uniform, float value)
+	{
+
+	}
+
+	void VulkanShader::SetFloat3(ShaderUniform uniform, const glm::vec3& value)
+	{
+
+	}
+
+	void VulkanShader::SetFloat4(ShaderUniform uniform, const glm::vec4& value)
+	{
+
+	}
+
+	void VulkanShader::SetMat4(ShaderUniform uniform, const glm::mat4& value)
+	{
+
+	}
+
 	void VulkanShader::SetMaterial(const std::string& name, const Ref<Material>& material)
 	{
 
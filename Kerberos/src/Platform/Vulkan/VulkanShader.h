@@ -26,6 +26,16 @@ namespace Kerberos
 		void SetFloat3(const std::string& name, const glm::vec3& value) override;
 		void SetFloat4(const std::string& name, const glm::vec4& value) override;
 		void SetMat4(const std::string& name, const glm::mat4& value) override;
+
+		ShaderUniform GetUniform(const std::string& name) const override;
+
+		void SetInt(ShaderUniform uniform, int value) override;
+		void SetIntArray(ShaderUniform uniform, const int* values, uint32_t count) override;
+		void SetFloat(ShaderUniform uniform, float value) override;
+		void SetFloat3(ShaderUniform uniform, const glm::vec3& value) override;
+		void SetFloat4(ShaderUniform uniform, const glm::vec4& value) override;
+		void SetMat4(ShaderUniform uniform, const glm::mat4& value) override;
+
 		void SetMaterial(const std::string& name, const Ref<Material>& material) override;
 
 		void SetDebugName(const std::string& name) const override;
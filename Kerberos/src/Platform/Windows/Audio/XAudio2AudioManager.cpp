@@ -93,29 +93,45 @@ namespace Kerberos
 	}
 
 	Ref<Sound> XAudio2AudioManager::Load(const std::filesystem::path& filepath) 
+	{
+		const auto registerSound = Decode(filepath);
+		if (!registerSound)
+			return nullptr;
+
+		return registerSound();
+	}
+
+	std::function<Ref<Sound>()> XAudio2AudioManager::Decode(const std::filesystem::path& filepath)
 	{
 		const AudioFormat format = DetectAudioFormat(filepath);
 		if (format == AudioFormat::FormatUnknown) 
 		{
 			KBR_CORE_ERROR("Unsupported audio format for file: {0}", filepath.string());
-			return nullptr;
+			return {};
 		}
 		if (format == AudioFormat::FormatPcm) 
 		{
-			LoadWavFile(filepath);
+			const auto soundData = CreateRef<AudioData>();
+			if (!ParseWavFile(filepath, *soundData))
+				return {};
+
+			return [this, filepath, soundData]() -> Ref<Sound>
+				{
+					m_LoadedWAVs[filepath] = std::move(*soundData);
 
-			const std::string soundName = filepath.stem().string();
+					const std::string soundName = filepath.stem().string();
 
-			Sound sound{ soundName };
-			const UUID soundUUID = sound.GetSoundID();
+					Sound sound{ soundName };
+					const UUID soundUUID = sound.GetSoundID();
 
-			m_SoundUUIDToFilepath[soundUUID] = filepath;
+					m_SoundUUIDToFilepath[soundUUID] = filepath;
 
-			return CreateRef<Sound>(sound);
+					return CreateRef<Sound>(sound);
+				};
 		}
 
 		KBR_CORE_ERROR("Audio format not implemented for file: {0}", filepath.string());
-		return nullptr;
+		return {};
 	}
 
 	void XAudio2AudioManager::Play(const std::filesystem::path& filepath) 
@@ -313,19 +329,19 @@ namespace Kerberos
 		return AudioFormat::FormatUnknown;
 	}
 
-	void XAudio2AudioManager::LoadWavFile(const std::filesystem::path& filepath) 
+	bool XAudio2AudioManager::ParseWavFile(const std::filesystem::path& filepath, AudioData& soundData) 
 	{
 		std::ifstream file(filepath, std::ios::binary);
 		if (!file) {
 			KBR_CORE_ERROR("Failed to open WAV file: {0}", filepath.string());
-			return;
+			return false;
 		}
 
 		char chunkId[4];
 		file.read(chunkId, 4);
 		if (strncmp(chunkId, "RIFF", 4) != 0) {
 			KBR_CORE_ERROR("Invalid WAV file (missing RIFF): {0}", filepath.string());
-			return;
+			return false;
 		}
 
 		DWORD chunkSize;
@@ -335,10 +351,9 @@ namespace Kerberos
 		file.read(chunkId, 4);
 		if (strncmp(chunkId, "WAVE", 4) != 0) {
 			KBR_CORE_ERROR("Invalid WAV file (missing WAVE): {0}", filepath.string());
-			return;
+			return false;
 		}
 
-		AudioData soundData;
 		bool foundFmt = false;
 		bool foundData = false;
 
@@ -383,19 +398,19 @@ namespace Kerberos
 
 		if (!foundFmt) {
 			KBR_CORE_ERROR("WAV file missing 'fmt ' chunk: {0}", filepath.string());
-			return;
+			return false;
 		}
 
 		if (!foundData) {
 			KBR_CORE_ERROR("WAV file missing 'data' chunk: {0}", filepath.string());
-			return;
+			return false;
 		}
 
 		if (soundData.buffer.empty()) {
 			KBR_CORE_ERROR("WAV file has empty audio data: {0}", filepath.string());
-			return;
+			return false;
 		}
 
-		m_LoadedWAVs[filepath] = std::move(soundData);
+		return true;
 	}
 }
@@ -47,6 +47,7 @@ namespace Kerberos
 		void Shutdown() override;
 
 		Ref<Sound> Load(const std::filesystem::path& filepath) override;
+		std::function<Ref<Sound>()> Decode(const std::filesystem::path& filepath) override;
 		void Play(const std::filesystem::path& filepath) override;
 		void Play(const UUID& soundID) override;
 		void Stop(const UUID& soundID) override;
@@ -60,7 +61,11 @@ namespace Kerberos
 	private:
 		static AudioFormat DetectAudioFormat(const std::filesystem::path& filepath);
 
-		void LoadWavFile(const std::filesystem::path& filepath);
+		/**
+		 * Parses the WAV file into the audio data. Doesn't touch the state of the manager,
+		 * so it can be called from any thread.
+		 */
+		static bool ParseWavFile(const std::filesystem::path& filepath, AudioData& soundData);
 
 	private:
 		IXAudio2* m_XAudio2 = nullptr;
@@ -0,0 +1,83 @@
+#include "kbrpch.h"
+#include "Kerberos/Core/MappedFile.h"
+
+namespace Kerberos
+{
+	MappedFile::MappedFile(const std::filesystem::path& filepath)
+	{
+		const HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+
+		m_FileHandle = file;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			Release();
+			return;
+		}
+
+		const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			KBR_CORE_ERROR("Failed to create file mapping of {0}", filepath.string());
+			Release();
+			return;
+		}
+
+		m_MappingHandle = mapping;
+
+		m_Data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (m_Data == nullptr)
+		{
+			KBR_CORE_ERROR("Failed to map view of {0}", filepath.string());
+			Release();
+			return;
+		}
+
+		m_Size = static_cast<uint64_t>(size.QuadPart);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Release();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: m_Data(std::exchange(other.m_Data, nullptr)), m_Size(std::exchange(other.m_Size, 0)),
+		m_FileHandle(std::exchange(other.m_FileHandle, nullptr)), m_MappingHandle(std::exchange(other.m_MappingHandle, nullptr))
+	{}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+
+			m_Data = std::exchange(other.m_Data, nullptr);
+			m_Size = std::exchange(other.m_Size, 0);
+			m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+			m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+		}
+
+		return *this;
+	}
+
+	void MappedFile::Release()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+
+		if (m_MappingHandle)
+			CloseHandle(m_MappingHandle);
+
+		if (m_FileHandle)
+			CloseHandle(m_FileHandle);
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_MappingHandle = nullptr;
+		m_FileHandle = nullptr;
+	}
+}
@@ -6,9 +6,11 @@
 #include "Kerberos/Events/KeyEvent.h"
 #include "Kerberos/Core.h"
 #include "Kerberos/Renderer/RendererAPI.h"
+#include "Kerberos/Renderer/RenderThread.h"
 #include "Platform/OpenGL/OpenGLContext.h"
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/D3D11/D3D11Context.h"
+#include "Platform/Null/NullContext.h"
 
 extern "C"
 {
@@ -94,6 +96,9 @@ namespace Kerberos
 		case RendererAPI::API::D3D12:
 			KBR_CORE_ASSERT(false, "D3D12 is currently not supported!");
 			break;
+		case RendererAPI::API::Null:
+			m_Context = new NullContext();
+			break;
 		}
 		m_Context->Init();
 
@@ -223,7 +228,11 @@ namespace Kerberos
 		KBR_PROFILE_FUNCTION();
 
 		glfwPollEvents();
-		m_Context->SwapBuffers();
+
+		RenderThread::Submit([context = m_Context]
+			{
+				context->SwapBuffers();
+			});
 	}
 
 	void WindowsWindow::SetVSync(const bool enabled) 
@@ -234,14 +243,18 @@ namespace Kerberos
 		if (RendererAPI::GetAPI() != RendererAPI::API::OpenGL)
 			return;
 
-		if (enabled)
-		{
-			glfwSwapInterval(1);
-		}
-		else
-		{
-			glfwSwapInterval(0);
-		}
+		/// The swap interval belongs to the context, which is current on the render thread
+		RenderThread::Submit([enabled]
+			{
+				if (enabled)
+				{
+					glfwSwapInterval(1);
+				}
+				else
+				{
+					glfwSwapInterval(0);
+				}
+			});
 		m_Data.VSync = enabled;
 	}
 
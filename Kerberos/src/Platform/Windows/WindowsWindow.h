@@ -24,6 +24,7 @@ namespace Kerberos
 		bool IsVSync() const override;
 
 		void* GetNativeWindow() const override { return m_Window; }
+		GraphicsContext* GetGraphicsContext() const override { return m_Context; }
 
 	private:
 		virtual void Init(const WindowProps& props);
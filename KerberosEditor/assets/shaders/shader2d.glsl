@@ -36,11 +36,18 @@ layout(location = 1) in vec2 v_TexCoord;
 layout(location = 2) in float v_TexIndex;
 layout(location = 3) in float v_TilingFactor;
 
-layout(binding = 0, set = 0) uniform sampler2D u_Textures[32];
+layout(binding = 0, set = 0) uniform sampler2D u_Textures[31];
+// The pages of a texture atlas, the quads using it have negative texture indices
+layout(binding = 31, set = 0) uniform sampler2DArray u_TextureArray;
 
 void main()
 {
 	// If we want to scale the texture, we can multiply the texture coordinates.
 	// We can tint the texture by multiplying the color with a color.
-	color = texture(u_Textures[int(v_TexIndex)], v_TexCoord * v_TilingFactor) * v_Color;
+	vec2 texCoord = v_TexCoord * v_TilingFactor;
+
+	if (v_TexIndex < 0.0)
+		color = texture(u_TextureArray, vec3(texCoord, -v_TexIndex - 1.0)) * v_Color;
+	else
+		color = texture(u_Textures[int(v_TexIndex)], texCoord) * v_Color;
 }
\ No newline at end of file
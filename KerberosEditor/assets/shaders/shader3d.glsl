@@ -7,6 +7,10 @@ layout(location = 2) in vec2 a_TexCoord;
 //layout(location = 3) in float a_TexIndex;
 //layout(location = 4) in float a_TilingFactor;
 
+// Per instance attributes, the model matrix takes locations 3-6
+layout(location = 3) in mat4 a_InstanceModel;
+layout(location = 7) in int a_InstanceEntityID;
+
 layout(std140, binding = 0) uniform Camera
 {
 	vec3 u_CameraPosition;
@@ -46,18 +50,20 @@ layout(location = 0) out vec3 v_FragPos_WorldSpace;
 layout(location = 1) out vec3 v_Normal_WorldSpace;
 layout(location = 2) out vec2 v_TexCoord;
 layout(location = 3) out vec4 v_FragPos_LightSpace;
+layout(location = 4) out flat int v_EntityID;
 
 void main()
 {
-    vec4 worldPos = u_Model * vec4(a_Position, 1.0);
+    vec4 worldPos = a_InstanceModel * vec4(a_Position, 1.0);
     v_FragPos_WorldSpace = worldPos.xyz;
 
-    mat3 normalMatrix = transpose(inverse(mat3(u_Model)));
+    mat3 normalMatrix = transpose(inverse(mat3(a_InstanceModel)));
     v_Normal_WorldSpace = normalize(normalMatrix * a_Normal);
 
 	v_FragPos_LightSpace = u_LightSpaceMatrix * vec4(v_FragPos_WorldSpace, 1.0);
 
     v_TexCoord = a_TexCoord;
+    v_EntityID = a_InstanceEntityID;
     gl_Position = u_ViewProjection * worldPos;
 }
 
@@ -79,6 +85,7 @@ layout(location = 0) in vec3 v_FragPos_WorldSpace;
 layout(location = 1) in vec3 v_Normal_WorldSpace;
 layout(location = 2) in vec2 v_TexCoord;
 layout(location = 3) in vec4 v_FragPos_LightSpace;
+layout(location = 4) in flat int v_EntityID;
 
 layout(binding = 0) uniform sampler2D u_Texture;
 layout(binding = 1) uniform sampler2D u_ShadowMap;
@@ -255,5 +262,5 @@ void main()
     color = vec4(totalLighting, alpha);
     //color = vec4(shadow, 0.0, 0.0, 1.0);
 
-    color2 = u_EntityID;
+    color2 = v_EntityID;
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 layout(location = 0) in vec3 a_Position;
 
+// Per instance model matrix, takes locations 3-6
+layout(location = 3) in mat4 a_InstanceModel;
+
 layout(std140, binding = 3) uniform ShadowData
 {
     mat4 u_LightSpaceMatrix;
@@ -27,7 +30,7 @@ layout(std140, binding = 2) uniform PerObjectData
 
 void main()
 {
-    gl_Position = u_LightSpaceMatrix * u_Model * vec4(a_Position, 1.0);
+    gl_Position = u_LightSpaceMatrix * a_InstanceModel * vec4(a_Position, 1.0);
 }
 
 #type fragment
@@ -14,21 +14,6 @@ layout(std140, binding = 0) uniform Camera
     mat4 u_ViewProjection;
 };
 
-struct Material
-{
-    vec3 diffuse;
-    vec3 specular;
-    vec3 ambient;
-    float shininess;
-};
-
-layout(std140, binding = 2) uniform PerObjectData
-{
-    int u_EntityID;
-    mat4 u_Model;
-    Material u_Material;
-};
-
 layout (location = 0) out vec4 v_Color;
 layout (location = 1) out vec2 v_TexCoord;
 layout (location = 2) out int v_EntityID;
@@ -37,9 +22,10 @@ void main()
 {
 	v_Color = a_Color;
 	v_TexCoord = a_TexCoord;
-	v_EntityID = u_EntityID;
+	v_EntityID = a_EntityID;
 
-	gl_Position = u_ViewProjection * u_Model * vec4(a_Position, 1.0);
+	// The glyph quads are batched, so their positions are already in world space
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
 }
 
 #type fragment
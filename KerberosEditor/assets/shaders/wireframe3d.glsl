@@ -7,6 +7,10 @@ layout(location = 2) in vec2 a_TexCoord;
 //layout(location = 3) in float a_TexIndex;
 //layout(location = 4) in float a_TilingFactor;
 
+// Per instance attributes, the model matrix takes locations 3-6
+layout(location = 3) in mat4 a_InstanceModel;
+layout(location = 7) in int a_InstanceEntityID;
+
 layout(std140, binding = 0) uniform Camera
 {
     vec3 u_ViewPos;
@@ -33,16 +37,18 @@ layout(std140, binding = 2) uniform PerObjectData
 layout(location = 0) out vec3 v_FragPos_WorldSpace;
 layout(location = 1) out vec3 v_Normal_WorldSpace;
 layout(location = 2) out vec2 v_TexCoord;
+layout(location = 3) out flat int v_EntityID;
 
 void main()
 {
-    vec4 worldPos = u_Model * vec4(a_Position, 1.0);
+    vec4 worldPos = a_InstanceModel * vec4(a_Position, 1.0);
     v_FragPos_WorldSpace = worldPos.xyz;
 
-    mat3 normalMatrix = transpose(inverse(mat3(u_Model)));
+    mat3 normalMatrix = transpose(inverse(mat3(a_InstanceModel)));
     v_Normal_WorldSpace = normalize(normalMatrix * a_Normal);
 
     v_TexCoord = a_TexCoord;
+    v_EntityID = a_InstanceEntityID;
     gl_Position = u_ViewProjection * worldPos;
 }
 
@@ -55,11 +61,13 @@ layout(line_strip, max_vertices = 3) out;
 layout(location = 0) in vec3 v_FragPos_WorldSpace[];
 layout(location = 1) in vec3 v_Normal_WorldSpace[];
 layout(location = 2) in vec2 v_TexCoord[];
+layout(location = 3) in flat int v_EntityID[];
 
 layout(location = 0) out vec3 g_FragPos_WorldSpace;
 layout(location = 1) out vec3 g_Normal_WorldSpace;
 layout(location = 2) out vec2 g_TexCoord;
 layout(location = 3) noperspective out vec3 g_EdgeDistance;
+layout(location = 4) out flat int g_EntityID;
 
 layout(std140, binding = 0) uniform Camera
 {
@@ -96,6 +104,7 @@ void main()
     g_FragPos_WorldSpace = v_FragPos_WorldSpace[0];
     g_Normal_WorldSpace = v_Normal_WorldSpace[0];
     g_TexCoord = v_TexCoord[0];
+    g_EntityID = v_EntityID[0];
     gl_Position = gl_in[0].gl_Position;
 	g_EdgeDistance = vec3(ha, 0.0, 0.0);
     EmitVertex();
@@ -103,6 +112,7 @@ void main()
     g_FragPos_WorldSpace = v_FragPos_WorldSpace[1];
     g_Normal_WorldSpace = v_Normal_WorldSpace[1];
     g_TexCoord = v_TexCoord[1];
+    g_EntityID = v_EntityID[1];
     gl_Position = gl_in[1].gl_Position;
     g_EdgeDistance = vec3(0.0, hb, 0.0);
     EmitVertex();
@@ -110,6 +120,7 @@ void main()
     g_FragPos_WorldSpace = v_FragPos_WorldSpace[2];
     g_Normal_WorldSpace = v_Normal_WorldSpace[2];
     g_TexCoord = v_TexCoord[2];
+    g_EntityID = v_EntityID[2];
     gl_Position = gl_in[2].gl_Position;
     g_EdgeDistance = vec3(0.0, 0.0, hc);
     EmitVertex();
@@ -135,6 +146,7 @@ layout(location = 0) in vec3 g_FragPos_WorldSpace;
 layout(location = 1) in vec3 g_Normal_WorldSpace;
 layout(location = 2) in vec2 g_TexCoord;
 layout(location = 3) noperspective in vec3 g_EdgeDistance;
+layout(location = 4) in flat int g_EntityID;
 
 layout(binding = 0) uniform sampler2D u_Texture;
 
@@ -278,5 +290,5 @@ void main()
     color = vec4(totalLighting, alpha);
 
 	color = mix(color, wireframeColor, mixVal);
-    entityIDColor = u_EntityID;
+    entityIDColor = g_EntityID;
 }
\ No newline at end of file
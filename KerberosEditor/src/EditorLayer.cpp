@@ -359,12 +359,57 @@ namespace Kerberos
 		ImGui::Begin("Settings");
 		ImGui::ColorEdit3("Square Color", glm::value_ptr(m_SquareColor));
 
-		const auto [DrawCalls, DrawnMeshes, Vertices, Faces] = Renderer3D::GetStatistics();
+		const auto stats = Renderer3D::GetStatistics();
 		ImGui::Text("Renderer3D Stats");
-		ImGui::Text("Draw Calls: %u", DrawCalls);
-		ImGui::Text("Meshes: %u", DrawnMeshes);
-		ImGui::Text("Vertices: %u", Vertices);
-		ImGui::Text("Faces: %u", Faces);
+		ImGui::Text("Draw Calls: %u", stats.DrawCalls);
+		ImGui::Text("Meshes: %u", stats.DrawnMeshes);
+		ImGui::Text("Vertices: %u", stats.Vertices);
+		ImGui::Text("Faces: %u", stats.Faces);
+		ImGui::Text("Submitted Meshes: %u", stats.SubmittedMeshes);
+		ImGui::Text("Culled Meshes: %u", stats.CulledMeshes);
+		ImGui::Text("Shader Binds: %u", stats.ShaderBinds);
+		ImGui::Text("Texture Binds: %u", stats.TextureBinds);
+		ImGui::Text("Vertex Array Binds: %u", stats.VertexArrayBinds);
+
+		const RenderThreadStats& renderThreadStats = RenderThread::GetStats();
+		ImGui::Text("Render Thread Stats");
+		ImGui::Text("Commands: %u", renderThreadStats.CommandCount);
+		ImGui::Text("Command Memory: %.1fKB", static_cast<float>(renderThreadStats.CommandMemory) / 1024.0f);
+		ImGui::Text("Render Thread: %.3fms", renderThreadStats.RenderThreadMs);
+		ImGui::Text("Main Thread Wait: %.3fms", renderThreadStats.MainThreadWaitMs);
+
+		const TransformStatistics& transformStats = m_ActiveScene->GetTransformStatistics();
+		ImGui::Text("Transform Stats");
+		ImGui::Text("Recomputed: %u", transformStats.Recomputed);
+		ImGui::Text("Skipped: %u", transformStats.Skipped);
+		ImGui::Text("Hierarchy Levels: %u", transformStats.Levels);
+
+		const PhysicsStatistics& physicsStats = m_ActiveScene->GetPhysicsSystem().GetStatistics();
+		ImGui::Text("Physics Stats");
+		ImGui::Text("Steps Taken: %u", physicsStats.StepsTaken);
+		ImGui::Text("Steps Dropped: %u", physicsStats.StepsDropped);
+		ImGui::Text("Accumulator Lag: %.3fms", physicsStats.AccumulatorLag * 1000.0f);
+		ImGui::Text("Interpolation: %.2f", physicsStats.InterpolationAlpha);
+		ImGui::Text("Active Bodies: %u", physicsStats.ActiveBodies);
+		ImGui::Text("Contact Events: %u", physicsStats.ContactEvents);
+		ImGui::Text("Contact Events Dropped: %u", physicsStats.ContactEventsDropped);
+
+		if (m_SceneState == SceneState::Play)
+		{
+			const FrameTimeBreakdown& breakdown = m_ActiveScene->GetFrameTimeBreakdown();
+			ImGui::Text("Frame Breakdown");
+			ImGui::Text("Wall Time: %.3fms", breakdown.WallMs);
+			ImGui::Text("Total Work: %.3fms", breakdown.TotalWorkMs);
+			ImGui::Text("Critical Path: %.3fms", breakdown.CriticalPathMs);
+			/// How many threads could be kept busy at most, with the systems as they are
+			ImGui::Text("Parallelism: %.2fx", breakdown.CriticalPathMs > 0.0f ? breakdown.TotalWorkMs / breakdown.CriticalPathMs : 1.0f);
+
+			for (const SystemTiming& system : breakdown.Systems)
+			{
+				ImGui::Text("%s %s: %.3fms at %.3fms%s", system.OnCriticalPath ? "*" : " ", system.Name.c_str(),
+					system.DurationMs, system.StartMs, system.MainThread ? " (main thread)" : "");
+			}
+		}
 
 		for (const auto& [Name, Time] : m_ProfileResults)
 		{
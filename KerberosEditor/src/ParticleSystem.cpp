@@ -33,6 +33,7 @@ ParticleSystem::ParticleSystem(const uint32_t maxParticles)
 	: m_PoolIndex(maxParticles - 1)
 {
 	m_ParticlePool.resize(maxParticles);
+	m_Quads.reserve(maxParticles);
 }
 
 void ParticleSystem::OnUpdate(const Kerberos::Timestep ts)
@@ -58,7 +59,7 @@ void ParticleSystem::OnUpdate(const Kerberos::Timestep ts)
 
 void ParticleSystem::OnRender(const Kerberos::OrthographicCamera& camera)
 {
-	Kerberos::Renderer2D::BeginScene(camera);
+	m_Quads.clear();
 
 	for (auto& particle : m_ParticlePool)
 	{
@@ -72,8 +73,11 @@ void ParticleSystem::OnRender(const Kerberos::OrthographicCamera& camera)
 
 		float size = glm::lerp(particle.SizeEnd, particle.SizeBegin, life);
 
-		Kerberos::Renderer2D::DrawQuad({ particle.Position.x, particle.Position.y, 1.0f }, { size, size }, particle.Rotation, color);
+		m_Quads.push_back({ { particle.Position.x, particle.Position.y, 1.0f }, { size, size }, particle.Rotation, color });
 	}
+
+	Kerberos::Renderer2D::BeginScene(camera);
+	Kerberos::Renderer2D::DrawQuads(m_Quads);
 	Kerberos::Renderer2D::EndScene();
 }
 
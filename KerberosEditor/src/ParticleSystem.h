@@ -40,4 +40,7 @@ private:
 
 	std::vector<Particle> m_ParticlePool;
 	uint32_t m_PoolIndex;
+
+	/// The active particles of the frame, drawn with a single DrawQuads call
+	std::vector<Kerberos::QuadInstance> m_Quads;
 };
\ No newline at end of file
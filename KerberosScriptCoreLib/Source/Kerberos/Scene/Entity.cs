@@ -20,6 +20,17 @@ namespace Kerberos.Source.Kerberos.Scene
 
         protected virtual void OnUpdate(float deltaTime) {}
 
+        // Called after the physics update, with the ID of the other entity of the contact
+        protected virtual void OnCollisionEnter(ulong otherID) {}
+
+        protected virtual void OnCollisionStay(ulong otherID) {}
+
+        protected virtual void OnCollisionExit(ulong otherID) {}
+
+        protected virtual void OnTriggerEnter(ulong otherID) {}
+
+        protected virtual void OnTriggerExit(ulong otherID) {}
+
         public Vector3 Translation
         {
             get
@@ -33,11 +33,18 @@ in vec2 v_TexCoord;
 in float v_TexIndex;
 in float v_TilingFactor;
 
-uniform sampler2D u_Textures[32];
+uniform sampler2D u_Textures[31];
+// The pages of a texture atlas, the quads using it have negative texture indices
+uniform sampler2DArray u_TextureArray;
 
 void main()
 {
 	// If we want to scale the texture, we can multiply the texture coordinates.
 	// We can tint the texture by multiplying the color with a color.
-	color = texture(u_Textures[int(v_TexIndex)], v_TexCoord * v_TilingFactor) * v_Color;
+	vec2 texCoord = v_TexCoord * v_TilingFactor;
+
+	if (v_TexIndex < 0.0)
+		color = texture(u_TextureArray, vec3(texCoord, -v_TexIndex - 1.0)) * v_Color;
+	else
+		color = texture(u_Textures[int(v_TexIndex)], texCoord) * v_Color;
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#type vertex
+#version 460 core
+
+layout(location = 0) in vec3 a_Center;
+layout(location = 1) in vec3 a_AxisX;
+layout(location = 2) in vec3 a_AxisY;
+layout(location = 3) in vec4 a_TexCoordRect;
+layout(location = 4) in int a_Color;
+layout(location = 5) in float a_TexIndex;
+
+uniform mat4 u_ViewProjection;
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+out float v_TexIndex;
+
+// The corners of the quad, in the order of the quad indices
+const vec2 c_Corners[4] = vec2[4](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0));
+
+void main()
+{
+	vec2 corner = c_Corners[gl_VertexIndex];
+
+	// The axes are halved already, and the tiling factor is part of the texture coordinates
+	vec3 position = a_Center + a_AxisX * corner.x + a_AxisY * corner.y;
+
+	v_Color = unpackUnorm4x8(uint(a_Color));
+	v_TexCoord = mix(a_TexCoordRect.xy, a_TexCoordRect.zw, corner * 0.5 + 0.5);
+	v_TexIndex = a_TexIndex;
+	gl_Position = u_ViewProjection * vec4(position, 1.0);
+}
+
+#type fragment
+#version 460 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in float v_TexIndex;
+
+uniform sampler2D u_Textures[31];
+// The pages of a texture atlas, the quads using it have negative texture indices
+uniform sampler2DArray u_TextureArray;
+
+void main()
+{
+	if (v_TexIndex < 0.0)
+		color = texture(u_TextureArray, vec3(v_TexCoord, -v_TexIndex - 1.0)) * v_Color;
+	else
+		color = texture(u_Textures[int(v_TexIndex)], v_TexCoord) * v_Color;
+}
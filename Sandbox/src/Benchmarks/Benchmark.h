@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Kerberos.h>
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+
+struct BenchmarkResult
+{
+	std::string Name;
+	float DurationMs;
+};
+
+class Benchmark
+{
+public:
+	virtual ~Benchmark() = default;
+
+	virtual const char* GetName() const = 0;
+	virtual std::vector<BenchmarkResult> Run() = 0;
+
+	/// The checks that failed in the last run, the measured times of a failed run can't be trusted
+	const std::vector<std::string>& GetFailures() const { return m_Failures; }
+	void ClearFailures() { m_Failures.clear(); }
+
+protected:
+	/// Marks the run as failed, the benchmark keeps running so the remaining results are still measured
+	void Fail(const std::string& message)
+	{
+		KBR_ERROR("{}: {}", GetName(), message);
+		m_Failures.push_back(message);
+	}
+
+	/**
+	 * Finds an asset in the working directory, or in the assets of the editor, which the Sandbox shares.
+	 * Fails the run and returns an empty path when neither has it.
+	 */
+	std::filesystem::path FindAsset(const std::filesystem::path& path)
+	{
+		if (std::filesystem::exists(path))
+			return path;
+
+		const std::filesystem::path editorPath = std::filesystem::path("../KerberosEditor") / path;
+		if (std::filesystem::exists(editorPath))
+			return editorPath;
+
+		Fail(std::format("Missing the asset {}", path.string()));
+		return {};
+	}
+
+private:
+	std::vector<std::string> m_Failures;
+};
+
+/**
+ * Runs the function and returns how long it took in milliseconds.
+ */
+template<typename Fn>
+float MeasureMs(Fn&& fn)
+{
+	const auto start = std::chrono::high_resolution_clock::now();
+	fn();
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	return std::chrono::duration<float, std::milli>(end - start).count();
+}
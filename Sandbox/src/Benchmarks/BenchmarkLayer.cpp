@@ -0,0 +1,69 @@
+#include "BenchmarkLayer.h"
+
+#include "ContactBenchmark.h"
+#include "FontBenchmark.h"
+#include "HierarchyBenchmark.h"
+#include "MeshBenchmark.h"
+#include "PhysicsBenchmark.h"
+#include "PhysicsSyncBenchmark.h"
+#include "Renderer2DBenchmark.h"
+#include "RenderReplayBenchmark.h"
+#include "SceneBenchmark.h"
+#include "ThreadPoolBenchmark.h"
+
+#include "imgui/imgui.h"
+
+BenchmarkLayer::BenchmarkLayer()
+	: Layer("BenchmarkLayer")
+{
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<HierarchyBenchmark>());
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<FontBenchmark>());
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<MeshBenchmark>());
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<SceneBenchmark>());
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<PhysicsBenchmark>());
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<ContactBenchmark>());
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<PhysicsSyncBenchmark>());
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<ThreadPoolBenchmark>());
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<RenderReplayBenchmark>());
+	m_Benchmarks.emplace_back(Kerberos::CreateScope<Renderer2DBenchmark>());
+}
+
+void BenchmarkLayer::OnImGuiRender()
+{
+	KBR_PROFILE_FUNCTION();
+
+	ImGui::Begin("Benchmarks");
+
+	for (const auto& benchmark : m_Benchmarks)
+	{
+		if (ImGui::Button(benchmark->GetName()))
+		{
+			KBR_INFO("Running benchmark {}", benchmark->GetName());
+
+			benchmark->ClearFailures();
+			m_Results = benchmark->Run();
+			m_Failures = benchmark->GetFailures();
+			for (const auto& [Name, DurationMs] : m_Results)
+			{
+				KBR_INFO("  {}: {:.3f}ms", Name, DurationMs);
+			}
+
+			if (!m_Failures.empty())
+				KBR_ERROR("Benchmark {} failed {} checks", benchmark->GetName(), m_Failures.size());
+		}
+	}
+
+	ImGui::Separator();
+
+	for (const auto& [Name, DurationMs] : m_Results)
+	{
+		ImGui::Text("%s %.3fms", Name.c_str(), DurationMs);
+	}
+
+	for (const auto& failure : m_Failures)
+	{
+		ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "FAILED: %s", failure.c_str());
+	}
+
+	ImGui::End();
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Kerberos.h>
+
+#include "Benchmark.h"
+
+class BenchmarkLayer : public Kerberos::Layer
+{
+public:
+	BenchmarkLayer();
+	~BenchmarkLayer() override = default;
+
+	void OnImGuiRender() override;
+
+private:
+	std::vector<Kerberos::Scope<Benchmark>> m_Benchmarks;
+	std::vector<BenchmarkResult> m_Results;
+	/// The failed checks of the last run
+	std::vector<std::string> m_Failures;
+};
@@ -0,0 +1,164 @@
+#include "ContactBenchmark.h"
+
+#include "Kerberos/Scene/Components/PhysicsComponents.h"
+
+#include <array>
+#include <format>
+
+static constexpr std::array<uint32_t, 2> BoxCounts = { 4'096, 16'384 };
+
+/// The boxes are placed on a grid of this many boxes per row, closer than their size, so they overlap
+static constexpr uint32_t GridSize = 64;
+static constexpr float BoxSpacing = 0.9f;
+
+static constexpr uint32_t FrameCount = 120;
+static constexpr float FrameTime = 1.0f / 60.0f;
+
+namespace
+{
+	struct ContactEventCounts
+	{
+		std::array<uint32_t, 5> Counts{};
+
+		void Add(const std::span<const Kerberos::ContactEvent> events)
+		{
+			for (const Kerberos::ContactEvent& event : events)
+			{
+				++Counts[static_cast<size_t>(event.Type)];
+			}
+		}
+
+		uint32_t Get(const Kerberos::ContactEventType type) const { return Counts[static_cast<size_t>(type)]; }
+	};
+}
+
+void ContactBenchmark::CheckContactEvents()
+{
+	const auto scene = Kerberos::CreateRef<Kerberos::Scene>();
+
+	Kerberos::Entity ground = scene->CreateEntity("Ground");
+	ground.GetComponent<Kerberos::TransformComponent>().Translation = { 0.0f, -1.0f, 0.0f };
+	ground.AddComponent<Kerberos::RigidBody3DComponent>(Kerberos::RigidBody3DComponent::BodyType::Static);
+	ground.AddComponent<Kerberos::BoxCollider3DComponent>(glm::vec3(5.0f, 0.5f, 5.0f));
+
+	Kerberos::Entity trigger = scene->CreateEntity("Trigger");
+	trigger.AddComponent<Kerberos::RigidBody3DComponent>(Kerberos::RigidBody3DComponent::BodyType::Static);
+	trigger.AddComponent<Kerberos::BoxCollider3DComponent>(glm::vec3(2.0f), glm::vec3(0.0f), true);
+
+	/// Resting on the ground, both colliders touch it and the trigger, so Jolt reports two sub shape contacts per pair
+	Kerberos::Entity body = scene->CreateEntity("Body");
+	body.AddComponent<Kerberos::RigidBody3DComponent>(Kerberos::RigidBody3DComponent::BodyType::Dynamic);
+	body.AddComponent<Kerberos::BoxCollider3DComponent>(glm::vec3(0.5f));
+	body.AddComponent<Kerberos::SphereCollider3DComponent>(0.5f);
+
+	scene->CalculateEntityTransforms();
+	scene->OnSimulationStart();
+
+	Kerberos::IPhysicsSystem& physicsSystem = scene->GetPhysicsSystem();
+
+	ContactEventCounts counts;
+	const auto step = [&](const uint32_t frameCount)
+		{
+			for (uint32_t frame = 0; frame < frameCount; ++frame)
+			{
+				physicsSystem.Update(FrameTime);
+				counts.Add(physicsSystem.GetContactEvents());
+			}
+		};
+
+	const auto expect = [&](const Kerberos::ContactEventType type, const uint32_t expected, const char* name)
+		{
+			if (counts.Get(type) != expected)
+				Fail(std::format("Expected {} {} events, got {}", expected, name, counts.Get(type)));
+		};
+
+	step(30);
+	expect(Kerberos::ContactEventType::CollisionEnter, 1, "CollisionEnter");
+	expect(Kerberos::ContactEventType::TriggerEnter, 1, "TriggerEnter");
+	expect(Kerberos::ContactEventType::CollisionExit, 0, "CollisionExit");
+	expect(Kerberos::ContactEventType::TriggerExit, 0, "TriggerExit");
+
+	/// Moved far above both, the body takes longer than the remaining steps to fall back
+	body.GetComponent<Kerberos::TransformComponent>().Translation = { 0.0f, 20.0f, 0.0f };
+	body.GetComponent<Kerberos::RigidBody3DComponent>().IsDirty = true;
+	scene->CalculateEntityTransforms();
+
+	step(5);
+	expect(Kerberos::ContactEventType::CollisionEnter, 1, "CollisionEnter");
+	expect(Kerberos::ContactEventType::TriggerEnter, 1, "TriggerEnter");
+	expect(Kerberos::ContactEventType::CollisionExit, 1, "CollisionExit");
+	expect(Kerberos::ContactEventType::TriggerExit, 1, "TriggerExit");
+
+	scene->OnSimulationStop();
+}
+
+std::vector<BenchmarkResult> ContactBenchmark::Run()
+{
+	std::vector<BenchmarkResult> results;
+
+	CheckContactEvents();
+
+	for (const uint32_t boxCount : BoxCounts)
+	{
+		const auto scene = Kerberos::CreateRef<Kerberos::Scene>();
+
+		const float groundSize = static_cast<float>(GridSize) * BoxSpacing;
+		Kerberos::Entity ground = scene->CreateEntity("Ground");
+		ground.GetComponent<Kerberos::TransformComponent>().Translation = { groundSize * 0.5f, -1.0f, groundSize * 0.5f };
+		ground.AddComponent<Kerberos::RigidBody3DComponent>(Kerberos::RigidBody3DComponent::BodyType::Static);
+		ground.AddComponent<Kerberos::BoxCollider3DComponent>(glm::vec3(groundSize, 0.5f, groundSize));
+
+		const uint32_t boxesPerLayer = GridSize * GridSize;
+		for (uint32_t i = 0; i < boxCount; ++i)
+		{
+			const uint32_t layer = i / boxesPerLayer;
+			const uint32_t index = i % boxesPerLayer;
+
+			Kerberos::Entity entity = scene->CreateEntity("Box");
+			entity.GetComponent<Kerberos::TransformComponent>().Translation = {
+				static_cast<float>(index % GridSize) * BoxSpacing,
+				static_cast<float>(layer) * BoxSpacing,
+				static_cast<float>(index / GridSize) * BoxSpacing
+			};
+			entity.AddComponent<Kerberos::RigidBody3DComponent>(Kerberos::RigidBody3DComponent::BodyType::Dynamic);
+			entity.AddComponent<Kerberos::BoxCollider3DComponent>(glm::vec3(0.5f));
+		}
+
+		scene->CalculateEntityTransforms();
+
+		/// Without an active project the scene keeps these settings when the simulation starts
+		Kerberos::PhysicsSettings settings = scene->GetPhysicsSystem().GetSettings();
+		settings.MaxBodies = boxCount + 1;
+		settings.MaxBodyPairs = boxCount * 8;
+		settings.MaxContactConstraints = boxCount * 8;
+		settings.MaxContactEvents = boxCount * 8;
+		settings.MaxStepsPerFrame = 1;
+		scene->GetPhysicsSystem().SetSettings(settings);
+
+		scene->OnSimulationStart();
+
+		Kerberos::IPhysicsSystem& physicsSystem = scene->GetPhysicsSystem();
+
+		uint64_t eventCount = 0;
+		uint64_t droppedCount = 0;
+		const float totalMs = MeasureMs([&]
+			{
+				for (uint32_t frame = 0; frame < FrameCount; ++frame)
+				{
+					physicsSystem.Update(FrameTime);
+
+					eventCount += physicsSystem.GetStatistics().ContactEvents;
+					droppedCount += physicsSystem.GetStatistics().ContactEventsDropped;
+				}
+			});
+
+		results.push_back({
+			std::format("Update ({} boxes, {} events/frame, {} dropped)", boxCount, eventCount / FrameCount, droppedCount),
+			totalMs / static_cast<float>(FrameCount)
+		});
+
+		scene->OnSimulationStop();
+	}
+
+	return results;
+}
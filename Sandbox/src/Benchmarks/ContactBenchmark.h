@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Measures the physics update with thousands of simultaneous contacts, while the contact events
+ * are pushed into the queue from the physics jobs and drained on the main thread.
+ * The boxes are placed overlapping each other on a static ground, so every box touches its neighbours.
+ * Before measuring, a small scene checks that the events are reported once per body pair.
+ */
+class ContactBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Physics contact events"; }
+	std::vector<BenchmarkResult> Run() override;
+
+private:
+	/// A body with two colliders touches the ground and a trigger with both, then leaves them
+	void CheckContactEvents();
+};
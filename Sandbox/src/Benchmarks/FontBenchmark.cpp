@@ -0,0 +1,27 @@
+#include "FontBenchmark.h"
+
+#include <filesystem>
+
+static constexpr auto FONT_PATH = "assets/fonts/Inter/Inter_18pt-Regular.ttf";
+
+std::vector<BenchmarkResult> FontBenchmark::Run()
+{
+	const std::filesystem::path fontPath = FindAsset(FONT_PATH);
+	if (fontPath.empty())
+		return {};
+
+	std::vector<BenchmarkResult> results;
+
+	/// Load once to find the cache file, then remove it so the first measured load is cold
+	std::filesystem::path cachePath;
+	{
+		const Kerberos::Font font("Benchmark", fontPath);
+		cachePath = font.GetAtlasCachePath();
+	}
+	std::filesystem::remove(cachePath);
+
+	results.push_back({ "Cold load (generate atlas)", MeasureMs([&] { const Kerberos::Font font("Benchmark", fontPath); }) });
+	results.push_back({ "Warm load (atlas cache)", MeasureMs([&] { const Kerberos::Font font("Benchmark", fontPath); }) });
+
+	return results;
+}
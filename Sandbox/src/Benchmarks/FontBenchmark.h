@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Compares loading a font without its atlas cache (FreeType loading and MSDF atlas generation)
+ * against loading it from the atlas cache.
+ */
+class FontBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Font loading (cold vs. warm cache)"; }
+	std::vector<BenchmarkResult> Run() override;
+};
@@ -0,0 +1,113 @@
+#include "HierarchyBenchmark.h"
+
+static constexpr uint32_t NodeCount = 100'000;
+static constexpr uint32_t ChildrenPerNode = 8;
+
+namespace
+{
+	/// The hierarchy representation the HierarchyComponent used before, linking entities through UUIDs
+	struct LegacyHierarchyComponent
+	{
+		Kerberos::UUID Parent = Kerberos::UUID::Invalid();
+		std::vector<Kerberos::UUID> Children;
+	};
+
+	struct LegacyScene
+	{
+		entt::registry Registry;
+		std::unordered_map<Kerberos::UUID, entt::entity> UUIDToEntityMap;
+
+		std::vector<entt::entity> GetChildren(const entt::entity parent) const
+		{
+			std::vector<entt::entity> children;
+			for (const auto& child : Registry.get<LegacyHierarchyComponent>(parent).Children)
+			{
+				children.push_back(UUIDToEntityMap.at(child));
+			}
+			return children;
+		}
+
+		void UpdateChildTransforms(const entt::entity parent, const glm::mat4& parentTransform)
+		{
+			auto& tc = Registry.get<Kerberos::TransformComponent>(parent);
+			tc.WorldTransform = parentTransform * tc.GetTransform();
+
+			for (const auto child : GetChildren(parent))
+			{
+				UpdateChildTransforms(child, tc.WorldTransform);
+			}
+		}
+	};
+
+	void UpdateLinkedTransforms(const Kerberos::Scene& scene, const Kerberos::Entity parent, const glm::mat4& parentTransform)
+	{
+		auto& tc = parent.GetComponent<Kerberos::TransformComponent>();
+		tc.WorldTransform = parentTransform * tc.GetTransform();
+
+		scene.ForEachChild(static_cast<entt::entity>(parent), [&scene, &tc](const entt::entity child)
+			{
+				UpdateLinkedTransforms(scene, { child, const_cast<Kerberos::Scene*>(&scene) }, tc.WorldTransform);
+			});
+	}
+}
+
+std::vector<BenchmarkResult> HierarchyBenchmark::Run()
+{
+	std::vector<BenchmarkResult> results;
+
+	/// Build the same tree in both representations, every node has ChildrenPerNode children
+	LegacyScene legacyScene;
+	const auto scene = Kerberos::CreateRef<Kerberos::Scene>();
+
+	std::vector<entt::entity> legacyEntities;
+	std::vector<Kerberos::Entity> entities;
+	legacyEntities.reserve(NodeCount);
+	entities.reserve(NodeCount);
+
+	for (uint32_t i = 0; i < NodeCount; ++i)
+	{
+		const glm::vec3 translation{ static_cast<float>(i % 7), static_cast<float>(i % 5), static_cast<float>(i % 3) };
+
+		Kerberos::Entity entity = scene->CreateEntity("Node");
+		entity.GetComponent<Kerberos::TransformComponent>().Translation = translation;
+		entities.push_back(entity);
+
+		const entt::entity legacyEntity = legacyScene.Registry.create();
+		legacyScene.Registry.emplace<Kerberos::TransformComponent>(legacyEntity, translation);
+		legacyScene.Registry.emplace<LegacyHierarchyComponent>(legacyEntity);
+		legacyScene.UUIDToEntityMap[entity.GetUUID()] = legacyEntity;
+		legacyEntities.push_back(legacyEntity);
+
+		if (i > 0)
+		{
+			const uint32_t parentIndex = (i - 1) / ChildrenPerNode;
+
+			scene->SetParent(entity, entities[parentIndex], false);
+
+			legacyScene.Registry.get<LegacyHierarchyComponent>(legacyEntity).Parent = entities[parentIndex].GetUUID();
+			legacyScene.Registry.get<LegacyHierarchyComponent>(legacyEntities[parentIndex]).Children.push_back(entity.GetUUID());
+		}
+	}
+
+	results.push_back({ "UUID children traversal",
+		MeasureMs([&] { legacyScene.UpdateChildTransforms(legacyEntities[0], glm::mat4(1.0f)); }) });
+
+	results.push_back({ "Linked handles traversal",
+		MeasureMs([&] { UpdateLinkedTransforms(*scene, entities[0], glm::mat4(1.0f)); }) });
+
+	results.push_back({ "CalculateEntityTransforms (rebuild levels)",
+		MeasureMs([&] { scene->CalculateEntityTransforms(); }) });
+
+	for (const auto& entity : entities)
+	{
+		entity.GetComponent<Kerberos::TransformComponent>().Dirty = true;
+	}
+
+	results.push_back({ "CalculateEntityTransforms (all dirty)",
+		MeasureMs([&] { scene->CalculateEntityTransforms(); }) });
+
+	results.push_back({ "CalculateEntityTransforms (none dirty)",
+		MeasureMs([&] { scene->CalculateEntityTransforms(); }) });
+
+	return results;
+}
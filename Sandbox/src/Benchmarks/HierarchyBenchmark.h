@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Compares the traversal of a 100k-node hierarchy stored with UUID child vectors (the previous representation)
+ * against the entity-handle links of the HierarchyComponent.
+ */
+class HierarchyBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Hierarchy traversal (100k nodes)"; }
+	std::vector<BenchmarkResult> Run() override;
+};
@@ -0,0 +1,34 @@
+#include "MeshBenchmark.h"
+
+#include "Kerberos/Assets/Importers/MeshImporter.h"
+
+#include <filesystem>
+
+static constexpr auto MODEL_PATH = "assets/models/deer_demo/scene.gltf";
+static constexpr uint32_t WarmLoadCount = 10;
+
+std::vector<BenchmarkResult> MeshBenchmark::Run()
+{
+	const std::filesystem::path modelPath = FindAsset(MODEL_PATH);
+	if (modelPath.empty())
+		return {};
+
+	std::vector<BenchmarkResult> results;
+
+	/// Remove the cooked file, so the first load goes through Assimp
+	std::filesystem::remove(Kerberos::MeshImporter::GetCookedMeshPath(modelPath));
+
+	results.push_back({ "Cold load (Assimp + cook)", MeasureMs([&] { Kerberos::MeshImporter importer; importer.ImportMesh(modelPath); }) });
+
+	const float warmMs = MeasureMs([&]
+		{
+			for (uint32_t i = 0; i < WarmLoadCount; ++i)
+			{
+				Kerberos::MeshImporter importer;
+				importer.ImportMesh(modelPath);
+			}
+		});
+	results.push_back({ "Warm load (cooked mesh)", warmMs / static_cast<float>(WarmLoadCount) });
+
+	return results;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Compares importing a model with Assimp (which also writes its cooked file)
+ * against loading the cooked mesh file.
+ */
+class MeshBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Mesh loading (Assimp vs. cooked)"; }
+	std::vector<BenchmarkResult> Run() override;
+};
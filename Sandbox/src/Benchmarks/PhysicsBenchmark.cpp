@@ -0,0 +1,42 @@
+#include "PhysicsBenchmark.h"
+
+#include "Kerberos/Scene/Components/PhysicsComponents.h"
+
+#include <array>
+#include <format>
+
+static constexpr std::array<uint32_t, 3> BodyCounts = { 10'000, 50'000, 100'000 };
+
+/// The bodies are placed on a grid of this many bodies per row
+static constexpr uint32_t GridSize = 512;
+
+std::vector<BenchmarkResult> PhysicsBenchmark::Run()
+{
+	std::vector<BenchmarkResult> results;
+
+	for (const uint32_t bodyCount : BodyCounts)
+	{
+		const auto scene = Kerberos::CreateRef<Kerberos::Scene>();
+
+		for (uint32_t i = 0; i < bodyCount; ++i)
+		{
+			Kerberos::Entity entity = scene->CreateEntity("Body");
+			entity.GetComponent<Kerberos::TransformComponent>().Translation = { static_cast<float>(i % GridSize) * 2.0f, 0.0f, static_cast<float>(i / GridSize) * 2.0f };
+			entity.AddComponent<Kerberos::RigidBody3DComponent>(Kerberos::RigidBody3DComponent::BodyType::Static);
+			entity.AddComponent<Kerberos::BoxCollider3DComponent>(glm::vec3(0.5f));
+		}
+
+		scene->CalculateEntityTransforms();
+
+		/// Without an active project the scene keeps these settings when the runtime starts
+		Kerberos::PhysicsSettings settings = scene->GetPhysicsSystem().GetSettings();
+		settings.MaxBodies = bodyCount;
+		scene->GetPhysicsSystem().SetSettings(settings);
+
+		results.push_back({ std::format("OnRuntimeStart ({} bodies)", bodyCount), MeasureMs([&] { scene->OnRuntimeStart(); }) });
+
+		scene->OnRuntimeStop();
+	}
+
+	return results;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Measures how long starting the runtime of a scene takes with 10k, 50k and 100k static bodies,
+ * which is dominated by creating the bodies and adding them to the physics world.
+ */
+class PhysicsBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Physics body creation"; }
+	std::vector<BenchmarkResult> Run() override;
+};
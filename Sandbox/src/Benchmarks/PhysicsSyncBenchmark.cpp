@@ -0,0 +1,83 @@
+#include "PhysicsSyncBenchmark.h"
+
+#include "Kerberos/Scene/Components/PhysicsComponents.h"
+
+#include <array>
+#include <format>
+
+static constexpr uint32_t BodyCount = 20'000;
+static constexpr std::array<uint32_t, 3> AwakeCounts = { 200, 2'000, 20'000 };
+
+/// The bodies are placed on a grid of this many bodies per row, far enough from each other not to touch
+static constexpr uint32_t GridSize = 200;
+static constexpr float BodySpacing = 2.0f;
+
+/// The awake bodies are falling from this height during the whole benchmark
+static constexpr float FallHeight = 100.0f;
+
+/// The resting bodies fall asleep during the warmup frames, before the measured ones
+static constexpr uint32_t WarmupFrameCount = 90;
+static constexpr uint32_t FrameCount = 120;
+static constexpr float FrameTime = 1.0f / 60.0f;
+
+std::vector<BenchmarkResult> PhysicsSyncBenchmark::Run()
+{
+	std::vector<BenchmarkResult> results;
+
+	for (const uint32_t awakeCount : AwakeCounts)
+	{
+		const auto scene = Kerberos::CreateRef<Kerberos::Scene>();
+
+		const float groundSize = static_cast<float>(GridSize) * BodySpacing;
+		Kerberos::Entity ground = scene->CreateEntity("Ground");
+		ground.GetComponent<Kerberos::TransformComponent>().Translation = { groundSize * 0.5f, -1.0f, groundSize * 0.5f };
+		ground.AddComponent<Kerberos::RigidBody3DComponent>(Kerberos::RigidBody3DComponent::BodyType::Static);
+		ground.AddComponent<Kerberos::BoxCollider3DComponent>(glm::vec3(groundSize, 0.5f, groundSize));
+
+		for (uint32_t i = 0; i < BodyCount; ++i)
+		{
+			/// The resting bodies are placed right on the ground, so they fall asleep quickly
+			const float height = i < awakeCount ? FallHeight : 0.0f;
+
+			Kerberos::Entity entity = scene->CreateEntity("Body");
+			entity.GetComponent<Kerberos::TransformComponent>().Translation = { static_cast<float>(i % GridSize) * BodySpacing, height, static_cast<float>(i / GridSize) * BodySpacing };
+			entity.AddComponent<Kerberos::RigidBody3DComponent>(Kerberos::RigidBody3DComponent::BodyType::Dynamic);
+			entity.AddComponent<Kerberos::BoxCollider3DComponent>(glm::vec3(0.5f));
+		}
+
+		scene->CalculateEntityTransforms();
+
+		/// Without an active project the scene keeps these settings when the simulation starts
+		Kerberos::PhysicsSettings settings = scene->GetPhysicsSystem().GetSettings();
+		settings.MaxBodies = BodyCount + 1;
+		settings.MaxStepsPerFrame = 1;
+		scene->GetPhysicsSystem().SetSettings(settings);
+
+		scene->OnSimulationStart();
+
+		Kerberos::IPhysicsSystem& physicsSystem = scene->GetPhysicsSystem();
+		for (uint32_t frame = 0; frame < WarmupFrameCount; ++frame)
+		{
+			physicsSystem.Update(FrameTime);
+		}
+
+		uint64_t activeBodyCount = 0;
+		const float totalMs = MeasureMs([&]
+			{
+				for (uint32_t frame = 0; frame < FrameCount; ++frame)
+				{
+					physicsSystem.Update(FrameTime);
+					activeBodyCount += physicsSystem.GetStatistics().ActiveBodies;
+				}
+			});
+
+		results.push_back({
+			std::format("Update ({} bodies, {} awake)", BodyCount, activeBodyCount / FrameCount),
+			totalMs / static_cast<float>(FrameCount)
+		});
+
+		scene->OnSimulationStop();
+	}
+
+	return results;
+}
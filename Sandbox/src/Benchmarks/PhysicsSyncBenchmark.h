@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Measures the physics update of 20k dynamic bodies, while only some of them are awake.
+ * Only the transforms of the awake bodies are synced, so the cost should follow their count.
+ */
+class PhysicsSyncBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Physics transform sync"; }
+	std::vector<BenchmarkResult> Run() override;
+};
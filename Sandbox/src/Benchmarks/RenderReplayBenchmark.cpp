@@ -0,0 +1,64 @@
+#include "RenderReplayBenchmark.h"
+
+#include "Platform/Null/NullRendererAPI.h"
+
+static constexpr uint32_t QuadCount = 100'000;
+
+namespace
+{
+	void RecordFrame()
+	{
+		const Kerberos::OrthographicCamera camera(-16.0f, 16.0f, -9.0f, 9.0f);
+
+		Kerberos::Renderer2D::BeginScene(camera);
+		for (uint32_t i = 0; i < QuadCount; ++i)
+		{
+			const glm::vec2 position = { static_cast<float>(i % 320) * 0.1f - 16.0f, static_cast<float>(i / 320 % 180) * 0.1f - 9.0f };
+			const glm::vec4 color = { static_cast<float>(i % 255) / 255.0f, 0.5f, 0.25f, 1.0f };
+			Kerberos::Renderer2D::DrawQuad(position, { 0.08f, 0.08f }, static_cast<float>(i % 90), color);
+		}
+		Kerberos::Renderer2D::EndScene();
+	}
+}
+
+std::vector<BenchmarkResult> RenderReplayBenchmark::Run()
+{
+	std::vector<BenchmarkResult> results;
+
+	if (Kerberos::RendererAPI::GetAPI() != Kerberos::RendererAPI::API::Null)
+	{
+		KBR_WARN("The render command replay benchmark needs the Null renderer, start the Sandbox with --null-renderer");
+		return results;
+	}
+
+	/// Also executes the commands recorded earlier in the frame, so they are not part of the statistics
+	Kerberos::NullRendererAPI::ResetStatistics();
+
+	results.push_back({ "Record frame (main thread)", MeasureMs(RecordFrame) });
+	results.push_back({ "Execute frame (render thread)", MeasureMs([] { Kerberos::RenderThread::Flush(); }) });
+	const Kerberos::NullRendererStatistics replayed = Kerberos::NullRendererAPI::GetStatistics();
+
+	Kerberos::NullRendererAPI::ResetStatistics();
+
+	/// Recorded on the render thread itself, so every command is executed right when it is submitted
+	results.push_back({ "Record and execute immediately", MeasureMs([] { Kerberos::RenderThread::SubmitAndWait([] { RecordFrame(); }); }) });
+	const Kerberos::NullRendererStatistics immediate = Kerberos::NullRendererAPI::GetStatistics();
+
+	KBR_INFO("  {} commands, {} draw calls, {} binds, {} KB uploaded",
+		replayed.CommandCount, replayed.DrawCalls, replayed.Binds, replayed.BytesUploaded / 1024);
+
+	/// The resources are hashed by the order of their first use, so the hash doesn't depend on which buffers of the ring the batches went to
+	if (replayed.CommandHash != immediate.CommandHash || replayed.CommandCount != immediate.CommandCount)
+	{
+		Fail(std::format("The replayed commands differ from executing them immediately ({} commands, {} immediately)",
+			replayed.CommandCount, immediate.CommandCount));
+	}
+
+	if (replayed.DrawCalls != immediate.DrawCalls || replayed.IndexCount != immediate.IndexCount || replayed.BytesUploaded != immediate.BytesUploaded)
+	{
+		Fail(std::format("The replayed draws differ from executing them immediately ({} draw calls, {} immediately)",
+			replayed.DrawCalls, immediate.DrawCalls));
+	}
+
+	return results;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Measures the CPU cost of recording a frame of 2D quads, and of executing it on the render thread.
+ * Needs the Null renderer (--null-renderer), which counts the executed commands,
+ * to check that the commands replayed on the render thread match executing them immediately.
+ */
+class RenderReplayBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Render command replay (Null renderer)"; }
+	std::vector<BenchmarkResult> Run() override;
+};
@@ -0,0 +1,180 @@
+#include "Renderer2DBenchmark.h"
+
+#include <array>
+
+static constexpr uint32_t QuadCount = 1'000'000;
+static constexpr uint32_t FrameCount = 3;
+/// More than fit in the texture slots of a batch
+static constexpr uint32_t SpriteCount = 64;
+
+namespace
+{
+	glm::vec2 GetQuadPosition(const uint32_t i)
+	{
+		return { static_cast<float>(i % 1000) * 0.032f - 16.0f, static_cast<float>(i / 1000) * 0.018f - 9.0f };
+	}
+
+	void DrawColoredQuads()
+	{
+		for (uint32_t i = 0; i < QuadCount; ++i)
+		{
+			const glm::vec4 color = { static_cast<float>(i % 255) / 255.0f, 0.5f, 0.25f, 1.0f };
+			Kerberos::Renderer2D::DrawQuad(GetQuadPosition(i), { 0.03f, 0.015f }, static_cast<float>(i % 90), color);
+		}
+	}
+
+	std::vector<Kerberos::QuadInstance> CreateQuadInstances()
+	{
+		std::vector<Kerberos::QuadInstance> quads(QuadCount);
+		for (uint32_t i = 0; i < QuadCount; ++i)
+		{
+			const glm::vec2 position = GetQuadPosition(i);
+			quads[i] = { { position.x, position.y, 0.0f }, { 0.03f, 0.015f }, static_cast<float>(i % 90), { static_cast<float>(i % 255) / 255.0f, 0.5f, 0.25f, 1.0f } };
+		}
+
+		return quads;
+	}
+
+	void DrawTexturedQuads(const Kerberos::Ref<Kerberos::Texture2D>& texture)
+	{
+		for (uint32_t i = 0; i < QuadCount; ++i)
+		{
+			Kerberos::Renderer2D::DrawTexturedQuad(GetQuadPosition(i), { 0.03f, 0.015f }, static_cast<float>(i % 90), texture);
+		}
+	}
+
+	/// Small sprites of different colors, drawn from separate textures and from an atlas
+	std::vector<std::array<uint8_t, 4 * 4 * 4>> CreateSpritePixels()
+	{
+		std::vector<std::array<uint8_t, 4 * 4 * 4>> sprites(SpriteCount);
+		for (uint32_t i = 0; i < SpriteCount; ++i)
+		{
+			for (uint32_t pixel = 0; pixel < 4 * 4; ++pixel)
+			{
+				sprites[i][pixel * 4 + 0] = static_cast<uint8_t>(i * 4);
+				sprites[i][pixel * 4 + 1] = static_cast<uint8_t>(255 - i * 4);
+				sprites[i][pixel * 4 + 2] = static_cast<uint8_t>(pixel * 16);
+				sprites[i][pixel * 4 + 3] = 255;
+			}
+		}
+
+		return sprites;
+	}
+
+	template<typename TSprite>
+	void DrawSprites(const std::vector<TSprite>& sprites)
+	{
+		for (uint32_t i = 0; i < QuadCount; ++i)
+		{
+			Kerberos::Renderer2D::DrawTexturedQuad(GetQuadPosition(i), { 0.03f, 0.015f }, 0.0f, sprites[i % SpriteCount]);
+		}
+	}
+
+	/// Records the frames and executes them, returns the time of the whole run
+	template<typename Fn>
+	float MeasureFrames(Fn&& drawQuads)
+	{
+		const Kerberos::OrthographicCamera camera(-16.0f, 16.0f, -9.0f, 9.0f);
+
+		return MeasureMs([&]
+			{
+				for (uint32_t frame = 0; frame < FrameCount; ++frame)
+				{
+					Kerberos::Renderer2D::BeginScene(camera);
+					drawQuads();
+					Kerberos::Renderer2D::EndScene();
+
+					Kerberos::RenderThread::Kick();
+				}
+
+				Kerberos::RenderThread::Flush();
+			});
+	}
+
+	void LogThroughput(const std::string& name, const float durationMs)
+	{
+		const Kerberos::Renderer2D::Statistics stats = Kerberos::Renderer2D::GetStatistics();
+
+		KBR_INFO("  {}: {:.0f} quads/ms, {} draw calls, {} texture limit flushes, {} vertex buffer waits, {} MB of vertex data",
+			name, static_cast<float>(stats.QuadCount) / durationMs, stats.DrawCalls, stats.TextureLimitFlushes, stats.VertexBufferWaits, stats.VertexDataSize / (1024 * 1024));
+	}
+
+	const char* GetQuadModeName(const Kerberos::Renderer2DQuadMode mode)
+	{
+		return mode == Kerberos::Renderer2DQuadMode::Instanced ? "Instanced" : "Vertices";
+	}
+}
+
+std::vector<BenchmarkResult> Renderer2DBenchmark::Run()
+{
+	std::vector<BenchmarkResult> results;
+
+	/// The frame recorded before the benchmark should not be measured
+	Kerberos::RenderThread::Flush();
+
+	/// The same quads as the colored ones, built up front like a particle system or the scene would
+	const std::vector<Kerberos::QuadInstance> quads = CreateQuadInstances();
+	const Kerberos::Ref<Kerberos::Texture2D> texture = Kerberos::AssetManager::GetDefaultTexture2D();
+
+	/// The same sprites as separate textures, and packed into an atlas
+	Kerberos::TextureSpecification spriteSpec;
+	spriteSpec.Width = 4;
+	spriteSpec.Height = 4;
+
+	std::vector<Kerberos::Ref<Kerberos::Texture2D>> spriteTextures;
+	Kerberos::TextureAtlasBuilder atlasBuilder;
+	for (auto& pixels : CreateSpritePixels())
+	{
+		Kerberos::Buffer data;
+		data.Data = pixels.data();
+		data.Size = pixels.size();
+
+		spriteTextures.push_back(Kerberos::Texture2D::Create(spriteSpec, data));
+		atlasBuilder.Add(spriteSpec, pixels.data());
+	}
+
+	const Kerberos::Ref<Kerberos::TextureAtlas> atlas = atlasBuilder.Build("Renderer2DBenchmark Atlas");
+
+	const Kerberos::Renderer2DSpecification previousSpecification = Kerberos::Renderer2D::GetSpecification();
+
+	/// Both modes are measured with the same quads, Renderer2D is initialized again for each of them
+	for (const Kerberos::Renderer2DQuadMode mode : { Kerberos::Renderer2DQuadMode::Vertices, Kerberos::Renderer2DQuadMode::Instanced })
+	{
+		Kerberos::Renderer2D::Shutdown();
+		Kerberos::Renderer2D::Init({ mode });
+
+		const std::string prefix = std::string("[") + GetQuadModeName(mode) + "] ";
+
+		Kerberos::Renderer2D::ResetStatistics();
+		const float coloredMs = MeasureFrames(DrawColoredQuads);
+		results.push_back({ prefix + "Colored quads (3 frames)", coloredMs });
+		LogThroughput(prefix + "Colored quads", coloredMs);
+
+		Kerberos::Renderer2D::ResetStatistics();
+		const float bulkMs = MeasureFrames([&quads] { Kerberos::Renderer2D::DrawQuads(quads); });
+		results.push_back({ prefix + "Colored quads with DrawQuads (3 frames)", bulkMs });
+		LogThroughput(prefix + "Colored quads with DrawQuads", bulkMs);
+
+		Kerberos::Renderer2D::ResetStatistics();
+		const float texturedMs = MeasureFrames([&texture] { DrawTexturedQuads(texture); });
+		results.push_back({ prefix + "Textured quads (3 frames)", texturedMs });
+		LogThroughput(prefix + "Textured quads", texturedMs);
+
+		Kerberos::Renderer2D::ResetStatistics();
+		const float spritesMs = MeasureFrames([&spriteTextures] { DrawSprites(spriteTextures); });
+		results.push_back({ prefix + "64 sprite textures (3 frames)", spritesMs });
+		LogThroughput(prefix + "64 sprite textures", spritesMs);
+
+		Kerberos::Renderer2D::ResetStatistics();
+		const float atlasMs = MeasureFrames([&atlas] { DrawSprites(atlas->GetSubTextures()); });
+		results.push_back({ prefix + "64 sprites from an atlas (3 frames)", atlasMs });
+		LogThroughput(prefix + "64 sprites from an atlas", atlasMs);
+	}
+
+	Kerberos::Renderer2D::Shutdown();
+	Kerberos::Renderer2D::Init(previousSpecification);
+
+	Kerberos::Renderer2D::ResetStatistics();
+
+	return results;
+}
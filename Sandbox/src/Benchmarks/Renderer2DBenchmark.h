@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Streams a million colored and textured quads through Renderer2D, one by one and with DrawQuads, and reports the throughput in quads per millisecond.
+ * The time includes executing the frame on the render thread, so waiting for the vertex buffers is part of it.
+ * Runs once with the quads expanded to vertices and once instanced, to compare the two modes.
+ * Sprites from more textures than a batch can bind are drawn from separate textures and from a TextureAtlas.
+ */
+class Renderer2DBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Renderer2D throughput (1M quads)"; }
+	std::vector<BenchmarkResult> Run() override;
+};
@@ -0,0 +1,386 @@
+#include "SceneBenchmark.h"
+
+#include "Kerberos/Scene/Components/AudioComponents.h"
+#include "Kerberos/Scene/Components/PhysicsComponents.h"
+#include "Kerberos/Scripting/ScriptClass.h"
+#include "Kerberos/Scripting/ScriptEngine.h"
+
+#include <filesystem>
+#include <format>
+
+static constexpr uint32_t EntityCount = 100'000;
+static constexpr uint32_t ChildrenPerEntity = 8;
+
+static constexpr auto YAML_PATH = "SceneBenchmark.kerberos";
+static constexpr auto BINARY_PATH = "SceneBenchmark.kbrscene";
+/// Every text component loads the default font from the working directory, the Sandbox has a copy of it in its assets
+static constexpr auto FONT_PATH = "assets/fonts/Inter/Inter_18pt-Regular.ttf";
+
+namespace
+{
+	/// The script fields are stored by the ScriptEngine per entity UUID, so the loaded scenes share them with the source scene
+	using ScriptFieldSnapshot = std::unordered_map<Kerberos::UUID, std::unordered_map<std::string, Kerberos::ScriptFieldInitializer>>;
+
+	/**
+	 * Compares a serialized component of the entities, it has to be present on both of them or on neither.
+	 */
+	template<typename Component, typename Fn>
+	bool ComponentsMatch(const Kerberos::Entity& entity, const Kerberos::Entity& loadedEntity, Fn&& equal)
+	{
+		const bool hasComponent = entity.HasComponent<Component>();
+		if (hasComponent != loadedEntity.HasComponent<Component>())
+			return false;
+
+		return !hasComponent || equal(entity.GetComponent<Component>(), loadedEntity.GetComponent<Component>());
+	}
+
+	bool CamerasMatch(const Kerberos::CameraComponent& a, const Kerberos::CameraComponent& b)
+	{
+		return a.Camera.GetProjectionType() == b.Camera.GetProjectionType()
+			&& a.Camera.GetPerspectiveFov() == b.Camera.GetPerspectiveFov()
+			&& a.Camera.GetPerspectiveNearClip() == b.Camera.GetPerspectiveNearClip()
+			&& a.Camera.GetPerspectiveFarClip() == b.Camera.GetPerspectiveFarClip()
+			&& a.Camera.GetOrthographicSize() == b.Camera.GetOrthographicSize()
+			&& a.Camera.GetOrthographicNearClip() == b.Camera.GetOrthographicNearClip()
+			&& a.Camera.GetOrthographicFarClip() == b.Camera.GetOrthographicFarClip()
+			&& a.IsPrimary == b.IsPrimary
+			&& a.FixedAspectRatio == b.FixedAspectRatio;
+	}
+
+	bool ScriptFieldsMatch(const std::unordered_map<std::string, Kerberos::ScriptFieldInitializer>& fields, const std::unordered_map<std::string, Kerberos::ScriptFieldInitializer>& loadedFields)
+	{
+		if (fields.size() != loadedFields.size())
+			return false;
+
+		/// Only the first 16 bytes of a field are serialized, the test scene has no string fields
+		using FieldData = std::array<std::byte, 16>;
+		for (const auto& [name, field] : fields)
+		{
+			const auto it = loadedFields.find(name);
+			if (it == loadedFields.end() || it->second.Field.Type != field.Field.Type || it->second.GetValue<FieldData>() != field.GetValue<FieldData>())
+				return false;
+		}
+
+		return true;
+	}
+
+	bool StaticMeshesMatch(const Kerberos::StaticMeshComponent& a, const Kerberos::StaticMeshComponent& b)
+	{
+		/// A missing mesh is loaded as the default cube
+		const bool meshMatches = a.StaticMesh ? b.StaticMesh && a.StaticMesh->GetHandle() == b.StaticMesh->GetHandle() : b.StaticMesh != nullptr;
+		const bool textureMatches = a.MeshTexture ? b.MeshTexture && a.MeshTexture->GetHandle() == b.MeshTexture->GetHandle() : !b.MeshTexture;
+		const bool materialMatches = !a.MeshMaterial || (b.MeshMaterial
+			&& a.MeshMaterial->Ambient == b.MeshMaterial->Ambient
+			&& a.MeshMaterial->Diffuse == b.MeshMaterial->Diffuse
+			&& a.MeshMaterial->Specular == b.MeshMaterial->Specular
+			&& a.MeshMaterial->Shininess == b.MeshMaterial->Shininess);
+
+		return meshMatches && textureMatches && materialMatches;
+	}
+
+	template<typename AudioSource>
+	bool AudioSourcesMatch(const AudioSource& a, const AudioSource& b)
+	{
+		return static_cast<bool>(a.SoundAsset) == static_cast<bool>(b.SoundAsset)
+			&& (!a.SoundAsset || a.SoundAsset->GetHandle() == b.SoundAsset->GetHandle())
+			&& a.Loop == b.Loop
+			&& a.Volume == b.Volume;
+	}
+
+	/// A missing collider mesh is loaded as the mesh of the static mesh
+	bool MeshCollidersMatch(const Kerberos::MeshCollider3DComponent& a, const Kerberos::MeshCollider3DComponent& b, const Kerberos::Entity& loadedEntity)
+	{
+		if (a.IsTrigger != b.IsTrigger)
+			return false;
+
+		if (a.Mesh)
+			return b.Mesh && a.Mesh->GetHandle() == b.Mesh->GetHandle();
+
+		const auto* staticMesh = loadedEntity.HasComponent<Kerberos::StaticMeshComponent>() ? &loadedEntity.GetComponent<Kerberos::StaticMeshComponent>() : nullptr;
+		return b.Mesh == (staticMesh ? staticMesh->StaticMesh : nullptr);
+	}
+
+	bool EntitiesMatch(const Kerberos::Scene& source, const Kerberos::Scene& loaded, const Kerberos::Entity& entity, const Kerberos::Entity& loadedEntity, const ScriptFieldSnapshot& scriptFields)
+	{
+		using namespace Kerberos;
+
+		const Entity parent = source.GetParent(entity);
+		const Entity loadedParent = loaded.GetParent(loadedEntity);
+		if (static_cast<bool>(parent) != static_cast<bool>(loadedParent) || (parent && parent.GetUUID() != loadedParent.GetUUID()))
+			return false;
+
+		const auto script = [&](const ScriptComponent& a, const ScriptComponent& b)
+			{
+				static const std::unordered_map<std::string, ScriptFieldInitializer> noFields;
+
+				const auto it = scriptFields.find(entity.GetUUID());
+				return a.ClassName == b.ClassName
+					&& ScriptFieldsMatch(it != scriptFields.end() ? it->second : noFields, ScriptEngine::GetScriptFieldInitializerMap(loadedEntity));
+			};
+
+		return ComponentsMatch<TagComponent>(entity, loadedEntity, [](const auto& a, const auto& b) { return a.Tag == b.Tag; })
+			&& ComponentsMatch<TransformComponent>(entity, loadedEntity, [](const auto& a, const auto& b)
+				{
+					return a.Translation == b.Translation && a.Rotation == b.Rotation && a.Scale == b.Scale;
+				})
+			&& ComponentsMatch<SpriteRendererComponent>(entity, loadedEntity, [](const auto& a, const auto& b) { return a.Color == b.Color; })
+			&& ComponentsMatch<CameraComponent>(entity, loadedEntity, CamerasMatch)
+			&& ComponentsMatch<ScriptComponent>(entity, loadedEntity, script)
+			&& ComponentsMatch<DirectionalLightComponent>(entity, loadedEntity, [](const auto& a, const auto& b)
+				{
+					return a.Light.Color == b.Light.Color && a.Light.Direction == b.Light.Direction && a.Light.Intensity == b.Light.Intensity;
+				})
+			&& ComponentsMatch<PointLightComponent>(entity, loadedEntity, [](const auto& a, const auto& b)
+				{
+					return a.Light.Color == b.Light.Color && a.Light.Position == b.Light.Position && a.Light.Intensity == b.Light.Intensity
+						&& a.Light.Constant == b.Light.Constant && a.Light.Linear == b.Light.Linear && a.Light.Quadratic == b.Light.Quadratic;
+				})
+			&& ComponentsMatch<SpotLightComponent>(entity, loadedEntity, [](const auto& a, const auto& b)
+				{
+					return a.Light.Color == b.Light.Color && a.Light.Position == b.Light.Position && a.Light.Direction == b.Light.Direction
+						&& a.Light.Intensity == b.Light.Intensity && a.Light.Constant == b.Light.Constant && a.Light.Linear == b.Light.Linear
+						&& a.Light.Quadratic == b.Light.Quadratic && a.Light.CutOffAngleRadians == b.Light.CutOffAngleRadians
+						&& a.Light.OuterCutOffAngleRadians == b.Light.OuterCutOffAngleRadians;
+				})
+			&& ComponentsMatch<RigidBody3DComponent>(entity, loadedEntity, [](const auto& a, const auto& b)
+				{
+					return a.Mass == b.Mass && a.Type == b.Type && a.Velocity == b.Velocity && a.AngularVelocity == b.AngularVelocity
+						&& a.UseGravity == b.UseGravity && a.Friction == b.Friction && a.Restitution == b.Restitution;
+				})
+			&& ComponentsMatch<BoxCollider3DComponent>(entity, loadedEntity, [](const auto& a, const auto& b) { return a.Size == b.Size && a.Offset == b.Offset; })
+			&& ComponentsMatch<SphereCollider3DComponent>(entity, loadedEntity, [](const auto& a, const auto& b) { return a.Radius == b.Radius && a.Offset == b.Offset; })
+			&& ComponentsMatch<CapsuleCollider3DComponent>(entity, loadedEntity, [](const auto& a, const auto& b)
+				{
+					return a.Radius == b.Radius && a.Height == b.Height && a.Offset == b.Offset;
+				})
+			&& ComponentsMatch<MeshCollider3DComponent>(entity, loadedEntity, [&loadedEntity](const auto& a, const auto& b)
+				{
+					return MeshCollidersMatch(a, b, loadedEntity);
+				})
+			&& ComponentsMatch<StaticMeshComponent>(entity, loadedEntity, StaticMeshesMatch)
+			&& ComponentsMatch<EnvironmentComponent>(entity, loadedEntity, [](const auto& a, const auto& b)
+				{
+					return a.SkyboxTexture == b.SkyboxTexture && a.IsSkyboxEnabled == b.IsSkyboxEnabled;
+				})
+			&& ComponentsMatch<TextComponent>(entity, loadedEntity, [](const auto& a, const auto& b)
+				{
+					return a.Text == b.Text && a.FontSize == b.FontSize && a.Color == b.Color;
+				})
+			&& ComponentsMatch<AudioSource3DComponent>(entity, loadedEntity, AudioSourcesMatch<AudioSource3DComponent>)
+			&& ComponentsMatch<AudioSource2DComponent>(entity, loadedEntity, AudioSourcesMatch<AudioSource2DComponent>)
+			&& ComponentsMatch<AudioListenerComponent>(entity, loadedEntity, [](const auto& a, const auto& b) { return a.Volume == b.Volume; });
+	}
+
+	/**
+	 * Checks that every entity of the source scene was loaded with the same components and values.
+	 *
+	 * @return The number of entities that differ
+	 */
+	uint32_t CountMismatches(const Kerberos::Scene& source, Kerberos::Scene& loaded, const std::vector<Kerberos::Entity>& entities, const ScriptFieldSnapshot& scriptFields)
+	{
+		uint32_t mismatches = 0;
+		for (const auto& entity : entities)
+		{
+			Kerberos::Entity loadedEntity;
+			try
+			{
+				loadedEntity = loaded.GetEntityByUUID(entity.GetUUID());
+			}
+			catch (const std::out_of_range&)
+			{
+				++mismatches;
+				continue;
+			}
+
+			if (!EntitiesMatch(source, loaded, entity, loadedEntity, scriptFields))
+				++mismatches;
+		}
+
+		if (loaded.GetRootEntities().size() != source.GetRootEntities().size())
+			++mismatches;
+
+		return mismatches;
+	}
+
+	/// Gives every serialized component type a few entities, with values different from the defaults
+	void AddTestComponents(Kerberos::Entity entity, const uint32_t i, const bool addText)
+	{
+		using namespace Kerberos;
+
+		const float value = static_cast<float>(i % 17) * 0.25f;
+
+		if (i % 10 == 0)
+		{
+			auto& pointLight = entity.AddComponent<PointLightComponent>();
+			pointLight.Light.Color = { value, 0.5f, 1.0f };
+			pointLight.Light.Intensity = 2.0f + value;
+			pointLight.Light.Linear = 0.5f;
+		}
+
+		switch (i % 100)
+		{
+		case 1:
+		{
+			auto& camera = entity.AddComponent<CameraComponent>();
+			camera.Camera.SetProjectionType(SceneCamera::ProjectionType::Orthographic);
+			camera.Camera.SetOrthographicSize(5.0f + value);
+			camera.Camera.SetPerspectiveFov(1.0f);
+			camera.IsPrimary = false;
+			camera.FixedAspectRatio = true;
+			break;
+		}
+		case 2:
+		{
+			entity.AddComponent<ScriptComponent>().ClassName = "Sandbox.Player";
+
+			auto& fields = ScriptEngine::GetScriptFieldInitializerMap(entity);
+			const auto addField = [&fields](const std::string& name, const ScriptFieldType type, const auto& fieldValue)
+				{
+					ScriptFieldInitializer initializer;
+					initializer.Field.Name = name;
+					initializer.Field.Type = type;
+					initializer.SetValue(fieldValue);
+					fields[name] = initializer;
+				};
+
+			addField("Speed", ScriptFieldType::Float, value);
+			addField("Health", ScriptFieldType::Int, static_cast<int>(i));
+			addField("Offset", ScriptFieldType::Vec3, glm::vec3(value, 1.0f, -value));
+			addField("Enabled", ScriptFieldType::Bool, i % 200 == 2);
+			break;
+		}
+		case 3:
+		{
+			auto& rigidBody = entity.AddComponent<RigidBody3DComponent>(RigidBody3DComponent::BodyType::Dynamic);
+			rigidBody.Mass = 1.0f + value;
+			rigidBody.Velocity = { value, 0.0f, 1.0f };
+			rigidBody.UseGravity = false;
+			rigidBody.Friction = 0.25f;
+			entity.AddComponent<BoxCollider3DComponent>(glm::vec3(1.0f + value), glm::vec3(0.0f, value, 0.0f));
+			break;
+		}
+		case 4:
+			entity.AddComponent<RigidBody3DComponent>(RigidBody3DComponent::BodyType::Static);
+			entity.AddComponent<SphereCollider3DComponent>(0.5f + value, glm::vec3(value, 0.0f, 0.0f));
+			entity.AddComponent<CapsuleCollider3DComponent>(0.5f, 2.0f + value);
+			break;
+		case 5:
+		case 6:
+			/// The missing mesh is replaced by the default cube, which is created for every loaded entity, so only a few have one
+			if (i % 1000 == 5 || i % 1000 == 6)
+			{
+				/// Not the default cube, its handle isn't an asset of a project, so it couldn't be loaded
+				auto& staticMesh = entity.AddComponent<StaticMeshComponent>(nullptr, CreateRef<Material>());
+				staticMesh.MeshMaterial->Diffuse = { value, 0.5f, 0.25f };
+				staticMesh.MeshMaterial->Shininess = 32.0f;
+
+				/// The mesh collider needs a static mesh on its entity
+				if (i % 1000 == 5)
+					entity.AddComponent<MeshCollider3DComponent>().IsTrigger = true;
+			}
+			break;
+		case 7:
+		{
+			if (!addText)
+				break;
+
+			auto& text = entity.AddComponent<TextComponent>();
+			text.Text = std::format("Text {}", i);
+			text.FontSize = 16.0f + value;
+			text.Color = { 1.0f, value, 0.0f, 1.0f };
+			break;
+		}
+		case 8:
+		{
+			auto& audioSource = entity.AddComponent<AudioSource3DComponent>();
+			audioSource.Loop = true;
+			audioSource.Volume = 0.5f;
+			break;
+		}
+		case 9:
+			entity.AddComponent<AudioSource2DComponent>().Volume = 0.25f;
+			entity.AddComponent<AudioListenerComponent>().Volume = 0.75f;
+			break;
+		default:
+			break;
+		}
+	}
+
+	/// Copies the script fields of the source scene, and removes them so the loaded scene has to fill them again
+	ScriptFieldSnapshot TakeScriptFields(const std::vector<Kerberos::Entity>& entities)
+	{
+		ScriptFieldSnapshot snapshot;
+		for (const auto& entity : entities)
+		{
+			if (entity.HasComponent<Kerberos::ScriptComponent>())
+				snapshot[entity.GetUUID()] = std::exchange(Kerberos::ScriptEngine::GetScriptFieldInitializerMap(entity), {});
+		}
+
+		return snapshot;
+	}
+
+	void ClearScriptFields(const ScriptFieldSnapshot& snapshot, const std::vector<Kerberos::Entity>& entities)
+	{
+		for (const auto& entity : entities)
+		{
+			if (snapshot.contains(entity.GetUUID()))
+				Kerberos::ScriptEngine::GetScriptFieldInitializerMap(entity).clear();
+		}
+	}
+}
+
+std::vector<BenchmarkResult> SceneBenchmark::Run()
+{
+	std::vector<BenchmarkResult> results;
+
+	const auto scene = Kerberos::CreateRef<Kerberos::Scene>();
+
+	const bool addText = std::filesystem::exists(FONT_PATH);
+	if (!addText)
+		Fail(std::format("Missing the default font {}, the text components are not checked", FONT_PATH));
+
+	std::vector<Kerberos::Entity> entities;
+	entities.reserve(EntityCount);
+
+	for (uint32_t i = 0; i < EntityCount; ++i)
+	{
+		Kerberos::Entity entity = scene->CreateEntity("Entity " + std::to_string(i % 100));
+
+		auto& transform = entity.GetComponent<Kerberos::TransformComponent>();
+		transform.Translation = { static_cast<float>(i % 7), static_cast<float>(i % 5), static_cast<float>(i % 3) };
+		transform.Rotation = { 0.0f, static_cast<float>(i % 11) * 0.1f, 0.0f };
+
+		entity.AddComponent<Kerberos::SpriteRendererComponent>(glm::vec4{ static_cast<float>(i % 255) / 255.0f, 0.5f, 0.25f, 1.0f });
+		AddTestComponents(entity, i, addText);
+
+		if (i > 0)
+			scene->SetParent(entity, entities[(i - 1) / ChildrenPerEntity], false);
+
+		entities.push_back(entity);
+	}
+
+	Kerberos::SceneSerializer serializer(scene);
+	results.push_back({ "Save YAML", MeasureMs([&] { serializer.Serialize(YAML_PATH); }) });
+	results.push_back({ "Save binary", MeasureMs([&] { serializer.SerializeRuntime(BINARY_PATH); }) });
+
+	const auto yamlScene = Kerberos::CreateRef<Kerberos::Scene>();
+	const auto binaryScene = Kerberos::CreateRef<Kerberos::Scene>();
+
+	/// Both formats must load back into the scene they were saved from
+	const ScriptFieldSnapshot scriptFields = TakeScriptFields(entities);
+
+	results.push_back({ "Load YAML", MeasureMs([&] { Kerberos::SceneSerializer(yamlScene).Deserialize(YAML_PATH); }) });
+	if (const uint32_t mismatches = CountMismatches(*scene, *yamlScene, entities, scriptFields); mismatches > 0)
+		Fail(std::format("{} entities differ after the YAML round trip", mismatches));
+
+	ClearScriptFields(scriptFields, entities);
+
+	results.push_back({ "Load binary", MeasureMs([&] { Kerberos::SceneSerializer(binaryScene).DeserializeRuntime(BINARY_PATH); }) });
+	if (const uint32_t mismatches = CountMismatches(*scene, *binaryScene, entities, scriptFields); mismatches > 0)
+		Fail(std::format("{} entities differ after the binary round trip", mismatches));
+
+	std::filesystem::remove(YAML_PATH);
+	std::filesystem::remove(BINARY_PATH);
+
+	return results;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Compares loading a 100k-entity scene from YAML against the binary runtime format,
+ * and checks that both files load back every serialized component of the scene.
+ */
+class SceneBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Scene loading (100k entities)"; }
+	std::vector<BenchmarkResult> Run() override;
+};
@@ -0,0 +1,211 @@
+#include "ThreadPoolBenchmark.h"
+
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <format>
+#include <queue>
+#include <thread>
+
+import ThreadPool;
+
+static constexpr std::array<int, 6> ThreadCounts = { 1, 2, 4, 8, 16, 32 };
+
+static constexpr uint32_t TaskCount = 100'000;
+
+static constexpr uint32_t ElementCount = 1 << 22;
+static constexpr uint32_t GrainSize = 4096;
+
+namespace
+{
+	/// The thread pool used before, a single queue of std::functions guarded by one mutex
+	class LegacyThreadPool
+	{
+	public:
+		explicit LegacyThreadPool(const int threadCount)
+		{
+			for (int i = 0; i < threadCount; ++i)
+			{
+				m_Workers.emplace_back([this]
+					{
+						while (true)
+						{
+							std::function<void()> task;
+							{
+								std::unique_lock<std::mutex> lock(m_QueueMutex);
+								m_Condition.wait(lock, [this] { return !m_TaskQueue.empty() || m_Stop; });
+
+								if (m_Stop && m_TaskQueue.empty())
+									return;
+
+								task = std::move(m_TaskQueue.front());
+								m_TaskQueue.pop();
+							}
+
+							task();
+						}
+					});
+			}
+		}
+
+		~LegacyThreadPool()
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_QueueMutex);
+				m_Stop = true;
+			}
+			m_Condition.notify_all();
+
+			for (std::thread& worker : m_Workers)
+			{
+				worker.join();
+			}
+		}
+
+		void Enqueue(std::function<void()> task)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_QueueMutex);
+				m_TaskQueue.emplace(std::move(task));
+			}
+			m_Condition.notify_one();
+		}
+
+	private:
+		std::vector<std::thread> m_Workers;
+		std::queue<std::function<void()>> m_TaskQueue;
+		std::mutex m_QueueMutex;
+		std::condition_variable m_Condition;
+		bool m_Stop = false;
+	};
+
+	/// The old pool can't wait for its tasks, so they count down and the caller spins until they are done
+	void WaitForCount(const std::atomic<uint32_t>& remaining)
+	{
+		while (remaining.load(std::memory_order_acquire) > 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	/// The old pool has no parallel for, the range is split into grain sized tasks up front
+	void LegacyParallelFor(LegacyThreadPool& pool, const uint32_t count, const uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& fn)
+	{
+		std::atomic<uint32_t> remaining = (count + grainSize - 1) / grainSize;
+		for (uint32_t begin = 0; begin < count; begin += grainSize)
+		{
+			const uint32_t end = std::min(begin + grainSize, count);
+			pool.Enqueue([&fn, &remaining, begin, end]
+				{
+					fn(begin, end);
+					remaining.fetch_sub(1, std::memory_order_release);
+				});
+		}
+
+		WaitForCount(remaining);
+	}
+}
+
+std::vector<BenchmarkResult> ThreadPoolBenchmark::Run()
+{
+	std::vector<BenchmarkResult> results;
+
+	std::vector<float> values(ElementCount);
+	for (uint32_t i = 0; i < ElementCount; ++i)
+	{
+		values[i] = static_cast<float>(i);
+	}
+
+	std::atomic<double> sum = 0.0;
+	const auto sumRange = [&values, &sum](const uint32_t begin, const uint32_t end)
+		{
+			double partial = 0.0;
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				partial += std::sqrt(values[i]);
+			}
+			sum.fetch_add(partial, std::memory_order_relaxed);
+		};
+
+	std::atomic<uint64_t> counter = 0;
+
+	for (const int threadCount : ThreadCounts)
+	{
+		{
+			LegacyThreadPool pool(threadCount);
+
+			results.push_back({ std::format("Legacy enqueue {} tasks ({} threads)", TaskCount, threadCount), MeasureMs([&]
+				{
+					std::atomic<uint32_t> remaining = TaskCount;
+					for (uint32_t i = 0; i < TaskCount; ++i)
+					{
+						pool.Enqueue([&counter, &remaining]
+							{
+								counter.fetch_add(1, std::memory_order_relaxed);
+								remaining.fetch_sub(1, std::memory_order_release);
+							});
+					}
+					WaitForCount(remaining);
+				}) });
+
+			results.push_back({ std::format("Legacy nested enqueue {} tasks ({} threads)", TaskCount, threadCount), MeasureMs([&]
+				{
+					std::atomic<uint32_t> remaining = TaskCount;
+					pool.Enqueue([&pool, &counter, &remaining]
+						{
+							for (uint32_t i = 0; i < TaskCount; ++i)
+							{
+								pool.Enqueue([&counter, &remaining]
+									{
+										counter.fetch_add(1, std::memory_order_relaxed);
+										remaining.fetch_sub(1, std::memory_order_release);
+									});
+							}
+						});
+					WaitForCount(remaining);
+				}) });
+
+			results.push_back({ std::format("Legacy parallel for ({} threads)", threadCount), MeasureMs([&]
+				{
+					LegacyParallelFor(pool, ElementCount, GrainSize, sumRange);
+				}) });
+		}
+
+		{
+			Kerberos::ThreadPool pool(threadCount);
+
+			results.push_back({ std::format("Work-stealing enqueue {} tasks ({} threads)", TaskCount, threadCount), MeasureMs([&]
+				{
+					Kerberos::TaskGroup group;
+					for (uint32_t i = 0; i < TaskCount; ++i)
+					{
+						pool.Enqueue([&counter] { counter.fetch_add(1, std::memory_order_relaxed); }, Kerberos::TaskPriority::Normal, &group);
+					}
+					pool.Wait(group);
+				}) });
+
+			/// Tasks spawned by a worker go to its own deque, which is where the work-stealing pool avoids the contention
+			results.push_back({ std::format("Work-stealing nested enqueue {} tasks ({} threads)", TaskCount, threadCount), MeasureMs([&]
+				{
+					Kerberos::TaskGroup group;
+					pool.Enqueue([&pool, &counter, &group]
+						{
+							for (uint32_t i = 0; i < TaskCount; ++i)
+							{
+								pool.Enqueue([&counter] { counter.fetch_add(1, std::memory_order_relaxed); }, Kerberos::TaskPriority::Normal, &group);
+							}
+						}, Kerberos::TaskPriority::Normal, &group);
+					pool.Wait(group);
+				}) });
+
+			results.push_back({ std::format("Work-stealing parallel for ({} threads)", threadCount), MeasureMs([&]
+				{
+					pool.ParallelFor(ElementCount, GrainSize, sumRange);
+				}) });
+		}
+	}
+
+	KBR_INFO("Thread pool benchmark ran {} tasks, sum: {}", counter.load(), sum.load());
+
+	return results;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Benchmark.h"
+
+/**
+ * Compares the work-stealing thread pool with the single queue pool it replaced, on 1 to 32 threads.
+ * Measures the throughput of enqueueing tiny tasks from outside and from inside the pool, and the scaling of a parallel for.
+ */
+class ThreadPoolBenchmark : public Benchmark
+{
+public:
+	const char* GetName() const override { return "Thread pool"; }
+	std::vector<BenchmarkResult> Run() override;
+};
@@ -186,6 +186,8 @@ void Sandbox2D::OnImGuiRender()
 	ImGui::Text("Quads: %u", stats.QuadCount);
 	ImGui::Text("Vertices: %u", stats.GetTotalVertexCount());
 	ImGui::Text("Indices: %u", stats.GetTotalIndexCount());
+	ImGui::Text("Vertex Buffer Waits: %u", stats.VertexBufferWaits);
+	ImGui::Text("Texture Limit Flushes: %u", stats.TextureLimitFlushes);
 
 	for (const auto& [Name, Time] : m_ProfileResults)
 	{
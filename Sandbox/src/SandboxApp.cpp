@@ -2,6 +2,7 @@
 #include <Kerberos/EntryPoint.h>
 
 #include "Sandbox2D.h"
+#include "Benchmarks/BenchmarkLayer.h"
 
 class Sandbox : public Kerberos::Application
 {
@@ -11,6 +12,7 @@ public:
 	{
 		//PushLayer(new ExampleLayer());
 		PushLayer(new Sandbox2D());
+		PushLayer(new BenchmarkLayer());
 	}
 
 	~Sandbox() override = default;
@@ -22,5 +24,15 @@ Kerberos::Application* Kerberos::CreateApplication(const ApplicationCommandLineA
 	spec.Name = "Sandbox";
 	spec.CommandLineArgs = args;
 
+	for (int i = 1; i < args.Count; ++i)
+	{
+		/// Profiles the CPU side of the renderer on machines without a GPU
+		if (std::string_view(args[i]) == "--null-renderer")
+			RendererAPI::SetAPI(RendererAPI::API::Null);
+
+		if (std::string_view(args[i]) == "--instanced-quads")
+			spec.Renderer2DSettings.QuadMode = Renderer2DQuadMode::Instanced;
+	}
+
 	return new Sandbox(spec);
 }
\ No newline at end of file